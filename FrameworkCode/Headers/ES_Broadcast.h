@@ -0,0 +1,32 @@
+/****************************************************************************
+ Module
+         ES_Broadcast.h
+
+ Revision
+         1.0.1
+
+ Description
+         Header File for the shared broadcast channel
+
+ Notes
+
+ History
+ When           Who	What/Why
+ -------------- ---	--------
+ 10/19/26 18:20 ags  Began Coding
+****************************************************************************/
+
+#ifndef ES_Broadcast_H
+#define ES_Broadcast_H
+
+#include "ES_Types.h"
+#include "ES_Events.h"
+
+bool ES_Broadcast(ES_Event_t ThisEvent);
+bool ES_Broadcast_Subscribe(uint8_t WhichService);
+bool ES_Broadcast_Unsubscribe(uint8_t WhichService);
+uint16_t ES_Broadcast_GetPending(void);
+bool ES_Broadcast_Next(uint8_t WhichService, ES_Event_t *pReturnEvent);
+
+#endif   /* ES_Broadcast_H */
+/*------------------------------ End of file ------------------------------*/
@@ -9,6 +9,30 @@
  History
  When           Who     What/Why
  -------------- ---     --------
+ 10/20/26 06:52  ags     input capture is off by default, like the other modules
+ 10/20/26 06:33  ags     the sample DIST_LIST_INIT has one mask, for 1 list
+ 10/20/26 06:22  ags     note that the byte debug markers give way to the trace
+ 10/20/26 05:04  ags     added _INCLUDE_VIRTUAL_TIME_
+ 10/20/26 03:52  ags     added TRACE_INPUTS_ONLY and _INCLUDE_EVENT_REPLAY_
+ 10/20/26 03:20  ags     added SERV_n_BUDGET, _INCLUDE_RUN_BUDGETS_, ES_OVERRUN
+                         and _INCLUDE_WATCHDOG_
+ 10/20/26 03:12  ags     added _INCLUDE_EVENT_STATS_
+ 10/20/26 02:36  ags     added _INCLUDE_PC_SAMPLER_
+ 10/20/26 01:55  ags     added _INCLUDE_LOAD_STATS_ and ES_LOAD_REPORT
+ 10/20/26 01:22  ags     the byte debug port is now sent by the uDMA
+ 10/20/26 00:36  ags     added _INCLUDE_TRACE_
+ 10/19/26 23:57  ags     added _INCLUDE_LATENCY_STATS_
+ 10/19/26 23:18  ags     added _INCLUDE_PROFILER_
+ 10/19/26 20:55  ags     added ES_ENTRY, ES_ENTRY_HISTORY & ES_EXIT events
+ 10/19/26 20:06  ags     added NUM_TIMED_DEFERRALS
+ 10/19/26 18:40  ags     added BROADCAST_RING_SIZE
+ 10/19/26 17:50  ags     distribution lists are now service bit masks set up
+                         by DIST_LIST_INIT
+ 10/19/26 16:40  ags     added ES_NUM_EVENT_TYPES to size the subscriptions
+ 10/19/26 15:30  ags     added ES_CAPTURE and the input capture configuration
+ 10/19/26 14:42  ags     added NUM_TIMER_GROUPS
+ 10/19/26 11:10  ags     added response functions for the high resolution
+                         timers that replace ES_ShortTimer
  12/19/16 20:19  jec     removed EVENT_CHECK_HEADER definition. This goes with
                          the V2.3 move to a single wrapper for event checking
                          headers
@@ -48,6 +72,9 @@
 #define SERV_0_RUN RunTestHarnessService0
 // How big should this services Queue be?
 #define SERV_0_QUEUE_SIZE 5
+// the longest its run function may take, in uS, 0 for no limit. Only
+// checked with _INCLUDE_RUN_BUDGETS_
+#define SERV_0_BUDGET 0
 
 /****************************************************************************/
 // The following sections are used to define the parameters for each of the
@@ -64,6 +91,9 @@
 #define SERV_1_RUN RunTestHarnessService1
 // How big should this services Queue be?
 #define SERV_1_QUEUE_SIZE 3
+// the longest its run function may take, in uS, 0 for no limit. Only
+// checked with _INCLUDE_RUN_BUDGETS_
+#define SERV_1_BUDGET 0
 #endif
 
 /****************************************************************************/
@@ -77,6 +107,9 @@
 #define SERV_2_RUN RunTestHarnessService2
 // How big should this services Queue be?
 #define SERV_2_QUEUE_SIZE 3
+// the longest its run function may take, in uS, 0 for no limit. Only
+// checked with _INCLUDE_RUN_BUDGETS_
+#define SERV_2_BUDGET 0
 #endif
 
 /****************************************************************************/
@@ -90,6 +123,9 @@
 #define SERV_3_RUN RunTestHarnessService3
 // How big should this services Queue be?
 #define SERV_3_QUEUE_SIZE 3
+// the longest its run function may take, in uS, 0 for no limit. Only
+// checked with _INCLUDE_RUN_BUDGETS_
+#define SERV_3_BUDGET 0
 #endif
 
 /****************************************************************************/
@@ -103,6 +139,9 @@
 #define SERV_4_RUN RunTestHarnessService4
 // How big should this services Queue be?
 #define SERV_4_QUEUE_SIZE 3
+// the longest its run function may take, in uS, 0 for no limit. Only
+// checked with _INCLUDE_RUN_BUDGETS_
+#define SERV_4_BUDGET 0
 #endif
 
 /****************************************************************************/
@@ -116,6 +155,9 @@
 #define SERV_5_RUN RunTestHarnessService5
 // How big should this services Queue be?
 #define SERV_5_QUEUE_SIZE 3
+// the longest its run function may take, in uS, 0 for no limit. Only
+// checked with _INCLUDE_RUN_BUDGETS_
+#define SERV_5_BUDGET 0
 #endif
 
 /****************************************************************************/
@@ -129,6 +171,9 @@
 #define SERV_6_RUN RunTestHarnessService6
 // How big should this services Queue be?
 #define SERV_6_QUEUE_SIZE 3
+// the longest its run function may take, in uS, 0 for no limit. Only
+// checked with _INCLUDE_RUN_BUDGETS_
+#define SERV_6_BUDGET 0
 #endif
 
 /****************************************************************************/
@@ -142,6 +187,9 @@
 #define SERV_7_RUN RunTestHarnessService7
 // How big should this services Queue be?
 #define SERV_7_QUEUE_SIZE 3
+// the longest its run function may take, in uS, 0 for no limit. Only
+// checked with _INCLUDE_RUN_BUDGETS_
+#define SERV_7_BUDGET 0
 #endif
 
 /****************************************************************************/
@@ -155,6 +203,9 @@
 #define SERV_8_RUN RunTestHarnessService8
 // How big should this services Queue be?
 #define SERV_8_QUEUE_SIZE 3
+// the longest its run function may take, in uS, 0 for no limit. Only
+// checked with _INCLUDE_RUN_BUDGETS_
+#define SERV_8_BUDGET 0
 #endif
 
 /****************************************************************************/
@@ -168,6 +219,9 @@
 #define SERV_9_RUN RunTestHarnessService9
 // How big should this services Queue be?
 #define SERV_9_QUEUE_SIZE 3
+// the longest its run function may take, in uS, 0 for no limit. Only
+// checked with _INCLUDE_RUN_BUDGETS_
+#define SERV_9_BUDGET 0
 #endif
 
 /****************************************************************************/
@@ -181,6 +235,9 @@
 #define SERV_10_RUN RunTestHarnessService10
 // How big should this services Queue be?
 #define SERV_10_QUEUE_SIZE 3
+// the longest its run function may take, in uS, 0 for no limit. Only
+// checked with _INCLUDE_RUN_BUDGETS_
+#define SERV_10_BUDGET 0
 #endif
 
 /****************************************************************************/
@@ -194,6 +251,9 @@
 #define SERV_11_RUN RunTestHarnessService11
 // How big should this services Queue be?
 #define SERV_11_QUEUE_SIZE 3
+// the longest its run function may take, in uS, 0 for no limit. Only
+// checked with _INCLUDE_RUN_BUDGETS_
+#define SERV_11_BUDGET 0
 #endif
 
 /****************************************************************************/
@@ -207,6 +267,9 @@
 #define SERV_12_RUN RunTestHarnessService12
 // How big should this services Queue be?
 #define SERV_12_QUEUE_SIZE 3
+// the longest its run function may take, in uS, 0 for no limit. Only
+// checked with _INCLUDE_RUN_BUDGETS_
+#define SERV_12_BUDGET 0
 #endif
 
 /****************************************************************************/
@@ -220,6 +283,9 @@
 #define SERV_13_RUN RunTestHarnessService13
 // How big should this services Queue be?
 #define SERV_13_QUEUE_SIZE 3
+// the longest its run function may take, in uS, 0 for no limit. Only
+// checked with _INCLUDE_RUN_BUDGETS_
+#define SERV_13_BUDGET 0
 #endif
 
 /****************************************************************************/
@@ -233,6 +299,9 @@
 #define SERV_14_RUN RunTestHarnessService14
 // How big should this services Queue be?
 #define SERV_14_QUEUE_SIZE 3
+// the longest its run function may take, in uS, 0 for no limit. Only
+// checked with _INCLUDE_RUN_BUDGETS_
+#define SERV_14_BUDGET 0
 #endif
 
 /****************************************************************************/
@@ -246,6 +315,9 @@
 #define SERV_15_RUN RunTestHarnessService15
 // How big should this services Queue be?
 #define SERV_15_QUEUE_SIZE 3
+// the longest its run function may take, in uS, 0 for no limit. Only
+// checked with _INCLUDE_RUN_BUDGETS_
+#define SERV_15_BUDGET 0
 #endif
 
 /****************************************************************************/
@@ -258,40 +330,39 @@ typedef enum
   ES_INIT,                  /* used to transition from initial pseudo-state */
   ES_TIMEOUT,               /* signals that the timer has expired */
   ES_SHORT_TIMEOUT,         /* signals that a short timer has expired */
+  ES_ENTRY,                 /* entry to a state of a hierarchical machine */
+  ES_ENTRY_HISTORY,         /* entry to a state, resuming its history */
+  ES_EXIT,                  /* exit from a state of a hierarchical machine */
+  ES_CAPTURE,               /* signals a captured edge, see ES_InputCapture.h */
+  ES_LOAD_REPORT,           /* the CPU load in 0.1%, see ES_Load.h */
+  ES_OVERRUN,               /* a run function went over its budget */
   /* User-defined events start here */
   ES_NEW_KEY,               /* signals a new key received from terminal */
   ES_LOCK,
-  ES_UNLOCK
+  ES_UNLOCK,
+  /* This must remain the last entry, it sizes the table of subscribers
+     used by ES_Publish */
+  ES_NUM_EVENT_TYPES
 }ES_EventType_t;
 
 /****************************************************************************/
-// These are the definitions for the Distribution lists. Each definition
-// should be a comma separated list of post functions to indicate which
-// services are on that distribution list.
+// The number of events held by the ES_Broadcast ring. Each broadcast event is
+// stored once and read by every subscriber, so this limits how far the
+// slowest subscriber can fall behind. Must be a power of 2, no larger than
+// 128. Set to 0 to leave out the broadcast channel.
+#define BROADCAST_RING_SIZE 16
+
+/****************************************************************************/
+// These are the definitions for the Distribution lists. Each list is a bit
+// mask of the services on it, bit n (BITnHI) for the service at priority n.
+// DIST_LIST_INIT gives the starting members of each list, one mask per list,
+// so it must have NUM_DIST_LISTS entries. The sample is for 1 list, with the
+// service at priority 0 on it, add a mask for each list added.
+// The members can be changed while running with ES_AddToList,
+// ES_RemoveFromList and ES_SetListMembers.
 #define NUM_DIST_LISTS 0
 #if NUM_DIST_LISTS > 0
-#define DIST_LIST0 PostTestHarnessService0, PostTestHarnessService0
-#endif
-#if NUM_DIST_LISTS > 1
-#define DIST_LIST1 PostTestHarnessService1, PostTestHarnessService1
-#endif
-#if NUM_DIST_LISTS > 2
-#define DIST_LIST2 PostTemplateFSM
-#endif
-#if NUM_DIST_LISTS > 3
-#define DIST_LIST3 PostTemplateFSM
-#endif
-#if NUM_DIST_LISTS > 4
-#define DIST_LIST4 PostTemplateFSM
-#endif
-#if NUM_DIST_LISTS > 5
-#define DIST_LIST5 PostTemplateFSM
-#endif
-#if NUM_DIST_LISTS > 6
-#define DIST_LIST6 PostTemplateFSM
-#endif
-#if NUM_DIST_LISTS > 7
-#define DIST_LIST7 PostTemplateFSM
+#define DIST_LIST_INIT { BIT0HI }
 #endif
 
 /****************************************************************************/
@@ -331,6 +402,227 @@ typedef enum
 
 #define SERVICE0_TIMER 15
 
+/****************************************************************************/
+// The number of timer groups available. Timers are placed in a group, owned
+// by a service, with ES_Timer_AssignGroup. ES_Timer_StopGroup then stops all
+// of the timers in the group and purges their queued ES_TIMEOUT events.
+#define NUM_TIMER_GROUPS 4
+
+/****************************************************************************/
+// The number of timed deferral queues (see ES_DeferRecall.h) whose expired
+// entries are removed on every tick. Set to 0 if none are used.
+#define NUM_TIMED_DEFERRALS 2
+
+/****************************************************************************/
+// uncomment this line to start the high resolution (1uS) timer module
+// in ES_Initialize. It uses Wide Timer 0A on the Tiva.
+#define _INCLUDE_HR_TIMERS_
+
+/****************************************************************************/
+// These are the definitions for the post functions to be executed when the
+// corresponding high resolution timer expires. These timers post
+// ES_SHORT_TIMEOUT with the timer number as the parameter. All 16 must be
+// defined. If you are not using a timer, then you should use TIMER_UNUSED
+#define HRTIMER0_RESP_FUNC PostTestHarnessService0
+#define HRTIMER1_RESP_FUNC TIMER_UNUSED
+#define HRTIMER2_RESP_FUNC TIMER_UNUSED
+#define HRTIMER3_RESP_FUNC TIMER_UNUSED
+#define HRTIMER4_RESP_FUNC TIMER_UNUSED
+#define HRTIMER5_RESP_FUNC TIMER_UNUSED
+#define HRTIMER6_RESP_FUNC TIMER_UNUSED
+#define HRTIMER7_RESP_FUNC TIMER_UNUSED
+#define HRTIMER8_RESP_FUNC TIMER_UNUSED
+#define HRTIMER9_RESP_FUNC TIMER_UNUSED
+#define HRTIMER10_RESP_FUNC TIMER_UNUSED
+#define HRTIMER11_RESP_FUNC TIMER_UNUSED
+#define HRTIMER12_RESP_FUNC TIMER_UNUSED
+#define HRTIMER13_RESP_FUNC TIMER_UNUSED
+#define HRTIMER14_RESP_FUNC TIMER_UNUSED
+#define HRTIMER15_RESP_FUNC TIMER_UNUSED
+
+// symbolic names for the high resolution timers
+#define SERVICE0_HR_TIMER 0
+
+/****************************************************************************/
+// uncomment this line to start the input capture module in ES_Initialize.
+// It timestamps edges on the high resolution timer count, so it needs
+// _INCLUDE_HR_TIMERS_ as well. Uses Wide Timers 1 & 2 on the Tiva.
+//#define _INCLUDE_INPUT_CAPTURE_
+
+/****************************************************************************/
+// These are the definitions for the post functions to be executed when an
+// edge is captured on the corresponding channel (0 = PC6, 1 = PC7, 2 = PD0,
+// 3 = PD1). They post ES_CAPTURE. All 4 must be defined. Channels that are
+// not in use should use CAPTURE_UNUSED, and their pins are left alone.
+#define CAPTURE_UNUSED ((pPostFunc)0)
+#define CAPTURE0_RESP_FUNC PostTestHarnessService0
+#define CAPTURE1_RESP_FUNC CAPTURE_UNUSED
+#define CAPTURE2_RESP_FUNC CAPTURE_UNUSED
+#define CAPTURE3_RESP_FUNC CAPTURE_UNUSED
+
+// the edge to capture on each channel: ES_CAPTURE_RISING, ES_CAPTURE_FALLING
+// or ES_CAPTURE_BOTH
+#define CAPTURE0_EDGE ES_CAPTURE_RISING
+#define CAPTURE1_EDGE ES_CAPTURE_RISING
+#define CAPTURE2_EDGE ES_CAPTURE_RISING
+#define CAPTURE3_EDGE ES_CAPTURE_RISING
+
+// the number of captured edges that can be waiting to be posted. This must
+// be a power of 2, no larger than 128. It is also the number of edges after
+// which a record can no longer be retrieved with ES_InputCapture_GetEdge
+#define CAPTURE_RING_SIZE 16
+
+/**************************************************************************/
+// uncomment this line to measure the cycles taken by every call to a run
+// function, per service and per event type, see ES_Profiler.h. Uses the
+// DWT cycle counter on the Tiva.
+//#define _INCLUDE_PROFILER_
+
+/**************************************************************************/
+// uncomment this line to keep a histogram, for each service, of the time
+// its events wait in its queue, see ES_Latency.h. The events are stamped on
+// the high resolution timer, so it needs _INCLUDE_HR_TIMERS_ as well.
+//#define _INCLUDE_LATENCY_STATS_
+
+// the stamps are the uS count shifted right by this, in 16 bits. At 2,
+// latencies up to 65535 * 4uS (262mS) are measured, to the nearest 4uS
+#define LATENCY_STAMP_SHIFT 2
+
+#if defined(_INCLUDE_LATENCY_STATS_) && !defined(_INCLUDE_HR_TIMERS_)
+#error _INCLUDE_LATENCY_STATS_ needs _INCLUDE_HR_TIMERS_
+#endif
+
+/**************************************************************************/
+// uncomment this line to record the posts, runs, timeouts and event checker
+// hits in a binary trace, see ES_Trace.h. The trace is sent out on UART1
+// (PB1, 1Mbaud) on the Tiva and to the file named by ES_TRACE_FILE (default
+// es_trace.bin) on the host. The records are timed on the high resolution
+// timer, so it needs _INCLUDE_HR_TIMERS_ as well.
+//#define _INCLUDE_TRACE_
+
+// the number of records that the trace can hold while waiting to be sent.
+// This must be a power of 2. Each record takes 6 bytes.
+#define TRACE_RING_SIZE 256
+
+// uncomment this line to trace only the inputs to the services, the posts
+// made from outside the run functions by the event checkers, the timers and
+// the interrupt responses. This is the capture to replay on the host with
+// _INCLUDE_EVENT_REPLAY_, and it keeps the trace small enough to run for a
+// long time in the field.
+//#define TRACE_INPUTS_ONLY
+
+#if defined(_INCLUDE_TRACE_) && !defined(_INCLUDE_HR_TIMERS_)
+#error _INCLUDE_TRACE_ needs _INCLUDE_HR_TIMERS_
+#endif
+
+/**************************************************************************/
+// uncomment this line to account for the time ES_Run spends dispatching
+// events, in the event checkers, processing pending interrupts and idle,
+// and to work out the CPU load from it, see ES_Load.h. The time is taken
+// from the high resolution timer, so it needs _INCLUDE_HR_TIMERS_ as well.
+//#define _INCLUDE_LOAD_STATS_
+
+// the load is worked out over windows of this many mS, and the sliding load
+// is the mean of the last LOAD_NUM_WINDOWS of them
+#define LOAD_WINDOW_MS 100
+#define LOAD_NUM_WINDOWS 10
+
+// uncomment this line to post an ES_LOAD_REPORT event, carrying the sliding
+// load, to this post function every LOAD_NUM_WINDOWS windows
+//#define LOAD_REPORT_FUNC PostTestHarnessService0
+
+#if defined(_INCLUDE_LOAD_STATS_) && !defined(_INCLUDE_HR_TIMERS_)
+#error _INCLUDE_LOAD_STATS_ needs _INCLUDE_HR_TIMERS_
+#endif
+
+/**************************************************************************/
+// uncomment this line to sample the PC from a timer interrupt and count the
+// samples in a histogram over the code, see ES_PCSample.h. Uses Timer 1A on
+// the Tiva and SIGPROF on the host. Tools/ES_PCSymbolize.py turns the
+// histogram into the time spent in each function.
+//#define _INCLUDE_PC_SAMPLER_
+
+// the samples taken each second. Keep this off a multiple of the tick rate,
+// so that the samples do not fall at the same point in every tick
+#define PC_SAMPLE_RATE_HZ 997
+
+// each bucket of the histogram covers 2^PC_SAMPLE_SHIFT bytes of code, and
+// the histogram covers PC_SAMPLE_NUM_BUCKETS of them from the start of the
+// code (32K at 5 and 1024). Each bucket takes 2 bytes of RAM
+#define PC_SAMPLE_SHIFT 5
+#define PC_SAMPLE_NUM_BUCKETS 1024
+
+/**************************************************************************/
+// uncomment this line to count the events of each type posted, dispatched,
+// dropped and deferred, and to keep decaying means of their rates, see
+// ES_EventStats.h
+//#define _INCLUDE_EVENT_STATS_
+
+// the rates are worked out over periods of this many ticks (mS at the usual
+// tick rate), and each one moves the mean 1/2^EVENT_RATE_SHIFT of the way to
+// the new rate. At 100 and 3 the mean follows a change over about a second.
+#define EVENT_RATE_PERIOD_MS 100
+#define EVENT_RATE_SHIFT 3
+
+/**************************************************************************/
+// uncomment this line to time every call to a run function and check it
+// against the service's SERV_n_BUDGET. The overruns are counted for each
+// service, see ES_GetOverrunStats. The time is taken from the high
+// resolution timer, so it needs _INCLUDE_HR_TIMERS_ as well.
+//#define _INCLUDE_RUN_BUDGETS_
+
+// uncomment this line to post an ES_OVERRUN event to this post function
+// for each overrun. The parameter holds the service and the type of the
+// event it was running, see ES_OVERRUN_SERVICE and ES_OVERRUN_TYPE
+//#define OVERRUN_POST_FUNC PostTestHarnessService0
+
+#if defined(_INCLUDE_RUN_BUDGETS_) && !defined(_INCLUDE_HR_TIMERS_)
+#error _INCLUDE_RUN_BUDGETS_ needs _INCLUDE_HR_TIMERS_
+#endif
+
+/**************************************************************************/
+// uncomment this line to start the hardware watchdog in ES_Initialize.
+// ES_Run feeds it before every run function and every pass through the
+// event checkers, so it only fires if one of them hangs. Uses Watchdog 0
+// on the Tiva, which resets the processor. On the host the process exits.
+//#define _INCLUDE_WATCHDOG_
+
+// the time without being fed after which the watchdog fires
+#define WATCHDOG_TIMEOUT_MS 500
+
+/**************************************************************************/
+// uncomment this line, on the host only, to replay the inputs captured in a
+// trace, see ES_Replay.h. Tools/ES_TraceDecode.py --replay turns the trace
+// into the file named by ES_REPLAY_FILE (default es_replay.txt). The clock
+// is virtual, it only moves on to the next input once ES_Run is idle, and
+// the live inputs from the timers and interrupt responses are dropped. The
+// event checkers are not called. At the end of the file the dispatch cycles,
+// queue peaks and response times are printed and the process exits.
+//#define _INCLUDE_EVENT_REPLAY_
+
+#if defined(_INCLUDE_EVENT_REPLAY_) && !defined(_ES_HOST_PORT_)
+#error _INCLUDE_EVENT_REPLAY_ is only for the host port
+#endif
+
+/**************************************************************************/
+// uncomment this line, on the host only, to run on a virtual clock. Once
+// ES_Run has no work and the event checkers have found nothing, the clock
+// jumps straight to the next timer deadline, so tests built on long
+// ES_Timer_InitTimer times take only as long as the work of the services.
+// See the notes in ES_HostPort.c. The clock stands still while the
+// services run, so the load and latency figures come out as 0, and a
+// service that waits in a loop for the time to pass waits for ever.
+//#define _INCLUDE_VIRTUAL_TIME_
+
+// the replay moves the same virtual clock on to each input
+#if defined(_INCLUDE_EVENT_REPLAY_) && !defined(_INCLUDE_VIRTUAL_TIME_)
+#define _INCLUDE_VIRTUAL_TIME_
+#endif
+
+#if defined(_INCLUDE_VIRTUAL_TIME_) && !defined(_ES_HOST_PORT_)
+#error _INCLUDE_VIRTUAL_TIME_ is only for the host port
+#endif
+
 /**************************************************************************/
 // uncomment this ine to get some basic framework operation debugging on
 // PF1 & PF2
@@ -339,7 +631,11 @@ typedef enum
 #ifndef _INCLUDE_BASIC_FRAMEWORK_DEBUG_
 /**************************************************************************/
 // uncomment the next line to get byte-wide debugging on the '595
-// uses PF1, PF2 & PF3 
+// uses PF1, PF2 & PF3 on SSI1, fed by uDMA channel 25, so the _HW_ByteDebug
+// calls only queue the byte. On the host the bytes are written to the file
+// named by ES_BYTE_DEBUG_FILE (default es_bytedebug.txt)
+// TestHarnessService0 marks its posts, runs and timeouts on it, unless
+// _INCLUDE_TRACE_ is defined, as the trace records them then
 #define _INCLUDE_BYTE_DEBUG_
 
 #endif /* _INCLUDE_BASIC_FRAMEWORK_DEBUG_ */
@@ -4,6 +4,30 @@
 #include "ES_Queue.h"
 #include "ES_Events.h"
 
+/*
+   A timed deferral queue. Each entry expires Lifetime ticks after it was
+   deferred. Expired entries are removed on every tick, and before a recall,
+   so they are never recalled. If ExpiredType is ES_NO_EVENT they are just
+   dropped, otherwise an ExpiredType event is posted to the Owner, with the
+   type of the expired event as its parameter.
+   pStamps must have one entry for each entry in the queue, i.e. one fewer
+   than BlockSize. Lifetime must be less than 32768 ticks.
+   e.g.
+     static ES_Event_t DeferralQueue[3 + 1];
+     static uint16_t   DeferralStamps[3];
+     static ES_TimedDeferral_t Deferral = { DeferralQueue,
+         ARRAY_SIZE(DeferralQueue), DeferralStamps, 500, ES_NO_EVENT, 0 };
+*/
+typedef struct
+{
+  ES_Event_t      *pBlock;
+  uint8_t         BlockSize;
+  uint16_t        *pStamps;
+  uint16_t        Lifetime;     /* ticks */
+  ES_EventType_t  ExpiredType;  /* ES_NO_EVENT to drop expired entries */
+  uint8_t         Owner;        /* set by ES_InitTimedDeferral */
+}ES_TimedDeferral_t;
+
 /****************************************************************************
  Function
    ES_InitDeferralQueueWith  (wrapper for ES_InitQueue )
@@ -26,7 +50,7 @@
 
 /****************************************************************************
  Function
-   ES_DeferEvent  (wrapper for ES_EnQueueLIFO)
+   ES_DeferEvent  (wrapper for ES_EnQueueFIFO)
    this is a straight re-naming to aid readability
  Parameters
    ES_Event * pBlock : pointer to the block of memory in use as the Queue
@@ -34,9 +58,17 @@
  Returns
    bool : true if the add was successful, false if not
  Description
-   if it will fit, adds Event2Add to the Queue
+   if it will fit, adds Event2Add to the Queue. The deferral queue is kept in
+   the order that the events arrived, which is the order they are recalled
+ Notes
+   with _INCLUDE_EVENT_STATS_ the deferrals are also counted, see
+   ES_EventStats.h
  ***************************************************************************/
-#define ES_DeferEvent(a, b) ES_EnQueueLIFO(a, b)
+#ifdef _INCLUDE_EVENT_STATS_
+#define ES_DeferEvent(a, b) ES_DeferEventCounted(a, b)
+#else
+#define ES_DeferEvent(a, b) ES_EnQueueFIFO(a, b)
+#endif
 
 /****************************************************************************
  Function
@@ -48,14 +80,38 @@
  Returns
      bool true if an event was recalled, false if no event was left in queue
  Description
-     pulls an event off the deferral queue if one is available. It there was
-     something in the queue, then it posts it LIFO fashion to the queue
-     indicated by WhichService
+     moves all of the events on the deferral queue to the front of the queue
+     indicated by WhichService, in the order that they were deferred
  Notes
-     None.
+     events that do not fit in the service's queue stay deferred
  Author
      J. Edward Carryer, 11/20/13 16:49
 ****************************************************************************/
 bool ES_RecallEvents(uint8_t WhichService, ES_Event_t *pBlock);
 
+/****************************************************************************
+ Function
+     ES_RecallEventsOfType
+ Parameters
+      uint8_t WhichService, number of the service to post Recalled event to
+      ES_Event * pBlock, pointer to the block of memory that implements the
+        Defer/Recall queue
+      uint32_t TypeMask, the types to recall, eg ES_TYPE_MASK(ES_NEW_KEY)
+ Returns
+     bool true if an event was recalled, false if none matched
+ Description
+     as ES_RecallEvents, but only for the events of the selected types
+****************************************************************************/
+bool ES_RecallEventsOfType(uint8_t WhichService, ES_Event_t *pBlock,
+    uint32_t TypeMask);
+
+#ifdef _INCLUDE_EVENT_STATS_
+bool ES_DeferEventCounted(ES_Event_t *pBlock, ES_Event_t ThisEvent);
+#endif
+bool ES_InitTimedDeferral(ES_TimedDeferral_t *pDeferral, uint8_t Owner);
+bool ES_DeferEventTimed(ES_TimedDeferral_t *pDeferral, ES_Event_t ThisEvent);
+bool ES_RecallTimedEvents(ES_TimedDeferral_t *pDeferral, uint32_t TypeMask);
+void ES_SweepTimedDeferrals(void);
+uint16_t ES_TicksToTimedExpiry(void);
+
 #endif
@@ -0,0 +1,49 @@
+/****************************************************************************
+ Module
+         ES_EventStats.h
+
+ Revision
+         1.0.1
+
+ Description
+         Header File for the per event type counters and rate meters
+
+ Notes
+         Only compiled in with _INCLUDE_EVENT_STATS_ defined in
+         ES_Configure.h.
+         The counts are of deliveries to service queues, so an event posted
+         to 3 services counts as 3 posts, and 3 dispatches once they have
+         all run. The rates are in tenths of an event per second.
+
+ History
+ When           Who	What/Why
+ -------------- ---	--------
+ 10/20/26 02:45 ags  Began Coding
+****************************************************************************/
+
+#ifndef ES_EventStats_H
+#define ES_EventStats_H
+
+#include "ES_Types.h"
+#include "ES_Events.h"
+
+typedef struct
+{
+  uint32_t  Posted;       /* put in a service queue or the broadcast ring */
+  uint32_t  Dispatched;   /* given to a run function */
+  uint32_t  Dropped;      /* lost because a queue was full */
+  uint32_t  Deferred;     /* put in a deferral queue */
+  uint32_t  PostRate;     /* decaying mean of the posts per second, x10 */
+  uint32_t  DispatchRate; /* decaying mean of the dispatches per second */
+}ES_EventStats_t;
+
+void ES_EventStats_Reset(void);
+void ES_EventStats_Posted(ES_EventType_t WhichType, uint16_t Services);
+void ES_EventStats_Dropped(ES_EventType_t WhichType, uint16_t Services);
+void ES_EventStats_Deferred(ES_EventType_t WhichType);
+void ES_EventStats_Dispatched(ES_EventType_t WhichType);
+bool ES_EventStats_Get(ES_EventType_t WhichType, ES_EventStats_t *pStats);
+void ES_EventStats_Dump(uint8_t TopN);
+
+#endif   /* ES_EventStats_H */
+/*------------------------------ End of file ------------------------------*/
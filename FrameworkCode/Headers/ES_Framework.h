@@ -8,6 +8,11 @@
  History
  When           Who     What/Why
  -------------- ---     --------
+ 10/20/26 04:19 ags      added ES_PostIsInput for the trace and the replay
+ 10/20/26 03:24 ags      added the run function overrun statistics
+ 10/19/26 19:18 ags      added prototypes for ES_SpliceToService and the
+                         multicast and publish/subscribe posting functions
+ 10/19/26 14:18 ags      added ES_PurgeFromService prototype
  11/02/13 17:06 jec      added ES_PostToServiceLIFO prototype
  08/05/13 15:00 jec      added #include for ES_Port.h to get portability stuff
  10/17/06 07:41 jec      started coding
@@ -39,10 +44,42 @@ typedef enum
   FailedInit
 }ES_Return_t;
 
+// the mask of every service, for the multicast post functions
+#define ES_ALL_SERVICES ((uint16_t)((1UL << NUM_SERVICES) - 1))
+
+// the parts of the parameter of an ES_OVERRUN event
+#define ES_OVERRUN_SERVICE(Param) ((uint8_t)((Param) >> 8))
+#define ES_OVERRUN_TYPE(Param) ((ES_EventType_t)((Param) & 0xFF))
+
+// the overruns of a service's SERV_n_BUDGET, with _INCLUDE_RUN_BUDGETS_
+typedef struct
+{
+  uint32_t        Count;      /* the number of runs over the budget */
+  uint32_t        WorstTime;  /* uS, the longest run over the budget */
+  ES_EventType_t  WorstType;  /* the event that the longest was given */
+  ES_EventType_t  LastType;   /* the event of the latest overrun */
+}ES_OverrunStats_t;
+
 ES_Return_t ES_Initialize(TimerRate_t NewRate);
 ES_Return_t ES_Run(void);
 bool ES_PostAll(ES_Event_t ThisEvent);
+bool ES_PostToMask(uint16_t Services, ES_Event_t ThisEvent);
+uint16_t ES_PostToMaskBestEffort(uint16_t Services, ES_Event_t ThisEvent);
 bool ES_PostToService(uint8_t WhichService, ES_Event_t ThisEvent);
 bool ES_PostToServiceLIFO(uint8_t WhichService, ES_Event_t TheEvent);
+uint8_t ES_SpliceToService(uint8_t WhichService, ES_Event_t *pSource,
+    uint16_t *pSourceStamps, uint32_t TypeMask);
+bool ES_PurgeFromService(uint8_t WhichService, ES_EventType_t WhichType,
+    uint16_t ParamMask);
+bool ES_Subscribe(uint8_t WhichService, ES_EventType_t WhichType);
+bool ES_Unsubscribe(uint8_t WhichService, ES_EventType_t WhichType);
+bool ES_Publish(ES_Event_t ThisEvent);
+#if defined(_INCLUDE_TRACE_) || defined(_INCLUDE_EVENT_REPLAY_)
+bool ES_PostIsInput(void);
+#endif
+#ifdef _INCLUDE_RUN_BUDGETS_
+bool ES_GetOverrunStats(uint8_t WhichService, ES_OverrunStats_t *pStats);
+void ES_ResetOverrunStats(void);
+#endif
 
 #endif   // ES_Framework_H
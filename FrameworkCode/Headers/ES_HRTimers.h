@@ -0,0 +1,52 @@
+/****************************************************************************
+ Module
+         ES_HRTimers.h
+
+ Revision
+         1.0.1
+
+ Description
+         Header File for the high resolution (1uS) timer module
+
+ Notes
+         The API mirrors ES_Timers.h, with times expressed in uS rather
+         than framework ticks.
+
+ History
+ When           Who	What/Why
+ -------------- ---	--------
+ 10/20/26 06:50 ags  added HR_TIMER_MAX_TIME, removed the prototype for
+                     IsTimerActive, it was never coded
+ 10/19/26 09:12 ags  Began Coding, replaces ES_ShortTimer
+****************************************************************************/
+
+#ifndef ES_HRTimers_H
+#define ES_HRTimers_H
+
+#include "ES_Types.h"
+#include "ES_Timers.h"
+
+/*
+   timeouts shorter than this (in uS) are posted immediately rather than
+   programmed into the hardware, since the interrupt response overhead would
+   make them late anyway
+*/
+#define HR_TIMER_MIN_TIME 11
+
+/*
+   the longest timeout (in uS, about 35 minutes) that can be set. Deadlines
+   are compared as signed 32 bit differences, so anything longer would look
+   like it was already in the past and expire at once
+*/
+#define HR_TIMER_MAX_TIME ((uint32_t)INT32_MAX)
+
+void ES_HRTimer_Init(void);
+void ES_HRTimer_Match_Resp(void);
+ES_TimerReturn_t ES_HRTimer_InitTimer(uint8_t Num, uint32_t NewTime);
+ES_TimerReturn_t ES_HRTimer_SetTimer(uint8_t Num, uint32_t NewTime);
+ES_TimerReturn_t ES_HRTimer_StartTimer(uint8_t Num);
+ES_TimerReturn_t ES_HRTimer_StopTimer(uint8_t Num);
+uint32_t ES_HRTimer_GetTime(void);
+
+#endif   /* ES_HRTimers_H */
+/*------------------------------ End of file ------------------------------*/
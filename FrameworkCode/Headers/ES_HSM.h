@@ -0,0 +1,161 @@
+/****************************************************************************
+ Module
+         ES_HSM.h
+
+ Revision
+         1.0.1
+
+ Description
+         Header File for the table driven hierarchical state machine engine
+
+ Notes
+         A machine is described by a const table of states. Each state names
+         its parent, its depth in the hierarchy, the substate entered by
+         default, its entry/exit/during functions and its transitions. The
+         engine keeps only the active leaf state in RAM.
+         A state may instead be split into orthogonal regions, which are
+         all active at once. Each region has a number, and the engine keeps
+         the deepest active state in each region. The regions are numbered
+         so that a region comes after every region nested inside it, with
+         the top level of the machine last (NumRegions - 1). A machine
+         without orthogonal states has the one region, 0.
+         A state may defer event types, by setting their bits in its
+         DeferMask. While it is active, events of those types are put on
+         the machine's deferral queue, see ES_HSM_SetDeferralQueue, and
+         they are recalled when no active state defers them any more.
+         A state may keep shallow or deep history. Whenever it is exited,
+         the deepest active state in its region is saved in its history
+         slot, and the deepest active state of each region as it is exited
+         is saved too. When the state is next the target of a transition,
+         it resumes: shallow history re-enters the substate it was in and
+         that substate's defaults, deep history goes straight back to the
+         saved leaves, in every region below it.
+
+ History
+ When           Who	What/Why
+ -------------- ---	--------
+ 10/20/26 06:27 ags  added ES_HSM_IsDeferring
+ 10/19/26 22:40 ags  added shallow and deep history
+ 10/19/26 22:20 ags  added per-state deferral masks
+ 10/19/26 21:40 ags  added orthogonal regions
+ 10/19/26 21:05 ags  added the per-state event map, so that the transitions
+                     on an event can be found without searching
+ 10/19/26 20:20 ags  Began Coding
+****************************************************************************/
+
+#ifndef ES_HSM_H
+#define ES_HSM_H
+
+#include "ES_Types.h"
+#include "ES_Events.h"
+
+// the deepest nesting of states that the engine will handle
+#define ES_HSM_MAX_DEPTH 8
+// the most regions, counting the top level, in one machine
+#define ES_HSM_MAX_REGIONS 4
+// the most states keeping history in one machine
+#define ES_HSM_MAX_HISTORY 4
+
+// states are numbered by their index in the state table
+typedef uint8_t ES_HSMState_t;
+
+// the parent of the top level states, and the LCA of a transition between
+// two of them
+#define ES_HSM_ROOT ((ES_HSMState_t)0xFF)
+// the InitialChild of a leaf state, and the state of an inactive region
+#define ES_HSM_NO_STATE ((ES_HSMState_t)0xFE)
+// the Target of an internal transition, which runs its action only
+#define ES_HSM_INTERNAL ((ES_HSMState_t)0xFD)
+// the Lca of a transition to be worked out when it is taken
+#define ES_HSM_LCA_AUTO ((ES_HSMState_t)0xFC)
+
+// the kinds of history that a state may keep
+#define ES_HSM_HISTORY_NONE     0
+#define ES_HSM_HISTORY_SHALLOW  1
+#define ES_HSM_HISTORY_DEEP     2
+
+// entry, exit and transition actions are passed the triggering event
+typedef void (*pHSMActionFunc)(ES_Event_t ThisEvent);
+// during functions may return the event, a re-mapped event, or ES_NO_EVENT
+// to consume it
+typedef ES_Event_t (*pHSMDuringFunc)(ES_Event_t ThisEvent);
+// guards return true to allow the transition to be taken
+typedef bool (*pHSMGuardFunc)(ES_Event_t ThisEvent);
+
+typedef struct
+{
+  ES_EventType_t  EventType;
+  pHSMGuardFunc   Guard;      /* 0 if always taken */
+  pHSMActionFunc  Action;     /* 0 if none */
+  ES_HSMState_t   Target;     /* or ES_HSM_INTERNAL */
+  /* the deepest state containing both the source and the target, that is
+     not left by the transition, or ES_HSM_LCA_AUTO */
+  ES_HSMState_t   Lca;
+}ES_HSMTransition_t;
+
+typedef struct
+{
+  ES_HSMState_t             Parent;       /* ES_HSM_ROOT at the top level */
+  uint8_t                   Depth;        /* 1 at the top level */
+  /* ES_HSM_NO_STATE for a leaf, the first of the region states for an
+     orthogonal state */
+  ES_HSMState_t             InitialChild;
+  pHSMActionFunc            Entry;        /* 0 if none */
+  pHSMActionFunc            Exit;         /* 0 if none */
+  pHSMDuringFunc            During;       /* 0 if none */
+  const ES_HSMTransition_t  *pTransitions;
+  uint8_t                   NumTransitions;
+  /* 0 to search the transitions, or ES_NUM_EVENT_TYPES entries giving, for
+     each event type, 1 + the index of its first transition (0 if none).
+     The transitions on one event type must then be next to each other. */
+  const uint8_t             *pEventMap;
+  uint8_t                   Region;       /* the region the state is in */
+  /* 0, or for an orthogonal state, the number of regions. There is a state
+     for each region, with this state as its Parent and a different Region,
+     and these region states follow each other in the table */
+  uint8_t                   NumRegions;
+  uint8_t                   SubRegion;    /* the lowest region inside it */
+  /* the event types deferred while the state is active, built with
+     ES_TYPE_MASK(), so only types 0-31 can be deferred */
+  uint32_t                  DeferMask;
+  uint8_t                   History;      /* ES_HSM_HISTORY_xxx */
+  /* for a state keeping history, its own slot, 0 to ES_HSM_MAX_HISTORY-1 */
+  uint8_t                   HistorySlot;
+}ES_HSMStateDesc_t;
+
+typedef struct
+{
+  const ES_HSMStateDesc_t *pStates;
+  uint8_t                 NumStates;
+  ES_HSMState_t           InitialState; /* the top level state entered first */
+  uint8_t                 NumRegions;   /* including the top level, or 0 */
+}ES_HSMDesc_t;
+
+// the RAM part of a machine, one per instance
+typedef struct
+{
+  const ES_HSMDesc_t  *pDesc;
+  /* the deepest active state in each region, ES_HSM_NO_STATE if inactive */
+  ES_HSMState_t       Current[ES_HSM_MAX_REGIONS];
+  uint32_t            ActiveDeferMask;  /* the DeferMasks of active states */
+  ES_Event_t          *pDeferQueue;     /* 0 if the machine has none */
+  uint8_t             Owner;            /* the service that runs it */
+  /* the deepest active state in the region of each state keeping history,
+     when it was last exited, ES_HSM_NO_STATE if it has not been */
+  ES_HSMState_t       History[ES_HSM_MAX_HISTORY];
+  /* the deepest active state in each region when it was last exited */
+  ES_HSMState_t       RegionHistory[ES_HSM_MAX_REGIONS];
+}ES_HSM_t;
+
+void ES_HSM_SetDeferralQueue(ES_HSM_t *pHSM, ES_Event_t *pDeferQueue,
+    uint8_t Owner);
+void ES_HSM_Start(ES_HSM_t *pHSM, const ES_HSMDesc_t *pDesc,
+    ES_Event_t EntryEvent);
+ES_Event_t ES_HSM_Run(ES_HSM_t *pHSM, ES_Event_t ThisEvent);
+ES_HSMState_t ES_HSM_GetState(const ES_HSM_t *pHSM);
+ES_HSMState_t ES_HSM_GetRegionState(const ES_HSM_t *pHSM, uint8_t Region);
+bool ES_HSM_IsIn(const ES_HSM_t *pHSM, ES_HSMState_t State);
+bool ES_HSM_IsDeferring(const ES_HSM_t *pHSM, ES_EventType_t EventType);
+
+#endif   /* ES_HSM_H */
+/*------------------------------ End of file ------------------------------*/
@@ -0,0 +1,56 @@
+/****************************************************************************
+ Module
+         ES_InputCapture.h
+
+ Revision
+         1.0.1
+
+ Description
+         Header File for the input capture (edge timestamping) module
+
+ Notes
+         Timestamps are on the same free-running uS count as ES_HRTimers,
+         so they can be compared directly with ES_HRTimer_GetTime()
+
+ History
+ When           Who	What/Why
+ -------------- ---	--------
+ 10/19/26 15:02 ags  Began Coding
+****************************************************************************/
+
+#ifndef ES_InputCapture_H
+#define ES_InputCapture_H
+
+#include "ES_Types.h"
+
+/*
+   the number of hardware capture channels. On the Tiva these are
+   channel 0 = WT1CCP0 (PC6), 1 = WT1CCP1 (PC7), 2 = WT2CCP0 (PD0),
+   3 = WT2CCP1 (PD1)
+*/
+#define NUM_CAPTURE_CHANNELS 4
+
+// which edge(s) of the input a channel timestamps
+typedef enum
+{
+  ES_CAPTURE_RISING,
+  ES_CAPTURE_FALLING,
+  ES_CAPTURE_BOTH
+}ES_CaptureEdge_t;
+
+// a captured edge, as returned by ES_InputCapture_GetEdge
+typedef struct
+{
+  uint8_t   Channel;
+  uint32_t  Timestamp;  /* uS count at the edge */
+  uint32_t  Period;     /* uS since the last edge on this channel, 0 if first */
+}ES_CaptureRecord_t;
+
+void ES_InputCapture_Init(void);
+void ES_InputCapture_Edge_Resp(uint8_t Channel, uint32_t Timestamp);
+void ES_InputCapture_Process(void);
+bool ES_InputCapture_GetEdge(uint16_t Param, ES_CaptureRecord_t *pEdge);
+uint16_t ES_InputCapture_GetOverruns(void);
+
+#endif   /* ES_InputCapture_H */
+/*------------------------------ End of file ------------------------------*/
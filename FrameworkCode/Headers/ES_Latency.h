@@ -0,0 +1,43 @@
+/****************************************************************************
+ Module
+         ES_Latency.h
+
+ Revision
+         1.0.1
+
+ Description
+         Header File for the queueing latency statistics of the services
+
+ Notes
+         Only compiled in with _INCLUDE_LATENCY_STATS_ defined in
+         ES_Configure.h.
+         The latency of an event is the time from when it was posted to a
+         service's queue until it was given to the service's run function.
+         The histograms have a bucket for each power of 2: bucket 0 counts
+         latencies of 0, and bucket n counts those from 2^(n-1) to 2^n - 1,
+         in units of 2^LATENCY_STAMP_SHIFT uS.
+
+ History
+ When           Who	What/Why
+ -------------- ---	--------
+ 10/19/26 23:47 ags  Began Coding
+****************************************************************************/
+
+#ifndef ES_Latency_H
+#define ES_Latency_H
+
+#include "ES_Types.h"
+
+// one bucket for each possible number of significant bits in a latency
+#define ES_LATENCY_NUM_BUCKETS 17
+
+void ES_Latency_Reset(void);
+uint16_t ES_Latency_Now(void);
+void ES_Latency_Record(uint8_t WhichService, uint16_t Latency);
+bool ES_Latency_GetHistogram(uint8_t WhichService, uint32_t *pBuckets);
+uint32_t ES_Latency_GetPercentile(uint8_t WhichService, uint8_t Percent);
+uint32_t ES_Latency_GetMax(uint8_t WhichService);
+void ES_Latency_Dump(void);
+
+#endif   /* ES_Latency_H */
+/*------------------------------ End of file ------------------------------*/
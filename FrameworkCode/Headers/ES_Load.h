@@ -0,0 +1,56 @@
+/****************************************************************************
+ Module
+         ES_Load.h
+
+ Revision
+         1.0.1
+
+ Description
+         Header File for the CPU load accounting of ES_Run
+
+ Notes
+         Only compiled in with _INCLUDE_LOAD_STATS_ defined in
+         ES_Configure.h.
+         The loads are in tenths of a percent, 0 to 1000. The times are in
+         uS of the high resolution timer.
+
+ History
+ When           Who	What/Why
+ -------------- ---	--------
+ 10/20/26 06:35 ags  the pending interrupts are idle when they give no work
+ 10/20/26 01:35 ags  Began Coding
+****************************************************************************/
+
+#ifndef ES_Load_H
+#define ES_Load_H
+
+#include "ES_Types.h"
+
+// what ES_Run is doing, the time is charged to one of these
+typedef enum
+{
+  ES_LOAD_DISPATCH = 0,   /* taking events off the queues & running services */
+  ES_LOAD_CHECKERS,       /* in ES_CheckUserEvents, when a checker fired */
+  ES_LOAD_PENDING_INTS,   /* in _HW_Process_Pending_Ints, when it gave work */
+  ES_LOAD_IDLE,           /* in either of them, when they gave no work */
+  ES_LOAD_NUM_CATEGORIES
+}ES_LoadCategory_t;
+
+typedef struct
+{
+  uint64_t  Time[ES_LOAD_NUM_CATEGORIES];  /* uS in each, since the reset */
+  uint16_t  Load;         /* over the last LOAD_NUM_WINDOWS windows */
+  uint16_t  LastWindow;   /* over the last window */
+  uint16_t  PeakWindow;   /* the busiest window since the reset */
+}ES_LoadStats_t;
+
+void ES_Load_Reset(void);
+void ES_Load_Enter(ES_LoadCategory_t NewCategory);
+void ES_Load_Recategorize(ES_LoadCategory_t NewCategory);
+uint16_t ES_Load_Get(void);
+uint16_t ES_Load_GetPeak(void);
+void ES_Load_GetStats(ES_LoadStats_t *pStats);
+void ES_Load_Dump(void);
+
+#endif   /* ES_Load_H */
+/*------------------------------ End of file ------------------------------*/
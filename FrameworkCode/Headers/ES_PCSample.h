@@ -0,0 +1,42 @@
+/****************************************************************************
+ Module
+         ES_PCSample.h
+
+ Revision
+         1.0.1
+
+ Description
+         Header File for the statistical PC sampling profiler
+
+ Notes
+         Only compiled in with _INCLUDE_PC_SAMPLER_ defined in
+         ES_Configure.h.
+         The samples are offsets of the interrupted PC from the start of the
+         program's code, the start of flash on the target. Each bucket of
+         the histogram counts the samples in 2^PC_SAMPLE_SHIFT bytes of
+         code. Tools/ES_PCSymbolize.py turns the output of ES_PCSample_Write
+         into a list of functions.
+
+ History
+ When           Who	What/Why
+ -------------- ---	--------
+ 10/20/26 02:05 ags  Began Coding
+****************************************************************************/
+
+#ifndef ES_PCSample_H
+#define ES_PCSample_H
+
+#include <stdio.h>
+#include "ES_Types.h"
+
+void ES_PCSample_Init(void);
+void ES_PCSample_Reset(void);
+void ES_PCSample_Record(uint32_t Offset);
+uint16_t ES_PCSample_GetCount(uint16_t Bucket);
+uint32_t ES_PCSample_GetTotal(void);
+uint32_t ES_PCSample_GetOutside(void);
+void ES_PCSample_Write(FILE *pFile);
+void ES_PCSample_Dump(void);
+
+#endif   /* ES_PCSample_H */
+/*------------------------------ End of file ------------------------------*/
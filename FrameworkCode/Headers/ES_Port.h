@@ -9,6 +9,15 @@
  History
  When           Who     What/Why
  -------------- ---     --------
+ 10/20/26 05:06 ags     added _HW_VirtualTime_Advance for host builds
+ 10/20/26 04:17 ags     added _HW_InInterrupt and the host's replay prototypes
+ 10/20/26 03:26 ags     added prototypes for the hardware watchdog
+ 10/20/26 02:17 ags     added prototypes for the PC sampling interrupt
+ 10/20/26 00:34 ags     added prototypes for the trace output
+ 10/19/26 23:16 ags     added prototypes for the profiler's cycle counter
+ 10/19/26 15:34 ags     added prototype for the input capture hardware
+ 10/19/26 10:05 ags     added prototypes for the high resolution timer hardware
+                        and the _ES_HOST_PORT_ variant for host builds
  10/26/17 18:39 jec     moves definition of ALL_BITS to here
  10/14/15 21:50 jec     added prototype for ES_Timer_GetTime
  01/18/15 13:24 jec     clean up and adapt to use TI driver lib functions
@@ -26,10 +35,13 @@
 
 #include <stdio.h>
 #include <stdint.h>
+#ifndef _ES_HOST_PORT_
 #include "termio.h"
-#include "bitdefs.h"        /* generic bit defs (BIT0HI, BIT0LO,...) */
+#endif
+#include "BITDEFS.H"        /* generic bit defs (BIT0HI, BIT0LO,...) */
 #include "Bin_Const.h"      /* macros to specify binary constants in C */
 #include "ES_Types.h"
+#include "ES_InputCapture.h"
 
 // macro to control the use of C99 data types (or simulations in case you don't
 // have a C99 compiler).
@@ -54,6 +66,13 @@
 // allocation of temp var for saving interrupt enable status should be defined
 // in ES_Port.c
 
+#ifdef _ES_HOST_PORT_
+// The host port (ES_HostPort.c) runs the framework as a single threaded
+// process. The 'interrupts' are all polled from _HW_Process_Pending_Ints so
+// there is nothing to protect against and the critical regions are empty.
+#define EnterCritical()
+#define ExitCritical()
+#else
 // Cortex M-series processors
 // The Interrupt Program Status Register (IPSR) contains the exception type number
 // of the current interrupt service routine (ISR)
@@ -64,6 +83,7 @@ void CPUsetPRIMASK(uint32_t newPRIMASK);
 
 #define EnterCritical() { _PRIMASK_temp = CPUgetPRIMASK_cpsid(); }
 #define ExitCritical() { CPUsetPRIMASK(_PRIMASK_temp); }
+#endif /* _ES_HOST_PORT_ */
 
 /* Rate constants for programming the SysTick Period to generate tick interrupts.
    These assume an 40MHz configuration, they are the values to be used to program
@@ -92,6 +112,9 @@ typedef enum
 // map the generic functions for testing the serial port to actual functions
 // for this platform. If the C compiler does not provide functions to test
 // and retrieve serial characters, you should write them in ES_Port.c
+#ifdef _ES_HOST_PORT_
+int kbhit(void);
+#endif
 #define IsNewKeyReady() (kbhit() != 0)
 #define GetNewKey() getchar()
 
@@ -102,6 +125,62 @@ uint16_t _HW_GetTickCount(void);
 void ConsoleInit(void);
 // and the one Framework function that we define here
 uint16_t ES_Timer_GetTime(void);
+// true while an interrupt handler is running, always false on the host
+bool _HW_InInterrupt(void);
+
+// prototypes for the high resolution (1uS) timer hardware used by
+// ES_HRTimers.c. The count is free-running and counts up.
+void _HW_HRTimer_Init(void);
+uint32_t _HW_HRTimer_GetCount(void);
+void _HW_HRTimer_SetMatch(uint32_t MatchTime);
+void _HW_HRTimer_DisableMatch(void);
+
+// prototype for the input capture hardware used by ES_InputCapture.c.
+// The interrupt responses call ES_InputCapture_Edge_Resp with a timestamp on
+// the count above.
+void _HW_InputCapture_Init(uint8_t Channel, ES_CaptureEdge_t Edge);
+
+// prototypes for the cycle counter read around every run function by
+// ES_Profiler.c. The count is free-running and counts up, in CPU clocks on
+// the target. ES_Replay.c uses it too.
+#if defined(_INCLUDE_PROFILER_) || defined(_INCLUDE_EVENT_REPLAY_)
+void _HW_CycleCount_Init(void);
+uint32_t _HW_GetCycleCount(void);
+#endif
+
+// prototypes for the output that ES_Trace.c drains its records to. PutByte
+// must not wait, it returns false if the byte can not be taken now.
+#ifdef _INCLUDE_TRACE_
+void _HW_Trace_Init(void);
+bool _HW_Trace_PutByte(uint8_t Byte);
+#endif
+
+// prototypes for the sampling interrupt of ES_PCSample.c. It calls
+// ES_PCSample_Record with the interrupted PC less the code base.
+#ifdef _INCLUDE_PC_SAMPLER_
+void _HW_PCSample_Init(uint16_t RateHz);
+uintptr_t _HW_PCSample_GetCodeBase(void);
+#endif
+
+// prototypes for the hardware watchdog fed by ES_Run
+#ifdef _INCLUDE_WATCHDOG_
+void _HW_Watchdog_Init(uint16_t TimeoutMS);
+void _HW_Watchdog_Feed(void);
+#endif
+
+// prototypes for the host's reading of the inputs replayed by ES_Replay.c.
+// Advance moves the virtual clock on to the next input, it returns false
+// when there are none left.
+#ifdef _INCLUDE_EVENT_REPLAY_
+void _HW_Replay_Init(void);
+bool _HW_Replay_Advance(void);
+#endif
+
+// prototype for moving the host's virtual clock on to the next deadline,
+// it returns false when nothing is waiting for the time to pass
+#ifdef _INCLUDE_VIRTUAL_TIME_
+bool _HW_VirtualTime_Advance(void);
+#endif
 
 // define the constant necessary to get at all of the bits of a port register
 #define ALL_BITS (0xff << 2)
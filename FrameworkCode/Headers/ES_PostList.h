@@ -9,6 +9,7 @@
  History
  When           Who     What/Why
  -------------- ---     --------
+ 10/19/26 18:05 ags      added the run time distribution list functions
  08/05/13 15:19 jec      modifications to suit new portable type definitions
  01/15/12 11:57 jec      modified includes to match Events & Services
  10/16/11 12:28 jec      started coding
@@ -23,6 +24,13 @@ typedef bool PostFunc_t (ES_Event_t);
 
 typedef PostFunc_t (*pPostFunc);
 
+bool ES_PostList(uint8_t WhichList, ES_Event_t NewEvent);
+bool ES_AddToList(uint8_t WhichList, uint8_t WhichService);
+bool ES_RemoveFromList(uint8_t WhichList, uint8_t WhichService);
+bool ES_SetListMembers(uint8_t WhichList, uint16_t Services);
+uint16_t ES_GetListMembers(uint8_t WhichList);
+
+// wrappers for lists 0-7, with the signature of a service post function
 bool  ES_PostList00(ES_Event_t);
 bool  ES_PostList01(ES_Event_t);
 bool  ES_PostList02(ES_Event_t);
@@ -0,0 +1,47 @@
+/****************************************************************************
+ Module
+         ES_Profiler.h
+
+ Revision
+         1.0.1
+
+ Description
+         Header File for the run time profiler of the service run functions
+
+ Notes
+         Only compiled in with _INCLUDE_PROFILER_ defined in ES_Configure.h.
+         The times are in cycles of _HW_GetCycleCount, the CPU clock on the
+         target and a 40MHz equivalent on the host.
+
+ History
+ When           Who	What/Why
+ -------------- ---	--------
+ 10/19/26 22:56 ags  Began Coding
+****************************************************************************/
+
+#ifndef ES_Profiler_H
+#define ES_Profiler_H
+
+#include "ES_Types.h"
+#include "ES_Events.h"
+
+typedef struct
+{
+  uint32_t  Count;        /* the number of runs measured */
+  uint32_t  MinCycles;
+  uint32_t  MaxCycles;
+  uint32_t  MeanCycles;   /* worked out when the stats are read */
+  uint64_t  TotalCycles;
+}ES_ProfileStats_t;
+
+void ES_Profiler_Init(void);
+void ES_Profiler_Reset(void);
+void ES_Profiler_StartRun(void);
+void ES_Profiler_EndRun(uint8_t WhichService, ES_EventType_t WhichType);
+bool ES_Profiler_GetService(uint8_t WhichService, ES_ProfileStats_t *pStats);
+bool ES_Profiler_GetEventType(ES_EventType_t WhichType,
+    ES_ProfileStats_t *pStats);
+void ES_Profiler_Dump(void);
+
+#endif   /* ES_Profiler_H */
+/*------------------------------ End of file ------------------------------*/
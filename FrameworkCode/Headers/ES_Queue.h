@@ -9,6 +9,12 @@
  History
  When           Who     What/Why
  -------------- ---     --------
+ 10/20/26 04:46 ags      added ES_PeekStamp
+ 10/19/26 23:46 ags      added the rest of the stamped operations
+ 10/19/26 19:52 ags      added the stamped queue operations
+ 10/19/26 19:10 ags      added ES_SpliceQueue and the event type mask macros
+ 10/19/26 17:16 ags      added ES_QueueSpace & ES_EnQueueFIFOInCritical
+ 10/19/26 14:10 ags      added ES_PurgeQueue prototype
  08/05/13 15:19 jec      modifications to suit new portable type definitions
  01/15/12 09:36 jec      converted to use new types from ES_Types.h
  10/17/11 07:49 jec      new header to match the rest of the framework
@@ -20,14 +26,40 @@
 #include "ES_Types.h"
 #include "ES_Events.h"
 
+/* event type masks for ES_SpliceQueue, bit n selects event type n */
+#define ES_TYPE_MASK(t) ((uint32_t)1 << (t))
+#define ES_RECALL_ALL 0xFFFFFFFFUL
+
 /* prototypes for public functions */
 
 uint8_t ES_InitQueue(ES_Event_t *pBlock, uint8_t BlockSize);
 bool ES_EnQueueFIFO(ES_Event_t *pBlock, ES_Event_t Event2Add);
+bool ES_EnQueueFIFOInCritical(ES_Event_t *pBlock, ES_Event_t Event2Add);
 bool ES_EnQueueLIFO(ES_Event_t *pBlock, ES_Event_t Event2Add);
 uint8_t ES_DeQueue(ES_Event_t *pBlock, ES_Event_t *pReturnEvent);
 //void EF_FlushQueue( unsigned char * pBlock );
 bool ES_IsQueueEmpty(ES_Event_t *pBlock);
+uint8_t ES_QueueSpace(ES_Event_t *pBlock);
+uint8_t ES_PurgeQueue(ES_Event_t *pBlock, ES_EventType_t WhichType,
+    uint16_t ParamMask);
+uint8_t ES_SpliceQueue(ES_Event_t *pDest, ES_Event_t *pSource,
+    uint16_t *pSourceStamps, uint32_t TypeMask);
+bool ES_EnQueueFIFOStamped(ES_Event_t *pBlock, uint16_t *pStamps,
+    ES_Event_t Event2Add, uint16_t Stamp);
+bool ES_DeQueueIfExpired(ES_Event_t *pBlock, uint16_t *pStamps, uint16_t Now,
+    ES_Event_t *pReturnEvent);
+bool ES_EnQueueFIFOStampedInCritical(ES_Event_t *pBlock, uint16_t *pStamps,
+    ES_Event_t Event2Add, uint16_t Stamp);
+bool ES_EnQueueLIFOStamped(ES_Event_t *pBlock, uint16_t *pStamps,
+    ES_Event_t Event2Add, uint16_t Stamp);
+uint8_t ES_DeQueueStamped(ES_Event_t *pBlock, uint16_t *pStamps,
+    ES_Event_t *pReturnEvent, uint16_t *pStamp);
+uint8_t ES_PurgeQueueStamped(ES_Event_t *pBlock, uint16_t *pStamps,
+    ES_EventType_t WhichType, uint16_t ParamMask);
+uint8_t ES_SpliceQueueStamped(ES_Event_t *pDest, uint16_t *pDestStamps,
+    uint16_t DestStamp, ES_Event_t *pSource, uint16_t *pSourceStamps,
+    uint32_t TypeMask);
+bool ES_PeekStamp(ES_Event_t *pBlock, uint16_t *pStamps, uint16_t *pStamp);
 
 #endif /*ES_Queue_H */
 
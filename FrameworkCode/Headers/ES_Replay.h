@@ -0,0 +1,65 @@
+/****************************************************************************
+ Module
+         ES_Replay.h
+
+ Revision
+         1.0.1
+
+ Description
+         Header File for the replay of captured inputs on the host
+
+ Notes
+         Only compiled in with _INCLUDE_EVENT_REPLAY_ defined in
+         ES_Configure.h, which is only allowed for the host port.
+         The cycles are of _HW_GetCycleCount, a 40MHz equivalent on the
+         host, so they compare with the profiler's.
+
+ History
+ When           Who	What/Why
+ -------------- ---	--------
+ 10/20/26 03:58 ags  Began Coding
+****************************************************************************/
+
+#ifndef ES_Replay_H
+#define ES_Replay_H
+
+#include "ES_Types.h"
+#include "ES_Events.h"
+
+// the service number given to ES_Replay_Input for an ES_Broadcast
+#define ES_REPLAY_BROADCAST 0xFF
+
+typedef struct
+{
+  uint32_t  Inputs;         /* the inputs posted */
+  uint32_t  InputsDropped;  /* of those, the ones that found no room */
+  uint32_t  Dispatches;     /* the events taken off the queues and run */
+  uint64_t  DispatchCycles; /* the cycles that the dispatches took */
+  uint32_t  Responses;      /* the times that inputs woke ES_Run up */
+  uint32_t  MinResponse;    /* cycles from the inputs until ES_Run is */
+  uint32_t  MeanResponse;   /* idle again */
+  uint32_t  MaxResponse;
+  uint32_t  LastInputTime;  /* uS of virtual time, of the last input */
+}ES_ReplayStats_t;
+
+// what the replay saw of each service
+typedef struct
+{
+  uint32_t  Dispatches;
+  uint64_t  Cycles;
+  uint8_t   QueuePeak;      /* the most events in its queue at a dispatch */
+}ES_ReplayServiceStats_t;
+
+void ES_Replay_Init(void);
+void ES_Replay_Input(uint8_t WhichService, ES_Event_t ThisEvent);
+bool ES_Replay_Mutes(void);
+void ES_Replay_StartRun(uint8_t WhichService, uint8_t QueueDepth);
+void ES_Replay_EndRun(uint8_t WhichService);
+void ES_Replay_Idle(void);
+void ES_Replay_GetStats(ES_ReplayStats_t *pStats);
+bool ES_Replay_GetService(uint8_t WhichService,
+    ES_ReplayServiceStats_t *pStats);
+void ES_Replay_Report(void);
+
+#endif   /* ES_Replay_H */
+/*------------------------------ End of file ------------------------------*/
@@ -14,6 +14,9 @@
  History
  When           Who	What/Why
  -------------- ---	--------
+ 10/20/26 04:55 ags  added prototype for ES_Timer_GetTicksToNext
+ 10/19/26 14:40 ags  added prototypes for the timer group functions
+ 10/19/26 13:16 ags  added prototype for ES_Timer_SetSlack
  10/13/15 20:48 jec  removed prototype for IsTimerActive, I had removed the code
                      a couple of years ago
  08/13/13 12:03 jec  added prototype for ES_Timer_Tick_Resp as part of
@@ -48,7 +51,12 @@ ES_TimerReturn_t ES_Timer_InitTimer(uint8_t Num, uint16_t NewTime);
 ES_TimerReturn_t ES_Timer_SetTimer(uint8_t Num, uint16_t NewTime);
 ES_TimerReturn_t ES_Timer_StartTimer(uint8_t Num);
 ES_TimerReturn_t ES_Timer_StopTimer(uint8_t Num);
+ES_TimerReturn_t ES_Timer_SetSlack(uint8_t Num, uint16_t Slack);
+ES_TimerReturn_t ES_Timer_AssignGroup(uint8_t Num, uint8_t Group,
+    uint8_t Owner);
+ES_TimerReturn_t ES_Timer_StopGroup(uint8_t Group);
 uint16_t ES_Timer_GetTime(void);
+uint16_t ES_Timer_GetTicksToNext(void);
 
 #endif   /* ES_Timers_H */
 /*------------------------------ End of file ------------------------------*/
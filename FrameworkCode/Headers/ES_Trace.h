@@ -0,0 +1,67 @@
+/****************************************************************************
+ Module
+         ES_Trace.h
+
+ Revision
+         1.0.1
+
+ Description
+         Header File for the binary trace of the framework's activity
+
+ Notes
+         Only compiled in with _INCLUDE_TRACE_ defined in ES_Configure.h.
+         Each record is ES_TRACE_RECORD_SIZE bytes:
+           byte 0    the kind of record in the high nybble, and the service
+                     number in the low nybble
+           byte 1    the event type
+           bytes 2-3 the uS since the previous record, low byte first
+           bytes 4-5 the event parameter, low byte first
+         A gap of more than 0xFFFF uS is carried by an ES_TRACE_TIME record
+         just before, whose parameter is the upper 16 bits of the gap.
+         A post made from outside the run functions, by an event checker,
+         a timer or an interrupt response, is an input to the services and
+         is recorded as ES_TRACE_INPUT rather than ES_TRACE_POST.
+         Tools/ES_TraceDecode.py turns the stream into a Chrome trace, or
+         with --replay, the inputs into a file for ES_Replay.
+
+ History
+ When           Who	What/Why
+ -------------- ---	--------
+ 10/20/26 03:54 ags  added the input records
+ 10/20/26 00:10 ags  Began Coding
+****************************************************************************/
+
+#ifndef ES_Trace_H
+#define ES_Trace_H
+
+#include "ES_Types.h"
+#include "ES_Events.h"
+
+#define ES_TRACE_RECORD_SIZE 6
+
+// the kinds of record, in the high nybble of the first byte
+typedef enum
+{
+  ES_TRACE_POST = 0,        /* event posted to the service's queue */
+  ES_TRACE_RUN_BEGIN,       /* service's run function called with the event */
+  ES_TRACE_RUN_END,         /* and returned */
+  ES_TRACE_TIMEOUT,         /* timer, given by the parameter, expired */
+  ES_TRACE_CHECKER,         /* event checker, given by the parameter, fired */
+  ES_TRACE_OVERFLOW,        /* service's queue was full, the post failed */
+  ES_TRACE_LOST,            /* the parameter is the number of records lost
+                               because the trace ring was full */
+  ES_TRACE_TIME,            /* the parameter extends the next record's gap */
+  ES_TRACE_INPUT,           /* event posted to the service's queue from
+                               outside the run functions */
+  ES_TRACE_INPUT_BROADCAST, /* event broadcast from outside the run
+                               functions, the service is 0 */
+  ES_TRACE_SYNC = 0x0F      /* start of the stream */
+}ES_TraceKind_t;
+
+void ES_Trace_Init(void);
+void ES_Trace_Record(ES_TraceKind_t Kind, uint8_t WhichService,
+    ES_Event_t ThisEvent);
+void ES_Trace_Drain(void);
+
+#endif   /* ES_Trace_H */
+/*------------------------------ End of file ------------------------------*/
@@ -0,0 +1,24 @@
+/****************************************************************************
+ Template header file for table driven Hierarchical State Machines, run by
+ the ES_HSM engine
+ 10/19/26 ags  first pass
+ ****************************************************************************/
+
+#ifndef TableHSMTemplate_H
+#define TableHSMTemplate_H
+
+#include "ES_HSM.h"
+
+// State definitions, these are the indices into the state table, so the
+// order must match the table in TableHSMTemplate.c
+typedef enum { STATE_ONE, STATE_ONE_A, STATE_ONE_B, STATE_TWO } TableState_t ;
+
+// Public Function Prototypes
+
+bool InitTableHSM ( uint8_t Priority );
+bool PostTableHSM( ES_Event_t ThisEvent );
+ES_Event_t RunTableHSM( ES_Event_t ThisEvent );
+TableState_t QueryTableHSM ( void );
+
+#endif /*TableHSMTemplate_H */
+
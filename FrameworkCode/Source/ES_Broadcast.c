@@ -0,0 +1,235 @@
+/****************************************************************************
+ Module
+     ES_Broadcast.c
+
+ Description
+     This is a module implementing a broadcast channel. Each event is stored
+     once, in a ring, and every subscribing service reads it from there
+     through its own cursor rather than getting a copy in its queue.
+
+ Notes
+     The ring Head is where the next broadcast goes. Each subscriber has a
+     cursor to the next broadcast that it has not yet been given. A slot is
+     free again once the slowest subscriber's cursor has passed it, so the
+     ring is full when the Head is BROADCAST_RING_SIZE ahead of any cursor.
+     BroadcastPending has a bit set for each subscriber that is behind the
+     Head. ES_Run runs a service with that bit set, using ES_Broadcast_Next,
+     once the service's own queue is empty.
+     The cursors are free-running 8 bit counts, the slot is the count
+     masked to the ring size.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/20/26 04:27 ags     trace the broadcasts from outside the service code
+                        as inputs, and drop them while replaying
+ 10/20/26 03:07 ags     count the broadcasts with _INCLUDE_EVENT_STATS_
+ 10/19/26 18:22 ags     Began Coding
+****************************************************************************/
+
+/*----------------------------- Include Files -----------------------------*/
+#include "ES_Configure.h"
+#include "ES_General.h"
+#include "ES_Framework.h"
+#include "ES_LookupTables.h"
+#include "ES_Broadcast.h"
+#include "ES_EventStats.h"
+#include "ES_Trace.h"
+#include "ES_Replay.h"
+
+#if BROADCAST_RING_SIZE > 0
+/*----------------------------- Module Defines ----------------------------*/
+#if (BROADCAST_RING_SIZE > 128) || \
+  ((BROADCAST_RING_SIZE & (BROADCAST_RING_SIZE - 1)) != 0)
+#error BROADCAST_RING_SIZE must be a power of 2, no larger than 128
+#endif
+
+#define BROADCAST_RING_MASK (BROADCAST_RING_SIZE - 1)
+
+/*---------------------------- Module Functions ---------------------------*/
+
+/*---------------------------- Module Variables ---------------------------*/
+static ES_Event_t BroadcastRing[BROADCAST_RING_SIZE];
+static uint8_t    BroadcastHead;
+static uint8_t    BroadcastCursor[NUM_SERVICES];
+
+// the services that have subscribed, and those with broadcasts waiting
+static uint16_t BroadcastSubscribers;
+static uint16_t BroadcastPending;
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+     ES_Broadcast
+ Parameters
+     ES_Event_t ThisEvent, the event to broadcast
+ Returns
+     bool, false if the ring is full, in which case no subscriber gets it
+ Description
+     stores the event once in the ring and marks every subscriber as having
+     a broadcast pending
+ Notes
+     finding the slowest subscriber takes a pass over the subscribers, the
+     event itself is only written once however many there are
+ Author
+     ags, 10/19/26 18:26
+****************************************************************************/
+bool ES_Broadcast(ES_Event_t ThisEvent)
+{
+  uint16_t  Remaining;
+  uint8_t   ThisService;
+  bool      ReturnValue = true;
+
+#ifdef _INCLUDE_EVENT_REPLAY_
+  if (ES_Replay_Mutes() == true)
+  {
+    return true;    // a live input, the captured one takes its place
+  }
+#endif
+  EnterCritical();
+  Remaining = BroadcastSubscribers;
+  while (Remaining != 0)
+  {
+    ThisService = ES_GetMSBitSet(Remaining);
+    if ((uint8_t)(BroadcastHead - BroadcastCursor[ThisService]) >=
+        BROADCAST_RING_SIZE)
+    {
+      ReturnValue = false;    // this one has not read the oldest slot yet
+      break;
+    }
+    Remaining &= BitNum2ClrMask[ThisService];
+  }
+  if (ReturnValue == true)
+  {
+    BroadcastRing[BroadcastHead & BROADCAST_RING_MASK] = ThisEvent;
+    BroadcastHead++;
+    BroadcastPending |= BroadcastSubscribers;
+  }
+  ExitCritical();
+#ifdef _INCLUDE_TRACE_
+  // only the inputs are traced, the subscribers' runs show the rest
+  if ((ReturnValue == true) && (ES_PostIsInput() == true))
+  {
+    ES_Trace_Record(ES_TRACE_INPUT_BROADCAST, 0, ThisEvent);
+  }
+#endif
+#ifdef _INCLUDE_EVENT_STATS_
+  if (ReturnValue == true)
+  {
+    ES_EventStats_Posted(ThisEvent.EventType, BroadcastSubscribers);
+  }
+  else
+  {
+    ES_EventStats_Dropped(ThisEvent.EventType, BroadcastSubscribers);
+  }
+#endif
+  return ReturnValue;
+}
+
+/****************************************************************************
+ Function
+     ES_Broadcast_Subscribe
+ Parameters
+     uint8_t WhichService, the service to subscribe (its priority)
+ Returns
+     bool, false if the service does not exist
+ Description
+     adds the service to the subscribers. It will be given every event
+     broadcast from now on.
+ Author
+     ags, 10/19/26 18:31
+****************************************************************************/
+bool ES_Broadcast_Subscribe(uint8_t WhichService)
+{
+  if (WhichService >= ARRAY_SIZE(BroadcastCursor))
+  {
+    return false;
+  }
+  EnterCritical();
+  BroadcastCursor[WhichService] = BroadcastHead;
+  BroadcastSubscribers |= BitNum2SetMask[WhichService];
+  ExitCritical();
+  return true;
+}
+
+/****************************************************************************
+ Function
+     ES_Broadcast_Unsubscribe
+ Parameters
+     uint8_t WhichService, the service to unsubscribe (its priority)
+ Returns
+     bool, false if the service does not exist
+ Description
+     removes the service from the subscribers, along with any broadcasts
+     that it had not yet been given, freeing the slots that it was holding
+ Author
+     ags, 10/19/26 18:33
+****************************************************************************/
+bool ES_Broadcast_Unsubscribe(uint8_t WhichService)
+{
+  if (WhichService >= ARRAY_SIZE(BroadcastCursor))
+  {
+    return false;
+  }
+  EnterCritical();
+  BroadcastSubscribers  &= BitNum2ClrMask[WhichService];
+  BroadcastPending      &= BitNum2ClrMask[WhichService];
+  ExitCritical();
+  return true;
+}
+
+/****************************************************************************
+ Function
+     ES_Broadcast_GetPending
+ Parameters
+     None.
+ Returns
+     uint16_t, bit n set if service n has broadcasts waiting for it
+ Description
+     used by ES_Run, along with Ready, to decide which service to run next
+ Author
+     ags, 10/19/26 18:35
+****************************************************************************/
+uint16_t ES_Broadcast_GetPending(void)
+{
+  return BroadcastPending;
+}
+
+/****************************************************************************
+ Function
+     ES_Broadcast_Next
+ Parameters
+     uint8_t WhichService, the service to be given the next broadcast
+     ES_Event_t *pReturnEvent, where to copy the event
+ Returns
+     bool, false if there was no broadcast waiting for the service
+ Description
+     gives the service the oldest broadcast that it has not seen, advancing
+     its cursor past it
+ Notes
+     called from ES_Run
+ Author
+     ags, 10/19/26 18:37
+****************************************************************************/
+bool ES_Broadcast_Next(uint8_t WhichService, ES_Event_t *pReturnEvent)
+{
+  bool ReturnValue = false;
+
+  EnterCritical();
+  if ((BroadcastPending & BitNum2SetMask[WhichService]) != 0)
+  {
+    *pReturnEvent =
+        BroadcastRing[BroadcastCursor[WhichService] & BROADCAST_RING_MASK];
+    if (++BroadcastCursor[WhichService] == BroadcastHead)
+    {
+      BroadcastPending &= BitNum2ClrMask[WhichService];  // caught up
+    }
+    ReturnValue = true;
+  }
+  ExitCritical();
+  return ReturnValue;
+}
+
+#endif /* BROADCAST_RING_SIZE > 0 */
+/*------------------------------- Footnotes -------------------------------*/
+/*------------------------------ End of file ------------------------------*/
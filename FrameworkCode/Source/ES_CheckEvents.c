@@ -8,6 +8,7 @@
  History
  When           Who     What/Why
  -------------- ---     --------
+ 10/20/26 00:32 ags     trace the checker that fires with _INCLUDE_TRACE_
                 jec     out all user modifications into ES_Configure
  10/16/11 12:32 jec      started coding
 *****************************************************************************/
@@ -16,6 +17,7 @@
 #include "ES_Events.h"
 #include "ES_General.h"
 #include "ES_CheckEvents.h"
+#include "ES_Trace.h"
 
 // Include the header files for the module(s) with your event checkers.
 // This gets you the prototypes for the event checking functions.
@@ -52,6 +54,10 @@ bool ES_CheckUserEvents(void)
   {
     if (ES_EventList[i]() == true)
     {
+#ifdef _INCLUDE_TRACE_
+      ES_Event_t Fired = { ES_NO_EVENT, i };
+      ES_Trace_Record(ES_TRACE_CHECKER, 0, Fired);
+#endif
       break; // found a new event, so process it first
     }
   }
@@ -11,7 +11,13 @@
  History
  When           Who     What/Why
  -------------- ---     --------
-
+ 10/20/26 04:48 ags     added ES_TicksToTimedExpiry
+ 10/20/26 03:09 ags     count the deferrals with _INCLUDE_EVENT_STATS_
+ 10/19/26 20:04 ags     added timed deferral queues, whose entries expire
+                        after a fixed lifetime, swept on each tick
+ 10/19/26 19:22 ags     recall now splices the deferred events onto the front
+                        of the service queue in one step, in the order they
+                        were deferred, and can recall selected types only
  10/11/14 14:58 jec     converted RecallEvent to RecallEvents to pull all
                         deferred events off the deferral queue
  11/02/13 16:38 jec      Began Coding
@@ -23,6 +29,8 @@
 #include "ES_General.h"
 #include "ES_Events.h"
 #include "ES_DeferRecall.h"
+#include "ES_Timers.h"
+#include "ES_EventStats.h"
 
 /*--------------------------- External Variables --------------------------*/
 
@@ -31,8 +39,14 @@
 /*------------------------------ Module Types -----------------------------*/
 
 /*---------------------------- Module Functions ---------------------------*/
+static void ExpireDeferred(ES_TimedDeferral_t *pDeferral);
 
 /*---------------------------- Module Variables ---------------------------*/
+#if NUM_TIMED_DEFERRALS > 0
+// the timed deferral queues that ES_SweepTimedDeferrals looks after
+static ES_TimedDeferral_t *TimedDeferrals[NUM_TIMED_DEFERRALS];
+static uint8_t            NumTimedDeferrals;
+#endif
 
 /*------------------------------ Module Code ------------------------------*/
 /****************************************************************************
@@ -45,29 +59,275 @@
  Returns
      bool true if an event was recalled, false if no event was left in queue
  Description
-     pulls all events off the deferral queue if any are available. If there was
-     something in the queue, then it posts it LIFO fashion to the queue
-     indicated by WhichService
+     moves all of the events on the deferral queue to the front of the queue
+     indicated by WhichService, in the order that they were deferred
  Notes
-     None.
+     Events that do not fit in the service's queue stay deferred, rather than
+     being lost as they were when each one was re-posted.
  Author
      J. Edward Carryer, 11/20/13 16:49
 ****************************************************************************/
 bool ES_RecallEvents(uint8_t WhichService, ES_Event_t *pBlock)
 {
-  ES_Event_t  RecalledEvent;
-  bool      WereEventsPulled = false;
-  // recall any events from the queue
-  do
+  return ES_SpliceToService(WhichService, pBlock, 0, ES_RECALL_ALL) != 0;
+}
+
+/****************************************************************************
+ Function
+     ES_RecallEventsOfType
+ Parameters
+      uint8_t WhichService, number of the service to post Recalled event to
+      ES_Event * pBlock, pointer to the block of memory that implements the
+        Defer/Recall queue
+      uint32_t TypeMask, the types to recall, built with ES_TYPE_MASK()
+ Returns
+     bool true if an event was recalled, false if none matched
+ Description
+     moves the deferred events of the selected types to the front of the
+     queue indicated by WhichService, in the order that they were deferred.
+     The other events stay deferred, in their order.
+ Notes
+     Only event types 0-31 can be selected.
+ Author
+     ags, 10/19/26 19:26
+****************************************************************************/
+bool ES_RecallEventsOfType(uint8_t WhichService, ES_Event_t *pBlock,
+    uint32_t TypeMask)
+{
+  return ES_SpliceToService(WhichService, pBlock, 0, TypeMask) != 0;
+}
+
+/****************************************************************************
+ Function
+     ES_InitTimedDeferral
+ Parameters
+      ES_TimedDeferral_t * pDeferral, the timed deferral queue, with its
+        pBlock, BlockSize, pStamps, Lifetime and ExpiredType filled in
+      uint8_t Owner, number of the service that defers to, and recalls
+        from, this queue
+ Returns
+     bool false if there is no room left to register another timed deferral
+     queue, in which case it will only be swept when it is recalled
+ Description
+     empties the queue and registers it so that its expired entries are
+     removed on every tick
+ Notes
+     Call it from the owner's init function. Calling it again for a queue
+     that is already registered just empties it.
+ Author
+     ags, 10/19/26 19:58
+****************************************************************************/
+bool ES_InitTimedDeferral(ES_TimedDeferral_t *pDeferral, uint8_t Owner)
+{
+  pDeferral->Owner = Owner;
+  ES_InitQueue(pDeferral->pBlock, pDeferral->BlockSize);
+#if NUM_TIMED_DEFERRALS > 0
+  {
+    uint8_t i;
+
+    for (i = 0; i < NumTimedDeferrals; i++)
+    {
+      if (TimedDeferrals[i] == pDeferral)
+      {
+        return true;    // already registered
+      }
+    }
+    if (NumTimedDeferrals < ARRAY_SIZE(TimedDeferrals))
+    {
+      TimedDeferrals[NumTimedDeferrals++] = pDeferral;
+      return true;
+    }
+  }
+#endif
+  return false;
+}
+
+/****************************************************************************
+ Function
+     ES_DeferEventTimed
+ Parameters
+      ES_TimedDeferral_t * pDeferral, the timed deferral queue
+      ES_Event_t ThisEvent, the event to defer
+ Returns
+     bool true if the event was deferred, false if the queue was full
+ Description
+     adds the event to the deferral queue, stamped with the tick at which it
+     will expire (now + Lifetime)
+ Author
+     ags, 10/19/26 20:00
+****************************************************************************/
+bool ES_DeferEventTimed(ES_TimedDeferral_t *pDeferral, ES_Event_t ThisEvent)
+{
+  bool ReturnValue;
+
+  ReturnValue = ES_EnQueueFIFOStamped(pDeferral->pBlock, pDeferral->pStamps,
+      ThisEvent, (uint16_t)(ES_Timer_GetTime() + pDeferral->Lifetime));
+#ifdef _INCLUDE_EVENT_STATS_
+  if (ReturnValue == true)
+  {
+    ES_EventStats_Deferred(ThisEvent.EventType);
+  }
+#endif
+  return ReturnValue;
+}
+
+#ifdef _INCLUDE_EVENT_STATS_
+/****************************************************************************
+ Function
+     ES_DeferEventCounted
+ Parameters
+      ES_Event_t * pBlock, the deferral queue
+      ES_Event_t ThisEvent, the event to defer
+ Returns
+     bool true if the event was deferred, false if the queue was full
+ Description
+     ES_DeferEvent with the event statistics included, adds the event to the
+     deferral queue and counts it
+ Author
+     ags, 10/20/26 03:10
+****************************************************************************/
+bool ES_DeferEventCounted(ES_Event_t *pBlock, ES_Event_t ThisEvent)
+{
+  bool ReturnValue;
+
+  ReturnValue = ES_EnQueueFIFO(pBlock, ThisEvent);
+  if (ReturnValue == true)
+  {
+    ES_EventStats_Deferred(ThisEvent.EventType);
+  }
+  return ReturnValue;
+}
+#endif
+
+/****************************************************************************
+ Function
+     ES_RecallTimedEvents
+ Parameters
+      ES_TimedDeferral_t * pDeferral, the timed deferral queue
+      uint32_t TypeMask, the types to recall, ES_RECALL_ALL for every type
+ Returns
+     bool true if an event was recalled, false if none was
+ Description
+     removes the expired entries, then moves the live entries of the
+     selected types to the front of the owner's queue, in the order that
+     they were deferred
+ Notes
+     the expired entries are handled first so that a stale event is never
+     recalled, even between ticks
+ Author
+     ags, 10/19/26 20:01
+****************************************************************************/
+bool ES_RecallTimedEvents(ES_TimedDeferral_t *pDeferral, uint32_t TypeMask)
+{
+  ExpireDeferred(pDeferral);
+  return ES_SpliceToService(pDeferral->Owner, pDeferral->pBlock,
+             pDeferral->pStamps, TypeMask) != 0;
+}
+
+/****************************************************************************
+ Function
+     ES_SweepTimedDeferrals
+ Parameters
+      None.
+ Returns
+      None.
+ Description
+     removes the expired entries from every registered timed deferral queue
+ Notes
+     Called from ES_Timer_Tick_Resp. Each queue is kept in expiry order, so
+     only the entries being removed, and the first live one, are looked at.
+ Author
+     ags, 10/19/26 20:02
+****************************************************************************/
+void ES_SweepTimedDeferrals(void)
+{
+#if NUM_TIMED_DEFERRALS > 0
+  uint8_t i;
+
+  for (i = 0; i < NumTimedDeferrals; i++)
+  {
+    ExpireDeferred(TimedDeferrals[i]);
+  }
+#endif
+}
+
+/****************************************************************************
+ Function
+     ES_TicksToTimedExpiry
+ Parameters
+      None.
+ Returns
+      uint16_t, the number of ticks until the next entry of a timed deferral
+      queue expires, or 0 if they are all empty
+ Description
+     looks at the head of every registered timed deferral queue
+ Notes
+     an entry that is already due is swept on the next tick, so counts as 1
+ Author
+     ags, 10/20/26 04:50
+****************************************************************************/
+uint16_t ES_TicksToTimedExpiry(void)
+{
+  uint16_t Ticks = 0;
+#if NUM_TIMED_DEFERRALS > 0
+  uint16_t Now = ES_Timer_GetTime();
+  uint16_t Stamp;
+  int16_t  Left;
+  uint8_t  i;
+
+  for (i = 0; i < NumTimedDeferrals; i++)
+  {
+    if (ES_PeekStamp(TimedDeferrals[i]->pBlock, TimedDeferrals[i]->pStamps,
+        &Stamp) == true)
+    {
+      Left = (int16_t)(Stamp - Now);
+      if (Left < 1)
+      {
+        Left = 1;
+      }
+      if ((Ticks == 0) || ((uint16_t)Left < Ticks))
+      {
+        Ticks = (uint16_t)Left;
+      }
+    }
+  }
+#endif
+  return Ticks;
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+/****************************************************************************
+ Function
+     ExpireDeferred
+ Parameters
+      ES_TimedDeferral_t * pDeferral, the timed deferral queue
+ Returns
+      None.
+ Description
+     takes the expired entries off the head of the queue, dropping them, or
+     posting the ExpiredType event to the owner with the type of the expired
+     event as the parameter
+ Author
+     ags, 10/19/26 20:03
+****************************************************************************/
+static void ExpireDeferred(ES_TimedDeferral_t *pDeferral)
+{
+  ES_Event_t  StaleEvent;
+  ES_Event_t  ExpiredEvent;
+  uint16_t    Now = ES_Timer_GetTime();
+
+  ExpiredEvent.EventType = pDeferral->ExpiredType;
+  while (ES_DeQueueIfExpired(pDeferral->pBlock, pDeferral->pStamps, Now,
+      &StaleEvent) == true)
   {
-    ES_DeQueue(pBlock, &RecalledEvent);
-    if (RecalledEvent.EventType != ES_NO_EVENT)
+    if (ExpiredEvent.EventType != ES_NO_EVENT)
     {
-      ES_PostToServiceLIFO(WhichService, RecalledEvent);
-      WereEventsPulled = true;
+      ExpiredEvent.EventParam = StaleEvent.EventType;
+      ES_PostToService(pDeferral->Owner, ExpiredEvent);
     }
-  } while (RecalledEvent.EventType != ES_NO_EVENT);
-  return WereEventsPulled;
+  }
 }
 
 /*------------------------------- Footnotes -------------------------------*/
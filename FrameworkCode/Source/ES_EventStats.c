@@ -0,0 +1,382 @@
+/****************************************************************************
+ Module
+     ES_EventStats.c
+
+ Description
+     This is a module keeping counts, for every event type, of the events
+     posted, dispatched, dropped because a queue was full and deferred,
+     along with decaying means of the post and dispatch rates. A burst of
+     one type of event, such as a bouncing input, shows up at the top of
+     ES_EventStats_Dump.
+
+ Notes
+     The whole module, and the calls to it from the framework, compile out
+     unless _INCLUDE_EVENT_STATS_ is defined in ES_Configure.h.
+     The rates are worked out every EVENT_RATE_PERIOD_MS from the events in
+     that period, and each new figure moves the mean 1/2^EVENT_RATE_SHIFT of
+     the way towards it. The periods are counted on the framework tick, so
+     they are in mS at ES_Timer_RATE_1mS.
+     Posts may come from interrupts, so ES_EventStats_Posted, _Dropped and
+     _Deferred count in a critical region, and must not be called from
+     within one. The rates are only worked out from ES_Run and the
+     functions that read them.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/20/26 06:46 ags     the dump skips a row that ES_EventStats_Get refuses
+ 10/20/26 02:47 ags     Began Coding
+****************************************************************************/
+
+/*----------------------------- Include Files -----------------------------*/
+#include "ES_Configure.h"
+#include "ES_General.h"
+#include "ES_Port.h"
+#include "ES_Timers.h"
+#include "ES_EventStats.h"
+#include <stdio.h>
+
+#ifdef _INCLUDE_EVENT_STATS_
+/*----------------------------- Module Defines ----------------------------*/
+// the rate, in tenths per second, of one event in a period
+#define RATE_PER_EVENT (10000UL / EVENT_RATE_PERIOD_MS)
+// rounds the steps of the mean up, so that it settles on the new rate
+#define RATE_ROUNDING ((1UL << EVENT_RATE_SHIFT) - 1)
+// after this many empty periods, the rates are as good as 0
+#define MAX_EMPTY_PERIODS 32
+
+#if EVENT_RATE_PERIOD_MS < 1
+#error EVENT_RATE_PERIOD_MS must be at least 1
+#endif
+
+/*---------------------------- Module Functions ---------------------------*/
+static void UpdateRates(void);
+static uint32_t MoveMean(uint32_t Mean, uint32_t NewRate);
+static uint8_t CountServices(uint16_t Services);
+
+/*---------------------------- Module Variables ---------------------------*/
+static ES_EventStats_t Stats[ES_NUM_EVENT_TYPES];
+
+// the events in the period that is under way, and when it started
+static uint16_t PeriodPosted[ES_NUM_EVENT_TYPES];
+static uint16_t PeriodDispatched[ES_NUM_EVENT_TYPES];
+static uint16_t PeriodStart;
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+     ES_EventStats_Reset
+ Parameters
+     None.
+ Returns
+     None.
+ Description
+     clears the counts and rates of every event type
+ Notes
+     called from ES_Initialize
+ Author
+     ags, 10/20/26 02:49
+****************************************************************************/
+void ES_EventStats_Reset(void)
+{
+  uint8_t i;
+
+  EnterCritical();
+  for (i = 0; i < ES_NUM_EVENT_TYPES; i++)
+  {
+    Stats[i].Posted       = 0;
+    Stats[i].Dispatched   = 0;
+    Stats[i].Dropped      = 0;
+    Stats[i].Deferred     = 0;
+    Stats[i].PostRate     = 0;
+    Stats[i].DispatchRate = 0;
+    PeriodPosted[i]       = 0;
+    PeriodDispatched[i]   = 0;
+  }
+  PeriodStart = ES_Timer_GetTime();
+  ExitCritical();
+}
+
+/****************************************************************************
+ Function
+     ES_EventStats_Posted
+ Parameters
+     ES_EventType_t WhichType, the type of the event posted
+     uint16_t Services, the services it was posted to, bit n for service n
+ Returns
+     None.
+ Description
+     counts one post for each service in the mask
+ Author
+     ags, 10/20/26 02:51
+****************************************************************************/
+void ES_EventStats_Posted(ES_EventType_t WhichType, uint16_t Services)
+{
+  uint8_t NumPosted = CountServices(Services);
+
+  if ((WhichType < ES_NUM_EVENT_TYPES) && (NumPosted != 0))
+  {
+    EnterCritical();
+    Stats[WhichType].Posted += NumPosted;
+    PeriodPosted[WhichType] += NumPosted;
+    ExitCritical();
+  }
+}
+
+/****************************************************************************
+ Function
+     ES_EventStats_Dropped
+ Parameters
+     ES_EventType_t WhichType, the type of the event that was lost
+     uint16_t Services, the services that did not get it, bit n for service n
+ Returns
+     None.
+ Description
+     counts one drop for each service in the mask
+ Author
+     ags, 10/20/26 02:52
+****************************************************************************/
+void ES_EventStats_Dropped(ES_EventType_t WhichType, uint16_t Services)
+{
+  uint8_t NumDropped = CountServices(Services);
+
+  if ((WhichType < ES_NUM_EVENT_TYPES) && (NumDropped != 0))
+  {
+    EnterCritical();
+    Stats[WhichType].Dropped += NumDropped;
+    ExitCritical();
+  }
+}
+
+/****************************************************************************
+ Function
+     ES_EventStats_Deferred
+ Parameters
+     ES_EventType_t WhichType, the type of the event deferred
+ Returns
+     None.
+ Author
+     ags, 10/20/26 02:53
+****************************************************************************/
+void ES_EventStats_Deferred(ES_EventType_t WhichType)
+{
+  if (WhichType < ES_NUM_EVENT_TYPES)
+  {
+    EnterCritical();
+    Stats[WhichType].Deferred++;
+    ExitCritical();
+  }
+}
+
+/****************************************************************************
+ Function
+     ES_EventStats_Dispatched
+ Parameters
+     ES_EventType_t WhichType, the type of the event given to a run function
+ Returns
+     None.
+ Description
+     counts the dispatch, and works out the rates if a period has ended
+ Notes
+     called from ES_Run
+ Author
+     ags, 10/20/26 02:55
+****************************************************************************/
+void ES_EventStats_Dispatched(ES_EventType_t WhichType)
+{
+  UpdateRates();
+  if (WhichType < ES_NUM_EVENT_TYPES)
+  {
+    Stats[WhichType].Dispatched++;
+    PeriodDispatched[WhichType]++;
+  }
+}
+
+/****************************************************************************
+ Function
+     ES_EventStats_Get
+ Parameters
+     ES_EventType_t WhichType, the event type to report on
+     ES_EventStats_t *pStats, where to copy its counts and rates
+ Returns
+     bool, false if the event type does not exist
+ Author
+     ags, 10/20/26 02:56
+****************************************************************************/
+bool ES_EventStats_Get(ES_EventType_t WhichType, ES_EventStats_t *pStats)
+{
+  if (WhichType >= ES_NUM_EVENT_TYPES)
+  {
+    return false;
+  }
+  UpdateRates();
+  EnterCritical();
+  *pStats = Stats[WhichType];
+  ExitCritical();
+  return true;
+}
+
+/****************************************************************************
+ Function
+     ES_EventStats_Dump
+ Parameters
+     uint8_t TopN, the most event types to list
+ Returns
+     None.
+ Description
+     prints the counts and rates of the event types that have been seen,
+     busiest first, by the post rate and then the number of posts
+ Author
+     ags, 10/20/26 02:58
+****************************************************************************/
+void ES_EventStats_Dump(uint8_t TopN)
+{
+  uint8_t         Order[ES_NUM_EVENT_TYPES];
+  uint8_t         NumSeen = 0;
+  uint8_t         i;
+  uint8_t         j;
+  ES_EventStats_t Row;
+
+  UpdateRates();
+  // an insertion sort of the types that have been seen
+  for (i = 0; i < ES_NUM_EVENT_TYPES; i++)
+  {
+    if ((Stats[i].Posted | Stats[i].Dispatched | Stats[i].Dropped |
+        Stats[i].Deferred) == 0)
+    {
+      continue;
+    }
+    for (j = NumSeen; j > 0; j--)
+    {
+      if ((Stats[Order[j - 1]].PostRate > Stats[i].PostRate) ||
+          ((Stats[Order[j - 1]].PostRate == Stats[i].PostRate) &&
+          (Stats[Order[j - 1]].Posted >= Stats[i].Posted)))
+      {
+        break;
+      }
+      Order[j] = Order[j - 1];
+    }
+    Order[j] = i;
+    NumSeen++;
+  }
+
+  printf("\r\nEvent     Posted Dispatched    Dropped   Deferred    Post/s"
+      "  Dispatch/s\r\n");
+  for (i = 0; (i < NumSeen) && (i < TopN); i++)
+  {
+    if (ES_EventStats_Get((ES_EventType_t)Order[i], &Row) == false)
+    {
+      continue;
+    }
+    printf("%5u %10lu %10lu %10lu %10lu %7lu.%lu %9lu.%lu\r\n", Order[i],
+        (unsigned long)Row.Posted, (unsigned long)Row.Dispatched,
+        (unsigned long)Row.Dropped, (unsigned long)Row.Deferred,
+        (unsigned long)(Row.PostRate / 10),
+        (unsigned long)(Row.PostRate % 10),
+        (unsigned long)(Row.DispatchRate / 10),
+        (unsigned long)(Row.DispatchRate % 10));
+  }
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+/****************************************************************************
+ Function
+     UpdateRates
+ Parameters
+     None.
+ Returns
+     None.
+ Description
+     if one or more periods have ended, moves the rates towards the events
+     counted in the first of them, then towards 0 for the rest, which had
+     none
+ Author
+     ags, 10/20/26 03:01
+****************************************************************************/
+static void UpdateRates(void)
+{
+  uint16_t  Posted[ES_NUM_EVENT_TYPES];
+  uint16_t  Elapsed = ES_Timer_GetTime() - PeriodStart;
+  uint16_t  NumPeriods;
+  uint16_t  Empty;
+  uint8_t   i;
+
+  if (Elapsed < EVENT_RATE_PERIOD_MS)
+  {
+    return;
+  }
+  NumPeriods = Elapsed / EVENT_RATE_PERIOD_MS;
+  PeriodStart += NumPeriods * EVENT_RATE_PERIOD_MS;
+
+  // the post counts are added to from interrupts
+  EnterCritical();
+  for (i = 0; i < ES_NUM_EVENT_TYPES; i++)
+  {
+    Posted[i]       = PeriodPosted[i];
+    PeriodPosted[i] = 0;
+  }
+  ExitCritical();
+
+  for (i = 0; i < ES_NUM_EVENT_TYPES; i++)
+  {
+    Stats[i].PostRate = MoveMean(Stats[i].PostRate,
+        Posted[i] * RATE_PER_EVENT);
+    Stats[i].DispatchRate = MoveMean(Stats[i].DispatchRate,
+        PeriodDispatched[i] * RATE_PER_EVENT);
+    PeriodDispatched[i] = 0;
+    for (Empty = 1; (Empty < NumPeriods) && (Empty < MAX_EMPTY_PERIODS);
+        Empty++)
+    {
+      Stats[i].PostRate     = MoveMean(Stats[i].PostRate, 0);
+      Stats[i].DispatchRate = MoveMean(Stats[i].DispatchRate, 0);
+    }
+  }
+}
+
+/****************************************************************************
+ Function
+     MoveMean
+ Parameters
+     uint32_t Mean, the decaying mean
+     uint32_t NewRate, the rate over the last period
+ Returns
+     uint32_t, the mean moved 1/2^EVENT_RATE_SHIFT of the way to NewRate
+ Author
+     ags, 10/20/26 03:02
+****************************************************************************/
+static uint32_t MoveMean(uint32_t Mean, uint32_t NewRate)
+{
+  if (NewRate >= Mean)
+  {
+    return Mean + ((NewRate - Mean + RATE_ROUNDING) >> EVENT_RATE_SHIFT);
+  }
+  return Mean - ((Mean - NewRate + RATE_ROUNDING) >> EVENT_RATE_SHIFT);
+}
+
+/****************************************************************************
+ Function
+     CountServices
+ Parameters
+     uint16_t Services, a mask of services, bit n for service n
+ Returns
+     uint8_t, the number of bits set in the mask
+ Author
+     ags, 10/20/26 03:03
+****************************************************************************/
+static uint8_t CountServices(uint16_t Services)
+{
+  uint8_t Count = 0;
+
+  while (Services != 0)
+  {
+    Services &= (uint16_t)(Services - 1);   // clears the lowest bit set
+    Count++;
+  }
+  return Count;
+}
+
+#endif /* _INCLUDE_EVENT_STATS_ */
+/*------------------------------- Footnotes -------------------------------*/
+/*------------------------------ End of file ------------------------------*/
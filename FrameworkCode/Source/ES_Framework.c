@@ -8,6 +8,40 @@
  History
  When           Who     What/Why
  -------------- ---     --------
+ 10/20/26 06:35 ags     a pass through the pending interrupts that gives no
+                        work is charged as idle
+ 10/20/26 06:31 ags     the load stats charge the checkers and the idle time
+                        with _INCLUDE_VIRTUAL_TIME_ or _INCLUDE_EVENT_REPLAY_
+ 10/20/26 06:08 ags     ES_PurgeFromService clears Ready in the same critical
+                        region as the empty check
+ 10/20/26 05:02 ags     move the host's virtual clock on from ES_Run when
+                        idle with _INCLUDE_VIRTUAL_TIME_
+ 10/20/26 04:21 ags     trace the posts from outside the service code as
+                        inputs, replay captured inputs on the host with
+                        _INCLUDE_EVENT_REPLAY_
+ 10/20/26 03:28 ags     check the run functions against their budgets with
+                        _INCLUDE_RUN_BUDGETS_, feed the watchdog from ES_Run
+ 10/20/26 03:05 ags     count the posts, drops and dispatches of each event
+                        type with _INCLUDE_EVENT_STATS_
+ 10/20/26 02:37 ags     start the PC sampler in ES_Initialize
+ 10/20/26 01:57 ags     account for the time spent in ES_Run with
+                        _INCLUDE_LOAD_STATS_
+ 10/20/26 00:38 ags     trace the posts and runs with _INCLUDE_TRACE_, and
+                        drain the trace from ES_Run
+ 10/19/26 23:59 ags     stamp the events in the service queues and record
+                        their queueing latency with _INCLUDE_LATENCY_STATS_
+ 10/19/26 23:20 ags     profile the run functions with _INCLUDE_PROFILER_
+ 10/19/26 19:55 ags     ES_SpliceToService passes on the source's stamps
+ 10/19/26 19:14 ags     added ES_SpliceToService for the deferral recall
+ 10/19/26 18:44 ags     ES_Run gives services their ES_Broadcast events once
+                        their own queue is empty
+ 10/19/26 17:20 ags     added all-or-nothing and best effort multicast posts,
+                        ES_PostAll & ES_Publish no longer deliver to only
+                        some of their targets
+ 10/19/26 16:44 ags     added publish/subscribe by event type
+ 10/19/26 15:32 ags     start input capture in ES_Initialize
+ 10/19/26 14:14 ags     added ES_PurgeFromService
+ 10/19/26 11:14 ags     start the high resolution timers in ES_Initialize
  08/21/17 13:18 jec     added conditional call to initialize the port lines
                         for the hardware debugging of the framework/apps
  12/19/16 20:18 jec      changed includes to accomodate the change to a fixed
@@ -32,6 +66,16 @@
 #include "ES_Queue.h"
 #include "ES_LookupTables.h"
 #include "ES_Timers.h"
+#include "ES_HRTimers.h"
+#include "ES_InputCapture.h"
+#include "ES_Broadcast.h"
+#include "ES_Profiler.h"
+#include "ES_Latency.h"
+#include "ES_Trace.h"
+#include "ES_Load.h"
+#include "ES_PCSample.h"
+#include "ES_EventStats.h"
+#include "ES_Replay.h"
 #include "ES_General.h"
 #include "ES_CheckEvents.h"
 // Include the header files for the Service modules.
@@ -60,6 +104,58 @@ typedef RunFunc_t   *pRunFunc;
 
 #define NULL_INIT_FUNC ((pInitFunc)0)
 
+// the services that have work to do, either events in their queue or
+// broadcasts that they have not yet been given
+#if BROADCAST_RING_SIZE > 0
+#define PENDING_WORK() (Ready | ES_Broadcast_GetPending())
+#else
+#define PENDING_WORK() (Ready)
+#endif
+
+// the service queue operations, which keep an enqueue stamp with each event
+// when the latency statistics are included
+#ifdef _INCLUDE_LATENCY_STATS_
+#define QUEUE_STAMPS(Service) (QueueStamps[Service])
+#define LATENCY_NOW() ES_Latency_Now()
+#define ENQUEUE_FIFO(Service, Event) \
+  ES_EnQueueFIFOStamped(EventQueues[Service].pMem, QueueStamps[Service], \
+      (Event), ES_Latency_Now())
+#define ENQUEUE_FIFO_IN_CRITICAL(Service, Event) \
+  ES_EnQueueFIFOStampedInCritical(EventQueues[Service].pMem, \
+      QueueStamps[Service], (Event), ES_Latency_Now())
+#define ENQUEUE_LIFO(Service, Event) \
+  ES_EnQueueLIFOStamped(EventQueues[Service].pMem, QueueStamps[Service], \
+      (Event), ES_Latency_Now())
+#define DEQUEUE(Service, pEvent) DeQueueAndRecord((Service), (pEvent))
+#else
+#define QUEUE_STAMPS(Service) ((uint16_t *)0)
+#define LATENCY_NOW() 0
+#define ENQUEUE_FIFO(Service, Event) \
+  ES_EnQueueFIFO(EventQueues[Service].pMem, (Event))
+#define ENQUEUE_FIFO_IN_CRITICAL(Service, Event) \
+  ES_EnQueueFIFOInCritical(EventQueues[Service].pMem, (Event))
+#define ENQUEUE_LIFO(Service, Event) \
+  ES_EnQueueLIFO(EventQueues[Service].pMem, (Event))
+#define DEQUEUE(Service, pEvent) \
+  ES_DeQueue(EventQueues[Service].pMem, (pEvent))
+#endif
+
+// the call to process the pending interrupts, which also charges the time
+// to them when the CPU load is being accounted for
+#ifdef _INCLUDE_LOAD_STATS_
+#define PROCESS_PENDING_INTS() \
+  (ES_Load_Enter(ES_LOAD_PENDING_INTS), _HW_Process_Pending_Ints())
+#else
+#define PROCESS_PENDING_INTS() _HW_Process_Pending_Ints()
+#endif
+
+// the kind of trace record for a successful post, those from outside the
+// service code are the inputs to the services
+#ifdef _INCLUDE_TRACE_
+#define TRACE_POST_KIND() \
+  ((ES_PostIsInput() == true) ? ES_TRACE_INPUT : ES_TRACE_POST)
+#endif
+
 typedef struct
 {
   InitFunc_t *InitFunc;       // Service Initialization function
@@ -74,6 +170,20 @@ typedef struct
 
 /*---------------------------- Module Functions ---------------------------*/
 //static bool CheckSystemEvents( void );
+#ifdef _INCLUDE_LATENCY_STATS_
+static uint8_t DeQueueAndRecord(uint8_t WhichService, ES_Event_t *pEvent);
+#endif
+#ifdef _INCLUDE_TRACE_
+static void TraceMask(ES_TraceKind_t Kind, uint16_t Services,
+    ES_Event_t ThisEvent);
+#endif
+#ifdef _INCLUDE_RUN_BUDGETS_
+static void CheckBudget(uint8_t WhichService, ES_EventType_t WhichType,
+    uint32_t RunTime);
+#endif
+#ifdef _INCLUDE_EVENT_REPLAY_
+static uint8_t QueueDepth(uint8_t WhichService);
+#endif
 
 /*---------------------------- Module Variables ---------------------------*/
 /****************************************************************************/
@@ -234,11 +344,185 @@ static ES_QueueDesc_t const EventQueues[NUM_SERVICES] = {
 #endif
 };
 
+#ifdef _INCLUDE_LATENCY_STATS_
+/****************************************************************************/
+// The enqueue stamps of the events in the queues, one for each queue entry
+
+static uint16_t Stamps0[SERV_0_QUEUE_SIZE];
+#if NUM_SERVICES > 1
+static uint16_t Stamps1[SERV_1_QUEUE_SIZE];
+#endif
+#if NUM_SERVICES > 2
+static uint16_t Stamps2[SERV_2_QUEUE_SIZE];
+#endif
+#if NUM_SERVICES > 3
+static uint16_t Stamps3[SERV_3_QUEUE_SIZE];
+#endif
+#if NUM_SERVICES > 4
+static uint16_t Stamps4[SERV_4_QUEUE_SIZE];
+#endif
+#if NUM_SERVICES > 5
+static uint16_t Stamps5[SERV_5_QUEUE_SIZE];
+#endif
+#if NUM_SERVICES > 6
+static uint16_t Stamps6[SERV_6_QUEUE_SIZE];
+#endif
+#if NUM_SERVICES > 7
+static uint16_t Stamps7[SERV_7_QUEUE_SIZE];
+#endif
+#if NUM_SERVICES > 8
+static uint16_t Stamps8[SERV_8_QUEUE_SIZE];
+#endif
+#if NUM_SERVICES > 9
+static uint16_t Stamps9[SERV_9_QUEUE_SIZE];
+#endif
+#if NUM_SERVICES > 10
+static uint16_t Stamps10[SERV_10_QUEUE_SIZE];
+#endif
+#if NUM_SERVICES > 11
+static uint16_t Stamps11[SERV_11_QUEUE_SIZE];
+#endif
+#if NUM_SERVICES > 12
+static uint16_t Stamps12[SERV_12_QUEUE_SIZE];
+#endif
+#if NUM_SERVICES > 13
+static uint16_t Stamps13[SERV_13_QUEUE_SIZE];
+#endif
+#if NUM_SERVICES > 14
+static uint16_t Stamps14[SERV_14_QUEUE_SIZE];
+#endif
+#if NUM_SERVICES > 15
+static uint16_t Stamps15[SERV_15_QUEUE_SIZE];
+#endif
+
+static uint16_t * const QueueStamps[NUM_SERVICES] = {
+  Stamps0
+#if NUM_SERVICES > 1
+  , Stamps1
+#endif
+#if NUM_SERVICES > 2
+  , Stamps2
+#endif
+#if NUM_SERVICES > 3
+  , Stamps3
+#endif
+#if NUM_SERVICES > 4
+  , Stamps4
+#endif
+#if NUM_SERVICES > 5
+  , Stamps5
+#endif
+#if NUM_SERVICES > 6
+  , Stamps6
+#endif
+#if NUM_SERVICES > 7
+  , Stamps7
+#endif
+#if NUM_SERVICES > 8
+  , Stamps8
+#endif
+#if NUM_SERVICES > 9
+  , Stamps9
+#endif
+#if NUM_SERVICES > 10
+  , Stamps10
+#endif
+#if NUM_SERVICES > 11
+  , Stamps11
+#endif
+#if NUM_SERVICES > 12
+  , Stamps12
+#endif
+#if NUM_SERVICES > 13
+  , Stamps13
+#endif
+#if NUM_SERVICES > 14
+  , Stamps14
+#endif
+#if NUM_SERVICES > 15
+  , Stamps15
+#endif
+};
+#endif /* _INCLUDE_LATENCY_STATS_ */
+
+#ifdef _INCLUDE_RUN_BUDGETS_
+/****************************************************************************/
+// The longest that each service's run function may take, in uS
+
+static uint32_t const RunBudget[NUM_SERVICES] = {
+  SERV_0_BUDGET
+#if NUM_SERVICES > 1
+  , SERV_1_BUDGET
+#endif
+#if NUM_SERVICES > 2
+  , SERV_2_BUDGET
+#endif
+#if NUM_SERVICES > 3
+  , SERV_3_BUDGET
+#endif
+#if NUM_SERVICES > 4
+  , SERV_4_BUDGET
+#endif
+#if NUM_SERVICES > 5
+  , SERV_5_BUDGET
+#endif
+#if NUM_SERVICES > 6
+  , SERV_6_BUDGET
+#endif
+#if NUM_SERVICES > 7
+  , SERV_7_BUDGET
+#endif
+#if NUM_SERVICES > 8
+  , SERV_8_BUDGET
+#endif
+#if NUM_SERVICES > 9
+  , SERV_9_BUDGET
+#endif
+#if NUM_SERVICES > 10
+  , SERV_10_BUDGET
+#endif
+#if NUM_SERVICES > 11
+  , SERV_11_BUDGET
+#endif
+#if NUM_SERVICES > 12
+  , SERV_12_BUDGET
+#endif
+#if NUM_SERVICES > 13
+  , SERV_13_BUDGET
+#endif
+#if NUM_SERVICES > 14
+  , SERV_14_BUDGET
+#endif
+#if NUM_SERVICES > 15
+  , SERV_15_BUDGET
+#endif
+};
+
+// the overruns of each service, only written from ES_Run
+static ES_OverrunStats_t OverrunStats[NUM_SERVICES];
+#endif /* _INCLUDE_RUN_BUDGETS_ */
+
 /****************************************************************************/
 // Variable used to keep track of which queues have events in them
 
 uint16_t Ready;
 
+#if defined(_INCLUDE_TRACE_) || defined(_INCLUDE_EVENT_REPLAY_)
+/****************************************************************************/
+// True while the services' own code is running, their init functions from
+// ES_Initialize and their run functions from ES_Run. The posts made at any
+// other time, by the event checkers, the timers and the interrupt responses,
+// are the inputs to the services.
+
+static bool InServiceCode = false;
+#endif
+
+/****************************************************************************/
+// For each event type, the services (as a Ready style bit mask) that have
+// subscribed to it with ES_Subscribe. ES_Publish posts only to these.
+
+static uint16_t SubscriberTable[ES_NUM_EVENT_TYPES];
+
 /*------------------------------ Module Code ------------------------------*/
 /****************************************************************************
  Function
@@ -259,6 +543,36 @@ ES_Return_t ES_Initialize(TimerRate_t NewRate)
 {
   uint8_t i;
   ES_Timer_Init(NewRate);  // start up the timer subsystem
+#ifdef _INCLUDE_HR_TIMERS_
+  ES_HRTimer_Init();       // and the high resolution timers
+#endif
+#ifdef _INCLUDE_INPUT_CAPTURE_
+  ES_InputCapture_Init();  // input capture needs the HR timer running
+#endif
+#ifdef _INCLUDE_TRACE_
+  ES_Trace_Init();         // the trace is timed on the HR timer
+#endif
+#ifdef _INCLUDE_PROFILER_
+  ES_Profiler_Init();
+#endif
+#ifdef _INCLUDE_LATENCY_STATS_
+  ES_Latency_Reset();
+#endif
+#ifdef _INCLUDE_PC_SAMPLER_
+  ES_PCSample_Init();
+#endif
+#ifdef _INCLUDE_EVENT_STATS_
+  ES_EventStats_Reset();
+#endif
+#ifdef _INCLUDE_WATCHDOG_
+  _HW_Watchdog_Init(WATCHDOG_TIMEOUT_MS);
+#endif
+#ifdef _INCLUDE_EVENT_REPLAY_
+  ES_Replay_Init();
+#endif
+#if defined(_INCLUDE_TRACE_) || defined(_INCLUDE_EVENT_REPLAY_)
+  InServiceCode = true;
+#endif
   // loop through the list testing for NULL pointers and
   for (i = 0; i < ARRAY_SIZE(ServDescList); i++)
   {
@@ -275,6 +589,9 @@ ES_Return_t ES_Initialize(TimerRate_t NewRate)
       return FailedInit; // this is a failed initialization
     }
   }
+#if defined(_INCLUDE_TRACE_) || defined(_INCLUDE_EVENT_REPLAY_)
+  InServiceCode = false;
+#endif
 #ifdef _INCLUDE_BASIC_FRAMEWORK_DEBUG_
   _HW_DebugLines_Init();
 #endif
@@ -304,26 +621,85 @@ ES_Return_t ES_Run(void)
   // make these static to improve speed
   uint8_t         HighestPrior;
   static ES_Event_t ThisEvent;
+#ifdef _INCLUDE_RUN_BUDGETS_
+  uint32_t        RunStart;
+#endif
 
+#ifdef _INCLUDE_LOAD_STATS_
+  ES_Load_Reset();  // the load is of the time since ES_Run started
+#endif
   while (1)  // stay here unless we detect an error condition
   { // loop through the list executing the run functions for services
     // with a non-empty queue. Process any pending ints before testing
     // Ready
-    while ((_HW_Process_Pending_Ints()) && (Ready != 0))
+    while ((PROCESS_PENDING_INTS()) && (PENDING_WORK() != 0))
     {
-      HighestPrior = ES_GetMSBitSet(Ready);
-      if (ES_DeQueue(EventQueues[HighestPrior].pMem, &ThisEvent) == 0)
+#ifdef _INCLUDE_LOAD_STATS_
+      ES_Load_Enter(ES_LOAD_DISPATCH);
+#endif
+      HighestPrior = ES_GetMSBitSet(PENDING_WORK());
+#ifdef _INCLUDE_EVENT_REPLAY_
+      ES_Replay_StartRun(HighestPrior, QueueDepth(HighestPrior));
+#endif
+#if BROADCAST_RING_SIZE > 0
+      if ((Ready & BitNum2SetMask[HighestPrior]) == 0)
+      {
+        // the service's own queue is empty, so give it the next broadcast
+        ES_Broadcast_Next(HighestPrior, &ThisEvent);
+      }
+      else if (DEQUEUE(HighestPrior, &ThisEvent) == 0)
       {
         Ready &= BitNum2ClrMask[HighestPrior]; // mark queue as now empty
       }
+#else
+      if (DEQUEUE(HighestPrior, &ThisEvent) == 0)
+      {
+        Ready &= BitNum2ClrMask[HighestPrior]; // mark queue as now empty
+      }
+#endif
+#ifdef _INCLUDE_EVENT_STATS_
+      ES_EventStats_Dispatched(ThisEvent.EventType);
+#endif
 #ifdef _INCLUDE_BASIC_FRAMEWORK_DEBUG_
       _HW_DebugSetLine1();
+#endif
+#ifdef _INCLUDE_TRACE_
+      ES_Trace_Record(ES_TRACE_RUN_BEGIN, HighestPrior, ThisEvent);
+#endif
+#ifdef _INCLUDE_WATCHDOG_
+      _HW_Watchdog_Feed();
+#endif
+#ifdef _INCLUDE_RUN_BUDGETS_
+      RunStart = ES_HRTimer_GetTime();
+#endif
+#ifdef _INCLUDE_PROFILER_
+      ES_Profiler_StartRun();
+#endif
+#if defined(_INCLUDE_TRACE_) || defined(_INCLUDE_EVENT_REPLAY_)
+      InServiceCode = true;
 #endif
       if (ServDescList[HighestPrior].RunFunc(ThisEvent).EventType !=
           ES_NO_EVENT)
       {
         return FailedRun;
       }
+#if defined(_INCLUDE_TRACE_) || defined(_INCLUDE_EVENT_REPLAY_)
+      InServiceCode = false;
+#endif
+#ifdef _INCLUDE_PROFILER_
+      ES_Profiler_EndRun(HighestPrior, ThisEvent.EventType);
+#endif
+#ifdef _INCLUDE_RUN_BUDGETS_
+      CheckBudget(HighestPrior, ThisEvent.EventType,
+          ES_HRTimer_GetTime() - RunStart);
+#endif
+#ifdef _INCLUDE_EVENT_REPLAY_
+      ES_Replay_EndRun(HighestPrior);
+#endif
+#ifdef _INCLUDE_TRACE_
+      ES_Trace_Record(ES_TRACE_RUN_END, HighestPrior, ThisEvent);
+      ES_Trace_Drain();
+#endif
 #ifdef _INCLUDE_BASIC_FRAMEWORK_DEBUG_
       _HW_DebugClearLine1();
 #endif
@@ -331,9 +707,37 @@ ES_Return_t ES_Run(void)
 
 #ifdef _INCLUDE_BASIC_FRAMEWORK_DEBUG_
     _HW_DebugSetLine2();
+#endif
+#ifdef _INCLUDE_TRACE_
+    ES_Trace_Drain();
 #endif
     // all the queues are empty, so look for new user detected events
-    ES_CheckUserEvents();
+#ifdef _INCLUDE_WATCHDOG_
+    _HW_Watchdog_Feed();
+#endif
+#ifdef _INCLUDE_LOAD_STATS_
+    // the last pass through the pending interrupts gave no work, so it was
+    // idle
+    ES_Load_Recategorize(ES_LOAD_IDLE);
+#endif
+#if defined(_INCLUDE_EVENT_REPLAY_)
+    // the captured inputs stand in for the event checkers, so the time up
+    // to the next one is idle too
+    ES_Replay_Idle();
+#else
+#ifdef _INCLUDE_LOAD_STATS_
+    ES_Load_Enter(ES_LOAD_CHECKERS);
+#endif
+    if (ES_CheckUserEvents() == false)
+    {
+#ifdef _INCLUDE_LOAD_STATS_
+      ES_Load_Recategorize(ES_LOAD_IDLE); // nothing to do, so it was idle
+#endif
+#ifdef _INCLUDE_VIRTUAL_TIME_
+      _HW_VirtualTime_Advance();  // nothing to do until the next deadline
+#endif
+    }
+#endif
 #ifdef _INCLUDE_BASIC_FRAMEWORK_DEBUG_
     _HW_DebugClearLine2();
 #endif
@@ -346,37 +750,156 @@ ES_Return_t ES_Run(void)
  Parameters
    ES_Event : The Event to be posted
  Returns
-   boolean : False if any of the post functions failed during execution
+   boolean : False if the event could not be posted to every service, in
+   which case it was not posted to any of them
  Description
    posts to all of the services' queues
  Notes
-
+   see ES_PostToMask
  Author
    J. Edward Carryer, 01/15/12,
 ****************************************************************************/
 bool ES_PostAll(ES_Event_t ThisEvent)
 {
-  uint8_t i;
-  // loop through the list executing the post functions
-  for (i = 0; i < ARRAY_SIZE(EventQueues); i++)
+  return ES_PostToMask(ES_ALL_SERVICES, ThisEvent);
+}
+
+/****************************************************************************
+ Function
+   ES_PostToMask
+ Parameters
+   uint16_t : the services to post to, as a bit mask with bit n for service n
+   ES_Event : The Event to be posted
+ Returns
+   boolean : False if any of the services does not exist or has a full
+   queue, in which case the event was not posted to any of them
+ Description
+   posts the event to every service in the mask, or to none of them
+ Notes
+   the space in every target queue is checked first, then all of the
+   enqueues and the update of Ready are done in the same critical region,
+   so no service can see the event before all of them have it
+ Author
+   ags, 10/19/26 17:24
+****************************************************************************/
+bool ES_PostToMask(uint16_t Services, ES_Event_t ThisEvent)
+{
+  uint16_t  Remaining;
+  uint8_t   ThisService;
+  bool      ReturnValue = true;
+
+  if ((Services & ~ES_ALL_SERVICES) != 0)
   {
-    if (ES_EnQueueFIFO(EventQueues[i].pMem, ThisEvent) != true)
+    return false;   // can't post to a service that does not exist
+  }
+#ifdef _INCLUDE_EVENT_REPLAY_
+  if (ES_Replay_Mutes() == true)
+  {
+    return true;    // a live input, the captured one takes its place
+  }
+#endif
+  EnterCritical();
+  // first make sure that there is room for the event in every queue
+  Remaining = Services;
+  while (Remaining != 0)
+  {
+    ThisService = ES_GetMSBitSet(Remaining);
+    if (ES_QueueSpace(EventQueues[ThisService].pMem) == 0)
     {
-      break; // this is a failed post
+      ReturnValue = false;
+      break;
     }
-    else
+    Remaining &= BitNum2ClrMask[ThisService];
+  }
+  // then, only if there was, post it to all of them
+  if (ReturnValue == true)
+  {
+    Remaining = Services;
+    while (Remaining != 0)
     {
-      Ready |= BitNum2SetMask[i]; // show queue as non-empty
+      ThisService = ES_GetMSBitSet(Remaining);
+      ENQUEUE_FIFO_IN_CRITICAL(ThisService, ThisEvent);
+      Remaining &= BitNum2ClrMask[ThisService];
     }
+    Ready |= Services; // show all of the queues as non-empty
   }
-  if (i == ARRAY_SIZE(EventQueues))    // if no failures
+  ExitCritical();
+#ifdef _INCLUDE_TRACE_
+  if (ReturnValue == true)
   {
-    return true;
+    TraceMask(TRACE_POST_KIND(), Services, ThisEvent);
   }
   else
   {
-    return false;
+    // ThisService is the one that had no room
+    ES_Trace_Record(ES_TRACE_OVERFLOW, ThisService, ThisEvent);
   }
+#endif
+#ifdef _INCLUDE_EVENT_STATS_
+  if (ReturnValue == true)
+  {
+    ES_EventStats_Posted(ThisEvent.EventType, Services);
+  }
+  else
+  {
+    ES_EventStats_Dropped(ThisEvent.EventType, Services);
+  }
+#endif
+  return ReturnValue;
+}
+
+/****************************************************************************
+ Function
+   ES_PostToMaskBestEffort
+ Parameters
+   uint16_t : the services to post to, as a bit mask with bit n for service n
+   ES_Event : The Event to be posted
+ Returns
+   uint16_t : bit mask of the services that did not get the event, either
+   because they do not exist or their queue was full, 0 if all succeeded
+ Description
+   posts the event to every service in the mask that has room for it
+ Notes
+   unlike ES_PostAll before it, this does not stop at the first full queue
+ Author
+   ags, 10/19/26 17:30
+****************************************************************************/
+uint16_t ES_PostToMaskBestEffort(uint16_t Services, ES_Event_t ThisEvent)
+{
+  uint16_t  Remaining;
+  uint16_t  Posted = 0;
+  uint8_t   ThisService;
+
+#ifdef _INCLUDE_EVENT_REPLAY_
+  if (ES_Replay_Mutes() == true)
+  {
+    return 0;       // a live input, the captured one takes its place
+  }
+#endif
+  Remaining = Services & ES_ALL_SERVICES;
+  EnterCritical();
+  while (Remaining != 0)
+  {
+    ThisService = ES_GetMSBitSet(Remaining);
+    if (ENQUEUE_FIFO_IN_CRITICAL(ThisService, ThisEvent) == true)
+    {
+      Posted |= BitNum2SetMask[ThisService];
+    }
+    Remaining &= BitNum2ClrMask[ThisService];
+  }
+  Ready |= Posted; // show the queues posted to as non-empty
+  ExitCritical();
+#ifdef _INCLUDE_TRACE_
+  TraceMask(TRACE_POST_KIND(), Posted, ThisEvent);
+  TraceMask(ES_TRACE_OVERFLOW, Services & ES_ALL_SERVICES & ~Posted,
+      ThisEvent);
+#endif
+#ifdef _INCLUDE_EVENT_STATS_
+  ES_EventStats_Posted(ThisEvent.EventType, Posted);
+  ES_EventStats_Dropped(ThisEvent.EventType,
+      Services & ES_ALL_SERVICES & ~Posted);
+#endif
+  return Services & ~Posted;
 }
 
 /****************************************************************************
@@ -396,15 +919,38 @@ bool ES_PostAll(ES_Event_t ThisEvent)
 ****************************************************************************/
 bool ES_PostToService(uint8_t WhichService, ES_Event_t TheEvent)
 {
+#ifdef _INCLUDE_EVENT_REPLAY_
+  if (ES_Replay_Mutes() == true)
+  {
+    return true;    // a live input, the captured one takes its place
+  }
+#endif
   if ((WhichService < ARRAY_SIZE(EventQueues)) &&
-      (ES_EnQueueFIFO(EventQueues[WhichService].pMem, TheEvent) ==
-        true))
+      (ENQUEUE_FIFO(WhichService, TheEvent) == true))
   {
     Ready |= BitNum2SetMask[WhichService]; // show queue as non-empty
+#ifdef _INCLUDE_TRACE_
+    ES_Trace_Record(TRACE_POST_KIND(), WhichService, TheEvent);
+#endif
+#ifdef _INCLUDE_EVENT_STATS_
+    ES_EventStats_Posted(TheEvent.EventType, BitNum2SetMask[WhichService]);
+#endif
     return true;
   }
   else
   {
+#ifdef _INCLUDE_TRACE_
+    if (WhichService < ARRAY_SIZE(EventQueues))
+    {
+      ES_Trace_Record(ES_TRACE_OVERFLOW, WhichService, TheEvent);
+    }
+#endif
+#ifdef _INCLUDE_EVENT_STATS_
+    if (WhichService < ARRAY_SIZE(EventQueues))
+    {
+      ES_EventStats_Dropped(TheEvent.EventType, BitNum2SetMask[WhichService]);
+    }
+#endif
     return false;
   }
 }
@@ -426,19 +972,275 @@ bool ES_PostToService(uint8_t WhichService, ES_Event_t TheEvent)
 ****************************************************************************/
 bool ES_PostToServiceLIFO(uint8_t WhichService, ES_Event_t TheEvent)
 {
+#ifdef _INCLUDE_EVENT_REPLAY_
+  if (ES_Replay_Mutes() == true)
+  {
+    return true;    // a live input, the captured one takes its place
+  }
+#endif
   if ((WhichService < ARRAY_SIZE(EventQueues)) &&
-      (ES_EnQueueLIFO(EventQueues[WhichService].pMem, TheEvent) ==
-        true))
+      (ENQUEUE_LIFO(WhichService, TheEvent) == true))
   {
     Ready |= BitNum2SetMask[WhichService]; // show queue as non-empty
+#ifdef _INCLUDE_TRACE_
+    ES_Trace_Record(TRACE_POST_KIND(), WhichService, TheEvent);
+#endif
+#ifdef _INCLUDE_EVENT_STATS_
+    ES_EventStats_Posted(TheEvent.EventType, BitNum2SetMask[WhichService]);
+#endif
     return true;
   }
   else
   {
+#ifdef _INCLUDE_TRACE_
+    if (WhichService < ARRAY_SIZE(EventQueues))
+    {
+      ES_Trace_Record(ES_TRACE_OVERFLOW, WhichService, TheEvent);
+    }
+#endif
+#ifdef _INCLUDE_EVENT_STATS_
+    if (WhichService < ARRAY_SIZE(EventQueues))
+    {
+      ES_EventStats_Dropped(TheEvent.EventType, BitNum2SetMask[WhichService]);
+    }
+#endif
     return false;
   }
 }
 
+/****************************************************************************
+ Function
+   ES_SpliceToService
+ Parameters
+   uint8_t : Which service to move the events to (index into ServDescList)
+   ES_Event_t * : the queue to move the events from
+   uint16_t * : the source queue's stamps, 0 if it is not stamped
+   uint32_t : the types of event to move, see ES_SpliceQueue
+ Returns
+   uint8_t : the number of events moved
+ Description
+   moves the selected events from the queue to the front of the service's
+   queue, in order, so that they will be the next ones that it processes
+ Notes
+   used by the Defer/Recall event capability
+ Author
+   ags, 10/19/26 19:16
+****************************************************************************/
+uint8_t ES_SpliceToService(uint8_t WhichService, ES_Event_t *pSource,
+    uint16_t *pSourceStamps, uint32_t TypeMask)
+{
+  uint8_t NumMoved;
+
+  if (WhichService >= ARRAY_SIZE(EventQueues))
+  {
+    return 0;
+  }
+  NumMoved = ES_SpliceQueueStamped(EventQueues[WhichService].pMem,
+      QUEUE_STAMPS(WhichService), LATENCY_NOW(), pSource, pSourceStamps,
+      TypeMask);
+  if (NumMoved != 0)
+  {
+    Ready |= BitNum2SetMask[WhichService]; // show queue as non-empty
+  }
+  return NumMoved;
+}
+
+/****************************************************************************
+ Function
+   ES_PurgeFromService
+ Parameters
+   uint8_t : Which service to purge (index into ServDescList)
+   ES_EventType_t : the type of event to remove
+   uint16_t : bit mask of the parameter values to remove
+ Returns
+   boolean : False if the service does not exist
+ Description
+   removes already queued events of the given type, whose parameter (as a
+   bit number) is in the mask, from a service's queue
+ Notes
+   used by the timer library to discard stale ES_TIMEOUT events when a
+   group of timers is stopped
+ Author
+   ags, 10/19/26 14:16
+****************************************************************************/
+bool ES_PurgeFromService(uint8_t WhichService, ES_EventType_t WhichType,
+    uint16_t ParamMask)
+{
+  if (WhichService >= ARRAY_SIZE(EventQueues))
+  {
+    return false;
+  }
+  ES_PurgeQueueStamped(EventQueues[WhichService].pMem,
+      QUEUE_STAMPS(WhichService), WhichType, ParamMask);
+  // check for empty and clear Ready together, so that an event posted by
+  // an interrupt after the purge is not left in the queue unseen
+  EnterCritical();
+  if (ES_IsQueueEmpty(EventQueues[WhichService].pMem) == true)
+  {
+    Ready &= BitNum2ClrMask[WhichService]; // mark queue as now empty
+  }
+  ExitCritical();
+  return true;
+}
+
+/****************************************************************************
+ Function
+   ES_Subscribe
+ Parameters
+   uint8_t : Which service is subscribing (index into ServDescList)
+   ES_EventType_t : the type of event to subscribe to
+ Returns
+   boolean : False if the service or event type does not exist
+ Description
+   adds the service to the subscribers for the event type, so that it will
+   receive the events of that type passed to ES_Publish
+ Notes
+   services will normally subscribe in their init function
+ Author
+   ags, 10/19/26 16:47
+****************************************************************************/
+bool ES_Subscribe(uint8_t WhichService, ES_EventType_t WhichType)
+{
+  if ((WhichService >= ARRAY_SIZE(EventQueues)) ||
+      (WhichType >= ARRAY_SIZE(SubscriberTable)))
+  {
+    return false;
+  }
+  SubscriberTable[WhichType] |= BitNum2SetMask[WhichService];
+  return true;
+}
+
+/****************************************************************************
+ Function
+   ES_Unsubscribe
+ Parameters
+   uint8_t : Which service is unsubscribing (index into ServDescList)
+   ES_EventType_t : the type of event to unsubscribe from
+ Returns
+   boolean : False if the service or event type does not exist
+ Description
+   removes the service from the subscribers for the event type
+ Notes
+   events of this type that have already been published to the service
+   stay in its queue
+ Author
+   ags, 10/19/26 16:49
+****************************************************************************/
+bool ES_Unsubscribe(uint8_t WhichService, ES_EventType_t WhichType)
+{
+  if ((WhichService >= ARRAY_SIZE(EventQueues)) ||
+      (WhichType >= ARRAY_SIZE(SubscriberTable)))
+  {
+    return false;
+  }
+  SubscriberTable[WhichType] &= BitNum2ClrMask[WhichService];
+  return true;
+}
+
+/****************************************************************************
+ Function
+   ES_Publish
+ Parameters
+   ES_Event : The Event to be published
+ Returns
+   boolean : False if the event type does not exist or any subscriber's
+   queue was full, in which case none of the subscribers got the event
+ Description
+   posts the event to every service that has subscribed to its type, and
+   only to those services
+ Notes
+   the subscriber mask goes straight to ES_PostToMask, so all of the
+   subscribers get the event or none of them do. An event with no
+   subscribers is simply dropped.
+ Author
+   ags, 10/19/26 16:52
+****************************************************************************/
+bool ES_Publish(ES_Event_t ThisEvent)
+{
+  if (ThisEvent.EventType >= ARRAY_SIZE(SubscriberTable))
+  {
+    return false;
+  }
+  return ES_PostToMask(SubscriberTable[ThisEvent.EventType], ThisEvent);
+}
+
+#if defined(_INCLUDE_TRACE_) || defined(_INCLUDE_EVENT_REPLAY_)
+/****************************************************************************
+ Function
+   ES_PostIsInput
+ Parameters
+   None
+ Returns
+   boolean : True if a post made now is an input to the services
+ Description
+   tells the posts from outside the services' own code, made by the event
+   checkers, the timers and the interrupt responses, from those that the
+   services make to each other
+ Notes
+   a post from an interrupt handler that breaks in on a run function is
+   an input too
+ Author
+   ags, 10/20/26 04:23
+****************************************************************************/
+bool ES_PostIsInput(void)
+{
+  return (InServiceCode == false) || (_HW_InInterrupt() == true);
+}
+#endif
+
+#ifdef _INCLUDE_RUN_BUDGETS_
+/****************************************************************************
+ Function
+   ES_GetOverrunStats
+ Parameters
+   uint8_t : Which service to report on (index into ServDescList)
+   ES_OverrunStats_t * : where to copy its overrun statistics
+ Returns
+   boolean : False if the service does not exist
+ Description
+   copies the count of the service's runs over its SERV_n_BUDGET, with the
+   longest of them and the events that caused the longest and the latest
+ Notes
+   the event types are ES_NO_EVENT if there have been no overruns
+ Author
+   ags, 10/20/26 03:31
+****************************************************************************/
+bool ES_GetOverrunStats(uint8_t WhichService, ES_OverrunStats_t *pStats)
+{
+  if (WhichService >= ARRAY_SIZE(OverrunStats))
+  {
+    return false;
+  }
+  *pStats = OverrunStats[WhichService];
+  return true;
+}
+
+/****************************************************************************
+ Function
+   ES_ResetOverrunStats
+ Parameters
+   None
+ Returns
+   None
+ Description
+   clears the overrun statistics of every service
+ Author
+   ags, 10/20/26 03:32
+****************************************************************************/
+void ES_ResetOverrunStats(void)
+{
+  uint8_t i;
+
+  for (i = 0; i < ARRAY_SIZE(OverrunStats); i++)
+  {
+    OverrunStats[i].Count     = 0;
+    OverrunStats[i].WorstTime = 0;
+    OverrunStats[i].WorstType = ES_NO_EVENT;
+    OverrunStats[i].LastType  = ES_NO_EVENT;
+  }
+}
+#endif /* _INCLUDE_RUN_BUDGETS_ */
+
 //*********************************
 // private functions
 //*********************************
@@ -472,5 +1274,133 @@ static bool CheckSystemEvents(void)
 }
 
 #endif
+
+#ifdef _INCLUDE_LATENCY_STATS_
+/****************************************************************************
+ Function
+   DeQueueAndRecord
+ Parameters
+   uint8_t : the service whose queue to take the next event from
+   ES_Event_t * : used to return the event
+ Returns
+   uint8_t : the number of events left in the queue
+ Description
+   takes the next event off a service's queue, recording the time since it
+   was posted in the service's latency histogram
+ Author
+   ags, 10/19/26 23:58
+****************************************************************************/
+static uint8_t DeQueueAndRecord(uint8_t WhichService, ES_Event_t *pEvent)
+{
+  uint16_t  Stamp;
+  uint8_t   NumLeft;
+
+  NumLeft = ES_DeQueueStamped(EventQueues[WhichService].pMem,
+      QueueStamps[WhichService], pEvent, &Stamp);
+  if (pEvent->EventType != ES_NO_EVENT)
+  {
+    ES_Latency_Record(WhichService, (uint16_t)(ES_Latency_Now() - Stamp));
+  }
+  return NumLeft;
+}
+
+#endif /* _INCLUDE_LATENCY_STATS_ */
+
+#ifdef _INCLUDE_TRACE_
+/****************************************************************************
+ Function
+   TraceMask
+ Parameters
+   ES_TraceKind_t : the kind of record
+   uint16_t : the services to make a record for, as a bit mask
+   ES_Event_t : the event posted
+ Returns
+   nothing
+ Description
+   makes a trace record of the event for each of the services in the mask
+ Author
+   ags, 10/20/26 00:40
+****************************************************************************/
+static void TraceMask(ES_TraceKind_t Kind, uint16_t Services,
+    ES_Event_t ThisEvent)
+{
+  uint8_t ThisService;
+
+  while (Services != 0)
+  {
+    ThisService = ES_GetMSBitSet(Services);
+    ES_Trace_Record(Kind, ThisService, ThisEvent);
+    Services &= BitNum2ClrMask[ThisService];
+  }
+}
+
+#endif /* _INCLUDE_TRACE_ */
+
+#ifdef _INCLUDE_RUN_BUDGETS_
+/****************************************************************************
+ Function
+   CheckBudget
+ Parameters
+   uint8_t : the service whose run function has returned
+   ES_EventType_t : the type of the event it was given
+   uint32_t : the time the run took, in uS
+ Returns
+   nothing
+ Description
+   if the run went over the service's budget, records the overrun and
+   reports it with an ES_OVERRUN event to OVERRUN_POST_FUNC
+ Notes
+   an overrun while handling an ES_OVERRUN is recorded but not reported,
+   so that a slow supervisor can not keep reporting itself
+ Author
+   ags, 10/20/26 03:34
+****************************************************************************/
+static void CheckBudget(uint8_t WhichService, ES_EventType_t WhichType,
+    uint32_t RunTime)
+{
+  ES_OverrunStats_t *pStats;
+
+  if ((RunBudget[WhichService] == 0) || (RunTime <= RunBudget[WhichService]))
+  {
+    return;
+  }
+  pStats = &OverrunStats[WhichService];
+  pStats->Count++;
+  pStats->LastType = WhichType;
+  if (RunTime > pStats->WorstTime)
+  {
+    pStats->WorstTime = RunTime;
+    pStats->WorstType = WhichType;
+  }
+#ifdef OVERRUN_POST_FUNC
+  if (WhichType != ES_OVERRUN)
+  {
+    ES_Event_t Report;
+
+    Report.EventType  = ES_OVERRUN;
+    Report.EventParam = ((uint16_t)WhichService << 8) | (uint8_t)WhichType;
+    OVERRUN_POST_FUNC(Report);
+  }
+#endif
+}
+#endif /* _INCLUDE_RUN_BUDGETS_ */
+
+#ifdef _INCLUDE_EVENT_REPLAY_
+/****************************************************************************
+ Function
+   QueueDepth
+ Parameters
+   uint8_t : the service whose queue to look at
+ Returns
+   uint8_t : the number of events in its queue
+ Author
+   ags, 10/20/26 04:25
+****************************************************************************/
+static uint8_t QueueDepth(uint8_t WhichService)
+{
+  return (EventQueues[WhichService].Size - 1) -
+         ES_QueueSpace(EventQueues[WhichService].pMem);
+}
+#endif /* _INCLUDE_EVENT_REPLAY_ */
 /*------------------------------- Footnotes -------------------------------*/
 /*------------------------------ End of file ------------------------------*/
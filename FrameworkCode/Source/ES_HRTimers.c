@@ -0,0 +1,372 @@
+/****************************************************************************
+ Module
+     ES_HRTimers.c
+
+ Description
+     This is a module implementing 16 high resolution (1uS) one-shot timers
+     all multiplexed onto a single free-running 32 bit hardware timer.
+
+ Notes
+     Each active timer holds an absolute deadline on the free-running uS
+     count. The hardware compare (match) register is always programmed with
+     the earliest active deadline, so there is only ever one interrupt
+     pending no matter how many timers are running. When the match
+     interrupt fires, every timer whose deadline has passed is expired and
+     the match is re-programmed for the next earliest deadline.
+     All of the hardware specific code lives in ES_Port.c (or the host port)
+     behind the _HW_HRTimer_xxx functions.
+     Deadlines are compared using signed differences so that the wrap of
+     the 32 bit count (every 71 minutes) is handled correctly, this limits
+     a single timeout to HR_TIMER_MAX_TIME (2^31 - 1 uS, about 35 minutes).
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/20/26 06:50 ags     refuse times longer than HR_TIMER_MAX_TIME
+ 10/20/26 00:31 ags     trace the expirations with _INCLUDE_TRACE_
+ 10/19/26 09:20 ags     Began Coding, replaces the 2 channel ES_ShortTimer
+****************************************************************************/
+
+/*----------------------------- Include Files -----------------------------*/
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_ServiceHeaders.h"
+#include "ES_General.h"
+#include "ES_Events.h"
+#include "ES_PostList.h"
+#include "ES_LookupTables.h"
+#include "ES_HRTimers.h"
+#include "ES_Trace.h"
+#include "ES_Port.h"
+/*--------------------------- External Variables --------------------------*/
+
+/*----------------------------- Module Defines ----------------------------*/
+
+/*------------------------------ Module Types -----------------------------*/
+/*
+   the size of HRTflag sets the number of timers, as in ES_Timers.c
+*/
+typedef uint16_t HRTflag_t;
+
+/*---------------------------- Module Functions ---------------------------*/
+static void ProgramNextMatch(uint32_t Now);
+static void PostHRTimeout(uint8_t Num);
+
+/*---------------------------- Module Variables ---------------------------*/
+// the durations as set by SetTimer/InitTimer, used by StartTimer
+static uint32_t HRT_TimeArray[sizeof(HRTflag_t) * BITS_PER_BYTE];
+// the absolute deadlines of the active timers on the free-running count
+static uint32_t HRT_DeadlineArray[sizeof(HRTflag_t) * BITS_PER_BYTE];
+
+static volatile HRTflag_t HRT_ActiveFlags;
+
+static pPostFunc const HRTimer2PostFunc[sizeof(HRTflag_t) * BITS_PER_BYTE] =
+{
+  HRTIMER0_RESP_FUNC,
+  HRTIMER1_RESP_FUNC,
+  HRTIMER2_RESP_FUNC,
+  HRTIMER3_RESP_FUNC,
+  HRTIMER4_RESP_FUNC,
+  HRTIMER5_RESP_FUNC,
+  HRTIMER6_RESP_FUNC,
+  HRTIMER7_RESP_FUNC,
+  HRTIMER8_RESP_FUNC,
+  HRTIMER9_RESP_FUNC,
+  HRTIMER10_RESP_FUNC,
+  HRTIMER11_RESP_FUNC,
+  HRTIMER12_RESP_FUNC,
+  HRTIMER13_RESP_FUNC,
+  HRTIMER14_RESP_FUNC,
+  HRTIMER15_RESP_FUNC
+};
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+     ES_HRTimer_Init
+ Parameters
+     None.
+ Returns
+     None.
+ Description
+     Initializes the high resolution timer module and starts the free-running
+     hardware count.
+ Notes
+     Called from ES_Initialize when _INCLUDE_HR_TIMERS_ is defined
+ Author
+     ags, 10/19/26 09:24
+****************************************************************************/
+void ES_HRTimer_Init(void)
+{
+  HRT_ActiveFlags = 0;
+  // call the hardware init routine
+  _HW_HRTimer_Init();
+}
+
+/****************************************************************************
+ Function
+     ES_HRTimer_SetTimer
+ Parameters
+     uint8_t Num, the number of the timer to set.
+     uint32_t NewTime, the new time (in uS) to set on that timer
+ Returns
+     ES_Timer_ERR if requested timer does not exist, has no service or
+                  NewTime is 0 or longer than HR_TIMER_MAX_TIME
+     ES_Timer_OK  otherwise
+ Description
+     sets the time for a timer, but does not make it active.
+ Notes
+     NewTime is limited to HR_TIMER_MAX_TIME because the deadlines are
+     compared as signed 32 bit differences.
+ Author
+     ags, 10/19/26 09:27
+****************************************************************************/
+ES_TimerReturn_t ES_HRTimer_SetTimer(uint8_t Num, uint32_t NewTime)
+{
+  /* tried to set a timer that doesn't exist */
+  if ((Num >= ARRAY_SIZE(HRT_TimeArray)) ||
+      /* tried to set a timer without a service */
+      (HRTimer2PostFunc[Num] == TIMER_UNUSED) ||
+      (NewTime == 0) ||   /* no time being set */
+      /* too long to compare as a signed difference */
+      (NewTime > HR_TIMER_MAX_TIME))
+  {
+    return ES_Timer_ERR;
+  }
+  HRT_TimeArray[Num] = NewTime;
+  return ES_Timer_OK;
+}
+
+/****************************************************************************
+ Function
+     ES_HRTimer_StartTimer
+ Parameters
+     uint8_t Num the number of the timer to start
+ Returns
+     ES_Timer_ERR for error ES_Timer_OK for success
+ Description
+     (re)starts a timer using the time last set with SetTimer or InitTimer,
+     measured from now.
+ Notes
+     None.
+ Author
+     ags, 10/19/26 09:30
+****************************************************************************/
+ES_TimerReturn_t ES_HRTimer_StartTimer(uint8_t Num)
+{
+  /* tried to set a timer that doesn't exist */
+  if ((Num >= ARRAY_SIZE(HRT_TimeArray)) ||
+      /* tried to set a timer with no time on it */
+      (HRT_TimeArray[Num] == 0))
+  {
+    return ES_Timer_ERR;
+  }
+  /* very short timeouts are simply posted, the hardware is not touched */
+  if (HRT_TimeArray[Num] < HR_TIMER_MIN_TIME)
+  {
+    EnterCritical();
+    HRT_ActiveFlags &= BitNum2ClrMask[Num];
+    ProgramNextMatch(_HW_HRTimer_GetCount());
+    ExitCritical();
+    PostHRTimeout(Num);
+    return ES_Timer_OK;
+  }
+  EnterCritical();
+  HRT_DeadlineArray[Num] = _HW_HRTimer_GetCount() + HRT_TimeArray[Num];
+  HRT_ActiveFlags |= BitNum2SetMask[Num];  /* set timer as active */
+  ProgramNextMatch(_HW_HRTimer_GetCount());
+  ExitCritical();
+  return ES_Timer_OK;
+}
+
+/****************************************************************************
+ Function
+     ES_HRTimer_StopTimer
+ Parameters
+     uint8_t Num the number of the timer to stop.
+ Returns
+     ES_Timer_ERR for error (timer doesn't exist) ES_Timer_OK for success.
+ Description
+     clears the bit in HRT_ActiveFlags associated with this timer and moves
+     the hardware match on to the next active deadline, if any
+ Notes
+     None.
+ Author
+     ags, 10/19/26 09:34
+****************************************************************************/
+ES_TimerReturn_t ES_HRTimer_StopTimer(uint8_t Num)
+{
+  if (Num >= ARRAY_SIZE(HRT_TimeArray))
+  {
+    return ES_Timer_ERR;    /* tried to stop a timer that doesn't exist */
+  }
+  EnterCritical();
+  HRT_ActiveFlags &= BitNum2ClrMask[Num];  /* set timer as inactive */
+  ProgramNextMatch(_HW_HRTimer_GetCount());
+  ExitCritical();
+  return ES_Timer_OK;
+}
+
+/****************************************************************************
+ Function
+     ES_HRTimer_InitTimer
+ Parameters
+     uint8_t Num, the number of the timer to start
+     uint32_t NewTime, the number of uS to be counted
+ Returns
+     ES_Timer_ERR if the requested timer does not exist or NewTime is out of
+     range (see ES_HRTimer_SetTimer), ES_Timer_OK otherwise.
+ Description
+     sets the NewTime into the chosen timer and sets the timer active to
+     begin counting.
+ Notes
+     None.
+ Author
+     ags, 10/19/26 09:36
+****************************************************************************/
+ES_TimerReturn_t ES_HRTimer_InitTimer(uint8_t Num, uint32_t NewTime)
+{
+  if (ES_HRTimer_SetTimer(Num, NewTime) != ES_Timer_OK)
+  {
+    return ES_Timer_ERR;
+  }
+  return ES_HRTimer_StartTimer(Num);
+}
+
+/****************************************************************************
+ Function
+     ES_HRTimer_GetTime
+ Parameters
+     None.
+ Returns
+     the current value of the free-running uS count
+ Description
+     Provides the ability to grab a high resolution snapshot time. Can be
+     used to determine how long between 2 events.
+ Notes
+     wraps every 2^32 uS (about 71 minutes)
+ Author
+     ags, 10/19/26 09:38
+****************************************************************************/
+uint32_t ES_HRTimer_GetTime(void)
+{
+  return _HW_HRTimer_GetCount();
+}
+
+/****************************************************************************
+ Function
+     ES_HRTimer_Match_Resp
+ Parameters
+     None.
+ Returns
+     None.
+ Description
+     This is the response routine to the hardware match interrupt. It checks
+     through the active timers, expiring every timer whose deadline has
+     passed and posting an ES_SHORT_TIMEOUT event to the corresponding
+     service. It then programs the match for the next earliest deadline.
+ Notes
+     Called from the match interrupt handler in ES_Port.c, so this runs at
+     interrupt level (as did the ES_ShortTimer handlers).
+ Author
+     ags, 10/19/26 09:42
+****************************************************************************/
+void ES_HRTimer_Match_Resp(void)
+{
+  HRTflag_t NeedsProcessing;
+  uint8_t   NextTimer2Process;
+  uint32_t  Now;
+
+  Now = _HW_HRTimer_GetCount();
+  // start by getting a list of all the active timers
+  NeedsProcessing = HRT_ActiveFlags;
+  while (NeedsProcessing != 0)
+  {
+    // find the MSB that is set
+    NextTimer2Process = ES_GetMSBitSet(NeedsProcessing);
+    /* has this deadline passed? */
+    if ((int32_t)(HRT_DeadlineArray[NextTimer2Process] - Now) <= 0)
+    {
+      /* stop counting, then post the timeout event to the right Service */
+      HRT_ActiveFlags &= BitNum2ClrMask[NextTimer2Process];
+      PostHRTimeout(NextTimer2Process);
+    }
+    // mark off the active timer that we just processed
+    NeedsProcessing &= BitNum2ClrMask[NextTimer2Process];
+  }
+  ProgramNextMatch(Now);
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+/****************************************************************************
+ Function
+     ProgramNextMatch
+ Parameters
+     uint32_t Now, the current free-running count
+ Returns
+     None.
+ Description
+     finds the earliest deadline among the active timers and programs it
+     into the hardware match, or disables the match if no timers are active
+ Notes
+     must be called with interrupts disabled or from the match interrupt.
+     _HW_HRTimer_SetMatch takes care of a deadline that has already passed
+ Author
+     ags, 10/19/26 09:47
+****************************************************************************/
+static void ProgramNextMatch(uint32_t Now)
+{
+  HRTflag_t ActiveTimers = HRT_ActiveFlags;
+  uint8_t   ThisTimer;
+  int32_t   Remaining;
+  int32_t   Earliest = INT32_MAX;
+  uint32_t  NextDeadline = 0;
+
+  if (ActiveTimers == 0)
+  {
+    _HW_HRTimer_DisableMatch();
+    return;
+  }
+  do
+  {
+    ThisTimer = ES_GetMSBitSet(ActiveTimers);
+    Remaining = (int32_t)(HRT_DeadlineArray[ThisTimer] - Now);
+    if (Remaining < Earliest)
+    {
+      Earliest      = Remaining;
+      NextDeadline  = HRT_DeadlineArray[ThisTimer];
+    }
+    ActiveTimers &= BitNum2ClrMask[ThisTimer];
+  } while (ActiveTimers != 0);
+  _HW_HRTimer_SetMatch(NextDeadline);
+}
+
+/****************************************************************************
+ Function
+     PostHRTimeout
+ Parameters
+     uint8_t Num, the timer that expired
+ Returns
+     None.
+ Description
+     posts ES_SHORT_TIMEOUT, with the timer number as the parameter, using
+     the response function configured for this timer
+ Author
+     ags, 10/19/26 09:50
+****************************************************************************/
+static void PostHRTimeout(uint8_t Num)
+{
+  ES_Event_t NewEvent;
+
+  NewEvent.EventType  = ES_SHORT_TIMEOUT;
+  NewEvent.EventParam = Num;
+#ifdef _INCLUDE_TRACE_
+  ES_Trace_Record(ES_TRACE_TIMEOUT, 0, NewEvent);
+#endif
+  HRTimer2PostFunc[Num](NewEvent);
+}
+
+/*------------------------------- Footnotes -------------------------------*/
+/*------------------------------ End of file ------------------------------*/
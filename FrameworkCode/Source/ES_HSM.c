@@ -0,0 +1,1020 @@
+/****************************************************************************
+ Module
+     ES_HSM.c
+
+ Description
+     This is a module implementing a table driven hierarchical state machine
+     engine, to replace the nested switch statements of HSMTemplate.c with
+     const tables that the engine walks.
+
+ Notes
+     An event is offered to the active leaf state first, then to each of its
+     ancestors in turn, until one of them consumes it or takes a transition
+     on it. At each level the state's during function (if any) is run first,
+     and may re-map or consume the event, then its transitions are searched
+     for the first one on the event type whose guard passes.
+     A transition exits from the active leaf up to, but not including, the
+     LCA of the transition, runs the transition action, enters from below
+     the LCA down to the target and then follows the InitialChild links down
+     to a leaf. All of the walks are loops over the Parent links, so the
+     stack used does not grow with the depth of the machine.
+     A transition is external: if the target contains the source, or the
+     source contains the target, the outer one is exited and re-entered.
+     With orthogonal regions, the regions are run in the order of their
+     numbers, so the regions of an orthogonal state each get the event, in
+     order, before the orthogonal state does. Each region is given the
+     event as it came to the orthogonal state. The orthogonal state then
+     gets ES_NO_EVENT if any of its regions consumed the event or took a
+     transition on it, otherwise the event as re-mapped by the first region
+     to re-map it, otherwise the event itself. A transition out of a region
+     ends the processing of the event, since the other regions have been
+     left too. A transition may not go from one region to another of the
+     same orthogonal state.
+     ActiveDeferMask holds the DeferMasks of all of the active states, so
+     whether an event is to be deferred is one bit test. It is worked out
+     again after each transition, and the types that are no longer deferred
+     are recalled, to the front of the owner's queue, in the order that
+     they were deferred.
+     A state keeping history has its own slot in History, written as the
+     state is exited with the deepest active state in its region. A region
+     being exited likewise saves its deepest active state in RegionHistory,
+     so the state of every region below a state keeping deep history is
+     still there when the state resumes. Resuming enters the saved path in
+     one walk down, rather than going through each level's defaults, and
+     passes ES_ENTRY_HISTORY, with the triggering event's parameter, to the
+     entry functions from the resumed state down, so that they can tell a
+     resumption from a fresh entry.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/20/26 06:27 ags     added ES_HSM_IsDeferring, so that the caller can tell
+                        a full deferral queue from an unused event
+ 10/20/26 05:10 ags     the top region's re-mapped flag is cleared for each
+                        event along with the others
+ 10/19/26 22:44 ags     added shallow and deep history
+ 10/19/26 22:24 ags     added per-state event deferral
+ 10/19/26 21:45 ags     added orthogonal regions
+ 10/19/26 21:07 ags     states with an event map index straight to the
+                        transitions on the event type
+ 10/19/26 20:22 ags     Began Coding
+****************************************************************************/
+
+/*----------------------------- Include Files -----------------------------*/
+#include "ES_Configure.h"
+#include "ES_General.h"
+#include "ES_DeferRecall.h"
+#include "ES_HSM.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+// a machine without orthogonal states may give NumRegions as 0 or 1
+#define TOP_REGION(pHSM) \
+  (((pHSM)->pDesc->NumRegions > 1) ? ((pHSM)->pDesc->NumRegions - 1) : 0)
+
+/*---------------------------- Module Functions ---------------------------*/
+static ES_Event_t RunRegion(ES_HSM_t *pHSM, uint8_t Region,
+    ES_Event_t ThisEvent, bool *pLeftRegion);
+static const ES_HSMTransition_t *FindTransition(
+    const ES_HSMStateDesc_t *pState, ES_Event_t ThisEvent);
+static ES_HSMState_t TakeTransition(ES_HSM_t *pHSM, ES_HSMState_t Source,
+    const ES_HSMTransition_t *pTransition, ES_Event_t ThisEvent);
+static ES_HSMState_t FindLca(const ES_HSMStateDesc_t *pStates,
+    ES_HSMState_t Source, ES_HSMState_t Target);
+static void ExitUpTo(ES_HSM_t *pHSM, ES_HSMState_t From, ES_HSMState_t Lca,
+    ES_Event_t ThisEvent);
+static void ExitRegions(ES_HSM_t *pHSM, uint8_t First, uint8_t Last,
+    ES_Event_t ThisEvent);
+static void EnterDownFrom(ES_HSM_t *pHSM, ES_HSMState_t Lca,
+    ES_HSMState_t Target, ES_Event_t ThisEvent);
+static void EnterDefaults(ES_HSM_t *pHSM, ES_HSMState_t State,
+    ES_Event_t ThisEvent);
+static void EnterHistory(ES_HSM_t *pHSM, ES_HSMState_t State,
+    ES_HSMState_t Leaf, bool Deep, ES_Event_t ThisEvent);
+static uint8_t RegionOf(const ES_HSM_t *pHSM, ES_HSMState_t State);
+static bool IsRegionState(const ES_HSMStateDesc_t *pStates,
+    ES_HSMState_t State);
+static uint8_t OuterRegion(const ES_HSM_t *pHSM, uint8_t Region);
+static uint32_t FindDeferMask(const ES_HSM_t *pHSM);
+static void UpdateDeferral(ES_HSM_t *pHSM);
+
+/*---------------------------- Module Variables ---------------------------*/
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+     ES_HSM_SetDeferralQueue
+ Parameters
+     ES_HSM_t *pHSM, the machine
+     ES_Event_t *pDeferQueue, a queue set up with ES_InitDeferralQueueWith
+     uint8_t Owner, the priority of the service that runs the machine, to
+       recall the events to
+ Returns
+     None.
+ Description
+     gives the machine a queue to hold the events that its states defer
+ Notes
+     call it before ES_HSM_Start. Without a queue, the DeferMasks are
+     ignored.
+ Author
+     ags, 10/19/26 22:26
+****************************************************************************/
+void ES_HSM_SetDeferralQueue(ES_HSM_t *pHSM, ES_Event_t *pDeferQueue,
+    uint8_t Owner)
+{
+  pHSM->pDeferQueue = pDeferQueue;
+  pHSM->Owner       = Owner;
+}
+
+/****************************************************************************
+ Function
+     ES_HSM_Start
+ Parameters
+     ES_HSM_t *pHSM, the machine to start
+     const ES_HSMDesc_t *pDesc, the table describing the machine
+     ES_Event_t EntryEvent, passed to the entry functions, ES_ENTRY or
+       ES_ENTRY_HISTORY
+ Returns
+     None.
+ Description
+     with ES_ENTRY, clears the history and enters the initial state of the
+     machine and its default substates, down to a leaf in every region.
+     With ES_ENTRY_HISTORY, if the machine was started before with the same
+     table, enters again the states that were active, as HSMTemplate.c
+     does.
+ Notes
+     any state that was active before is not exited
+ Author
+     ags, 10/19/26 20:24
+****************************************************************************/
+void ES_HSM_Start(ES_HSM_t *pHSM, const ES_HSMDesc_t *pDesc,
+    ES_Event_t EntryEvent)
+{
+  ES_HSMState_t Leaf;
+  uint8_t       Region;
+  uint8_t       Slot;
+
+  if ((EntryEvent.EventType == ES_ENTRY_HISTORY) && (pHSM->pDesc == pDesc))
+  {
+    // the deepest active states become the history to resume
+    Leaf = pHSM->Current[TOP_REGION(pHSM)];
+    for (Region = 0; Region < ARRAY_SIZE(pHSM->Current); Region++)
+    {
+      pHSM->RegionHistory[Region] = pHSM->Current[Region];
+      pHSM->Current[Region]       = ES_HSM_NO_STATE;
+    }
+    pHSM->Current[TOP_REGION(pHSM)] = ES_HSM_ROOT;
+    EnterHistory(pHSM, ES_HSM_ROOT, Leaf, true, EntryEvent);
+  }
+  else
+  {
+    pHSM->pDesc = pDesc;
+    for (Region = 0; Region < ARRAY_SIZE(pHSM->Current); Region++)
+    {
+      pHSM->Current[Region]       = ES_HSM_NO_STATE;
+      pHSM->RegionHistory[Region] = ES_HSM_NO_STATE;
+    }
+    for (Slot = 0; Slot < ARRAY_SIZE(pHSM->History); Slot++)
+    {
+      pHSM->History[Slot] = ES_HSM_NO_STATE;
+    }
+    pHSM->Current[TOP_REGION(pHSM)] = ES_HSM_ROOT;
+    EnterDownFrom(pHSM, ES_HSM_ROOT, pDesc->InitialState, EntryEvent);
+  }
+  pHSM->ActiveDeferMask = FindDeferMask(pHSM);
+}
+
+/****************************************************************************
+ Function
+     ES_HSM_Run
+ Parameters
+     ES_HSM_t *pHSM, the machine to run
+     ES_Event_t ThisEvent, the event to process
+ Returns
+     ES_Event_t, ES_NO_EVENT if the event was consumed, otherwise the event
+     (possibly re-mapped by a during function) for the caller to deal with
+ Description
+     offers the event to the active leaf state and then to its ancestors,
+     taking the first transition found, in each active region in turn
+ Notes
+     a taken transition consumes the event, as does deferring it. If the
+     deferral queue is full, the event is returned.
+ Author
+     ags, 10/19/26 20:28
+****************************************************************************/
+ES_Event_t ES_HSM_Run(ES_HSM_t *pHSM, ES_Event_t ThisEvent)
+{
+  // the event for the deepest state in each region, combined from the
+  // results of its regions if it is an orthogonal state
+  ES_Event_t  RegionEvent[ES_HSM_MAX_REGIONS];
+  bool        Remapped[ES_HSM_MAX_REGIONS];
+  ES_Event_t  Result;
+  bool        LeftRegion;
+  uint8_t     Region;
+  uint8_t     Outer;
+
+  if (ES_HSM_IsDeferring(pHSM, ThisEvent.EventType) == true)
+  {
+    if (ES_DeferEvent(pHSM->pDeferQueue, ThisEvent) == true)
+    {
+      ThisEvent.EventType = ES_NO_EVENT;
+    }
+    return ThisEvent;
+  }
+
+  for (Region = 0; Region <= TOP_REGION(pHSM); Region++)
+  {
+    RegionEvent[Region] = ThisEvent;
+    Remapped[Region]    = false;
+  }
+
+  for (Region = 0; Region < TOP_REGION(pHSM); Region++)
+  {
+    if (pHSM->Current[Region] == ES_HSM_NO_STATE)
+    {
+      continue;   // not in the orthogonal state that holds this region
+    }
+    Result = RunRegion(pHSM, Region, RegionEvent[Region], &LeftRegion);
+    if (LeftRegion == true)
+    {
+      return Result;
+    }
+    // combine the result into the event for the orthogonal state
+    Outer = OuterRegion(pHSM, Region);
+    if (RegionEvent[Outer].EventType == ES_NO_EVENT)
+    {
+      // already consumed by an earlier region
+    }
+    else if (Result.EventType == ES_NO_EVENT)
+    {
+      RegionEvent[Outer] = Result;
+    }
+    else if ((Remapped[Outer] == false) &&
+        ((Result.EventType != ThisEvent.EventType) ||
+        (Result.EventParam != ThisEvent.EventParam)))
+    {
+      RegionEvent[Outer]  = Result;
+      Remapped[Outer]     = true;
+    }
+  }
+  return RunRegion(pHSM, Region, RegionEvent[Region], &LeftRegion);
+}
+
+/****************************************************************************
+ Function
+     ES_HSM_GetState
+ Parameters
+     const ES_HSM_t *pHSM, the machine to query
+ Returns
+     ES_HSMState_t, the active leaf state at the top level, or the
+     orthogonal state, if the machine is in one
+ Author
+     ags, 10/19/26 20:30
+****************************************************************************/
+ES_HSMState_t ES_HSM_GetState(const ES_HSM_t *pHSM)
+{
+  return pHSM->Current[TOP_REGION(pHSM)];
+}
+
+/****************************************************************************
+ Function
+     ES_HSM_GetRegionState
+ Parameters
+     const ES_HSM_t *pHSM, the machine to query
+     uint8_t Region, the region
+ Returns
+     ES_HSMState_t, the deepest active state in the region, ES_HSM_NO_STATE
+     if the region is not active
+ Author
+     ags, 10/19/26 21:47
+****************************************************************************/
+ES_HSMState_t ES_HSM_GetRegionState(const ES_HSM_t *pHSM, uint8_t Region)
+{
+  if (Region > TOP_REGION(pHSM))
+  {
+    return ES_HSM_NO_STATE;
+  }
+  return pHSM->Current[Region];
+}
+
+/****************************************************************************
+ Function
+     ES_HSM_IsIn
+ Parameters
+     const ES_HSM_t *pHSM, the machine to query
+     ES_HSMState_t State, the state to test for
+ Returns
+     bool, true if State is active, that is it is the deepest active state
+     in a region or one of its ancestors
+ Author
+     ags, 10/19/26 20:31
+****************************************************************************/
+bool ES_HSM_IsIn(const ES_HSM_t *pHSM, ES_HSMState_t State)
+{
+  ES_HSMState_t ThisState;
+  uint8_t       Region;
+
+  for (Region = 0; Region <= TOP_REGION(pHSM); Region++)
+  {
+    ThisState = pHSM->Current[Region];
+    if (ThisState == ES_HSM_NO_STATE)
+    {
+      continue;
+    }
+    while (ThisState != ES_HSM_ROOT)
+    {
+      if (ThisState == State)
+      {
+        return true;
+      }
+      ThisState = pHSM->pDesc->pStates[ThisState].Parent;
+    }
+  }
+  return false;
+}
+
+/****************************************************************************
+ Function
+     ES_HSM_IsDeferring
+ Parameters
+     const ES_HSM_t *pHSM, the machine to query
+     ES_EventType_t EventType, the type to test for
+ Returns
+     bool, true if an active state defers EventType and the machine has a
+     deferral queue
+ Notes
+     an event of a deferred type that ES_HSM_Run hands back did not fit in
+     the deferral queue
+ Author
+     ags, 10/20/26 06:27
+****************************************************************************/
+bool ES_HSM_IsDeferring(const ES_HSM_t *pHSM, ES_EventType_t EventType)
+{
+  return (pHSM->pDeferQueue != 0) && (EventType < 32) &&
+      ((pHSM->ActiveDeferMask & ES_TYPE_MASK(EventType)) != 0);
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+/****************************************************************************
+ Function
+     RunRegion
+ Parameters
+     ES_HSM_t *pHSM, the machine
+     uint8_t Region, the region to run
+     ES_Event_t ThisEvent, the event for the deepest state in the region
+     bool *pLeftRegion, set true if a transition left the region
+ Returns
+     ES_Event_t, the event after the region has processed it
+ Description
+     offers the event to the deepest active state of the region and then to
+     its ancestors, up to the state for the region (or the top level)
+ Author
+     ags, 10/19/26 21:50
+****************************************************************************/
+static ES_Event_t RunRegion(ES_HSM_t *pHSM, uint8_t Region,
+    ES_Event_t ThisEvent, bool *pLeftRegion)
+{
+  const ES_HSMStateDesc_t   *pStates = pHSM->pDesc->pStates;
+  const ES_HSMTransition_t  *pTransition;
+  ES_HSMState_t             Source = pHSM->Current[Region];
+  ES_HSMState_t             Lca;
+
+  *pLeftRegion = false;
+  while ((Source != ES_HSM_ROOT) && (ThisEvent.EventType != ES_NO_EVENT))
+  {
+    if (pStates[Source].During != 0)
+    {
+      ThisEvent = pStates[Source].During(ThisEvent);
+      if (ThisEvent.EventType == ES_NO_EVENT)
+      {
+        break;    // consumed
+      }
+    }
+    pTransition = FindTransition(&pStates[Source], ThisEvent);
+    if (pTransition != 0)
+    {
+      Lca = TakeTransition(pHSM, Source, pTransition, ThisEvent);
+      *pLeftRegion = (RegionOf(pHSM, Lca) != Region);
+      ThisEvent.EventType = ES_NO_EVENT;
+      break;
+    }
+    if (IsRegionState(pStates, Source) == true)
+    {
+      break;      // the rest is up to the orthogonal state
+    }
+    Source = pStates[Source].Parent;
+  }
+  return ThisEvent;
+}
+
+/****************************************************************************
+ Function
+     FindTransition
+ Parameters
+     const ES_HSMStateDesc_t *pState, the state to search
+     ES_Event_t ThisEvent, the event
+ Returns
+     const ES_HSMTransition_t *, the first transition on the event type
+     whose guard passes, 0 if none
+ Notes
+     with an event map, only the transitions on the event type are looked
+     at, otherwise all of the state's transitions are searched
+ Author
+     ags, 10/19/26 20:33
+****************************************************************************/
+static const ES_HSMTransition_t *FindTransition(
+    const ES_HSMStateDesc_t *pState, ES_Event_t ThisEvent)
+{
+  const ES_HSMTransition_t  *pTransition = pState->pTransitions;
+  uint8_t                   i = 0;
+
+  if (pState->pEventMap != 0)
+  {
+    if ((ThisEvent.EventType >= ES_NUM_EVENT_TYPES) ||
+        (pState->pEventMap[ThisEvent.EventType] == 0))
+    {
+      return 0;
+    }
+    i = pState->pEventMap[ThisEvent.EventType] - 1;
+    pTransition += i;
+    for ( ; (i < pState->NumTransitions) &&
+          (pTransition->EventType == ThisEvent.EventType);
+          i++, pTransition++)
+    {
+      if ((pTransition->Guard == 0) || (pTransition->Guard(ThisEvent) == true))
+      {
+        return pTransition;
+      }
+    }
+    return 0;
+  }
+
+  for ( ; i < pState->NumTransitions; i++, pTransition++)
+  {
+    if ((pTransition->EventType == ThisEvent.EventType) &&
+        ((pTransition->Guard == 0) || (pTransition->Guard(ThisEvent) == true)))
+    {
+      return pTransition;
+    }
+  }
+  return 0;
+}
+
+/****************************************************************************
+ Function
+     TakeTransition
+ Parameters
+     ES_HSM_t *pHSM, the machine
+     ES_HSMState_t Source, the state that the transition belongs to
+     const ES_HSMTransition_t *pTransition, the transition to take
+     ES_Event_t ThisEvent, the triggering event
+ Returns
+     ES_HSMState_t, the LCA of the transition, the Source for an internal
+     transition
+ Description
+     runs the exit functions from the leaf up to the LCA, the transition
+     action, then the entry functions down to the new leaf
+ Author
+     ags, 10/19/26 20:36
+****************************************************************************/
+static ES_HSMState_t TakeTransition(ES_HSM_t *pHSM, ES_HSMState_t Source,
+    const ES_HSMTransition_t *pTransition, ES_Event_t ThisEvent)
+{
+  ES_HSMState_t Lca;
+
+  if (pTransition->Target == ES_HSM_INTERNAL)
+  {
+    if (pTransition->Action != 0)
+    {
+      pTransition->Action(ThisEvent);
+    }
+    return Source;
+  }
+
+  Lca = pTransition->Lca;
+  if (Lca == ES_HSM_LCA_AUTO)
+  {
+    Lca = FindLca(pHSM->pDesc->pStates, Source, pTransition->Target);
+  }
+  ExitUpTo(pHSM, pHSM->Current[RegionOf(pHSM, Source)], Lca, ThisEvent);
+
+  if (pTransition->Action != 0)
+  {
+    pTransition->Action(ThisEvent);
+  }
+  EnterDownFrom(pHSM, Lca, pTransition->Target, ThisEvent);
+  UpdateDeferral(pHSM);
+  return Lca;
+}
+
+/****************************************************************************
+ Function
+     FindLca
+ Parameters
+     const ES_HSMStateDesc_t *pStates, the state table
+     ES_HSMState_t Source, the state that the transition belongs to
+     ES_HSMState_t Target, the target of the transition
+ Returns
+     ES_HSMState_t, the deepest state that contains both and is not left
+ Description
+     brings the deeper of the two up to the depth of the other, then walks
+     both up together until they meet
+ Author
+     ags, 10/19/26 20:39
+****************************************************************************/
+static ES_HSMState_t FindLca(const ES_HSMStateDesc_t *pStates,
+    ES_HSMState_t Source, ES_HSMState_t Target)
+{
+  ES_HSMState_t A = Source;
+  ES_HSMState_t B = Target;
+
+  while (pStates[A].Depth > pStates[B].Depth)
+  {
+    A = pStates[A].Parent;
+  }
+  while (pStates[B].Depth > pStates[A].Depth)
+  {
+    B = pStates[B].Parent;
+  }
+  while ((A != B) && (A != ES_HSM_ROOT))
+  {
+    A = pStates[A].Parent;
+    B = pStates[B].Parent;
+  }
+  // the transition is external, so if one contains the other, it is left
+  if (((A == Source) || (A == Target)) && (A != ES_HSM_ROOT))
+  {
+    A = pStates[A].Parent;
+  }
+  return A;
+}
+
+/****************************************************************************
+ Function
+     ExitUpTo
+ Parameters
+     ES_HSM_t *pHSM, the machine
+     ES_HSMState_t From, the deepest active state in the source's region
+     ES_HSMState_t Lca, the state not to exit
+     ES_Event_t ThisEvent, passed to the exit functions
+ Returns
+     None.
+ Description
+     runs the exit functions from the inside out, up to the Lca. The
+     regions of an orthogonal state are all exited before the state itself.
+     The history of each state and region left is saved on the way.
+ Author
+     ags, 10/19/26 21:53
+****************************************************************************/
+static void ExitUpTo(ES_HSM_t *pHSM, ES_HSMState_t From, ES_HSMState_t Lca,
+    ES_Event_t ThisEvent)
+{
+  const ES_HSMStateDesc_t *pStates = pHSM->pDesc->pStates;
+  const ES_HSMStateDesc_t *pState;
+  ES_HSMState_t           ThisState;
+
+  for (ThisState = From; ThisState != Lca; ThisState = pState->Parent)
+  {
+    pState = &pStates[ThisState];
+    if (pState->NumRegions > 0)
+    {
+      ExitRegions(pHSM, pState->SubRegion,
+          pStates[pState->InitialChild + pState->NumRegions - 1].Region,
+          ThisEvent);
+    }
+    if (pState->Exit != 0)
+    {
+      pState->Exit(ThisEvent);
+    }
+    if (pState->History != ES_HSM_HISTORY_NONE)
+    {
+      pHSM->History[pState->HistorySlot] = pHSM->Current[pState->Region];
+    }
+    if (IsRegionState(pStates, ThisState) == true)
+    {
+      pHSM->RegionHistory[pState->Region] = pHSM->Current[pState->Region];
+      pHSM->Current[pState->Region]       = ES_HSM_NO_STATE;
+    }
+  }
+  pHSM->Current[RegionOf(pHSM, Lca)] = Lca;
+}
+
+/****************************************************************************
+ Function
+     ExitRegions
+ Parameters
+     ES_HSM_t *pHSM, the machine
+     uint8_t First, uint8_t Last, the range of regions to exit
+     ES_Event_t ThisEvent, passed to the exit functions
+ Returns
+     None.
+ Description
+     exits every active region in the range, from its deepest state up to
+     its region state, saving the history of the region and of the states
+     in it
+ Notes
+     the regions inside an orthogonal state have consecutive numbers, those
+     nested deeper coming first, so by the time a region's orthogonal state
+     is exited, its own regions have been
+ Author
+     ags, 10/19/26 21:56
+****************************************************************************/
+static void ExitRegions(ES_HSM_t *pHSM, uint8_t First, uint8_t Last,
+    ES_Event_t ThisEvent)
+{
+  const ES_HSMStateDesc_t *pStates = pHSM->pDesc->pStates;
+  ES_HSMState_t           ThisState;
+  uint8_t                 Region;
+
+  for (Region = First; Region <= Last; Region++)
+  {
+    ThisState = pHSM->Current[Region];
+    if (ThisState == ES_HSM_NO_STATE)
+    {
+      continue;
+    }
+    for (;;)
+    {
+      if (pStates[ThisState].Exit != 0)
+      {
+        pStates[ThisState].Exit(ThisEvent);
+      }
+      if (pStates[ThisState].History != ES_HSM_HISTORY_NONE)
+      {
+        pHSM->History[pStates[ThisState].HistorySlot] = pHSM->Current[Region];
+      }
+      if (IsRegionState(pStates, ThisState) == true)
+      {
+        break;
+      }
+      ThisState = pStates[ThisState].Parent;
+    }
+    pHSM->RegionHistory[Region] = pHSM->Current[Region];
+    pHSM->Current[Region]       = ES_HSM_NO_STATE;
+  }
+}
+
+/****************************************************************************
+ Function
+     EnterDownFrom
+ Parameters
+     ES_HSM_t *pHSM, the machine
+     ES_HSMState_t Lca, the state already active, not entered again
+     ES_HSMState_t Target, the state to enter
+     ES_Event_t ThisEvent, passed to the entry functions
+ Returns
+     None.
+ Description
+     runs the entry functions from below the Lca down to the Target, then
+     enters the default substates below the Target, or resumes its history
+     if it keeps history and has been exited before. Any orthogonal state
+     passed through on the way to the Target then has its other regions
+     entered by default.
+ Notes
+     the path from the Lca down to the Target is found by walking up from
+     the Target, so it is collected in a local array first
+ Author
+     ags, 10/19/26 20:43
+****************************************************************************/
+static void EnterDownFrom(ES_HSM_t *pHSM, ES_HSMState_t Lca,
+    ES_HSMState_t Target, ES_Event_t ThisEvent)
+{
+  const ES_HSMStateDesc_t *pStates = pHSM->pDesc->pStates;
+  ES_HSMState_t           Path[ES_HSM_MAX_DEPTH];
+  uint8_t                 PathLength = 0;
+  ES_HSMState_t           Orthogonal[ES_HSM_MAX_DEPTH];
+  uint8_t                 NumOrthogonal = 0;
+  ES_HSMState_t           ThisState;
+  ES_HSMState_t           RegionState;
+  ES_HSMState_t           Leaf = ES_HSM_NO_STATE;
+  ES_Event_t              HistoryEvent = ThisEvent;
+
+  if (pStates[Target].History != ES_HSM_HISTORY_NONE)
+  {
+    Leaf = pHSM->History[pStates[Target].HistorySlot];
+    HistoryEvent.EventType = ES_ENTRY_HISTORY;
+  }
+  for (ThisState = Target; ThisState != Lca;
+       ThisState = pStates[ThisState].Parent)
+  {
+    Path[PathLength++] = ThisState;
+  }
+  while (PathLength > 0)
+  {
+    ThisState = Path[--PathLength];
+    if (pStates[ThisState].Entry != 0)
+    {
+      pStates[ThisState].Entry(((PathLength == 0) &&
+          (Leaf != ES_HSM_NO_STATE)) ? HistoryEvent : ThisEvent);
+    }
+    pHSM->Current[pStates[ThisState].Region] = ThisState;
+    if ((pStates[ThisState].NumRegions > 0) && (PathLength > 0))
+    {
+      Orthogonal[NumOrthogonal++] = ThisState;
+    }
+  }
+  if (Leaf != ES_HSM_NO_STATE)
+  {
+    EnterHistory(pHSM, Target, Leaf,
+        pStates[Target].History == ES_HSM_HISTORY_DEEP, HistoryEvent);
+  }
+  else
+  {
+    EnterDefaults(pHSM, Target, ThisEvent);
+  }
+
+  // then the regions that were not on the path, innermost first
+  while (NumOrthogonal > 0)
+  {
+    ThisState = Orthogonal[--NumOrthogonal];
+    for (RegionState = pStates[ThisState].InitialChild;
+         RegionState < pStates[ThisState].InitialChild +
+         pStates[ThisState].NumRegions; RegionState++)
+    {
+      if (pHSM->Current[pStates[RegionState].Region] == ES_HSM_NO_STATE)
+      {
+        if (pStates[RegionState].Entry != 0)
+        {
+          pStates[RegionState].Entry(ThisEvent);
+        }
+        EnterDefaults(pHSM, RegionState, ThisEvent);
+      }
+    }
+  }
+}
+
+/****************************************************************************
+ Function
+     EnterDefaults
+ Parameters
+     ES_HSM_t *pHSM, the machine
+     ES_HSMState_t State, a state that has just been entered
+     ES_Event_t ThisEvent, passed to the entry functions
+ Returns
+     None.
+ Description
+     follows the InitialChild links down to a leaf, entering each state on
+     the way, and entering every region of each orthogonal state found
+ Notes
+     the regions still to be entered are kept in a local stack, there can
+     never be more of them than there are regions in the machine
+ Author
+     ags, 10/19/26 22:00
+****************************************************************************/
+static void EnterDefaults(ES_HSM_t *pHSM, ES_HSMState_t State,
+    ES_Event_t ThisEvent)
+{
+  const ES_HSMStateDesc_t *pStates = pHSM->pDesc->pStates;
+  ES_HSMState_t           Pending[ES_HSM_MAX_REGIONS];
+  uint8_t                 NumPending = 0;
+  uint8_t                 i;
+
+  for (;;)
+  {
+    pHSM->Current[pStates[State].Region] = State;
+    if (pStates[State].NumRegions > 0)
+    {
+      // push them last first, so that they are entered in order
+      for (i = pStates[State].NumRegions; i > 0; i--)
+      {
+        Pending[NumPending++] = pStates[State].InitialChild + i - 1;
+      }
+    }
+    else if (pStates[State].InitialChild != ES_HSM_NO_STATE)
+    {
+      State = pStates[State].InitialChild;
+      if (pStates[State].Entry != 0)
+      {
+        pStates[State].Entry(ThisEvent);
+      }
+      continue;
+    }
+    if (NumPending == 0)
+    {
+      break;
+    }
+    State = Pending[--NumPending];
+    if (pStates[State].Entry != 0)
+    {
+      pStates[State].Entry(ThisEvent);
+    }
+  }
+}
+
+/****************************************************************************
+ Function
+     EnterHistory
+ Parameters
+     ES_HSM_t *pHSM, the machine
+     ES_HSMState_t State, a state that has just been entered, or ES_HSM_ROOT
+     ES_HSMState_t Leaf, the saved deepest state below it in its region
+     bool Deep, true to go all the way back to the Leaf and to the saved
+       states of the regions below it, false to go one level down only
+     ES_Event_t ThisEvent, passed to the entry functions
+ Returns
+     None.
+ Description
+     enters the path from below the State down to the Leaf, then, for deep
+     history of an orthogonal state, each of its regions down to the state
+     saved for it, and so on. Regions with nothing saved, and the states
+     below the first level of shallow history, are entered by default.
+ Notes
+     the regions still to be resumed are kept in a local stack, as in
+     EnterDefaults
+ Author
+     ags, 10/19/26 22:48
+****************************************************************************/
+static void EnterHistory(ES_HSM_t *pHSM, ES_HSMState_t State,
+    ES_HSMState_t Leaf, bool Deep, ES_Event_t ThisEvent)
+{
+  const ES_HSMStateDesc_t *pStates = pHSM->pDesc->pStates;
+  ES_HSMState_t           Path[ES_HSM_MAX_DEPTH];
+  uint8_t                 PathLength;
+  ES_HSMState_t           Pending[ES_HSM_MAX_REGIONS];
+  uint8_t                 NumPending = 0;
+  ES_HSMState_t           ThisState;
+  uint8_t                 i;
+
+  for (;;)
+  {
+    PathLength = 0;
+    if (Leaf != ES_HSM_NO_STATE)
+    {
+      for (ThisState = Leaf; ThisState != State;
+           ThisState = pStates[ThisState].Parent)
+      {
+        Path[PathLength++] = ThisState;
+      }
+    }
+    if ((Deep == false) && (PathLength > 1))
+    {
+      Path[0]     = Path[PathLength - 1];   // only the substate of State
+      PathLength  = 1;
+    }
+    ThisState = State;
+    while (PathLength > 0)
+    {
+      ThisState = Path[--PathLength];
+      if (pStates[ThisState].Entry != 0)
+      {
+        pStates[ThisState].Entry(ThisEvent);
+      }
+      pHSM->Current[pStates[ThisState].Region] = ThisState;
+    }
+    if ((Deep == true) && (Leaf != ES_HSM_NO_STATE) &&
+        (pStates[ThisState].NumRegions > 0))
+    {
+      // push them last first, so that they are resumed in order
+      for (i = pStates[ThisState].NumRegions; i > 0; i--)
+      {
+        Pending[NumPending++] = pStates[ThisState].InitialChild + i - 1;
+      }
+    }
+    else
+    {
+      EnterDefaults(pHSM, ThisState, ThisEvent);
+    }
+    if (NumPending == 0)
+    {
+      break;
+    }
+    State = Pending[--NumPending];
+    if (pStates[State].Entry != 0)
+    {
+      pStates[State].Entry(ThisEvent);
+    }
+    pHSM->Current[pStates[State].Region] = State;
+    Leaf = pHSM->RegionHistory[pStates[State].Region];
+  }
+}
+
+/****************************************************************************
+ Function
+     RegionOf
+ Parameters
+     const ES_HSM_t *pHSM, the machine
+     ES_HSMState_t State, a state, or ES_HSM_ROOT
+ Returns
+     uint8_t, the region the state is in
+ Author
+     ags, 10/19/26 22:03
+****************************************************************************/
+static uint8_t RegionOf(const ES_HSM_t *pHSM, ES_HSMState_t State)
+{
+  if (State == ES_HSM_ROOT)
+  {
+    return TOP_REGION(pHSM);
+  }
+  return pHSM->pDesc->pStates[State].Region;
+}
+
+/****************************************************************************
+ Function
+     IsRegionState
+ Parameters
+     const ES_HSMStateDesc_t *pStates, the state table
+     ES_HSMState_t State, a state
+ Returns
+     bool, true if the state is one of the regions of an orthogonal state
+ Author
+     ags, 10/19/26 22:04
+****************************************************************************/
+static bool IsRegionState(const ES_HSMStateDesc_t *pStates,
+    ES_HSMState_t State)
+{
+  ES_HSMState_t Parent = pStates[State].Parent;
+
+  return (Parent != ES_HSM_ROOT) &&
+         (pStates[Parent].Region != pStates[State].Region);
+}
+
+/****************************************************************************
+ Function
+     OuterRegion
+ Parameters
+     const ES_HSM_t *pHSM, the machine
+     uint8_t Region, an active region, not the top level
+ Returns
+     uint8_t, the region of the orthogonal state that holds the region
+ Author
+     ags, 10/19/26 22:05
+****************************************************************************/
+static uint8_t OuterRegion(const ES_HSM_t *pHSM, uint8_t Region)
+{
+  const ES_HSMStateDesc_t *pStates = pHSM->pDesc->pStates;
+  ES_HSMState_t           ThisState = pHSM->Current[Region];
+
+  while (IsRegionState(pStates, ThisState) == false)
+  {
+    ThisState = pStates[ThisState].Parent;
+  }
+  return pStates[pStates[ThisState].Parent].Region;
+}
+
+/****************************************************************************
+ Function
+     FindDeferMask
+ Parameters
+     const ES_HSM_t *pHSM, the machine
+ Returns
+     uint32_t, the DeferMasks of all of the active states
+ Author
+     ags, 10/19/26 22:29
+****************************************************************************/
+static uint32_t FindDeferMask(const ES_HSM_t *pHSM)
+{
+  const ES_HSMStateDesc_t *pStates = pHSM->pDesc->pStates;
+  ES_HSMState_t           ThisState;
+  uint32_t                Mask = 0;
+  uint8_t                 Region;
+
+  for (Region = 0; Region <= TOP_REGION(pHSM); Region++)
+  {
+    ThisState = pHSM->Current[Region];
+    if (ThisState == ES_HSM_NO_STATE)
+    {
+      continue;
+    }
+    // up to the region state, the states above it are in another region
+    while (ThisState != ES_HSM_ROOT)
+    {
+      Mask |= pStates[ThisState].DeferMask;
+      if (IsRegionState(pStates, ThisState) == true)
+      {
+        break;
+      }
+      ThisState = pStates[ThisState].Parent;
+    }
+  }
+  return Mask;
+}
+
+/****************************************************************************
+ Function
+     UpdateDeferral
+ Parameters
+     ES_HSM_t *pHSM, the machine
+ Returns
+     None.
+ Description
+     works out the ActiveDeferMask after a transition and recalls the event
+     types that are no longer deferred
+ Author
+     ags, 10/19/26 22:31
+****************************************************************************/
+static void UpdateDeferral(ES_HSM_t *pHSM)
+{
+  uint32_t OldMask = pHSM->ActiveDeferMask;
+
+  pHSM->ActiveDeferMask = FindDeferMask(pHSM);
+  if ((pHSM->pDeferQueue != 0) &&
+      ((OldMask & ~pHSM->ActiveDeferMask) != 0))
+  {
+    ES_RecallEventsOfType(pHSM->Owner, pHSM->pDeferQueue,
+        OldMask & ~pHSM->ActiveDeferMask);
+  }
+}
+
+/*------------------------------- Footnotes -------------------------------*/
+/*------------------------------ End of file ------------------------------*/
@@ -0,0 +1,1232 @@
+/****************************************************************************
+ Module
+   ES_HostPort.c
+
+ Revision
+   1.0.1
+
+ Description
+   This is the port of the hardware specific functions of the Events &
+   Services Framework to a POSIX host (Linux or macOS). It allows services
+   and the framework itself to be built and exercised off-target.
+
+ Notes
+   Build with _ES_HOST_PORT_ defined and compile this file in place of
+   ES_Port.c, for example:
+     cc -std=c99 -D_ES_HOST_PORT_ -IHeaders Source/ES_HostPort.c
+        Source/ES_Framework.c Source/ES_Queue.c ... your services ...
+   Tests/run_tests.sh builds the framework's own host tests this way, and
+   runs them.
+   The framework tick and the high resolution timer match are not driven by
+   interrupts, instead the elapsed time is checked on each call to
+   _HW_Process_Pending_Ints, which ES_Run calls on every pass through its
+   loop. Since everything happens in the one thread, the critical region
+   macros in ES_Port.h are empty for this port.
+   Input capture edges are read from a text file, named by the environment
+   variable ES_CAPTURE_FILE (default es_capture.txt). Each line holds the
+   time of an edge in uS from the start of the run and the channel, e.g.
+     1500 0
+   with the times in increasing order. Lines starting with # are ignored.
+   The edges are delivered as the uS count passes their times. The file is
+   taken to hold only the edges of interest, so the edge selection for the
+   channel is not applied.
+   The cycle count for the profiler is taken from the same monotonic clock,
+   scaled to a 40MHz count so that the numbers compare with the target.
+   The trace output is written to a binary file, named by the environment
+   variable ES_TRACE_FILE (default es_trace.bin). What is left in the trace
+   ring is written out when the process exits.
+   The bytes sent to the byte debug port are written to a text file, named
+   by the environment variable ES_BYTE_DEBUG_FILE (default
+   es_bytedebug.txt), one per line with the uS count, e.g.
+     1520 0x81
+   The PC sampler is driven by SIGPROF, so it samples at the requested
+   rate of CPU time, which is close to real time as ES_Run never sleeps.
+   The samples are offsets from the start of the executable, and the
+   histogram is written at exit to the file named by the environment
+   variable ES_PCSAMPLE_FILE (default es_pcsample.txt). Reading the PC from
+   the signal context is only done for x86-64 and ARM64, Linux and macOS.
+   On anything else every sample counts as outside.
+   The watchdog is checked from SIGALRM. If it has not been fed for the
+   timeout, the process exits with a message on stderr, in place of the
+   target's reset.
+   With _INCLUDE_EVENT_REPLAY_, the inputs are read from a text file, named
+   by the environment variable ES_REPLAY_FILE (default es_replay.txt). Each
+   line holds the time of the input in uS, the service it was posted to (B
+   for a broadcast), the event type and the parameter, e.g.
+     1500 0 11 0x0061
+   with the times in increasing order. Lines starting with # are ignored.
+   Tools/ES_TraceDecode.py --replay writes these from a trace. The uS count
+   is then a virtual clock, which stands still until ES_Replay_Idle moves it
+   on to the time of the next input. The ticks and the high resolution
+   matches follow it. The watchdog stays on real time.
+   With _INCLUDE_VIRTUAL_TIME_, the uS count is the same virtual clock, but
+   it is moved on by _HW_VirtualTime_Advance, once ES_Run has no work and
+   the event checkers have found nothing, straight to the next tick that
+   will post an event, the high resolution match or the next capture edge,
+   whichever is first. Time passes only when something is waiting for it,
+   so a test that runs the timers for an hour takes as long as the work
+   that the services do. If nothing is waiting the clock stands still. The
+   watchdog and the PC sampler stay on real time.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/20/26 06:52 ags     FeedCaptures only with _INCLUDE_INPUT_CAPTURE_
+ 10/20/26 05:58 ags     point to the host tests
+ 10/20/26 05:38 ags     quiet the unused parameter in WatchdogHandler
+ 10/20/26 05:37 ags     quiet the unused parameters in SampleHandler
+ 10/20/26 05:35 ags     quiet the unused parameter in _HW_InputCapture_Init
+ 10/20/26 05:12 ags     kbhit stops at the end of a redirected stdin
+ 10/20/26 04:58 ags     virtual time, jumping to the next deadline when idle
+ 10/20/26 04:32 ags     replay of captured inputs on a virtual clock
+ 10/20/26 03:44 ags     watchdog on SIGALRM
+ 10/20/26 02:28 ags     PC sampler on SIGPROF
+ 10/20/26 01:24 ags     byte debug port logged to a file
+ 10/20/26 00:50 ags     trace output to a file
+ 10/19/26 23:22 ags     cycle count for the profiler
+ 10/19/26 16:02 ags     input capture edges fed from a file
+ 10/19/26 10:40 ags     Began coding, tick and high resolution timer
+ ***************************************************************************/
+#define _POSIX_C_SOURCE 200809L
+// for the register names in the signal context read by the PC sampler
+#define _DEFAULT_SOURCE
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <signal.h>
+#include <sys/select.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "ES_Configure.h"
+#include "ES_Port.h"
+#include "ES_Types.h"
+#include "ES_Timers.h"
+#include "ES_HRTimers.h"
+#include "ES_InputCapture.h"
+#include "ES_Trace.h"
+#include "ES_PCSample.h"
+#include "ES_Replay.h"
+
+// the TimerRate_t values are SysTick reload values for a 40MHz clock,
+// this is the number of those clocks per uS
+#define TARGET_CLKS_PER_uS 40UL
+
+// Global tick count, as in ES_Port.c
+static uint16_t SysTickCounter = 0;
+
+// the length of a tick in uS, 0 when the tick is off
+static uint32_t TickPeriod = 0;
+// the value of the uS count at the last tick
+static uint32_t LastTickTime;
+
+// the state of the emulated match register for the high resolution timer
+static bool     HRMatchArmed = false;
+static uint32_t HRMatchTime;
+
+// the host time that corresponds to a uS count of 0
+#if !defined(_INCLUDE_VIRTUAL_TIME_) || defined(_INCLUDE_WATCHDOG_)
+static struct timespec StartTime;
+static bool            StartTimeValid = false;
+#endif
+
+// the file of input capture edges and the next edge read from it
+static FILE     *CaptureFile = NULL;
+static bool     CaptureEnabled[NUM_CAPTURE_CHANNELS];
+static bool     NextEdgeValid = false;
+static uint32_t NextEdgeTime;
+static unsigned NextEdgeChannel;
+
+// set once stdin has reached its end, after which no more keys can come
+static bool     StdinEnded = false;
+
+#ifdef _INCLUDE_BYTE_DEBUG_
+// the file that the byte debug port is logged to, and the port's contents
+static FILE     *ByteDebugFile = NULL;
+static uint8_t  ByteDebugPortShadow = 0;
+#endif
+
+#ifdef _INCLUDE_TRACE_
+// the file that the trace is written to
+static FILE     *TraceFile = NULL;
+#endif
+
+#ifdef _INCLUDE_PC_SAMPLER_
+// the file that the PC samples are written to at exit
+static FILE     *PCSampleFile = NULL;
+
+// the interrupted PC from the context given to the SIGPROF handler.
+// REG_RIP is 16, but the name needs _GNU_SOURCE
+#if defined(__linux__) && defined(__x86_64__)
+#define SAMPLED_PC(pContext) ((uintptr_t)(pContext)->uc_mcontext.gregs[16])
+#elif defined(__linux__) && defined(__aarch64__)
+#define SAMPLED_PC(pContext) ((uintptr_t)(pContext)->uc_mcontext.pc)
+#elif defined(__APPLE__) && defined(__x86_64__)
+#define SAMPLED_PC(pContext) ((uintptr_t)(pContext)->uc_mcontext->__ss.__rip)
+#elif defined(__APPLE__) && defined(__aarch64__)
+#define SAMPLED_PC(pContext) ((uintptr_t)(pContext)->uc_mcontext->__ss.__pc)
+#else
+#define SAMPLED_PC(pContext) ((uintptr_t)0)
+#endif
+
+// the start of the executable, which the linker marks with a symbol
+#if defined(__APPLE__)
+extern const char _mh_execute_header;
+#define CODE_BASE ((uintptr_t)&_mh_execute_header)
+#else
+extern const char __executable_start;
+#define CODE_BASE ((uintptr_t)&__executable_start)
+#endif
+#endif /* _INCLUDE_PC_SAMPLER_ */
+
+#ifdef _INCLUDE_WATCHDOG_
+// the watchdog timeout in uS, and the real uS count when it was last fed
+static uint32_t           WatchdogTimeout;
+static volatile uint32_t  LastFeedTime;
+#endif
+
+#ifdef _INCLUDE_VIRTUAL_TIME_
+// the virtual uS count
+static uint32_t   VirtualTime = 0;
+#endif
+
+#ifdef _INCLUDE_EVENT_REPLAY_
+// the file of inputs to replay and the next input read from it
+static FILE       *ReplayFile = NULL;
+static bool       NextInputValid = false;
+static uint32_t   NextInputTime;
+static uint8_t    NextInputService;
+static ES_Event_t NextInputEvent;
+#endif
+
+/*---------------------------- Module Functions ---------------------------*/
+static uint32_t HostMicros(void);
+#if !defined(_INCLUDE_VIRTUAL_TIME_) || defined(_INCLUDE_WATCHDOG_)
+static uint32_t RealMicros(void);
+#endif
+static void ReadNextEdge(void);
+#ifdef _INCLUDE_INPUT_CAPTURE_
+static void FeedCaptures(uint32_t Now);
+#endif
+#ifdef _INCLUDE_EVENT_REPLAY_
+static void ReadNextInput(void);
+static void FeedInputs(uint32_t Now);
+#endif
+#ifdef _INCLUDE_TRACE_
+static void FlushTrace(void);
+#endif
+#ifdef _INCLUDE_BYTE_DEBUG_
+static void ByteDebugPut(uint8_t NewValue);
+#endif
+#ifdef _INCLUDE_WATCHDOG_
+static void WatchdogHandler(int Signal);
+#endif
+#ifdef _INCLUDE_PC_SAMPLER_
+static void SampleHandler(int Signal, siginfo_t *pInfo, void *pContext);
+static void WritePCSamples(void);
+#endif
+
+/****************************************************************************
+ Function
+     _HW_Timer_Init
+ Parameters
+     TimerRate_t Rate set to one of the ES_Timer_RATE_XX values to set the
+     Tick rate
+ Returns
+     None.
+ Description
+     converts the SysTick reload value into a tick period in uS and starts
+     timing the ticks from now
+ Notes
+
+ Author
+     ags, 10/19/26 10:44
+****************************************************************************/
+void _HW_Timer_Init(TimerRate_t Rate)
+{
+  if (Rate == ES_Timer_RATE_OFF)
+  {
+    TickPeriod = 0;
+  }
+  else
+  {
+    TickPeriod = ((uint32_t)Rate + 1) / TARGET_CLKS_PER_uS;
+  }
+  LastTickTime = HostMicros();
+}
+
+/****************************************************************************
+ Function
+    _HW_GetTickCount()
+ Parameters
+    none
+ Returns
+    uint16_t   count of number of system ticks that have occurred.
+ Description
+    wrapper for access to SysTickCounter
+ Notes
+
+ Author
+    ags, 10/19/26 10:46
+****************************************************************************/
+uint16_t _HW_GetTickCount(void)
+{
+  return SysTickCounter;
+}
+
+/****************************************************************************
+ Function
+     _HW_Process_Pending_Ints
+ Parameters
+     none
+ Returns
+     always true.
+ Description
+     generates any ticks that have come due since the last call and, if the
+     high resolution match time has passed, runs the match response
+ Notes
+     see the notes on the version in ES_Port.c
+ Author
+     ags, 10/19/26 10:49
+****************************************************************************/
+bool _HW_Process_Pending_Ints(void)
+{
+  uint32_t Now = HostMicros();
+
+  if (TickPeriod != 0)
+  {
+    while ((Now - LastTickTime) >= TickPeriod)
+    {
+      LastTickTime += TickPeriod;
+      ++SysTickCounter;
+      /* call the framework tick response to actually run the timers */
+      ES_Timer_Tick_Resp();
+    }
+  }
+  if ((HRMatchArmed == true) && ((int32_t)(HRMatchTime - Now) <= 0))
+  {
+    HRMatchArmed = false;
+    ES_HRTimer_Match_Resp();
+  }
+#ifdef _INCLUDE_INPUT_CAPTURE_
+  FeedCaptures(Now);
+  ES_InputCapture_Process();
+#endif
+#ifdef _INCLUDE_EVENT_REPLAY_
+  FeedInputs(Now);
+#endif
+  return true;  // always return true to allow loop test in ES_Run to proceed
+}
+
+/****************************************************************************
+ Function
+     _HW_InInterrupt
+ Parameters
+     none
+ Returns
+     bool, always false
+ Description
+     the host's interrupts are all polled from _HW_Process_Pending_Ints, so
+     nothing runs as an interrupt handler
+ Author
+     ags, 10/20/26 04:33
+****************************************************************************/
+bool _HW_InInterrupt(void)
+{
+  return false;
+}
+
+/****************************************************************************
+ Function
+     _HW_HRTimer_Init
+ Parameters
+     none
+ Returns
+     None.
+ Description
+     the host uS count is always running, so just disarm the match
+ Author
+     ags, 10/19/26 10:52
+****************************************************************************/
+void _HW_HRTimer_Init(void)
+{
+  HRMatchArmed = false;
+}
+
+/****************************************************************************
+ Function
+     _HW_HRTimer_GetCount
+ Parameters
+     none
+ Returns
+     uint32_t the free-running uS count
+ Author
+     ags, 10/19/26 10:53
+****************************************************************************/
+uint32_t _HW_HRTimer_GetCount(void)
+{
+  return HostMicros();
+}
+
+/****************************************************************************
+ Function
+     _HW_HRTimer_SetMatch
+ Parameters
+     uint32_t MatchTime, the value of the uS count at which to respond
+ Returns
+     None.
+ Description
+     arms the emulated match, which is polled in _HW_Process_Pending_Ints
+ Author
+     ags, 10/19/26 10:54
+****************************************************************************/
+void _HW_HRTimer_SetMatch(uint32_t MatchTime)
+{
+  HRMatchTime   = MatchTime;
+  HRMatchArmed  = true;
+}
+
+/****************************************************************************
+ Function
+     _HW_HRTimer_DisableMatch
+ Parameters
+     none
+ Returns
+     None.
+ Author
+     ags, 10/19/26 10:55
+****************************************************************************/
+void _HW_HRTimer_DisableMatch(void)
+{
+  HRMatchArmed = false;
+}
+
+/****************************************************************************
+ Function
+     _HW_InputCapture_Init
+ Parameters
+     uint8_t Channel, the capture channel to start
+     ES_CaptureEdge_t Edge, the edge(s) to capture, not used on the host
+ Returns
+     None.
+ Description
+     enables delivery of the edges from the capture file for this channel,
+     opening the file the first time through
+ Author
+     ags, 10/19/26 16:05
+****************************************************************************/
+void _HW_InputCapture_Init(uint8_t Channel, ES_CaptureEdge_t Edge)
+{
+  const char *FileName;
+
+  (void)Edge;   // the file gives the edges that were seen
+  CaptureEnabled[Channel] = true;
+  if (CaptureFile == NULL)
+  {
+    FileName = getenv("ES_CAPTURE_FILE");
+    if (FileName == NULL)
+    {
+      FileName = "es_capture.txt";
+    }
+    CaptureFile = fopen(FileName, "r");
+    ReadNextEdge();
+  }
+}
+
+#if defined(_INCLUDE_PROFILER_) || defined(_INCLUDE_EVENT_REPLAY_)
+/****************************************************************************
+ Function
+     _HW_CycleCount_Init
+ Parameters
+     none
+ Returns
+     None.
+ Description
+     the host clock is always running, so there is nothing to start
+ Author
+     ags, 10/19/26 23:23
+****************************************************************************/
+void _HW_CycleCount_Init(void)
+{
+}
+
+/****************************************************************************
+ Function
+     _HW_GetCycleCount
+ Parameters
+     none
+ Returns
+     uint32_t, a free-running count of 40MHz clocks
+ Author
+     ags, 10/19/26 23:24
+****************************************************************************/
+uint32_t _HW_GetCycleCount(void)
+{
+  struct timespec Now;
+
+  clock_gettime(CLOCK_MONOTONIC, &Now);
+  return (uint32_t)((uint64_t)Now.tv_sec * 1000000UL * TARGET_CLKS_PER_uS +
+         (uint64_t)Now.tv_nsec * TARGET_CLKS_PER_uS / 1000UL);
+}
+#endif /* _INCLUDE_PROFILER_ || _INCLUDE_EVENT_REPLAY_ */
+
+#ifdef _INCLUDE_TRACE_
+/****************************************************************************
+ Function
+     _HW_Trace_Init
+ Parameters
+     none
+ Returns
+     None.
+ Description
+     opens the trace file, and arranges for the rest of the trace to be
+     written out when the process exits
+ Author
+     ags, 10/20/26 00:52
+****************************************************************************/
+void _HW_Trace_Init(void)
+{
+  const char *FileName;
+
+  if (TraceFile == NULL)
+  {
+    FileName = getenv("ES_TRACE_FILE");
+    if (FileName == NULL)
+    {
+      FileName = "es_trace.bin";
+    }
+    TraceFile = fopen(FileName, "wb");
+    atexit(FlushTrace);
+  }
+}
+
+/****************************************************************************
+ Function
+     _HW_Trace_PutByte
+ Parameters
+     uint8_t Byte, the next byte of the trace
+ Returns
+     bool, always true, the file never fills up
+ Author
+     ags, 10/20/26 00:53
+****************************************************************************/
+bool _HW_Trace_PutByte(uint8_t Byte)
+{
+  if (TraceFile != NULL)
+  {
+    fputc(Byte, TraceFile);
+  }
+  return true;
+}
+#endif /* _INCLUDE_TRACE_ */
+
+#ifdef _INCLUDE_PC_SAMPLER_
+/****************************************************************************
+ Function
+     _HW_PCSample_Init
+ Parameters
+     uint16_t RateHz, the number of samples to take each second
+ Returns
+     None.
+ Description
+     opens the sample file, arranges for the histogram to be written to it
+     at exit and starts SIGPROF at the rate
+ Notes
+     SA_RESTART keeps the signal from breaking the console reads
+ Author
+     ags, 10/20/26 02:30
+****************************************************************************/
+void _HW_PCSample_Init(uint16_t RateHz)
+{
+  const char        *FileName;
+  struct sigaction  Action;
+  struct itimerval  Period;
+
+  if (PCSampleFile == NULL)
+  {
+    FileName = getenv("ES_PCSAMPLE_FILE");
+    if (FileName == NULL)
+    {
+      FileName = "es_pcsample.txt";
+    }
+    PCSampleFile = fopen(FileName, "w");
+    atexit(WritePCSamples);
+  }
+  Action.sa_sigaction = SampleHandler;
+  Action.sa_flags     = SA_SIGINFO | SA_RESTART;
+  sigemptyset(&Action.sa_mask);
+  sigaction(SIGPROF, &Action, NULL);
+
+  Period.it_interval.tv_sec   = 0;
+  Period.it_interval.tv_usec  = 1000000L / RateHz;
+  Period.it_value             = Period.it_interval;
+  setitimer(ITIMER_PROF, &Period, NULL);
+}
+
+/****************************************************************************
+ Function
+     _HW_PCSample_GetCodeBase
+ Parameters
+     none
+ Returns
+     uintptr_t, the address that the sampled PCs are offsets from
+ Description
+     the start of the executable, which moves from run to run when it is
+     position independent
+ Author
+     ags, 10/20/26 02:31
+****************************************************************************/
+uintptr_t _HW_PCSample_GetCodeBase(void)
+{
+  return CODE_BASE;
+}
+#endif /* _INCLUDE_PC_SAMPLER_ */
+
+#ifdef _INCLUDE_WATCHDOG_
+/****************************************************************************
+ Function
+     _HW_Watchdog_Init
+ Parameters
+     uint16_t TimeoutMS, the time without a feed after which to exit
+ Returns
+     None.
+ Description
+     starts SIGALRM at a quarter of the timeout to check on the feeds
+ Author
+     ags, 10/20/26 03:46
+****************************************************************************/
+void _HW_Watchdog_Init(uint16_t TimeoutMS)
+{
+  struct sigaction  Action;
+  struct itimerval  Period;
+
+  WatchdogTimeout = (uint32_t)TimeoutMS * 1000UL;
+  LastFeedTime    = RealMicros();
+
+  Action.sa_handler = WatchdogHandler;
+  Action.sa_flags   = SA_RESTART;
+  sigemptyset(&Action.sa_mask);
+  sigaction(SIGALRM, &Action, NULL);
+
+  Period.it_interval.tv_sec   = WatchdogTimeout / 4 / 1000000UL;
+  Period.it_interval.tv_usec  = WatchdogTimeout / 4 % 1000000UL;
+  Period.it_value             = Period.it_interval;
+  setitimer(ITIMER_REAL, &Period, NULL);
+}
+
+/****************************************************************************
+ Function
+     _HW_Watchdog_Feed
+ Parameters
+     none
+ Returns
+     None.
+ Description
+     notes the time of the feed
+ Author
+     ags, 10/20/26 03:47
+****************************************************************************/
+void _HW_Watchdog_Feed(void)
+{
+  LastFeedTime = RealMicros();
+}
+#endif /* _INCLUDE_WATCHDOG_ */
+
+#ifdef _INCLUDE_EVENT_REPLAY_
+/****************************************************************************
+ Function
+     _HW_Replay_Init
+ Parameters
+     none
+ Returns
+     None.
+ Description
+     opens the file of inputs and reads ahead the first one
+ Author
+     ags, 10/20/26 04:34
+****************************************************************************/
+void _HW_Replay_Init(void)
+{
+  const char *FileName;
+
+  if (ReplayFile == NULL)
+  {
+    FileName = getenv("ES_REPLAY_FILE");
+    if (FileName == NULL)
+    {
+      FileName = "es_replay.txt";
+    }
+    ReplayFile = fopen(FileName, "r");
+    if (ReplayFile == NULL)
+    {
+      fprintf(stderr, "replay: can not open %s\n", FileName);
+    }
+  }
+  ReadNextInput();
+}
+
+/****************************************************************************
+ Function
+     _HW_Replay_Advance
+ Parameters
+     none
+ Returns
+     bool, false if there are no inputs left
+ Description
+     moves the virtual clock on to the time of the next input, the next
+     call to _HW_Process_Pending_Ints runs the ticks up to it and then
+     hands over the input
+ Notes
+     the clock never goes back, an input that is already due is handed
+     over at the present time
+ Author
+     ags, 10/20/26 04:35
+****************************************************************************/
+bool _HW_Replay_Advance(void)
+{
+  if (NextInputValid == false)
+  {
+    return false;
+  }
+  if ((int32_t)(NextInputTime - VirtualTime) > 0)
+  {
+    VirtualTime = NextInputTime;
+  }
+  return true;
+}
+#endif /* _INCLUDE_EVENT_REPLAY_ */
+
+#ifdef _INCLUDE_VIRTUAL_TIME_
+/****************************************************************************
+ Function
+     _HW_VirtualTime_Advance
+ Parameters
+     none
+ Returns
+     bool, false if nothing is waiting for the time to pass
+ Description
+     moves the virtual clock on to the first of the tick on which a timer
+     runs out or a timed deferral expires, the high resolution match and
+     the next capture edge. The next call to _HW_Process_Pending_Ints then
+     runs the ticks up to it and the responses that are due.
+ Notes
+     called from ES_Run when there is no work and the event checkers have
+     found nothing. The clock never goes back.
+ Author
+     ags, 10/20/26 05:00
+****************************************************************************/
+bool _HW_VirtualTime_Advance(void)
+{
+  uint32_t  Next = 0;
+  bool      NextValid = false;
+  uint16_t  Ticks;
+
+  if (TickPeriod != 0)
+  {
+    Ticks = ES_Timer_GetTicksToNext();
+    if (Ticks != 0)
+    {
+      Next      = LastTickTime + (uint32_t)Ticks * TickPeriod;
+      NextValid = true;
+    }
+  }
+  if ((HRMatchArmed == true) &&
+      ((NextValid == false) || ((int32_t)(HRMatchTime - Next) < 0)))
+  {
+    Next      = HRMatchTime;
+    NextValid = true;
+  }
+  if ((NextEdgeValid == true) &&
+      ((NextValid == false) || ((int32_t)(NextEdgeTime - Next) < 0)))
+  {
+    Next      = NextEdgeTime;
+    NextValid = true;
+  }
+  if ((NextValid == true) && ((int32_t)(Next - VirtualTime) > 0))
+  {
+    VirtualTime = Next;
+  }
+  return NextValid;
+}
+#endif /* _INCLUDE_VIRTUAL_TIME_ */
+
+#ifdef _INCLUDE_BYTE_DEBUG_
+/****************************************************************************
+ Function
+     _HW_ByteDebug_Init
+ Parameters
+     none
+ Returns
+     None.
+ Description
+     opens the byte debug log file
+ Author
+     ags, 10/20/26 01:26
+****************************************************************************/
+void _HW_ByteDebug_Init(void)
+{
+  const char *FileName;
+
+  if (ByteDebugFile == NULL)
+  {
+    FileName = getenv("ES_BYTE_DEBUG_FILE");
+    if (FileName == NULL)
+    {
+      FileName = "es_bytedebug.txt";
+    }
+    ByteDebugFile = fopen(FileName, "w");
+  }
+  ByteDebugPortShadow = 0;
+  ByteDebugPut(ByteDebugPortShadow);
+}
+
+/****************************************************************************
+ Function
+     _HW_ByteDebug_ClearBit
+ Parameters
+     uint8_t WhichBit, specifies which bit to clear
+ Returns
+     None.
+ Author
+     ags, 10/20/26 01:27
+****************************************************************************/
+void _HW_ByteDebug_ClearBit(uint8_t WhichBit)
+{
+  ByteDebugPortShadow &= ~(BIT0HI << WhichBit);
+  ByteDebugPut(ByteDebugPortShadow);
+}
+
+/****************************************************************************
+ Function
+     _HW_ByteDebug_SetBit
+ Parameters
+     uint8_t WhichBit, specifies which bit to set
+ Returns
+     None.
+ Author
+     ags, 10/20/26 01:27
+****************************************************************************/
+void _HW_ByteDebug_SetBit(uint8_t WhichBit)
+{
+  ByteDebugPortShadow |= (BIT0HI << WhichBit);
+  ByteDebugPut(ByteDebugPortShadow);
+}
+
+/****************************************************************************
+ Function
+     _HW_ByteDebug_SetValueWithStrobe
+ Parameters
+     uint8_t NewValue, the new value (7 bits) for the port
+ Returns
+     None.
+ Description
+     logs the two bytes that the target sends, with bit 7 hi then lo
+ Author
+     ags, 10/20/26 01:28
+****************************************************************************/
+void _HW_ByteDebug_SetValueWithStrobe(uint8_t NewValue)
+{
+  ByteDebugPortShadow = NewValue;
+  ByteDebugPut(ByteDebugPortShadow | BIT7HI);
+  ByteDebugPut(ByteDebugPortShadow & BIT7LO);
+}
+
+/****************************************************************************
+ Function
+     _HW_ByteDebug_SetValue
+ Parameters
+     uint8_t NewValue, the new value (8 bits) for the port
+ Returns
+     None.
+ Author
+     ags, 10/20/26 01:28
+****************************************************************************/
+void _HW_ByteDebug_SetValue(uint8_t NewValue)
+{
+  ByteDebugPortShadow = NewValue;
+  ByteDebugPut(ByteDebugPortShadow);
+}
+#endif /* _INCLUDE_BYTE_DEBUG_ */
+
+/****************************************************************************
+ Function
+     ConsoleInit
+ Parameters
+     none
+ Returns
+     none.
+ Description
+     the console is stdin/stdout, make stdout unbuffered so that output
+     interleaves with the framework activity as it does on the target
+ Author
+     ags, 10/19/26 10:57
+ ****************************************************************************/
+void ConsoleInit(void)
+{
+  setvbuf(stdout, NULL, _IONBF, 0);
+}
+
+/****************************************************************************
+ Function
+     kbhit
+ Parameters
+     none
+ Returns
+     int, non-zero if there is a character waiting on stdin
+ Description
+     host replacement for the kbhit() in termio.c
+ Notes
+     stdin is normally line buffered by the terminal, so keys arrive when
+     return is pressed. At the end of a redirected stdin, select keeps
+     saying it can be read, so the next character is read and put back to
+     tell a key from the end.
+ Author
+     ags, 10/19/26 10:59
+ ****************************************************************************/
+int kbhit(void)
+{
+  fd_set          ReadSet;
+  struct timeval  NoWait = { 0, 0 };
+  int             NextChar;
+
+  if (StdinEnded == true)
+  {
+    return 0;
+  }
+  FD_ZERO(&ReadSet);
+  FD_SET(STDIN_FILENO, &ReadSet);
+  if (select(STDIN_FILENO + 1, &ReadSet, NULL, NULL, &NoWait) <= 0)
+  {
+    return 0;
+  }
+  NextChar = getchar();
+  if (NextChar == EOF)
+  {
+    StdinEnded = true;
+    return 0;
+  }
+  ungetc(NextChar, stdin);
+  return 1;
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+/****************************************************************************
+ Function
+     ReadNextEdge
+ Parameters
+     none
+ Returns
+     none
+ Description
+     reads ahead the next edge from the capture file, NextEdgeValid is false
+     once the file is used up (or if there is no file)
+ Author
+     ags, 10/19/26 16:09
+****************************************************************************/
+static void ReadNextEdge(void)
+{
+  char          Line[80];
+  unsigned long Time;
+
+  NextEdgeValid = false;
+  if (CaptureFile == NULL)
+  {
+    return;
+  }
+  while (fgets(Line, sizeof(Line), CaptureFile) != NULL)
+  {
+    if ((Line[0] != '#') &&
+        (sscanf(Line, "%lu %u", &Time, &NextEdgeChannel) == 2) &&
+        (NextEdgeChannel < NUM_CAPTURE_CHANNELS))
+    {
+      NextEdgeTime  = (uint32_t)Time;
+      NextEdgeValid = true;
+      return;
+    }
+  }
+}
+
+#ifdef _INCLUDE_INPUT_CAPTURE_
+/****************************************************************************
+ Function
+     FeedCaptures
+ Parameters
+     uint32_t Now, the current uS count
+ Returns
+     none
+ Description
+     hands every edge from the file whose time has come to ES_InputCapture,
+     just as the capture interrupts do on the target
+ Author
+     ags, 10/19/26 16:12
+****************************************************************************/
+static void FeedCaptures(uint32_t Now)
+{
+  while ((NextEdgeValid == true) && ((int32_t)(NextEdgeTime - Now) <= 0))
+  {
+    if (CaptureEnabled[NextEdgeChannel] == true)
+    {
+      ES_InputCapture_Edge_Resp((uint8_t)NextEdgeChannel, NextEdgeTime);
+    }
+    ReadNextEdge();
+  }
+}
+#endif /* _INCLUDE_INPUT_CAPTURE_ */
+
+#ifdef _INCLUDE_EVENT_REPLAY_
+/****************************************************************************
+ Function
+     ReadNextInput
+ Parameters
+     none
+ Returns
+     none
+ Description
+     reads ahead the next input from the replay file, NextInputValid is
+     false once the file is used up (or if there is no file)
+ Notes
+     the times are taken modulo 2^32, like the uS count, so the gap between
+     two inputs must be less than half of that (35 minutes)
+ Author
+     ags, 10/20/26 04:36
+****************************************************************************/
+static void ReadNextInput(void)
+{
+  char          Line[120];
+  char          Service[8];
+  unsigned long Time;
+  unsigned      Type;
+  long          Param;
+
+  NextInputValid = false;
+  if (ReplayFile == NULL)
+  {
+    return;
+  }
+  while (fgets(Line, sizeof(Line), ReplayFile) != NULL)
+  {
+    if ((Line[0] == '#') ||
+        (sscanf(Line, "%lu %7s %u %li", &Time, Service, &Type, &Param) != 4))
+    {
+      continue;
+    }
+    if (Service[0] == 'B')
+    {
+      NextInputService = ES_REPLAY_BROADCAST;
+    }
+    else if (strtoul(Service, NULL, 10) < NUM_SERVICES)
+    {
+      NextInputService = (uint8_t)strtoul(Service, NULL, 10);
+    }
+    else
+    {
+      continue;   // not a service in this build
+    }
+    NextInputTime             = (uint32_t)Time;
+    NextInputEvent.EventType  = (ES_EventType_t)Type;
+    NextInputEvent.EventParam = (uint16_t)Param;
+    NextInputValid            = true;
+    return;
+  }
+}
+
+/****************************************************************************
+ Function
+     FeedInputs
+ Parameters
+     uint32_t Now, the current uS count
+ Returns
+     none
+ Description
+     hands every input from the file whose time has come to ES_Replay
+ Author
+     ags, 10/20/26 04:38
+****************************************************************************/
+static void FeedInputs(uint32_t Now)
+{
+  while ((NextInputValid == true) && ((int32_t)(NextInputTime - Now) <= 0))
+  {
+    ES_Replay_Input(NextInputService, NextInputEvent);
+    ReadNextInput();
+  }
+}
+#endif /* _INCLUDE_EVENT_REPLAY_ */
+
+/****************************************************************************
+ Function
+     HostMicros
+ Parameters
+     none
+ Returns
+     uint32_t the uS count, the virtual clock with _INCLUDE_VIRTUAL_TIME_,
+     otherwise the real time
+ Author
+     ags, 10/20/26 04:39
+****************************************************************************/
+static uint32_t HostMicros(void)
+{
+#ifdef _INCLUDE_VIRTUAL_TIME_
+  return VirtualTime;
+#else
+  return RealMicros();
+#endif
+}
+
+#if !defined(_INCLUDE_VIRTUAL_TIME_) || defined(_INCLUDE_WATCHDOG_)
+/****************************************************************************
+ Function
+     RealMicros
+ Parameters
+     none
+ Returns
+     uint32_t uS since the first call, wrapping like the target count
+ Author
+     ags, 10/19/26 11:02
+****************************************************************************/
+static uint32_t RealMicros(void)
+{
+  struct timespec Now;
+
+  clock_gettime(CLOCK_MONOTONIC, &Now);
+  if (StartTimeValid == false)
+  {
+    StartTime       = Now;
+    StartTimeValid  = true;
+  }
+  return (uint32_t)((Now.tv_sec - StartTime.tv_sec) * 1000000L +
+         (Now.tv_nsec - StartTime.tv_nsec) / 1000L);
+}
+#endif
+
+#ifdef _INCLUDE_TRACE_
+/****************************************************************************
+ Function
+     FlushTrace
+ Parameters
+     none
+ Returns
+     None.
+ Description
+     called at exit, drains what is left in the trace ring and closes the
+     file
+ Author
+     ags, 10/20/26 00:54
+****************************************************************************/
+static void FlushTrace(void)
+{
+  ES_Trace_Drain();
+  if (TraceFile != NULL)
+  {
+    fclose(TraceFile);
+    TraceFile = NULL;
+  }
+}
+#endif /* _INCLUDE_TRACE_ */
+
+#ifdef _INCLUDE_BYTE_DEBUG_
+/****************************************************************************
+ Function
+     ByteDebugPut
+ Parameters
+     uint8_t NewValue, the byte the target would send to the '595
+ Returns
+     None.
+ Description
+     writes the byte to the log with the current uS count
+ Author
+     ags, 10/20/26 01:29
+****************************************************************************/
+static void ByteDebugPut(uint8_t NewValue)
+{
+  if (ByteDebugFile != NULL)
+  {
+    fprintf(ByteDebugFile, "%lu 0x%02X\n", (unsigned long)HostMicros(),
+        NewValue);
+  }
+}
+#endif /* _INCLUDE_BYTE_DEBUG_ */
+
+#ifdef _INCLUDE_WATCHDOG_
+/****************************************************************************
+ Function
+     WatchdogHandler
+ Parameters
+     int Signal, SIGALRM
+ Returns
+     None.
+ Description
+     exits if the watchdog has gone unfed for longer than the timeout
+ Notes
+     only async-signal-safe calls are made from here
+ Author
+     ags, 10/20/26 03:48
+****************************************************************************/
+static void WatchdogHandler(int Signal)
+{
+  static const char Message[] = "\nwatchdog: not fed in time, exiting\n";
+
+  (void)Signal;
+  if ((RealMicros() - LastFeedTime) > WatchdogTimeout)
+  {
+    write(STDERR_FILENO, Message, sizeof(Message) - 1);
+    _exit(EXIT_FAILURE);
+  }
+}
+#endif /* _INCLUDE_WATCHDOG_ */
+
+#ifdef _INCLUDE_PC_SAMPLER_
+/****************************************************************************
+ Function
+     SampleHandler
+ Parameters
+     int Signal, SIGPROF
+     siginfo_t *pInfo, not used
+     void *pContext, the ucontext_t of the code that was interrupted
+ Returns
+     None.
+ Description
+     records the interrupted PC, the host's version of the timer interrupt
+ Author
+     ags, 10/20/26 02:33
+****************************************************************************/
+static void SampleHandler(int Signal, siginfo_t *pInfo, void *pContext)
+{
+  (void)Signal;
+  (void)pInfo;
+  ES_PCSample_Record((uint32_t)(SAMPLED_PC((ucontext_t *)pContext) -
+      CODE_BASE));
+}
+
+/****************************************************************************
+ Function
+     WritePCSamples
+ Parameters
+     none
+ Returns
+     None.
+ Description
+     called at exit, stops the sampling and writes the histogram to the
+     sample file
+ Author
+     ags, 10/20/26 02:34
+****************************************************************************/
+static void WritePCSamples(void)
+{
+  struct itimerval Stop = { { 0, 0 }, { 0, 0 } };
+
+  setitimer(ITIMER_PROF, &Stop, NULL);
+  if (PCSampleFile != NULL)
+  {
+    ES_PCSample_Write(PCSampleFile);
+    fclose(PCSampleFile);
+    PCSampleFile = NULL;
+  }
+}
+#endif /* _INCLUDE_PC_SAMPLER_ */
+
+/*------------------------------ End of file ------------------------------*/
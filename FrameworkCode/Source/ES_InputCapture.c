@@ -0,0 +1,235 @@
+/****************************************************************************
+ Module
+     ES_InputCapture.c
+
+ Description
+     This is a module implementing input capture (edge timestamping) for the
+     framework. The hardware latches the time of each edge, so the timestamp
+     does not depend on how often the event checkers get to run.
+
+ Notes
+     The capture interrupts (in ES_Port.c, or the host port) convert the
+     latched edge time into a uS timestamp on the ES_HRTimers count and call
+     ES_InputCapture_Edge_Resp, which only copies it into a ring. The ring is
+     drained by ES_InputCapture_Process, called from _HW_Process_Pending_Ints,
+     which works out the period since the last edge on that channel and posts
+     an ES_CAPTURE event to the service configured for the channel.
+     An edge record is too big for the EventParam, so the parameter tells the
+     receiver where to find it: the low byte is a sequence number for the
+     ring slot and the high byte is the channel. Call ES_InputCapture_GetEdge
+     with the parameter to get the record. A slot is re-used after
+     CAPTURE_RING_SIZE more edges, after which GetEdge will return false.
+     All of the capture interrupts run at the same priority, so the ring
+     Head is only ever written by one interrupt at a time.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/19/26 15:06 ags     Began Coding
+****************************************************************************/
+
+/*----------------------------- Include Files -----------------------------*/
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_ServiceHeaders.h"
+#include "ES_General.h"
+#include "ES_Events.h"
+#include "ES_PostList.h"
+#include "ES_InputCapture.h"
+#include "ES_Port.h"
+/*--------------------------- External Variables --------------------------*/
+
+/*----------------------------- Module Defines ----------------------------*/
+// the sequence numbers are 8 bits and must be able to tell a slot that has
+// been re-used from one that has not, so the ring can be at most half that
+#if (CAPTURE_RING_SIZE > 128) || ((CAPTURE_RING_SIZE & (CAPTURE_RING_SIZE - 1)) != 0)
+#error CAPTURE_RING_SIZE must be a power of 2, no larger than 128
+#endif
+
+#define CAPTURE_RING_MASK (CAPTURE_RING_SIZE - 1)
+
+/*------------------------------ Module Types -----------------------------*/
+
+/*---------------------------- Module Functions ---------------------------*/
+
+/*---------------------------- Module Variables ---------------------------*/
+static ES_CaptureRecord_t CaptureRing[CAPTURE_RING_SIZE];
+// free-running sequence numbers, the slot is the sequence & CAPTURE_RING_MASK
+static volatile uint8_t CaptureHead;    /* next slot the interrupts write */
+static uint8_t          CaptureTail;    /* next slot to be posted */
+
+// edges lost because the ring was full when they arrived
+static volatile uint16_t CaptureOverruns;
+
+// the time of the last edge on each channel, to form the period
+static uint32_t LastEdgeTime[NUM_CAPTURE_CHANNELS];
+static bool     LastEdgeValid[NUM_CAPTURE_CHANNELS];
+
+static pPostFunc const Capture2PostFunc[NUM_CAPTURE_CHANNELS] =
+{
+  CAPTURE0_RESP_FUNC,
+  CAPTURE1_RESP_FUNC,
+  CAPTURE2_RESP_FUNC,
+  CAPTURE3_RESP_FUNC
+};
+
+static ES_CaptureEdge_t const CaptureEdges[NUM_CAPTURE_CHANNELS] =
+{
+  CAPTURE0_EDGE,
+  CAPTURE1_EDGE,
+  CAPTURE2_EDGE,
+  CAPTURE3_EDGE
+};
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+     ES_InputCapture_Init
+ Parameters
+     None.
+ Returns
+     None.
+ Description
+     Empties the ring and starts the hardware capture on every channel that
+     has a response function
+ Notes
+     Called from ES_Initialize, after the high resolution timers have been
+     started, when _INCLUDE_INPUT_CAPTURE_ is defined
+ Author
+     ags, 10/19/26 15:10
+****************************************************************************/
+void ES_InputCapture_Init(void)
+{
+  uint8_t i;
+
+  CaptureHead     = 0;
+  CaptureTail     = 0;
+  CaptureOverruns = 0;
+  for (i = 0; i < ARRAY_SIZE(Capture2PostFunc); i++)
+  {
+    LastEdgeValid[i] = false;
+    if (Capture2PostFunc[i] != CAPTURE_UNUSED)
+    {
+      _HW_InputCapture_Init(i, CaptureEdges[i]);
+    }
+  }
+}
+
+/****************************************************************************
+ Function
+     ES_InputCapture_Edge_Resp
+ Parameters
+     uint8_t Channel, the channel that captured the edge
+     uint32_t Timestamp, the time of the edge on the uS count
+ Returns
+     None.
+ Description
+     records an edge in the ring, or counts an overrun if the ring is full
+ Notes
+     Called from the capture interrupt handlers, so keep it short
+ Author
+     ags, 10/19/26 15:14
+****************************************************************************/
+void ES_InputCapture_Edge_Resp(uint8_t Channel, uint32_t Timestamp)
+{
+  uint8_t Slot;
+
+  if ((uint8_t)(CaptureHead - CaptureTail) >= CAPTURE_RING_SIZE)
+  {
+    CaptureOverruns++;
+    return;
+  }
+  Slot = CaptureHead & CAPTURE_RING_MASK;
+  CaptureRing[Slot].Channel   = Channel;
+  CaptureRing[Slot].Timestamp = Timestamp;
+  CaptureRing[Slot].Period    = 0;
+  // only publish the slot once it is filled in
+  CaptureHead++;
+}
+
+/****************************************************************************
+ Function
+     ES_InputCapture_Process
+ Parameters
+     None.
+ Returns
+     None.
+ Description
+     posts an ES_CAPTURE event for every edge that has arrived since the last
+     call, filling in the period since the previous edge on that channel
+ Notes
+     Called from _HW_Process_Pending_Ints, so it runs at the same level as the
+     services and needs no protection from them
+ Author
+     ags, 10/19/26 15:19
+****************************************************************************/
+void ES_InputCapture_Process(void)
+{
+  ES_Event_t  NewEvent;
+  uint8_t     Slot;
+  uint8_t     Channel;
+
+  NewEvent.EventType = ES_CAPTURE;
+  while (CaptureTail != CaptureHead)
+  {
+    Slot    = CaptureTail & CAPTURE_RING_MASK;
+    Channel = CaptureRing[Slot].Channel;
+    if (LastEdgeValid[Channel] == true)
+    {
+      CaptureRing[Slot].Period =
+          CaptureRing[Slot].Timestamp - LastEdgeTime[Channel];
+    }
+    LastEdgeTime[Channel]   = CaptureRing[Slot].Timestamp;
+    LastEdgeValid[Channel]  = true;
+
+    NewEvent.EventParam = ((uint16_t)Channel << 8) | CaptureTail;
+    CaptureTail++;
+    Capture2PostFunc[Channel](NewEvent);
+  }
+}
+
+/****************************************************************************
+ Function
+     ES_InputCapture_GetEdge
+ Parameters
+     uint16_t Param, the EventParam from an ES_CAPTURE event
+     ES_CaptureRecord_t *pEdge, where to copy the edge record
+ Returns
+     bool, false if the slot has already been re-used for a newer edge
+ Description
+     gets the channel, timestamp and period of a captured edge
+ Notes
+     The copy is made with the interrupts off, then checked against the
+     ring Head to make sure that the slot was not being overwritten
+ Author
+     ags, 10/19/26 15:24
+****************************************************************************/
+bool ES_InputCapture_GetEdge(uint16_t Param, ES_CaptureRecord_t *pEdge)
+{
+  uint8_t Seq = (uint8_t)Param;
+  bool    ReturnValue;
+
+  EnterCritical();
+  *pEdge      = CaptureRing[Seq & CAPTURE_RING_MASK];
+  ReturnValue = ((uint8_t)(CaptureHead - Seq) <= CAPTURE_RING_SIZE);
+  ExitCritical();
+  return ReturnValue;
+}
+
+/****************************************************************************
+ Function
+     ES_InputCapture_GetOverruns
+ Parameters
+     None.
+ Returns
+     uint16_t the number of edges lost because the ring was full
+ Author
+     ags, 10/19/26 15:27
+****************************************************************************/
+uint16_t ES_InputCapture_GetOverruns(void)
+{
+  return CaptureOverruns;
+}
+
+/*------------------------------- Footnotes -------------------------------*/
+/*------------------------------ End of file ------------------------------*/
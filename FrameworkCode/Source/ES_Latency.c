@@ -0,0 +1,274 @@
+/****************************************************************************
+ Module
+     ES_Latency.c
+
+ Description
+     This is a module keeping histograms of the queueing latency of each
+     service. The framework stamps every event with ES_Latency_Now as it is
+     posted to a service's queue, keeping the stamps in an array alongside
+     the queue so that ES_Event_t does not grow, and ES_Run records the time
+     since the stamp as it takes the event off the queue.
+
+ Notes
+     The whole module, and the stamping in ES_Framework, compile out unless
+     _INCLUDE_LATENCY_STATS_ is defined in ES_Configure.h.
+     The stamps are the high resolution timer count shifted down by
+     LATENCY_STAMP_SHIFT, kept to 16 bits. A latency of more than 65535 of
+     these units wraps, and is recorded as the remainder.
+     Broadcasts are not stamped, as they are not held in the service queues.
+     The histograms are only written from ES_Run, so they can be read from a
+     service without a critical region.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/19/26 23:48 ags     Began Coding
+****************************************************************************/
+
+/*----------------------------- Include Files -----------------------------*/
+#include "ES_Configure.h"
+#include "ES_General.h"
+#include "ES_HRTimers.h"
+#include "ES_LookupTables.h"
+#include "ES_Latency.h"
+#include <stdio.h>
+
+#ifdef _INCLUDE_LATENCY_STATS_
+/*----------------------------- Module Defines ----------------------------*/
+
+/*---------------------------- Module Functions ---------------------------*/
+static uint32_t BucketLimit(uint8_t Bucket);
+
+/*---------------------------- Module Variables ---------------------------*/
+static uint32_t Histogram[NUM_SERVICES][ES_LATENCY_NUM_BUCKETS];
+static uint32_t NumRecorded[NUM_SERVICES];
+static uint16_t MaxLatency[NUM_SERVICES];
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+     ES_Latency_Reset
+ Parameters
+     None.
+ Returns
+     None.
+ Description
+     clears the histograms of every service
+ Notes
+     called from ES_Initialize
+ Author
+     ags, 10/19/26 23:49
+****************************************************************************/
+void ES_Latency_Reset(void)
+{
+  uint8_t Service;
+  uint8_t Bucket;
+
+  for (Service = 0; Service < NUM_SERVICES; Service++)
+  {
+    for (Bucket = 0; Bucket < ES_LATENCY_NUM_BUCKETS; Bucket++)
+    {
+      Histogram[Service][Bucket] = 0;
+    }
+    NumRecorded[Service]  = 0;
+    MaxLatency[Service]   = 0;
+  }
+}
+
+/****************************************************************************
+ Function
+     ES_Latency_Now
+ Parameters
+     None.
+ Returns
+     uint16_t, the time to stamp a posted event with
+ Description
+     the high resolution timer count, in units of 2^LATENCY_STAMP_SHIFT uS
+ Notes
+     called from the post functions, which may be running in an interrupt
+ Author
+     ags, 10/19/26 23:50
+****************************************************************************/
+uint16_t ES_Latency_Now(void)
+{
+  return (uint16_t)(ES_HRTimer_GetTime() >> LATENCY_STAMP_SHIFT);
+}
+
+/****************************************************************************
+ Function
+     ES_Latency_Record
+ Parameters
+     uint8_t WhichService, the service the event was taken off the queue for
+     uint16_t Latency, the time it spent on the queue, from ES_Latency_Now
+ Returns
+     None.
+ Description
+     counts the latency in the service's histogram
+ Notes
+     called from ES_Run
+ Author
+     ags, 10/19/26 23:51
+****************************************************************************/
+void ES_Latency_Record(uint8_t WhichService, uint16_t Latency)
+{
+  uint8_t Bucket;
+
+  if (WhichService >= NUM_SERVICES)
+  {
+    return;
+  }
+  // the bucket is the number of significant bits in the latency
+  Bucket = (Latency == 0) ? 0 : (uint8_t)(ES_GetMSBitSet(Latency) + 1);
+  Histogram[WhichService][Bucket]++;
+  NumRecorded[WhichService]++;
+  if (Latency > MaxLatency[WhichService])
+  {
+    MaxLatency[WhichService] = Latency;
+  }
+}
+
+/****************************************************************************
+ Function
+     ES_Latency_GetHistogram
+ Parameters
+     uint8_t WhichService, the service to report on
+     uint32_t *pBuckets, where to copy its ES_LATENCY_NUM_BUCKETS counts
+ Returns
+     bool, false if the service does not exist
+ Description
+     copies the service's histogram
+ Author
+     ags, 10/19/26 23:52
+****************************************************************************/
+bool ES_Latency_GetHistogram(uint8_t WhichService, uint32_t *pBuckets)
+{
+  uint8_t Bucket;
+
+  if (WhichService >= NUM_SERVICES)
+  {
+    return false;
+  }
+  for (Bucket = 0; Bucket < ES_LATENCY_NUM_BUCKETS; Bucket++)
+  {
+    pBuckets[Bucket] = Histogram[WhichService][Bucket];
+  }
+  return true;
+}
+
+/****************************************************************************
+ Function
+     ES_Latency_GetPercentile
+ Parameters
+     uint8_t WhichService, the service to report on
+     uint8_t Percent, the percentile wanted, 1 to 100
+ Returns
+     uint32_t, the latency in uS that at least Percent % of the service's
+     events were taken off the queue within, 0 if none have been recorded
+ Description
+     finds the bucket holding the percentile and returns its upper limit
+ Notes
+     the answer is only as fine as the buckets, so it may be up to twice
+     the true percentile
+ Author
+     ags, 10/19/26 23:53
+****************************************************************************/
+uint32_t ES_Latency_GetPercentile(uint8_t WhichService, uint8_t Percent)
+{
+  uint32_t  Needed;
+  uint32_t  Counted = 0;
+  uint8_t   Bucket;
+
+  if ((WhichService >= NUM_SERVICES) || (NumRecorded[WhichService] == 0))
+  {
+    return 0;
+  }
+  if (Percent > 100)
+  {
+    Percent = 100;
+  }
+  // the number of events that must be at or below the answer, rounded up
+  Needed = (uint32_t)(((uint64_t)NumRecorded[WhichService] * Percent + 99) /
+      100);
+  for (Bucket = 0; Bucket < (ES_LATENCY_NUM_BUCKETS - 1); Bucket++)
+  {
+    Counted += Histogram[WhichService][Bucket];
+    if (Counted >= Needed)
+    {
+      break;
+    }
+  }
+  return BucketLimit(Bucket);
+}
+
+/****************************************************************************
+ Function
+     ES_Latency_GetMax
+ Parameters
+     uint8_t WhichService, the service to report on
+ Returns
+     uint32_t, the longest latency recorded for the service, in uS
+ Author
+     ags, 10/19/26 23:54
+****************************************************************************/
+uint32_t ES_Latency_GetMax(uint8_t WhichService)
+{
+  if (WhichService >= NUM_SERVICES)
+  {
+    return 0;
+  }
+  return (uint32_t)MaxLatency[WhichService] << LATENCY_STAMP_SHIFT;
+}
+
+/****************************************************************************
+ Function
+     ES_Latency_Dump
+ Parameters
+     None.
+ Returns
+     None.
+ Description
+     prints the number of events, the 50th, 90th and 99th percentiles and
+     the maximum latency in uS for every service that has had an event
+ Author
+     ags, 10/19/26 23:55
+****************************************************************************/
+void ES_Latency_Dump(void)
+{
+  uint8_t Service;
+
+  printf("\r\nService      Count     p50     p90     p99     Max\r\n");
+  for (Service = 0; Service < NUM_SERVICES; Service++)
+  {
+    if (NumRecorded[Service] != 0)
+    {
+      printf("%7u %10lu %7lu %7lu %7lu %7lu\r\n", Service,
+          (unsigned long)NumRecorded[Service],
+          (unsigned long)ES_Latency_GetPercentile(Service, 50),
+          (unsigned long)ES_Latency_GetPercentile(Service, 90),
+          (unsigned long)ES_Latency_GetPercentile(Service, 99),
+          (unsigned long)ES_Latency_GetMax(Service));
+    }
+  }
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+/****************************************************************************
+ Function
+     BucketLimit
+ Parameters
+     uint8_t Bucket, the histogram bucket
+ Returns
+     uint32_t, the upper limit of the latencies in the bucket, in uS
+ Author
+     ags, 10/19/26 23:56
+****************************************************************************/
+static uint32_t BucketLimit(uint8_t Bucket)
+{
+  return (((uint32_t)1 << Bucket) - 1) << LATENCY_STAMP_SHIFT;
+}
+
+#endif /* _INCLUDE_LATENCY_STATS_ */
+/*------------------------------- Footnotes -------------------------------*/
+/*------------------------------ End of file ------------------------------*/
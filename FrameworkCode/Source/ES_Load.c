@@ -0,0 +1,354 @@
+/****************************************************************************
+ Module
+     ES_Load.c
+
+ Description
+     This is a module accounting for where ES_Run spends its time, so that
+     the headroom left on the processor can be measured. ES_Run tells it
+     each time it moves between dispatching events, processing the pending
+     interrupts and calling the event checkers, and the time since the last
+     move is charged to what it was doing. A pass through the pending
+     interrupts that gave no work, and a pass through the event checkers
+     that found nothing, are charged as idle, as that is where ES_Run spins
+     when there is no work. Everything else counts towards the load.
+
+ Notes
+     The whole module, and the calls to it from ES_Run, compile out unless
+     _INCLUDE_LOAD_STATS_ is defined in ES_Configure.h.
+     The time is cut into windows of LOAD_WINDOW_MS. The load is worked out
+     for each window as it closes, and the sliding load is the mean of the
+     last LOAD_NUM_WINDOWS of them. A window only closes when ES_Run next
+     moves, so a long run function stretches the window that it is in, and
+     that window's load is still correct over its actual length.
+     Time spent in interrupt handlers is charged to whatever ES_Run was
+     doing when they fired.
+     With LOAD_REPORT_FUNC defined, an ES_LOAD_REPORT event carrying the
+     sliding load is posted to it every LOAD_NUM_WINDOWS windows.
+     The statistics are only written from ES_Run, so they can be read from a
+     service without a critical region.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/20/26 06:35 ags     a pass through the pending interrupts that gives no
+                        work is idle
+ 10/20/26 01:36 ags     Began Coding
+****************************************************************************/
+
+/*----------------------------- Include Files -----------------------------*/
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_ServiceHeaders.h"
+#include "ES_General.h"
+#include "ES_HRTimers.h"
+#include "ES_Load.h"
+#include <stdio.h>
+
+#ifdef _INCLUDE_LOAD_STATS_
+/*----------------------------- Module Defines ----------------------------*/
+#define WINDOW_LENGTH ((uint32_t)LOAD_WINDOW_MS * 1000)
+
+#if LOAD_NUM_WINDOWS < 1
+#error LOAD_NUM_WINDOWS must be at least 1
+#endif
+
+/*---------------------------- Module Functions ---------------------------*/
+static void CloseWindow(uint32_t Now);
+static void PrintLoad(const char *pLabel, uint16_t Load);
+
+/*---------------------------- Module Variables ---------------------------*/
+// what ES_Run is doing now, and since when
+static ES_LoadCategory_t  Current = ES_LOAD_DISPATCH;
+static uint32_t           SliceStart;
+static uint64_t           TotalTime[ES_LOAD_NUM_CATEGORIES];
+
+// the window that is open
+static uint32_t WindowStart;
+static uint32_t WindowBusy;
+
+// the loads of the windows that have closed, oldest overwritten first
+static uint16_t WindowLoad[LOAD_NUM_WINDOWS];
+static uint8_t  NextWindow;
+static uint8_t  NumWindows;
+static uint16_t LastWindowLoad;
+static uint16_t PeakWindowLoad;
+
+#ifdef LOAD_REPORT_FUNC
+static uint8_t WindowsSinceReport;
+#endif
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+     ES_Load_Reset
+ Parameters
+     None.
+ Returns
+     None.
+ Description
+     clears the times and the window loads, and opens a new window
+ Notes
+     called as ES_Run starts. It may also be called from a service, and
+     the accounting carries on from then.
+ Author
+     ags, 10/20/26 01:38
+****************************************************************************/
+void ES_Load_Reset(void)
+{
+  uint8_t i;
+
+  for (i = 0; i < ES_LOAD_NUM_CATEGORIES; i++)
+  {
+    TotalTime[i] = 0;
+  }
+  for (i = 0; i < LOAD_NUM_WINDOWS; i++)
+  {
+    WindowLoad[i] = 0;
+  }
+  NextWindow      = 0;
+  NumWindows      = 0;
+  LastWindowLoad  = 0;
+  PeakWindowLoad  = 0;
+#ifdef LOAD_REPORT_FUNC
+  WindowsSinceReport = 0;
+#endif
+  SliceStart  = ES_HRTimer_GetTime();
+  WindowStart = SliceStart;
+  WindowBusy  = 0;
+}
+
+/****************************************************************************
+ Function
+     ES_Load_Enter
+ Parameters
+     ES_LoadCategory_t NewCategory, what ES_Run is about to do
+ Returns
+     None.
+ Description
+     charges the time since the last call to what ES_Run was doing, then
+     closes the window if it has run its length
+ Notes
+     called from ES_Run
+ Author
+     ags, 10/20/26 01:41
+****************************************************************************/
+void ES_Load_Enter(ES_LoadCategory_t NewCategory)
+{
+  uint32_t Now = ES_HRTimer_GetTime();
+  uint32_t Elapsed = Now - SliceStart;
+
+  TotalTime[Current] += Elapsed;
+  if (Current != ES_LOAD_IDLE)
+  {
+    WindowBusy += Elapsed;
+  }
+  Current     = NewCategory;
+  SliceStart  = Now;
+
+  if ((Now - WindowStart) >= WINDOW_LENGTH)
+  {
+    CloseWindow(Now);
+  }
+}
+
+/****************************************************************************
+ Function
+     ES_Load_Recategorize
+ Parameters
+     ES_LoadCategory_t NewCategory, what ES_Run turned out to be doing
+ Returns
+     None.
+ Description
+     changes what the time since the last ES_Load_Enter is charged to
+ Notes
+     used by ES_Run to charge a pass through the pending interrupts that
+     gave no work, or through the event checkers that found nothing, as idle
+ Author
+     ags, 10/20/26 01:43
+****************************************************************************/
+void ES_Load_Recategorize(ES_LoadCategory_t NewCategory)
+{
+  Current = NewCategory;
+}
+
+/****************************************************************************
+ Function
+     ES_Load_Get
+ Parameters
+     None.
+ Returns
+     uint16_t, the sliding load in tenths of a percent
+ Description
+     returns the mean load of the last LOAD_NUM_WINDOWS windows, or of as
+     many as have closed since the reset
+ Notes
+     0 until the first window has closed
+ Author
+     ags, 10/20/26 01:45
+****************************************************************************/
+uint16_t ES_Load_Get(void)
+{
+  uint32_t  Sum = 0;
+  uint8_t   i;
+
+  if (NumWindows == 0)
+  {
+    return 0;
+  }
+  for (i = 0; i < NumWindows; i++)
+  {
+    Sum += WindowLoad[i];
+  }
+  return (uint16_t)(Sum / NumWindows);
+}
+
+/****************************************************************************
+ Function
+     ES_Load_GetPeak
+ Parameters
+     None.
+ Returns
+     uint16_t, the peak load in tenths of a percent
+ Description
+     returns the load of the busiest window since the reset
+ Author
+     ags, 10/20/26 01:46
+****************************************************************************/
+uint16_t ES_Load_GetPeak(void)
+{
+  return PeakWindowLoad;
+}
+
+/****************************************************************************
+ Function
+     ES_Load_GetStats
+ Parameters
+     ES_LoadStats_t *pStats, where to copy the statistics
+ Returns
+     None.
+ Description
+     copies the time charged to each category since the reset, with the
+     sliding, last window and peak loads
+ Notes
+     the time of the slice that is under way is not included
+ Author
+     ags, 10/20/26 01:47
+****************************************************************************/
+void ES_Load_GetStats(ES_LoadStats_t *pStats)
+{
+  uint8_t i;
+
+  for (i = 0; i < ES_LOAD_NUM_CATEGORIES; i++)
+  {
+    pStats->Time[i] = TotalTime[i];
+  }
+  pStats->Load        = ES_Load_Get();
+  pStats->LastWindow  = LastWindowLoad;
+  pStats->PeakWindow  = PeakWindowLoad;
+}
+
+/****************************************************************************
+ Function
+     ES_Load_Dump
+ Parameters
+     None.
+ Returns
+     None.
+ Description
+     prints the loads and the share of the time in each category
+ Author
+     ags, 10/20/26 01:49
+****************************************************************************/
+void ES_Load_Dump(void)
+{
+  static const char * const Names[ES_LOAD_NUM_CATEGORIES] =
+  {
+    "dispatch", "checkers", "pending ints", "idle"
+  };
+  uint64_t  Total = 0;
+  uint8_t   i;
+
+  for (i = 0; i < ES_LOAD_NUM_CATEGORIES; i++)
+  {
+    Total += TotalTime[i];
+  }
+  printf("\r\n");
+  PrintLoad("load", ES_Load_Get());
+  PrintLoad("last window", LastWindowLoad);
+  PrintLoad("peak window", PeakWindowLoad);
+  for (i = 0; i < ES_LOAD_NUM_CATEGORIES; i++)
+  {
+    PrintLoad(Names[i],
+        (Total == 0) ? 0 : (uint16_t)((TotalTime[i] * 1000) / Total));
+  }
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+/****************************************************************************
+ Function
+     CloseWindow
+ Parameters
+     uint32_t Now, the HR timer count as the window closes
+ Returns
+     None.
+ Description
+     works out the load of the window, adds it to the sliding load and the
+     peak, opens the next window and posts the report if one is due
+ Author
+     ags, 10/20/26 01:52
+****************************************************************************/
+static void CloseWindow(uint32_t Now)
+{
+  uint16_t Load;
+
+  // 64 bits, as a run function may have stretched the window a long way
+  Load = (uint16_t)(((uint64_t)WindowBusy * 1000) / (Now - WindowStart));
+
+  WindowLoad[NextWindow] = Load;
+  NextWindow = (NextWindow + 1) % LOAD_NUM_WINDOWS;
+  if (NumWindows < LOAD_NUM_WINDOWS)
+  {
+    NumWindows++;
+  }
+  LastWindowLoad = Load;
+  if (Load > PeakWindowLoad)
+  {
+    PeakWindowLoad = Load;
+  }
+  WindowStart = Now;
+  WindowBusy  = 0;
+
+#ifdef LOAD_REPORT_FUNC
+  if (++WindowsSinceReport >= LOAD_NUM_WINDOWS)
+  {
+    ES_Event_t Report;
+
+    WindowsSinceReport  = 0;
+    Report.EventType    = ES_LOAD_REPORT;
+    Report.EventParam   = ES_Load_Get();
+    LOAD_REPORT_FUNC(Report);
+  }
+#endif
+}
+
+/****************************************************************************
+ Function
+     PrintLoad
+ Parameters
+     const char *pLabel, what the figure is
+     uint16_t Load, in tenths of a percent
+ Returns
+     None.
+ Author
+     ags, 10/20/26 01:53
+****************************************************************************/
+static void PrintLoad(const char *pLabel, uint16_t Load)
+{
+  printf("%-12s %3u.%u%%\r\n", pLabel, Load / 10, Load % 10);
+}
+
+#endif /* _INCLUDE_LOAD_STATS_ */
+/*------------------------------- Footnotes -------------------------------*/
+/*------------------------------ End of file ------------------------------*/
@@ -0,0 +1,241 @@
+/****************************************************************************
+ Module
+     ES_PCSample.c
+
+ Description
+     This is a module implementing a statistical profiler. A timer interrupt
+     (SIGPROF on the host) samples the PC of the code it interrupted, and
+     the samples are counted in a histogram over the program's code. Over a
+     long enough run, the share of the samples that land in a function is
+     the share of the time spent in it, so the hot spots show up without
+     changing any of the code being measured.
+
+ Notes
+     The whole module compiles out unless _INCLUDE_PC_SAMPLER_ is defined in
+     ES_Configure.h.
+     The samples are taken at PC_SAMPLE_RATE_HZ, which should not be a
+     multiple of the tick rate, or the samples fall at the same point in
+     the tick every time.
+     The histogram covers PC_SAMPLE_NUM_BUCKETS << PC_SAMPLE_SHIFT bytes
+     from the start of the code. Samples beyond that, or in a shared
+     library on the host, are only counted as outside. The buckets saturate
+     at 65535 samples.
+     The samples are recorded from the interrupt, so ES_PCSample_Reset
+     clears the histogram in a critical region. Reading it while the
+     sampler runs gives counts that may be a sample or so apart.
+     The output of ES_PCSample_Write is one header line, a line for each
+     bucket with samples, and an end line, for example:
+       # ES_PCSample base 0x00000000 shift 5 rate 997 samples 2000 outside 3
+       000012c0 417
+       # end
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/20/26 02:06 ags     Began Coding
+****************************************************************************/
+
+/*----------------------------- Include Files -----------------------------*/
+#include "ES_Configure.h"
+#include "ES_General.h"
+#include "ES_Port.h"
+#include "ES_PCSample.h"
+
+#ifdef _INCLUDE_PC_SAMPLER_
+/*----------------------------- Module Defines ----------------------------*/
+#define MAX_COUNT 0xFFFF
+
+/*---------------------------- Module Functions ---------------------------*/
+
+/*---------------------------- Module Variables ---------------------------*/
+static uint16_t Histogram[PC_SAMPLE_NUM_BUCKETS];
+static uint32_t NumSamples;
+static uint32_t NumOutside;
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+     ES_PCSample_Init
+ Parameters
+     None.
+ Returns
+     None.
+ Description
+     clears the histogram and starts the sampling interrupt
+ Notes
+     called from ES_Initialize
+ Author
+     ags, 10/20/26 02:08
+****************************************************************************/
+void ES_PCSample_Init(void)
+{
+  ES_PCSample_Reset();
+  _HW_PCSample_Init(PC_SAMPLE_RATE_HZ);
+}
+
+/****************************************************************************
+ Function
+     ES_PCSample_Reset
+ Parameters
+     None.
+ Returns
+     None.
+ Description
+     clears the histogram and the sample counts
+ Notes
+     must not be called from within a critical region
+ Author
+     ags, 10/20/26 02:09
+****************************************************************************/
+void ES_PCSample_Reset(void)
+{
+  uint16_t i;
+
+  EnterCritical();
+  for (i = 0; i < PC_SAMPLE_NUM_BUCKETS; i++)
+  {
+    Histogram[i] = 0;
+  }
+  NumSamples = 0;
+  NumOutside = 0;
+  ExitCritical();
+}
+
+/****************************************************************************
+ Function
+     ES_PCSample_Record
+ Parameters
+     uint32_t Offset, the sampled PC less the start of the code
+ Returns
+     None.
+ Description
+     counts the sample in its bucket
+ Notes
+     called from the sampling interrupt in the port
+ Author
+     ags, 10/20/26 02:10
+****************************************************************************/
+void ES_PCSample_Record(uint32_t Offset)
+{
+  uint32_t Bucket = Offset >> PC_SAMPLE_SHIFT;
+
+  NumSamples++;
+  if (Bucket >= PC_SAMPLE_NUM_BUCKETS)
+  {
+    NumOutside++;
+  }
+  else if (Histogram[Bucket] != MAX_COUNT)
+  {
+    Histogram[Bucket]++;
+  }
+}
+
+/****************************************************************************
+ Function
+     ES_PCSample_GetCount
+ Parameters
+     uint16_t Bucket, which bucket of the histogram
+ Returns
+     uint16_t, the samples in the bucket, 0 if there is no such bucket
+ Description
+     the bucket covers the code from Bucket << PC_SAMPLE_SHIFT
+ Author
+     ags, 10/20/26 02:11
+****************************************************************************/
+uint16_t ES_PCSample_GetCount(uint16_t Bucket)
+{
+  if (Bucket >= PC_SAMPLE_NUM_BUCKETS)
+  {
+    return 0;
+  }
+  return Histogram[Bucket];
+}
+
+/****************************************************************************
+ Function
+     ES_PCSample_GetTotal
+ Parameters
+     None.
+ Returns
+     uint32_t, the number of samples taken since the reset
+ Author
+     ags, 10/20/26 02:12
+****************************************************************************/
+uint32_t ES_PCSample_GetTotal(void)
+{
+  return NumSamples;
+}
+
+/****************************************************************************
+ Function
+     ES_PCSample_GetOutside
+ Parameters
+     None.
+ Returns
+     uint32_t, the number of samples that fell outside the histogram
+ Author
+     ags, 10/20/26 02:12
+****************************************************************************/
+uint32_t ES_PCSample_GetOutside(void)
+{
+  return NumOutside;
+}
+
+/****************************************************************************
+ Function
+     ES_PCSample_Write
+ Parameters
+     FILE *pFile, where to write the histogram
+ Returns
+     None.
+ Description
+     writes the histogram in the form read by Tools/ES_PCSymbolize.py
+ Notes
+     the host port writes it to a file at exit. On the target, everything
+     written goes out on the console, see ES_PCSample_Dump
+ Author
+     ags, 10/20/26 02:14
+****************************************************************************/
+void ES_PCSample_Write(FILE *pFile)
+{
+  uint16_t i;
+
+  fprintf(pFile, "# ES_PCSample base 0x%08lx shift %u rate %u samples %lu "
+      "outside %lu\r\n", (unsigned long)_HW_PCSample_GetCodeBase(),
+      PC_SAMPLE_SHIFT, PC_SAMPLE_RATE_HZ, (unsigned long)NumSamples,
+      (unsigned long)NumOutside);
+  for (i = 0; i < PC_SAMPLE_NUM_BUCKETS; i++)
+  {
+    if (Histogram[i] != 0)
+    {
+      fprintf(pFile, "%08lx %u\r\n", (unsigned long)i << PC_SAMPLE_SHIFT,
+          Histogram[i]);
+    }
+  }
+  fprintf(pFile, "# end\r\n");
+}
+
+/****************************************************************************
+ Function
+     ES_PCSample_Dump
+ Parameters
+     None.
+ Returns
+     None.
+ Description
+     writes the histogram to the console, from where it can be saved for
+     Tools/ES_PCSymbolize.py
+ Notes
+     printing takes a long time, and is sampled like anything else, so
+     reset the histogram after it
+ Author
+     ags, 10/20/26 02:15
+****************************************************************************/
+void ES_PCSample_Dump(void)
+{
+  ES_PCSample_Write(stdout);
+}
+
+#endif /* _INCLUDE_PC_SAMPLER_ */
+/*------------------------------- Footnotes -------------------------------*/
+/*------------------------------ End of file ------------------------------*/
@@ -15,6 +15,22 @@
  History
  When           Who     What/Why
  -------------- ---     --------
+ 10/20/26 06:25 ags     the uDMA control table only holds the channels up to
+                        the one in use, rather than the whole 1KB
+ 10/20/26 05:35 ags     input capture leaves the timer configuration alone
+                        when the other half of the block is already running
+ 10/20/26 04:29 ags     added _HW_InInterrupt
+ 10/20/26 03:38 ags     added the hardware watchdog on Watchdog 0
+ 10/20/26 02:20 ags     added the PC sampling interrupt on Timer 1A for
+                        ES_PCSample
+ 10/20/26 01:20 ags     the byte debug port is fed from a RAM ring by the
+                        uDMA, so the calls no longer wait on the SSI
+ 10/20/26 00:44 ags     added the trace output on UART1 for ES_Trace
+ 10/19/26 23:26 ags     added the DWT cycle counter for ES_Profiler
+ 10/19/26 15:40 ags     added edge-time input capture on Wide Timers 1 & 2
+                        for ES_InputCapture
+ 10/19/26 10:12 ags     added the free-running uS timer with match interrupt
+                        on Wide Timer 0A to support ES_HRTimers
  08/21/17 13:47 jec     added functions to init 2 lines for debugging the framework
                         and functions to set & clear those lines.
  03/13/14 10:30	joa		  Updated files to use with Cortex M4 processor core.
@@ -33,6 +49,11 @@
 #include "inc/hw_gpio.h"
 #include "inc/hw_ssi.h"
 #include "inc/hw_sysctl.h"
+#include "inc/hw_timer.h"
+#include "inc/hw_uart.h"
+#include "inc/hw_watchdog.h"
+#include "inc/hw_ints.h"
+#include "inc/hw_nvic.h"
 #include "inc\tm4c123gh6pm.h"
 #include "driverlib/sysctl.h"
 #include "driverlib/interrupt.h"
@@ -41,11 +62,16 @@
 #include "driverlib/systick.h"
 #include "driverlib/gpio.h"
 #include "driverlib/ssi.h"
+#include "driverlib/udma.h"
 #include "utils/uartstdio.h"
 
+#include "ES_Configure.h"
 #include "ES_Port.h"
 #include "ES_Types.h"
 #include "ES_Timers.h"
+#include "ES_HRTimers.h"
+#include "ES_InputCapture.h"
+#include "ES_PCSample.h"
 
 #define UART_PORT 0
 #define UART_BAUD 115200UL
@@ -71,6 +97,69 @@
 // used to set CPSDVSR on SSI1, large, even value for debugging, 2 for production
 #define BYTE_DEBUG_SSI1__DIVISOR 2
 
+// the number of bytes that can be waiting for the uDMA to send them to the
+// '595. This must be a power of 2, no larger than 128
+#define BYTE_DEBUG_RING_SIZE 64
+#define BYTE_DEBUG_RING_MASK (BYTE_DEBUG_RING_SIZE - 1)
+
+// the highest uDMA channel in use, the SSI1 Tx for the byte debug port
+#define UDMA_LAST_CHANNEL 25
+
+// the high resolution timer runs on Wide Timer 0, timer A in 32 bit mode
+// counting down with the prescaler set to give 1uS per count
+#define HR_TIMER_BASE WTIMER0_BASE
+#define HR_TIMER_PRESCALE ((CLK_FREQ / 1000000UL) - 1)
+
+// the input capture timers count system clocks, this converts to uS
+#define CAPTURE_CLKS_PER_uS (CLK_FREQ / 1000000UL)
+
+// the Cortex-M4 debug registers that start the DWT cycle counter, TRCENA in
+// the DEMCR enables the DWT, then CYCCNTENA starts the count
+#define CORE_DEBUG_DEMCR  0xE000EDFCUL
+#define DEMCR_TRCENA      BIT24HI
+#define DWT_CTRL          0xE0001000UL
+#define DWT_CTRL_CYCCNTENA BIT0HI
+#define DWT_CYCCNT        0xE0001004UL
+
+// the trace goes out on UART1 Tx (PB1) at 1Mbaud, clocked from the system
+// clock. The divisor is in 1/64ths: BRD = CLK_FREQ / (16 * baud), rounded
+#define TRACE_UART_BAUD 1000000UL
+#define TRACE_UART_BRD64 ((((CLK_FREQ * 8) / TRACE_UART_BAUD) + 1) / 2)
+
+// the PC sampler runs on Timer 1, timer A in 32 bit periodic mode counting
+// system clocks. The interrupted PC is the 7th word of the exception frame
+#define PC_SAMPLE_TIMER_BASE TIMER1_BASE
+#define EXC_FRAME_PC 6
+
+// the timer B bits in the CTL, IMR & ICR registers are the timer A bits
+// shifted up by 8
+#define TIMER_B_SHIFT 8
+
+// the hardware behind each input capture channel
+typedef struct
+{
+  uint32_t TimerBase;
+  uint8_t  Shift;           /* 0 for timer A, TIMER_B_SHIFT for timer B */
+  uint32_t TimerPeriph;
+  uint32_t GPIOPeriph;
+  uint32_t GPIOBase;
+  uint8_t  Pin;
+  uint32_t PinConfig;
+  uint32_t IntNum;
+}CaptureChannel_t;
+
+static const CaptureChannel_t CaptureChannels[NUM_CAPTURE_CHANNELS] =
+{
+  { WTIMER1_BASE, 0, SYSCTL_PERIPH_WTIMER1, SYSCTL_PERIPH_GPIOC,
+    GPIO_PORTC_BASE, GPIO_PIN_6, GPIO_PC6_WT1CCP0, INT_WTIMER1A },
+  { WTIMER1_BASE, TIMER_B_SHIFT, SYSCTL_PERIPH_WTIMER1, SYSCTL_PERIPH_GPIOC,
+    GPIO_PORTC_BASE, GPIO_PIN_7, GPIO_PC7_WT1CCP1, INT_WTIMER1B },
+  { WTIMER2_BASE, 0, SYSCTL_PERIPH_WTIMER2, SYSCTL_PERIPH_GPIOD,
+    GPIO_PORTD_BASE, GPIO_PIN_0, GPIO_PD0_WT2CCP0, INT_WTIMER2A },
+  { WTIMER2_BASE, TIMER_B_SHIFT, SYSCTL_PERIPH_WTIMER2, SYSCTL_PERIPH_GPIOD,
+    GPIO_PORTD_BASE, GPIO_PIN_1, GPIO_PD1_WT2CCP1, INT_WTIMER2B }
+};
+
 // TickCount is used to track the number of timer ints that have occurred
 // since the last check. It should really never be more than 1, but just to
 // be sure, we increment it in the interrupt response rather than simply
@@ -94,6 +183,27 @@ uint32_t _PRIMASK_temp;
 
 static uint8_t ByteDebugPortShadow = 0;
 
+// the bytes waiting to go out to the '595. Head and Tail are free-running,
+// the slot is the count & BYTE_DEBUG_RING_MASK. The bytes from Tail are in
+// the uDMA transfer that is under way, ByteDebugInFlight of them, 0 if the
+// uDMA is idle
+static uint8_t          ByteDebugRing[BYTE_DEBUG_RING_SIZE];
+static volatile uint8_t ByteDebugHead;
+static volatile uint8_t ByteDebugTail;
+static volatile uint8_t ByteDebugInFlight;
+
+// the uDMA channel control table. It must start on a 1024 byte boundary,
+// but only the primary entries up to the SSI1 Tx channel are used (basic
+// mode never reaches the alternate half), so the rest of the 1KB is left
+// for other variables. Raise UDMA_LAST_CHANNEL if another channel is used.
+static tDMAControlTable uDMAControlTable[UDMA_LAST_CHANNEL + 1]
+    __attribute__((aligned(1024)));
+
+/*---------------------------- Module Functions ---------------------------*/
+static void CaptureResponse(uint8_t Channel);
+static void ByteDebugPut(uint8_t NewValue);
+static void StartByteDebugTransfer(void);
+
 /****************************************************************************
  Function
      _HW_Timer_Init
@@ -166,6 +276,24 @@ uint16_t _HW_GetTickCount(void)
   return SysTickCounter;
 }
 
+/****************************************************************************
+ Function
+     _HW_InInterrupt
+ Parameters
+     none
+ Returns
+     bool, true if called from an interrupt (or other exception) handler
+ Description
+     reads the active exception number from the NVIC, which is 0 in thread
+     mode
+ Author
+     ags, 10/20/26 04:30
+****************************************************************************/
+bool _HW_InInterrupt(void)
+{
+  return (HWREG(NVIC_INT_CTRL) & NVIC_INT_CTRL_VEC_ACT_M) != 0;
+}
+
 /****************************************************************************
  Function
      _HW_Process_Pending_Ints
@@ -195,9 +323,501 @@ bool _HW_Process_Pending_Ints(void)
     ES_Timer_Tick_Resp();
     TickCount--;
   }
+#ifdef _INCLUDE_INPUT_CAPTURE_
+  /* post the edges that the capture interrupts have collected */
+  ES_InputCapture_Process();
+#endif
   return true;  // always return true to allow loop test in ES_Run to proceed
 }
 
+/****************************************************************************
+ Function
+     _HW_HRTimer_Init
+ Parameters
+     none
+ Returns
+     None.
+ Description
+     Sets up Wide Timer 0A as a free-running 32 bit count of uS with the
+     match interrupt available to ES_HRTimers
+ Notes
+     In down-count mode the prescaler is a true prescaler (counting up it
+     becomes a timer extension), so we count down from 0xFFFFFFFF and
+     complement the count to present an up-counting time to the framework
+ Author
+     ags, 10/19/26 10:15
+****************************************************************************/
+void _HW_HRTimer_Init(void)
+{
+  // enable the clock to the wide timer and wait for it to be ready
+  HWREG(SYSCTL_RCGCWTIMER) |= SYSCTL_RCGCWTIMER_R0;
+  while ((HWREG(SYSCTL_PRWTIMER) & SYSCTL_PRWTIMER_R0) != SYSCTL_PRWTIMER_R0)
+  {
+    ;
+  }
+  // make sure that timer A is disabled before configuring
+  HWREG(HR_TIMER_BASE + TIMER_O_CTL) &= ~TIMER_CTL_TAEN;
+  // individual (32 bit for a wide timer) mode
+  HWREG(HR_TIMER_BASE + TIMER_O_CFG) = TIMER_CFG_16_BIT;
+  // periodic, counting down, with the match interrupt enabled
+  HWREG(HR_TIMER_BASE + TIMER_O_TAMR) = TIMER_TAMR_TAMR_PERIOD |
+      TIMER_TAMR_TAMIE;
+  // full range count and 1uS per count
+  HWREG(HR_TIMER_BASE + TIMER_O_TAILR) = 0xFFFFFFFF;
+  HWREG(HR_TIMER_BASE + TIMER_O_TAPR)  = HR_TIMER_PRESCALE;
+  HWREG(HR_TIMER_BASE + TIMER_O_TAPMR) = 0;
+  // no match armed until a timer is started
+  HWREG(HR_TIMER_BASE + TIMER_O_IMR) &= ~TIMER_IMR_TAMIM;
+  HWREG(HR_TIMER_BASE + TIMER_O_ICR) = TIMER_ICR_TAMCINT;
+  IntEnable(INT_WTIMER0A);
+  // start it running, stalling with the debugger
+  HWREG(HR_TIMER_BASE + TIMER_O_CTL) |= (TIMER_CTL_TAEN | TIMER_CTL_TASTALL);
+}
+
+/****************************************************************************
+ Function
+     _HW_HRTimer_GetCount
+ Parameters
+     none
+ Returns
+     uint32_t the free-running uS count
+ Description
+     returns the current value of the uS count, counting up
+ Author
+     ags, 10/19/26 10:21
+****************************************************************************/
+uint32_t _HW_HRTimer_GetCount(void)
+{
+  return ~HWREG(HR_TIMER_BASE + TIMER_O_TAR);
+}
+
+/****************************************************************************
+ Function
+     _HW_HRTimer_SetMatch
+ Parameters
+     uint32_t MatchTime, the value of the uS count at which to interrupt
+ Returns
+     None.
+ Description
+     programs the match register and enables the match interrupt. If the
+     match time has already passed, the interrupt is pended so that it will
+     be serviced right away rather than after the count wraps.
+ Author
+     ags, 10/19/26 10:24
+****************************************************************************/
+void _HW_HRTimer_SetMatch(uint32_t MatchTime)
+{
+  HWREG(HR_TIMER_BASE + TIMER_O_TAMATCHR) = ~MatchTime;
+  HWREG(HR_TIMER_BASE + TIMER_O_IMR) |= TIMER_IMR_TAMIM;
+  if ((int32_t)(MatchTime - _HW_HRTimer_GetCount()) <= 0)
+  {
+    IntPendSet(INT_WTIMER0A);
+  }
+}
+
+/****************************************************************************
+ Function
+     _HW_HRTimer_DisableMatch
+ Parameters
+     none
+ Returns
+     None.
+ Description
+     disables the match interrupt, the count keeps running
+ Author
+     ags, 10/19/26 10:26
+****************************************************************************/
+void _HW_HRTimer_DisableMatch(void)
+{
+  HWREG(HR_TIMER_BASE + TIMER_O_IMR) &= ~TIMER_IMR_TAMIM;
+}
+
+/****************************************************************************
+ Function
+     HRTimerIntHandler
+ Parameters
+     none
+ Returns
+     None.
+ Description
+     interrupt response routine for the Wide Timer 0A match
+ Notes
+     unlike the tick, the response is run right here in the interrupt so
+     that the timeouts are posted with uS accuracy
+ Author
+     ags, 10/19/26 10:28
+****************************************************************************/
+void HRTimerIntHandler(void)
+{
+  // start by clearing the source of the interrupt
+  HWREG(HR_TIMER_BASE + TIMER_O_ICR) = TIMER_ICR_TAMCINT;
+  ES_HRTimer_Match_Resp();
+}
+
+/****************************************************************************
+ Function
+     _HW_InputCapture_Init
+ Parameters
+     uint8_t Channel, the capture channel to start
+     ES_CaptureEdge_t Edge, the edge(s) to capture
+ Returns
+     None.
+ Description
+     Sets up the wide timer half behind the channel in edge-time capture
+     mode, counting system clocks, and connects it to its pin
+ Notes
+     In edge-time mode counting down, the prescaler extends the count so the
+     low 32 bits in TnR/TnV run continuously at the system clock. Only the
+     difference between the two is used, to measure the interrupt latency.
+ Author
+     ags, 10/19/26 15:44
+****************************************************************************/
+void _HW_InputCapture_Init(uint8_t Channel, ES_CaptureEdge_t Edge)
+{
+  const CaptureChannel_t *pChannel = &CaptureChannels[Channel];
+  uint32_t EventBits;
+  uint32_t OtherHalfEnable;
+
+  // enable the clocks to the timer and the port and wait for them
+  ROM_SysCtlPeripheralEnable(pChannel->TimerPeriph);
+  ROM_SysCtlPeripheralEnable(pChannel->GPIOPeriph);
+  while ((ROM_SysCtlPeripheralReady(pChannel->TimerPeriph) == false) ||
+         (ROM_SysCtlPeripheralReady(pChannel->GPIOPeriph) == false))
+  {
+    ;
+  }
+  // hand the pin over to the timer
+  ROM_GPIOPinConfigure(pChannel->PinConfig);
+  ROM_GPIOPinTypeTimer(pChannel->GPIOBase, pChannel->Pin);
+
+  // the other half of the block shares the configuration register
+  if (pChannel->Shift == 0)
+  {
+    OtherHalfEnable = TIMER_CTL_TBEN;
+  }
+  else
+  {
+    OtherHalfEnable = TIMER_CTL_TAEN;
+  }
+  // make sure that this half is disabled before configuring
+  HWREG(pChannel->TimerBase + TIMER_O_CTL) &=
+      ~(TIMER_CTL_TAEN << pChannel->Shift);
+  // individual (32 bit for a wide timer) mode, the same for both halves.
+  // Writing it stops the other half, so leave it alone when that half is
+  // already running, it was set up by the channel sharing this block.
+  if ((HWREG(pChannel->TimerBase + TIMER_O_CTL) & OtherHalfEnable) == 0)
+  {
+    HWREG(pChannel->TimerBase + TIMER_O_CFG) = TIMER_CFG_16_BIT;
+  }
+  // capture, edge-time mode, counting down over the full range
+  if (pChannel->Shift == 0)
+  {
+    HWREG(pChannel->TimerBase + TIMER_O_TAMR) = TIMER_TAMR_TAMR_CAP |
+        TIMER_TAMR_TACMR;
+    HWREG(pChannel->TimerBase + TIMER_O_TAILR) = 0xFFFFFFFF;
+    HWREG(pChannel->TimerBase + TIMER_O_TAPR)  = 0xFFFF;
+  }
+  else
+  {
+    HWREG(pChannel->TimerBase + TIMER_O_TBMR) = TIMER_TBMR_TBMR_CAP |
+        TIMER_TBMR_TBCMR;
+    HWREG(pChannel->TimerBase + TIMER_O_TBILR) = 0xFFFFFFFF;
+    HWREG(pChannel->TimerBase + TIMER_O_TBPR)  = 0xFFFF;
+  }
+  // select the edge(s)
+  switch (Edge)
+  {
+    case ES_CAPTURE_FALLING:
+    {
+      EventBits = TIMER_CTL_TAEVENT_NEG;
+    }
+    break;
+    case ES_CAPTURE_BOTH:
+    {
+      EventBits = TIMER_CTL_TAEVENT_BOTH;
+    }
+    break;
+    default:
+    {
+      EventBits = TIMER_CTL_TAEVENT_POS;
+    }
+    break;
+  }
+  HWREG(pChannel->TimerBase + TIMER_O_CTL) =
+      (HWREG(pChannel->TimerBase + TIMER_O_CTL) &
+      ~(TIMER_CTL_TAEVENT_M << pChannel->Shift)) |
+      (EventBits << pChannel->Shift);
+  // enable the capture event interrupt, clearing any stale one first
+  HWREG(pChannel->TimerBase + TIMER_O_ICR) =
+      TIMER_ICR_CAECINT << pChannel->Shift;
+  HWREG(pChannel->TimerBase + TIMER_O_IMR) |=
+      TIMER_IMR_CAEIM << pChannel->Shift;
+  IntEnable(pChannel->IntNum);
+  // start it running, stalling with the debugger
+  HWREG(pChannel->TimerBase + TIMER_O_CTL) |=
+      (TIMER_CTL_TAEN | TIMER_CTL_TASTALL) << pChannel->Shift;
+}
+
+/****************************************************************************
+ Function
+     InputCapture0IntHandler ... InputCapture3IntHandler
+ Parameters
+     none
+ Returns
+     None.
+ Description
+     interrupt response routines for the 4 capture channels
+ Author
+     ags, 10/19/26 15:52
+****************************************************************************/
+void InputCapture0IntHandler(void)
+{
+  CaptureResponse(0);
+}
+
+void InputCapture1IntHandler(void)
+{
+  CaptureResponse(1);
+}
+
+void InputCapture2IntHandler(void)
+{
+  CaptureResponse(2);
+}
+
+void InputCapture3IntHandler(void)
+{
+  CaptureResponse(3);
+}
+
+#ifdef _INCLUDE_PROFILER_
+/****************************************************************************
+ Function
+     _HW_CycleCount_Init
+ Parameters
+     none
+ Returns
+     None.
+ Description
+     enables the DWT and starts its free-running count of CPU clocks
+ Notes
+     the debugger may have started it already, that does no harm
+ Author
+     ags, 10/19/26 23:28
+****************************************************************************/
+void _HW_CycleCount_Init(void)
+{
+  HWREG(CORE_DEBUG_DEMCR) |= DEMCR_TRCENA;
+  HWREG(DWT_CYCCNT) = 0;
+  HWREG(DWT_CTRL) |= DWT_CTRL_CYCCNTENA;
+}
+
+/****************************************************************************
+ Function
+     _HW_GetCycleCount
+ Parameters
+     none
+ Returns
+     uint32_t, the free-running count of CPU clocks
+ Author
+     ags, 10/19/26 23:29
+****************************************************************************/
+uint32_t _HW_GetCycleCount(void)
+{
+  return HWREG(DWT_CYCCNT);
+}
+#endif /* _INCLUDE_PROFILER_ */
+
+#ifdef _INCLUDE_TRACE_
+/****************************************************************************
+ Function
+     _HW_Trace_Init
+ Parameters
+     none
+ Returns
+     None.
+ Description
+     sets up UART1 to send only, 8 bits, no parity, with the FIFO enabled,
+     on PB1
+ Notes
+     PB0 (U1Rx) is left alone
+ Author
+     ags, 10/20/26 00:46
+****************************************************************************/
+void _HW_Trace_Init(void)
+{
+  // enable the clocks to UART1 and Port B
+  HWREG(SYSCTL_RCGCUART) |= SYSCTL_RCGCUART_R1;
+  HWREG(SYSCTL_RCGCGPIO) |= SYSCTL_RCGCGPIO_R1;
+  while ((HWREG(SYSCTL_PRGPIO) & SYSCTL_PRGPIO_R1) != SYSCTL_PRGPIO_R1)
+  {}
+  // select the U1Tx function on PB1
+  HWREG(GPIO_PORTB_BASE + GPIO_O_AFSEL) |= BIT1HI;
+  HWREG(GPIO_PORTB_BASE + GPIO_O_PCTL) =
+      (HWREG(GPIO_PORTB_BASE + GPIO_O_PCTL) & ~GPIO_PCTL_PB1_M) |
+      GPIO_PCTL_PB1_U1TX;
+  HWREG(GPIO_PORTB_BASE + GPIO_O_DEN) |= BIT1HI;
+  while ((HWREG(SYSCTL_PRUART) & SYSCTL_PRUART_R1) != SYSCTL_PRUART_R1)
+  {}
+  // disable the UART while it is programmed
+  HWREG(UART1_BASE + UART_O_CTL) &= ~UART_CTL_UARTEN;
+  HWREG(UART1_BASE + UART_O_IBRD) = TRACE_UART_BRD64 / 64;
+  HWREG(UART1_BASE + UART_O_FBRD) = TRACE_UART_BRD64 % 64;
+  // writing LCRH also latches the divisor
+  HWREG(UART1_BASE + UART_O_LCRH) = UART_LCRH_WLEN_8 | UART_LCRH_FEN;
+  HWREG(UART1_BASE + UART_O_CC) = 0;    // system clock
+  HWREG(UART1_BASE + UART_O_CTL) |= (UART_CTL_TXE | UART_CTL_UARTEN);
+}
+
+/****************************************************************************
+ Function
+     _HW_Trace_PutByte
+ Parameters
+     uint8_t Byte, the next byte of the trace
+ Returns
+     bool, false if the transmit FIFO was full, and the byte was not sent
+ Author
+     ags, 10/20/26 00:47
+****************************************************************************/
+bool _HW_Trace_PutByte(uint8_t Byte)
+{
+  if ((HWREG(UART1_BASE + UART_O_FR) & UART_FR_TXFF) != 0)
+  {
+    return false;
+  }
+  HWREG(UART1_BASE + UART_O_DR) = Byte;
+  return true;
+}
+#endif /* _INCLUDE_TRACE_ */
+
+#ifdef _INCLUDE_PC_SAMPLER_
+/****************************************************************************
+ Function
+     _HW_PCSample_Init
+ Parameters
+     uint16_t RateHz, the number of samples to take each second
+ Returns
+     None.
+ Description
+     sets up Timer 1A to interrupt RateHz times a second
+ Notes
+     the interrupt is left at the default priority, the same as the others,
+     so it does not break in on them. A sample that falls due during
+     another handler is taken as it returns.
+ Author
+     ags, 10/20/26 02:22
+****************************************************************************/
+void _HW_PCSample_Init(uint16_t RateHz)
+{
+  HWREG(SYSCTL_RCGCTIMER) |= SYSCTL_RCGCTIMER_R1;
+  while ((HWREG(SYSCTL_PRTIMER) & SYSCTL_PRTIMER_R1) != SYSCTL_PRTIMER_R1)
+  {}
+  // make sure that the timer is disabled while it is set up
+  HWREG(PC_SAMPLE_TIMER_BASE + TIMER_O_CTL) &= ~TIMER_CTL_TAEN;
+  HWREG(PC_SAMPLE_TIMER_BASE + TIMER_O_CFG) = TIMER_CFG_32_BIT_TIMER;
+  HWREG(PC_SAMPLE_TIMER_BASE + TIMER_O_TAMR) = TIMER_TAMR_TAMR_PERIOD;
+  HWREG(PC_SAMPLE_TIMER_BASE + TIMER_O_TAILR) = (CLK_FREQ / RateHz) - 1;
+  HWREG(PC_SAMPLE_TIMER_BASE + TIMER_O_ICR) = TIMER_ICR_TATOCINT;
+  HWREG(PC_SAMPLE_TIMER_BASE + TIMER_O_IMR) |= TIMER_IMR_TATOIM;
+  IntEnable(INT_TIMER1A);
+  // stall with the debugger, so the time at a breakpoint is not sampled
+  HWREG(PC_SAMPLE_TIMER_BASE + TIMER_O_CTL) |= (TIMER_CTL_TAEN |
+      TIMER_CTL_TASTALL);
+}
+
+/****************************************************************************
+ Function
+     _HW_PCSample_GetCodeBase
+ Parameters
+     none
+ Returns
+     uintptr_t, the address that the sampled PCs are offsets from
+ Description
+     the code is linked to run from the start of flash, at 0
+ Author
+     ags, 10/20/26 02:23
+****************************************************************************/
+uintptr_t _HW_PCSample_GetCodeBase(void)
+{
+  return 0;
+}
+#endif /* _INCLUDE_PC_SAMPLER_ */
+
+/****************************************************************************
+ Function
+     PCSampleIntResponse
+ Parameters
+     uint32_t *pFrame, the exception frame of the code that was interrupted
+ Returns
+     None.
+ Description
+     interrupt response for the Timer 1A timeout, records the stacked PC
+ Notes
+     entered from PCSampleIntHandler in startup_rvmdk.S, which finds the
+     frame on the main or the process stack and passes it here. The PC is
+     at the same place whether or not the FPU registers were also stacked.
+ Author
+     ags, 10/20/26 02:25
+****************************************************************************/
+void PCSampleIntResponse(uint32_t *pFrame)
+{
+  HWREG(PC_SAMPLE_TIMER_BASE + TIMER_O_ICR) = TIMER_ICR_TATOCINT;
+#ifdef _INCLUDE_PC_SAMPLER_
+  ES_PCSample_Record(pFrame[EXC_FRAME_PC]);
+#endif
+}
+
+#ifdef _INCLUDE_WATCHDOG_
+/****************************************************************************
+ Function
+     _HW_Watchdog_Init
+ Parameters
+     uint16_t TimeoutMS, the time without a feed after which to reset
+ Returns
+     None.
+ Description
+     starts Watchdog 0 with the reset enabled
+ Notes
+     the first time the count runs out it only sets the interrupt flag, the
+     interrupt is not enabled in the NVIC, and the second time it resets the
+     processor, so the count is loaded with half of the timeout. Once
+     started, the watchdog can only be stopped by a reset. It stalls while
+     the debugger has the processor halted.
+ Author
+     ags, 10/20/26 03:40
+****************************************************************************/
+void _HW_Watchdog_Init(uint16_t TimeoutMS)
+{
+  HWREG(SYSCTL_RCGCWD) |= SYSCTL_RCGCWD_R0;
+  while ((HWREG(SYSCTL_PRWD) & SYSCTL_PRWD_R0) != SYSCTL_PRWD_R0)
+  {}
+  HWREG(WATCHDOG0_BASE + WATCHDOG_O_LOAD) = (CLK_FREQ / 2000UL) * TimeoutMS;
+  HWREG(WATCHDOG0_BASE + WATCHDOG_O_TEST) |= WATCHDOG_TEST_STALL;
+  HWREG(WATCHDOG0_BASE + WATCHDOG_O_CTL) |= WATCHDOG_CTL_RESEN;
+  // setting INTEN starts the count
+  HWREG(WATCHDOG0_BASE + WATCHDOG_O_CTL) |= WATCHDOG_CTL_INTEN;
+}
+
+/****************************************************************************
+ Function
+     _HW_Watchdog_Feed
+ Parameters
+     none
+ Returns
+     None.
+ Description
+     clears the first timeout, and reloads the count
+ Notes
+     a write of any value to the ICR does both
+ Author
+     ags, 10/20/26 03:41
+****************************************************************************/
+void _HW_Watchdog_Feed(void)
+{
+  HWREG(WATCHDOG0_BASE + WATCHDOG_O_ICR) = 1;
+}
+#endif /* _INCLUDE_WATCHDOG_ */
+
 /****************************************************************************
  Function
      ConsoleInit
@@ -366,7 +986,8 @@ void _HW_DebugLines_ClearLine2(void)
  Returns
      None.
  Description
-     Initializes SSI1 on PortF to send bytes to an 'HC595 connected there
+     Initializes SSI1 on PortF to send bytes to an 'HC595 connected there,
+     and uDMA channel 25 to feed it from the byte debug ring
  Notes
     based on code from SSIDemo.c in project GIT_FrameworkWithSPIDemo
     Does not use the Rx line on SSI1 so PF0 is still free
@@ -437,6 +1058,56 @@ void _HW_ByteDebug_Init( void){
 // set all of the output lines lo
   HWREG(SSI1_BASE + SSI_O_DR) = 0;
 
+// start the uDMA, and set up channel 25 to move bytes from the ring to the
+// SSI1 data register, 4 at a time as the Tx FIFO empties
+  ROM_SysCtlPeripheralEnable(SYSCTL_PERIPH_UDMA);
+  while (ROM_SysCtlPeripheralReady(SYSCTL_PERIPH_UDMA) == false)
+    ;
+  uDMAEnable();
+  uDMAControlBaseSet(uDMAControlTable);
+  uDMAChannelAssign(UDMA_CH25_SSI1TX);
+  uDMAChannelAttributeDisable(UDMA_CH25_SSI1TX, UDMA_ATTR_ALL);
+  uDMAChannelControlSet(UDMA_CH25_SSI1TX | UDMA_PRI_SELECT,
+    UDMA_SIZE_8 | UDMA_SRC_INC_8 | UDMA_DST_INC_NONE | UDMA_ARB_4);
+  ByteDebugHead = 0;
+  ByteDebugTail = 0;
+  ByteDebugInFlight = 0;
+
+// let the SSI request the uDMA when there is room in its Tx FIFO. The end
+// of each transfer interrupts on the SSI1 vector
+  HWREG(SSI1_BASE + SSI_O_DMACTL) |= SSI_DMACTL_TXDMAE;
+  IntEnable(INT_SSI1);
+}
+
+/****************************************************************************
+ Function
+     SSI1IntHandler
+ Parameters
+     none
+ Returns
+     None.
+ Description
+     interrupt response for the end of a uDMA transfer to the byte debug
+     port, frees the bytes sent and starts the transfer of any more
+ Notes
+     only the uDMA completion interrupt is enabled on SSI1
+ Author
+     ags, 10/20/26 01:14
+****************************************************************************/
+void SSI1IntHandler(void)
+{
+  uint32_t SavedPRIMASK;
+
+  // ByteDebugPut may be called from a higher priority interrupt
+  SavedPRIMASK = CPUgetPRIMASK_cpsid();
+  if ((ByteDebugInFlight != 0) &&
+      (uDMAChannelIsEnabled(UDMA_CH25_SSI1TX) == false))
+  {
+    ByteDebugTail += ByteDebugInFlight;
+    ByteDebugInFlight = 0;
+    StartByteDebugTransfer();
+  }
+  CPUsetPRIMASK(SavedPRIMASK);
 }
 
 /****************************************************************************
@@ -456,13 +1127,9 @@ void _HW_ByteDebug_Init( void){
 ****************************************************************************/
 void _HW_ByteDebug_ClearBit( uint8_t WhichBit ){
   
-// update the shadow register contents and write the new data to the SSI 
-// data register
+// update the shadow register contents and queue the new data for the SSI
     ByteDebugPortShadow &= ~(BIT0HI << WhichBit);
-  // make sure that there is room in the FIFO, then write new data
-  while(0 == (HWREG(SSI1_BASE + SSI_O_SR) & SSI_SR_TNF))
-    ;
-  HWREG(SSI1_BASE + SSI_O_DR) = ByteDebugPortShadow;
+  ByteDebugPut(ByteDebugPortShadow);
 }
 
 /****************************************************************************
@@ -482,13 +1149,9 @@ void _HW_ByteDebug_ClearBit( uint8_t WhichBit ){
 ****************************************************************************/
 void _HW_ByteDebug_SetBit( uint8_t WhichBit ){
   
-// update the shadow register contents and write the new data to the SSI 
-// data register
+// update the shadow register contents and queue the new data for the SSI
     ByteDebugPortShadow |= (BIT0HI << WhichBit);
-  // make sure that there is room in the FIFO, then write new data
-  while(0 == (HWREG(SSI1_BASE + SSI_O_SR) & SSI_SR_TNF))
-    ;
-  HWREG(SSI1_BASE + SSI_O_DR) = ByteDebugPortShadow;
+  ByteDebugPut(ByteDebugPortShadow);
 }
 
 /****************************************************************************
@@ -509,19 +1172,11 @@ void _HW_ByteDebug_SetBit( uint8_t WhichBit ){
 ****************************************************************************/
 void _HW_ByteDebug_SetValueWithStrobe( uint8_t NewValue ){
   
-// update the shadow register contents and write the new data to the SSI 
-// data register first with bit 7 hi, then with bit 7 lo
+// update the shadow register contents and queue the new data for the SSI
+// first with bit 7 hi, then with bit 7 lo
     ByteDebugPortShadow = NewValue;
-  // make sure that there is room in the FIFO, then write new data with B7 hi
-  while(0 == (HWREG(SSI1_BASE + SSI_O_SR) & SSI_SR_TNF))
-      ;
-  HWREG(SSI1_BASE + SSI_O_DR) = ByteDebugPortShadow | BIT7HI;
-  
-  // make sure that there is room in the FIFO, then write new data with B7 lo
-  while(0 == (HWREG(SSI1_BASE + SSI_O_SR) & SSI_SR_TNF))
-      ;
-  HWREG(SSI1_BASE + SSI_O_DR) = ByteDebugPortShadow & BIT7LO;
-  
+  ByteDebugPut(ByteDebugPortShadow | BIT7HI);
+  ByteDebugPut(ByteDebugPortShadow & BIT7LO);
 }
 
 /****************************************************************************
@@ -541,12 +1196,120 @@ void _HW_ByteDebug_SetValueWithStrobe( uint8_t NewValue ){
 ****************************************************************************/
 void _HW_ByteDebug_SetValue( uint8_t NewValue ){
   
-// update the shadow register contents and write the new data to the SSI 
-// data register
+// update the shadow register contents and queue the new data for the SSI
     ByteDebugPortShadow = NewValue;
-  // make sure that there is room in the FIFO, then write new data
-  while(0 == (HWREG(SSI1_BASE + SSI_O_SR) & SSI_SR_TNF))
-      ;
-  HWREG(SSI1_BASE + SSI_O_DR) = ByteDebugPortShadow;
-    
+  ByteDebugPut(ByteDebugPortShadow);
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+/****************************************************************************
+ Function
+     CaptureResponse
+ Parameters
+     uint8_t Channel, the channel that captured an edge
+ Returns
+     None.
+ Description
+     converts the captured edge time into a timestamp on the uS count and
+     hands it to ES_InputCapture
+ Notes
+     the capture timer and the uS count are not the same timer, so rather
+     than use the captured value directly, we measure how long ago the edge
+     was (the captured count less the current count, since they count down)
+     and take that off the current uS count
+ Author
+     ags, 10/19/26 15:56
+****************************************************************************/
+static void CaptureResponse(uint8_t Channel)
+{
+  const CaptureChannel_t *pChannel = &CaptureChannels[Channel];
+  uint32_t Captured;
+  uint32_t Current;
+  uint32_t Now;
+
+  // start by clearing the source of the interrupt
+  HWREG(pChannel->TimerBase + TIMER_O_ICR) =
+      TIMER_ICR_CAECINT << pChannel->Shift;
+  if (pChannel->Shift == 0)
+  {
+    Captured  = HWREG(pChannel->TimerBase + TIMER_O_TAR);
+    Current   = HWREG(pChannel->TimerBase + TIMER_O_TAV);
+  }
+  else
+  {
+    Captured  = HWREG(pChannel->TimerBase + TIMER_O_TBR);
+    Current   = HWREG(pChannel->TimerBase + TIMER_O_TBV);
+  }
+  Now = _HW_HRTimer_GetCount();
+  ES_InputCapture_Edge_Resp(Channel,
+      Now - ((Captured - Current) / CAPTURE_CLKS_PER_uS));
+}
+
+/****************************************************************************
+ Function
+     ByteDebugPut
+ Parameters
+     uint8_t NewValue, the next byte for the debug port expander
+ Returns
+     None.
+ Description
+     adds the byte to the ring, and starts the uDMA if it is idle
+ Notes
+     saves and restores the interrupt mask itself, rather than using
+     EnterCritical, so that it can be used from inside a critical region.
+     If the ring is full, the byte is dropped.
+ Author
+     ags, 10/20/26 01:10
+****************************************************************************/
+static void ByteDebugPut(uint8_t NewValue)
+{
+  uint32_t SavedPRIMASK;
+
+  SavedPRIMASK = CPUgetPRIMASK_cpsid();
+  if ((uint8_t)(ByteDebugHead - ByteDebugTail) < BYTE_DEBUG_RING_SIZE)
+  {
+    ByteDebugRing[ByteDebugHead & BYTE_DEBUG_RING_MASK] = NewValue;
+    ByteDebugHead++;
+    if (ByteDebugInFlight == 0)
+    {
+      StartByteDebugTransfer();
+    }
+  }
+  CPUsetPRIMASK(SavedPRIMASK);
+}
+
+/****************************************************************************
+ Function
+     StartByteDebugTransfer
+ Parameters
+     none
+ Returns
+     None.
+ Description
+     starts a uDMA transfer of the bytes waiting in the ring, up to the end
+     of the ring. The rest go in the next transfer.
+ Notes
+     must be called with the interrupts off and the uDMA idle
+ Author
+     ags, 10/20/26 01:12
+****************************************************************************/
+static void StartByteDebugTransfer(void)
+{
+  uint8_t Start = ByteDebugTail & BYTE_DEBUG_RING_MASK;
+  uint8_t Count = (uint8_t)(ByteDebugHead - ByteDebugTail);
+
+  if (Count == 0)
+  {
+    return;
+  }
+  if (Count > (BYTE_DEBUG_RING_SIZE - Start))
+  {
+    Count = BYTE_DEBUG_RING_SIZE - Start;
+  }
+  ByteDebugInFlight = Count;
+  uDMAChannelTransferSet(UDMA_CH25_SSI1TX | UDMA_PRI_SELECT, UDMA_MODE_BASIC,
+    &ByteDebugRing[Start], (void *)(SSI1_BASE + SSI_O_DR), Count);
+  uDMAChannelEnable(UDMA_CH25_SSI1TX);
 }
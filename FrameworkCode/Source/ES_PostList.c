@@ -5,10 +5,18 @@
      source file for the module to post events to lists of state
      machines
  Notes
+     Each distribution list is a bit mask of the services on the list, so
+     posting to a list is a single multicast post, with no call through the
+     services' post functions, and the members can be changed at run time.
 
  History
  When           Who     What/Why
  -------------- ---     --------
+ 10/19/26 17:52 ags     lists are now service bit masks that can be changed
+                        while running, posting uses ES_PostToMask and there
+                        is no longer a limit of 8 lists. ES_PostList00-07
+                        are kept as wrappers for existing code.
+ 10/19/26 17:36 ags     PostToList no longer stops at the first failed post
  10/26/17 18:20 jec     moved prototype of PostToList into the conditional to
                         eliminate warning when not using distribution lists
  08/05/13 15:04 jec      added #includes for ES_Port & ES_Types and converted
@@ -23,60 +31,152 @@
 #include "ES_Configure.h"
 #include "ES_General.h"
 #include "ES_PostList.h"
-#include "ES_ServiceHeaders.h"
+#include "ES_Framework.h"
+#include "ES_LookupTables.h"
 
 /*---------------------------- Module Functions ---------------------------*/
 
 /*---------------------------- Module Variables ---------------------------*/
-// Fill in these arrays with the lists of posting funcitons for the state
-// machines that will have common events delivered to them.
+// The members of each list, bit n set for the service at priority n.
+// Fill in DIST_LIST_INIT in ES_Configure.h with the starting members.
 
 #if NUM_DIST_LISTS > 0
-static bool PostToList(PostFunc_t *const *FuncList, uint8_t ListSize, ES_Event_t NewEvent);
-static PostFunc_t *const DistList00[] = {
-  DIST_LIST0
-};
+static uint16_t DistListMasks[NUM_DIST_LISTS] = DIST_LIST_INIT;
 // the endif for NUM_DIST_LISTS > 0 is at the end of the file
-#if NUM_DIST_LISTS > 1
-static PostFunc_t *const DistList01[] = {
-  DIST_LIST1
-};
-#endif
-#if NUM_DIST_LISTS > 2
-static PostFunc_t *const DistList02[] = {
-  DIST_LIST2
-};
-#endif
-#if NUM_DIST_LISTS > 3
-static PostFunc_t *const DistList03[] = {
-  DIST_LIST3
-};
-#endif
-#if NUM_DIST_LISTS > 4
-static PostFunc_t *const DistList04[] = {
-  DIST_LIST4
-};
-#endif
-#if NUM_DIST_LISTS > 5
-static PostFunc_t *const DistList05[] = {
-  DIST_LIST5
-};
-#endif
-#if NUM_DIST_LISTS > 6
-static PostFunc_t *const DistList06[] = {
-  DIST_LIST6
-};
-#endif
-#if NUM_DIST_LISTS > 7
-static PostFunc_t *const DistList07[] = {
-  DIST_LIST7
-};
-#endif
 
 /*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+   ES_PostList
+ Parameters
+   uint8_t WhichList : the number of the distribution list
+   ES_Event NewEvent : the new event to be posted to the services on the list
+ Returns
+   bool: true if the event was posted to every service on the list, false if
+   the list does not exist or any of the services' queues was full
+ Description
+   Posts NewEvent to all of the services on the list
+ Notes
+   the list mask goes straight to ES_PostToMask, so all of the services on
+   the list get the event or none of them do
+ Author
+   ags, 10/19/26 17:55
+****************************************************************************/
+bool ES_PostList(uint8_t WhichList, ES_Event_t NewEvent)
+{
+  if (WhichList >= ARRAY_SIZE(DistListMasks))
+  {
+    return false;
+  }
+  return ES_PostToMask(DistListMasks[WhichList], NewEvent);
+}
 
-// Each of these list-specific functions is a wrapper that calls the generic
-// function to walk through the list, calling the listed posting functions
+/****************************************************************************
+ Function
+   ES_AddToList
+ Parameters
+   uint8_t WhichList : the number of the distribution list
+   uint8_t WhichService : the service to add to the list
+ Returns
+   bool: false if the list or the service does not exist
+ Description
+   adds a service to a distribution list
+ Notes
+
+ Author
+   ags, 10/19/26 17:58
+****************************************************************************/
+bool ES_AddToList(uint8_t WhichList, uint8_t WhichService)
+{
+  if ((WhichList >= ARRAY_SIZE(DistListMasks)) ||
+      (WhichService >= NUM_SERVICES))
+  {
+    return false;
+  }
+  DistListMasks[WhichList] |= BitNum2SetMask[WhichService];
+  return true;
+}
+
+/****************************************************************************
+ Function
+   ES_RemoveFromList
+ Parameters
+   uint8_t WhichList : the number of the distribution list
+   uint8_t WhichService : the service to remove from the list
+ Returns
+   bool: false if the list or the service does not exist
+ Description
+   removes a service from a distribution list
+ Notes
+
+ Author
+   ags, 10/19/26 17:59
+****************************************************************************/
+bool ES_RemoveFromList(uint8_t WhichList, uint8_t WhichService)
+{
+  if ((WhichList >= ARRAY_SIZE(DistListMasks)) ||
+      (WhichService >= NUM_SERVICES))
+  {
+    return false;
+  }
+  DistListMasks[WhichList] &= BitNum2ClrMask[WhichService];
+  return true;
+}
+
+/****************************************************************************
+ Function
+   ES_SetListMembers
+ Parameters
+   uint8_t WhichList : the number of the distribution list
+   uint16_t Services : the new members, bit n set for service n
+ Returns
+   bool: false if the list or any of the services does not exist
+ Description
+   replaces all of the members of a distribution list at once, for example
+   on a change of operating mode
+ Notes
+
+ Author
+   ags, 10/19/26 18:01
+****************************************************************************/
+bool ES_SetListMembers(uint8_t WhichList, uint16_t Services)
+{
+  if ((WhichList >= ARRAY_SIZE(DistListMasks)) ||
+      ((Services & ~ES_ALL_SERVICES) != 0))
+  {
+    return false;
+  }
+  DistListMasks[WhichList] = Services;
+  return true;
+}
+
+/****************************************************************************
+ Function
+   ES_GetListMembers
+ Parameters
+   uint8_t WhichList : the number of the distribution list
+ Returns
+   uint16_t: the members of the list, bit n set for service n, 0 if the
+   list does not exist
+ Description
+   see above
+ Notes
+
+ Author
+   ags, 10/19/26 18:02
+****************************************************************************/
+uint16_t ES_GetListMembers(uint8_t WhichList)
+{
+  if (WhichList >= ARRAY_SIZE(DistListMasks))
+  {
+    return 0;
+  }
+  return DistListMasks[WhichList];
+}
+
+// Each of these list-specific functions is a wrapper, kept so that existing
+// code (and timer response functions) can post to lists 0-7 through a
+// function with the same signature as a service post function
 
 /****************************************************************************
  Function
@@ -95,104 +195,65 @@ static PostFunc_t *const DistList07[] = {
 ****************************************************************************/
 bool ES_PostList00(ES_Event_t NewEvent)
 {
-  return PostToList(DistList00, ARRAY_SIZE(DistList00), NewEvent);
+  return ES_PostList(0, NewEvent);
 }
 
 #if NUM_DIST_LISTS > 1
-bool ES_PostList01(ES_Event NewEvent)
+bool ES_PostList01(ES_Event_t NewEvent)
 {
-  return PostToList(DistList01, ARRAY_SIZE(DistList01), NewEvent);
+  return ES_PostList(1, NewEvent);
 }
 
 #endif
 
 #if NUM_DIST_LISTS > 2
-bool ES_PostList02(ES_Event NewEvent)
+bool ES_PostList02(ES_Event_t NewEvent)
 {
-  return PostToList(DistList02, ARRAY_SIZE(DistList02), NewEvent);
+  return ES_PostList(2, NewEvent);
 }
 
 #endif
 
 #if NUM_DIST_LISTS > 3
-bool ES_PostList03(ES_Event NewEvent)
+bool ES_PostList03(ES_Event_t NewEvent)
 {
-  return PostToList(DistList03, ARRAY_SIZE(DistList03), NewEvent);
+  return ES_PostList(3, NewEvent);
 }
 
 #endif
 
 #if NUM_DIST_LISTS > 4
-bool ES_PostList04(ES_Event NewEvent)
+bool ES_PostList04(ES_Event_t NewEvent)
 {
-  return PostToList(DistList04, ARRAY_SIZE(DistList04), NewEvent);
+  return ES_PostList(4, NewEvent);
 }
 
 #endif
 
 #if NUM_DIST_LISTS > 5
-bool ES_PostList05(ES_Event NewEvent)
+bool ES_PostList05(ES_Event_t NewEvent)
 {
-  return PostToList(DistList05, ARRAY_SIZE(DistList05), NewEvent);
+  return ES_PostList(5, NewEvent);
 }
 
 #endif
 
 #if NUM_DIST_LISTS > 6
-bool ES_PostList06(ES_Event NewEvent)
+bool ES_PostList06(ES_Event_t NewEvent)
 {
-  return PostToList(DistList06, ARRAY_SIZE(DistList06), NewEvent);
+  return ES_PostList(6, NewEvent);
 }
 
 #endif
 
 #if NUM_DIST_LISTS > 7
-bool ES_PostList07(ES_Event NewEvent)
+bool ES_PostList07(ES_Event_t NewEvent)
 {
-  return PostToList(DistList07, ARRAY_SIZE(DistList07), NewEvent);
+  return ES_PostList(7, NewEvent);
 }
 
 #endif
 
-// Implementations for private functions
-/****************************************************************************
- Function
-   PostToList
- Parameters
-   PostFunc *const*List : pointer to the list of posting functions
-   unsigned char ListSize : number of elements in the list array
-   EF_Event NewEvent : the new event to be passed to each of the state machine
-   posting functions in the list
- Returns
-   bool: true if all the post functions succeeded, false if any failed
- Description
-   Posts NewEvent to all of the state machines listed in the list
- Notes
-
- Author
-   J. Edward Carryer, 10/24/11, 07:52
-****************************************************************************/
-static bool PostToList(PostFunc_t *const *List, uint8_t ListSize, ES_Event_t NewEvent)
-{
-  uint8_t i;
-  // loop through the list executing the post functions
-  for (i = 0; i < ListSize; i++)
-  {
-    if (List[i](NewEvent) != true)
-    {
-      break; // this is a failed post
-    }
-  }
-  if (i != ListSize)   // if no failures, i = ListSize
-  {
-    return false;
-  }
-  else
-  {
-    return true;
-  }
-}
-
 #endif /* NUM_DIST_LISTS > 0*/
 
 /*------------------------------- Footnotes -------------------------------*/
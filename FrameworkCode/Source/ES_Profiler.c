@@ -0,0 +1,317 @@
+/****************************************************************************
+ Module
+     ES_Profiler.c
+
+ Description
+     This is a module implementing a run time profiler for the services.
+     ES_Run reads the cycle counter before and after every call to a run
+     function, and the time taken is added to the statistics for the
+     service and for the type of the event that it was given.
+
+ Notes
+     The whole module, and the calls to it from ES_Run, compile out unless
+     _INCLUDE_PROFILER_ is defined in ES_Configure.h.
+     The cycle counter is 32 bits, so a single run of more than 2^32 cycles
+     (107S at 40MHz) is not measured correctly. The totals are 64 bits.
+     The time taken to read the counter is measured in ES_Profiler_Init and
+     taken off each measurement, so that an empty run function comes out
+     close to 0.
+     The statistics are only written from ES_Run, so they can be read from
+     a service without a critical region.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/19/26 22:58 ags     Began Coding
+****************************************************************************/
+
+/*----------------------------- Include Files -----------------------------*/
+#include "ES_Configure.h"
+#include "ES_General.h"
+#include "ES_Port.h"
+#include "ES_Profiler.h"
+
+#ifdef _INCLUDE_PROFILER_
+/*----------------------------- Module Defines ----------------------------*/
+
+/*---------------------------- Module Functions ---------------------------*/
+static void AddSample(ES_ProfileStats_t *pStats, uint32_t Cycles);
+static void CopyStats(const ES_ProfileStats_t *pFrom, ES_ProfileStats_t *pTo);
+static void PrintRow(uint8_t Index, const ES_ProfileStats_t *pStats);
+
+/*---------------------------- Module Variables ---------------------------*/
+static ES_ProfileStats_t ServiceStats[NUM_SERVICES];
+static ES_ProfileStats_t EventTypeStats[ES_NUM_EVENT_TYPES];
+
+// the count when the current run function was called
+static uint32_t RunStart;
+// the cycles taken by reading the counter, taken off every measurement
+static uint32_t Overhead;
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+     ES_Profiler_Init
+ Parameters
+     None.
+ Returns
+     None.
+ Description
+     starts the cycle counter, measures the cost of reading it and clears
+     the statistics
+ Notes
+     called from ES_Initialize
+ Author
+     ags, 10/19/26 23:00
+****************************************************************************/
+void ES_Profiler_Init(void)
+{
+  _HW_CycleCount_Init();
+  ES_Profiler_StartRun();
+  Overhead = _HW_GetCycleCount() - RunStart;
+  ES_Profiler_Reset();
+}
+
+/****************************************************************************
+ Function
+     ES_Profiler_Reset
+ Parameters
+     None.
+ Returns
+     None.
+ Description
+     clears the statistics of every service and event type
+ Author
+     ags, 10/19/26 23:02
+****************************************************************************/
+void ES_Profiler_Reset(void)
+{
+  uint8_t i;
+
+  for (i = 0; i < ARRAY_SIZE(ServiceStats); i++)
+  {
+    ServiceStats[i].Count       = 0;
+    ServiceStats[i].TotalCycles = 0;
+  }
+  for (i = 0; i < ARRAY_SIZE(EventTypeStats); i++)
+  {
+    EventTypeStats[i].Count       = 0;
+    EventTypeStats[i].TotalCycles = 0;
+  }
+}
+
+/****************************************************************************
+ Function
+     ES_Profiler_StartRun
+ Parameters
+     None.
+ Returns
+     None.
+ Description
+     notes the cycle count as a run function is called
+ Notes
+     called from ES_Run
+ Author
+     ags, 10/19/26 23:03
+****************************************************************************/
+void ES_Profiler_StartRun(void)
+{
+  RunStart = _HW_GetCycleCount();
+}
+
+/****************************************************************************
+ Function
+     ES_Profiler_EndRun
+ Parameters
+     uint8_t WhichService, the service whose run function has returned
+     ES_EventType_t WhichType, the type of the event it was given
+ Returns
+     None.
+ Description
+     adds the cycles since ES_Profiler_StartRun to the statistics of the
+     service and of the event type
+ Notes
+     called from ES_Run
+ Author
+     ags, 10/19/26 23:05
+****************************************************************************/
+void ES_Profiler_EndRun(uint8_t WhichService, ES_EventType_t WhichType)
+{
+  uint32_t Cycles = _HW_GetCycleCount() - RunStart;
+
+  Cycles = (Cycles > Overhead) ? (Cycles - Overhead) : 0;
+  AddSample(&ServiceStats[WhichService], Cycles);
+  if (WhichType < ARRAY_SIZE(EventTypeStats))
+  {
+    AddSample(&EventTypeStats[WhichType], Cycles);
+  }
+}
+
+/****************************************************************************
+ Function
+     ES_Profiler_GetService
+ Parameters
+     uint8_t WhichService, the service to report on
+     ES_ProfileStats_t *pStats, where to copy its statistics
+ Returns
+     bool, false if the service does not exist
+ Description
+     copies the statistics of the service's run function, with the mean
+ Notes
+     the min, max and mean are 0 if the service has not been run
+ Author
+     ags, 10/19/26 23:07
+****************************************************************************/
+bool ES_Profiler_GetService(uint8_t WhichService, ES_ProfileStats_t *pStats)
+{
+  if (WhichService >= ARRAY_SIZE(ServiceStats))
+  {
+    return false;
+  }
+  CopyStats(&ServiceStats[WhichService], pStats);
+  return true;
+}
+
+/****************************************************************************
+ Function
+     ES_Profiler_GetEventType
+ Parameters
+     ES_EventType_t WhichType, the event type to report on
+     ES_ProfileStats_t *pStats, where to copy its statistics
+ Returns
+     bool, false if the event type does not exist
+ Description
+     copies the statistics of the runs given an event of this type, by
+     any service
+ Author
+     ags, 10/19/26 23:08
+****************************************************************************/
+bool ES_Profiler_GetEventType(ES_EventType_t WhichType,
+    ES_ProfileStats_t *pStats)
+{
+  if (WhichType >= ARRAY_SIZE(EventTypeStats))
+  {
+    return false;
+  }
+  CopyStats(&EventTypeStats[WhichType], pStats);
+  return true;
+}
+
+/****************************************************************************
+ Function
+     ES_Profiler_Dump
+ Parameters
+     None.
+ Returns
+     None.
+ Description
+     prints a table of the statistics of every service and event type that
+     has been run
+ Notes
+     printing takes far longer than any run function, so call it from a
+     service that is not being measured, or reset the statistics after it
+ Author
+     ags, 10/19/26 23:10
+****************************************************************************/
+void ES_Profiler_Dump(void)
+{
+  uint8_t i;
+
+  printf("\r\nService      Count        Min       Mean        Max\r\n");
+  for (i = 0; i < ARRAY_SIZE(ServiceStats); i++)
+  {
+    PrintRow(i, &ServiceStats[i]);
+  }
+  printf("Event\r\n");
+  for (i = 0; i < ARRAY_SIZE(EventTypeStats); i++)
+  {
+    PrintRow(i, &EventTypeStats[i]);
+  }
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+/****************************************************************************
+ Function
+     AddSample
+ Parameters
+     ES_ProfileStats_t *pStats, the statistics to add to
+     uint32_t Cycles, the time taken by one run
+ Returns
+     None.
+ Author
+     ags, 10/19/26 23:12
+****************************************************************************/
+static void AddSample(ES_ProfileStats_t *pStats, uint32_t Cycles)
+{
+  if ((pStats->Count == 0) || (Cycles < pStats->MinCycles))
+  {
+    pStats->MinCycles = Cycles;
+  }
+  if ((pStats->Count == 0) || (Cycles > pStats->MaxCycles))
+  {
+    pStats->MaxCycles = Cycles;
+  }
+  pStats->Count++;
+  pStats->TotalCycles += Cycles;
+}
+
+/****************************************************************************
+ Function
+     CopyStats
+ Parameters
+     const ES_ProfileStats_t *pFrom, the statistics kept
+     ES_ProfileStats_t *pTo, the copy to fill in
+ Returns
+     None.
+ Description
+     copies the statistics, working out the mean, and zeroing the min and
+     max if there have been no runs
+ Author
+     ags, 10/19/26 23:13
+****************************************************************************/
+static void CopyStats(const ES_ProfileStats_t *pFrom, ES_ProfileStats_t *pTo)
+{
+  *pTo = *pFrom;
+  if (pTo->Count == 0)
+  {
+    pTo->MinCycles  = 0;
+    pTo->MaxCycles  = 0;
+    pTo->MeanCycles = 0;
+  }
+  else
+  {
+    pTo->MeanCycles = (uint32_t)(pTo->TotalCycles / pTo->Count);
+  }
+}
+
+/****************************************************************************
+ Function
+     PrintRow
+ Parameters
+     uint8_t Index, the service or event type number
+     const ES_ProfileStats_t *pStats, its statistics
+ Returns
+     None.
+ Description
+     prints one line of the dump, nothing if there have been no runs
+ Author
+     ags, 10/19/26 23:14
+****************************************************************************/
+static void PrintRow(uint8_t Index, const ES_ProfileStats_t *pStats)
+{
+  ES_ProfileStats_t Stats;
+
+  CopyStats(pStats, &Stats);
+  if (Stats.Count != 0)
+  {
+    printf("%7u %10lu %10lu %10lu %10lu\r\n", Index,
+        (unsigned long)Stats.Count, (unsigned long)Stats.MinCycles,
+        (unsigned long)Stats.MeanCycles, (unsigned long)Stats.MaxCycles);
+  }
+}
+
+#endif /* _INCLUDE_PROFILER_ */
+/*------------------------------- Footnotes -------------------------------*/
+/*------------------------------ End of file ------------------------------*/
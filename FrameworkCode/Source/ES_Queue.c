@@ -9,13 +9,27 @@
  History
  When           Who     What/Why
  -------------- ---     --------
+ 10/20/26 04:45 ags      added ES_PeekStamp for the host's virtual clock
+ 10/19/26 23:34 ags      stamped versions of the rest of the operations used
+                         on the service queues, so that the stamps can follow
+                         the events for the latency statistics
+ 10/19/26 19:40 ags      added stamped queue operations, where a side array
+                         holds a time for each entry, for timed deferral
+ 10/19/26 18:58 ags      added ES_SpliceQueue to move events to the front of
+                         another queue in order, in one critical region
+ 10/19/26 17:10 ags      added ES_QueueSpace and ES_EnQueueFIFOInCritical so
+                         that multicast posts can check and then fill several
+                         queues inside one critical region
+ 10/19/26 14:02 ags      added ES_PurgeQueue to remove stale events in place
  01/15/12 09:34 jec      converted to use the new C99 types from types.h
  08/09/11 18:16 jec      started coding
 *****************************************************************************/
 /*----------------------------- Include Files -----------------------------*/
 #include "ES_Configure.h"
+#include "ES_General.h"
 #include "ES_Queue.h"
 #include "ES_Port.h" /* get the macros for EnterCritical and ExitCritical */
+#include "ES_LookupTables.h"
 
 /*----------------------------- Module Defines ----------------------------*/
 // QueueSize is max number of entries in the queue
@@ -32,6 +46,7 @@ typedef struct
 typedef ES_Queue_t *pQueue_t;
 
 /*---------------------------- Module Functions ---------------------------*/
+static bool IsTypeInMask(ES_EventType_t ThisType, uint32_t TypeMask);
 
 /*---------------------------- Module Variables ---------------------------*/
 
@@ -104,6 +119,40 @@ bool ES_EnQueueFIFO(ES_Event_t *pBlock, ES_Event_t Event2Add)
   }
 }
 
+/****************************************************************************
+ Function
+   ES_EnQueueFIFOInCritical
+ Parameters
+   ES_Event * pBlock : pointer to the block of memory in use as the Queue
+   ES_Event Event2Add : event to be added to the Queue
+ Returns
+   bool : true if the add was successful, false if not
+ Description
+   the same as ES_EnQueueFIFO, for use when the caller already has the
+   interrupts off
+ Notes
+   EnterCritical/ExitCritical can not be nested, since they share the one
+   place to save the interrupt state, so this version does not use them
+ Author
+   ags, 10/19/26 17:12
+****************************************************************************/
+bool ES_EnQueueFIFOInCritical(ES_Event_t *pBlock, ES_Event_t Event2Add)
+{
+  pQueue_t pThisQueue;
+  pThisQueue = (pQueue_t)pBlock;
+  if (pThisQueue->NumEntries < pThisQueue->QueueSize)
+  {
+    pBlock[1 + ((pThisQueue->CurrentIndex + pThisQueue->NumEntries)
+          % pThisQueue->QueueSize)] = Event2Add;
+    pThisQueue->NumEntries++; // inc number of entries
+    return true;
+  }
+  else
+  {
+    return false;
+  }
+}
+
 /****************************************************************************
  Function
    ES_EnQueueLIFO
@@ -218,6 +267,500 @@ bool ES_IsQueueEmpty(ES_Event_t *pBlock)
   return pThisQueue->NumEntries == 0;
 }
 
+/****************************************************************************
+ Function
+   ES_QueueSpace
+ Parameters
+   unsigned char * pBlock : pointer to the block of memory in use as the Queue
+ Returns
+   uint8_t : the number of events that can still be added to the Queue
+ Description
+   see above
+ Notes
+
+ Author
+   ags, 10/19/26 17:14
+****************************************************************************/
+uint8_t ES_QueueSpace(ES_Event_t *pBlock)
+{
+  pQueue_t pThisQueue;
+
+  pThisQueue = (pQueue_t)pBlock;
+  return pThisQueue->QueueSize - pThisQueue->NumEntries;
+}
+
+/****************************************************************************
+ Function
+   ES_PurgeQueue
+ Parameters
+   ES_Event_t * pBlock : pointer to the block of memory in use as the Queue
+   ES_EventType_t WhichType : the type of event to be removed
+   uint16_t ParamMask : bit mask of the parameter values to be removed
+ Returns
+   The number of entries remaining in the Queue
+ Description
+   removes every entry of type WhichType whose EventParam, taken as a bit
+   number (0-15), is set in ParamMask. The remaining entries keep their order.
+ Notes
+   intended for events like ES_TIMEOUT where the parameter is a timer number,
+   so that the timeouts from a set of timers can be removed in one pass
+ Author
+   ags, 10/19/26 14:05
+****************************************************************************/
+uint8_t ES_PurgeQueue(ES_Event_t *pBlock, ES_EventType_t WhichType,
+    uint16_t ParamMask)
+{
+  return ES_PurgeQueueStamped(pBlock, (uint16_t *)0, WhichType, ParamMask);
+}
+
+/****************************************************************************
+ Function
+   ES_PurgeQueueStamped
+ Parameters
+   ES_Event_t * pBlock : pointer to the block of memory in use as the Queue
+   uint16_t * pStamps : the stamp array of the Queue, 0 if it has none
+   ES_EventType_t WhichType : the type of event to be removed
+   uint16_t ParamMask : bit mask of the parameter values to be removed
+ Returns
+   The number of entries remaining in the Queue
+ Description
+   ES_PurgeQueue, with the stamps of the entries kept moving with them
+ Author
+   ags, 10/19/26 23:36
+****************************************************************************/
+uint8_t ES_PurgeQueueStamped(ES_Event_t *pBlock, uint16_t *pStamps,
+    ES_EventType_t WhichType, uint16_t ParamMask)
+{
+  pQueue_t  pThisQueue;
+  uint8_t   ReadIndex;
+  uint8_t   WriteIndex;
+  uint8_t   Scanned;
+  uint8_t   NumKept = 0;
+  ES_Event_t ThisEntry;
+
+  pThisQueue = (pQueue_t)pBlock;
+  EnterCritical();     // save interrupt state, turn ints off
+  ReadIndex   = pThisQueue->CurrentIndex;
+  WriteIndex  = pThisQueue->CurrentIndex;
+  for (Scanned = 0; Scanned < pThisQueue->NumEntries; Scanned++)
+  {
+    ThisEntry = pBlock[1 + ReadIndex];
+    if ((ThisEntry.EventType != WhichType) ||
+        (ThisEntry.EventParam >= (sizeof(ParamMask) * BITS_PER_BYTE)) ||
+        ((BitNum2SetMask[ThisEntry.EventParam] & ParamMask) == 0))
+    {
+      // keep this one, sliding it down over any that were removed
+      pBlock[1 + WriteIndex] = ThisEntry;
+      if (pStamps != (uint16_t *)0)
+      {
+        pStamps[WriteIndex] = pStamps[ReadIndex];
+      }
+      if (++WriteIndex >= pThisQueue->QueueSize)
+      {
+        WriteIndex = 0;
+      }
+      NumKept++;
+    }
+    if (++ReadIndex >= pThisQueue->QueueSize)
+    {
+      ReadIndex = 0;
+    }
+  }
+  pThisQueue->NumEntries = NumKept;
+  ExitCritical();    // restore saved interrupt state
+  return NumKept;
+}
+
+/****************************************************************************
+ Function
+   ES_SpliceQueue
+ Parameters
+   ES_Event_t * pDest : pointer to the block of memory in use as the Queue
+     to move the events to
+   ES_Event_t * pSource : pointer to the block of memory in use as the Queue
+     to move the events from
+   uint16_t * pSourceStamps : the stamp array of the source Queue, if it is
+     a stamped Queue, 0 otherwise. The stamps of the events left in the
+     source are kept with them.
+   uint32_t TypeMask : the types of event to move, bit n set for event type
+     n, or ES_RECALL_ALL to move every event
+ Returns
+   The number of events moved
+ Description
+   moves the events of the selected types out of the source Queue and onto
+   the front of the destination Queue, so that they will be the next ones
+   removed from it. Both the moved events and those left in the source keep
+   their order.
+ Notes
+   If there is not room for all of the selected events, the oldest ones
+   that fit are moved and the rest stay in the source.
+   Only types 0-31 can be selected individually, ES_RECALL_ALL also moves
+   events with higher type numbers.
+   The whole move is done in a single critical region with one pass to
+   count the events that will fit and one pass to copy them.
+ Author
+   ags, 10/19/26 19:02
+****************************************************************************/
+uint8_t ES_SpliceQueue(ES_Event_t *pDest, ES_Event_t *pSource,
+    uint16_t *pSourceStamps, uint32_t TypeMask)
+{
+  return ES_SpliceQueueStamped(pDest, (uint16_t *)0, 0, pSource,
+      pSourceStamps, TypeMask);
+}
+
+/****************************************************************************
+ Function
+   ES_SpliceQueueStamped
+ Parameters
+   ES_Event_t * pDest : pointer to the block of memory in use as the Queue
+     to move the events to
+   uint16_t * pDestStamps : the stamp array of the destination Queue, 0 if
+     it has none
+   uint16_t DestStamp : the stamp given to each of the moved events
+   ES_Event_t * pSource : pointer to the block of memory in use as the Queue
+     to move the events from
+   uint16_t * pSourceStamps : the stamp array of the source Queue, 0 if it
+     has none
+   uint32_t TypeMask : the types of event to move
+ Returns
+   The number of events moved
+ Description
+   ES_SpliceQueue, stamping the events as they arrive in the destination
+ Notes
+   the events are given a new stamp, rather than keeping their stamps from
+   the source, since the two Queues' stamps need not be the same kind of
+   time
+ Author
+   ags, 10/19/26 23:38
+****************************************************************************/
+uint8_t ES_SpliceQueueStamped(ES_Event_t *pDest, uint16_t *pDestStamps,
+    uint16_t DestStamp, ES_Event_t *pSource, uint16_t *pSourceStamps,
+    uint32_t TypeMask)
+{
+  pQueue_t  pDestQueue;
+  pQueue_t  pSourceQueue;
+  uint8_t   ToMove = 0;
+  uint8_t   Space;
+  uint8_t   ReadIndex;
+  uint8_t   KeepIndex;
+  uint8_t   MoveIndex;
+  uint8_t   Scanned;
+  uint8_t   NumKept = 0;
+  uint8_t   NumMoved = 0;
+  ES_Event_t ThisEntry;
+
+  pDestQueue    = (pQueue_t)pDest;
+  pSourceQueue  = (pQueue_t)pSource;
+  EnterCritical();     // save interrupt state, turn ints off
+  Space = pDestQueue->QueueSize - pDestQueue->NumEntries;
+  // first pass, how many of the selected events will fit
+  ReadIndex = pSourceQueue->CurrentIndex;
+  for (Scanned = 0; (Scanned < pSourceQueue->NumEntries) && (ToMove < Space);
+      Scanned++)
+  {
+    if (IsTypeInMask(pSource[1 + ReadIndex].EventType, TypeMask))
+    {
+      ToMove++;
+    }
+    if (++ReadIndex >= pSourceQueue->QueueSize)
+    {
+      ReadIndex = 0;
+    }
+  }
+  if (ToMove != 0)
+  {
+    // back the destination up to make room at the front
+    MoveIndex = (uint8_t)((pDestQueue->CurrentIndex + pDestQueue->QueueSize -
+        ToMove) % pDestQueue->QueueSize);
+    pDestQueue->CurrentIndex  = MoveIndex;
+    pDestQueue->NumEntries    += ToMove;
+    // second pass, copy the ones that fit and slide the rest down
+    ReadIndex = pSourceQueue->CurrentIndex;
+    KeepIndex = pSourceQueue->CurrentIndex;
+    for (Scanned = 0; Scanned < pSourceQueue->NumEntries; Scanned++)
+    {
+      ThisEntry = pSource[1 + ReadIndex];
+      if ((NumMoved < ToMove) && IsTypeInMask(ThisEntry.EventType, TypeMask))
+      {
+        pDest[1 + MoveIndex] = ThisEntry;
+        if (pDestStamps != (uint16_t *)0)
+        {
+          pDestStamps[MoveIndex] = DestStamp;
+        }
+        if (++MoveIndex >= pDestQueue->QueueSize)
+        {
+          MoveIndex = 0;
+        }
+        NumMoved++;
+      }
+      else
+      {
+        pSource[1 + KeepIndex] = ThisEntry;
+        if (pSourceStamps != (uint16_t *)0)
+        {
+          pSourceStamps[KeepIndex] = pSourceStamps[ReadIndex];
+        }
+        if (++KeepIndex >= pSourceQueue->QueueSize)
+        {
+          KeepIndex = 0;
+        }
+        NumKept++;
+      }
+      if (++ReadIndex >= pSourceQueue->QueueSize)
+      {
+        ReadIndex = 0;
+      }
+    }
+    pSourceQueue->NumEntries = NumKept;
+  }
+  ExitCritical();    // restore saved interrupt state
+  return ToMove;
+}
+
+/****************************************************************************
+ Function
+   ES_EnQueueFIFOStamped
+ Parameters
+   ES_Event * pBlock : pointer to the block of memory in use as the Queue
+   uint16_t * pStamps : the stamp array, one entry per Queue entry
+   ES_Event Event2Add : event to be added to the Queue
+   uint16_t Stamp : the stamp to keep with the event
+ Returns
+   bool : true if the add was successful, false if not
+ Description
+   if it will fit, adds Event2Add to the Queue and records its stamp in the
+   same position in the stamp array
+ Notes
+   the stamp array must have (at least) as many entries as the Queue
+ Author
+   ags, 10/19/26 19:44
+****************************************************************************/
+bool ES_EnQueueFIFOStamped(ES_Event_t *pBlock, uint16_t *pStamps,
+    ES_Event_t Event2Add, uint16_t Stamp)
+{
+  pQueue_t  pThisQueue;
+  uint8_t   Slot;
+
+  pThisQueue = (pQueue_t)pBlock;
+  if (pThisQueue->NumEntries < pThisQueue->QueueSize)
+  {
+    EnterCritical();  // save interrupt state, turn ints off
+    Slot = (pThisQueue->CurrentIndex + pThisQueue->NumEntries) %
+        pThisQueue->QueueSize;
+    pBlock[1 + Slot]  = Event2Add;
+    pStamps[Slot]     = Stamp;
+    pThisQueue->NumEntries++; // inc number of entries
+    ExitCritical();           // restore saved interrupt state
+    return true;
+  }
+  else
+  {
+    return false;
+  }
+}
+
+/****************************************************************************
+ Function
+   ES_DeQueueIfExpired
+ Parameters
+   ES_Event * pBlock : pointer to the block of memory in use as the Queue
+   uint16_t * pStamps : the stamp array, holding the expiry time of each entry
+   uint16_t Now : the current time
+   ES_Event * pReturnEvent : used to return the event pulled from the queue
+ Returns
+   bool : true if the entry at the head of the Queue had expired and was
+   removed, false if the Queue is empty or its head has not expired
+ Description
+   removes the head of the Queue if its expiry time has been reached
+ Notes
+   Only the head is checked. When every entry is given the same lifetime,
+   the entries expire in Queue order, so calling this until it returns false
+   removes every expired entry while looking only at the ones that go.
+   Times are compared with a signed difference, so they may wrap, as long
+   as the lifetimes are less than half the range of the count.
+ Author
+   ags, 10/19/26 19:48
+****************************************************************************/
+bool ES_DeQueueIfExpired(ES_Event_t *pBlock, uint16_t *pStamps, uint16_t Now,
+    ES_Event_t *pReturnEvent)
+{
+  pQueue_t  pThisQueue;
+  bool      ReturnValue = false;
+
+  pThisQueue = (pQueue_t)pBlock;
+  EnterCritical();     // save interrupt state, turn ints off
+  if ((pThisQueue->NumEntries > 0) &&
+      ((int16_t)(pStamps[pThisQueue->CurrentIndex] - Now) <= 0))
+  {
+    *pReturnEvent = pBlock[1 + pThisQueue->CurrentIndex];
+    if (++pThisQueue->CurrentIndex >= pThisQueue->QueueSize)
+    {
+      pThisQueue->CurrentIndex = 0;
+    }
+    pThisQueue->NumEntries--;
+    ReturnValue = true;
+  }
+  ExitCritical();    // restore saved interrupt state
+  return ReturnValue;
+}
+
+/****************************************************************************
+ Function
+   ES_EnQueueFIFOStampedInCritical
+ Parameters
+   ES_Event * pBlock : pointer to the block of memory in use as the Queue
+   uint16_t * pStamps : the stamp array, one entry per Queue entry
+   ES_Event Event2Add : event to be added to the Queue
+   uint16_t Stamp : the stamp to keep with the event
+ Returns
+   bool : true if the add was successful, false if not
+ Description
+   the same as ES_EnQueueFIFOStamped, for use when the caller already has
+   the interrupts off
+ Author
+   ags, 10/19/26 23:40
+****************************************************************************/
+bool ES_EnQueueFIFOStampedInCritical(ES_Event_t *pBlock, uint16_t *pStamps,
+    ES_Event_t Event2Add, uint16_t Stamp)
+{
+  pQueue_t  pThisQueue;
+  uint8_t   Slot;
+
+  pThisQueue = (pQueue_t)pBlock;
+  if (pThisQueue->NumEntries < pThisQueue->QueueSize)
+  {
+    Slot = (pThisQueue->CurrentIndex + pThisQueue->NumEntries) %
+        pThisQueue->QueueSize;
+    pBlock[1 + Slot]  = Event2Add;
+    pStamps[Slot]     = Stamp;
+    pThisQueue->NumEntries++; // inc number of entries
+    return true;
+  }
+  else
+  {
+    return false;
+  }
+}
+
+/****************************************************************************
+ Function
+   ES_EnQueueLIFOStamped
+ Parameters
+   ES_Event * pBlock : pointer to the block of memory in use as the Queue
+   uint16_t * pStamps : the stamp array, one entry per Queue entry
+   ES_Event Event2Add : event to be added to the Queue
+   uint16_t Stamp : the stamp to keep with the event
+ Returns
+   bool : true if the add was successful, false if not
+ Description
+   ES_EnQueueLIFO, recording the stamp in the same position in the stamp
+   array
+ Author
+   ags, 10/19/26 23:42
+****************************************************************************/
+bool ES_EnQueueLIFOStamped(ES_Event_t *pBlock, uint16_t *pStamps,
+    ES_Event_t Event2Add, uint16_t Stamp)
+{
+  pQueue_t pThisQueue;
+  pThisQueue = (pQueue_t)pBlock;
+  if (pThisQueue->NumEntries < pThisQueue->QueueSize)
+  {
+    EnterCritical();     // save interrupt state, turn ints off
+    pThisQueue->NumEntries++;
+    if (pThisQueue->CurrentIndex == 0)
+    {
+      pThisQueue->CurrentIndex = pThisQueue->QueueSize - 1;
+    }
+    else
+    {
+      pThisQueue->CurrentIndex--;
+    }
+    pBlock[1 + pThisQueue->CurrentIndex]  = Event2Add;
+    pStamps[pThisQueue->CurrentIndex]     = Stamp;
+    ExitCritical();    // restore saved interrupt state
+    return true;
+  }
+  else    // in case no room on the queue
+  {
+    return false;
+  }
+}
+
+/****************************************************************************
+ Function
+   ES_DeQueueStamped
+ Parameters
+   ES_Event * pBlock : pointer to the block of memory in use as the Queue
+   uint16_t * pStamps : the stamp array, one entry per Queue entry
+   ES_Event * pReturnEvent : used to return the event pulled from the queue
+   uint16_t * pStamp : used to return the stamp of the event
+ Returns
+   The number of entries remaining in the Queue
+ Description
+   ES_DeQueue, also returning the stamp that was kept with the event
+ Notes
+   if the Queue was empty, the stamp is left alone
+ Author
+   ags, 10/19/26 23:44
+****************************************************************************/
+uint8_t ES_DeQueueStamped(ES_Event_t *pBlock, uint16_t *pStamps,
+    ES_Event_t *pReturnEvent, uint16_t *pStamp)
+{
+  pQueue_t  pThisQueue;
+  uint8_t   NumLeft;
+
+  pThisQueue = (pQueue_t)pBlock;
+  if (pThisQueue->NumEntries > 0)
+  {
+    EnterCritical();     // save interrupt state, turn ints off
+    *pReturnEvent = pBlock[1 + pThisQueue->CurrentIndex];
+    *pStamp       = pStamps[pThisQueue->CurrentIndex];
+    if (++pThisQueue->CurrentIndex >= pThisQueue->QueueSize)
+    {
+      pThisQueue->CurrentIndex = 0;
+    }
+    NumLeft = --pThisQueue->NumEntries;
+    ExitCritical();    // restore saved interrupt state
+  }
+  else     // no items left in the queue
+  {
+    (*pReturnEvent).EventType   = ES_NO_EVENT;
+    (*pReturnEvent).EventParam  = 0;
+    NumLeft                     = 0;
+  }
+  return NumLeft;
+}
+
+/****************************************************************************
+ Function
+   ES_PeekStamp
+ Parameters
+   ES_Event * pBlock : pointer to the block of memory in use as the Queue
+   uint16_t * pStamps : the stamp array, one entry per Queue entry
+   uint16_t * pStamp : used to return the stamp of the entry at the head
+ Returns
+   bool : false if the Queue is empty, in which case the stamp is left alone
+ Description
+   reads the stamp kept with the head of the Queue, without removing it
+ Author
+   ags, 10/20/26 04:45
+****************************************************************************/
+bool ES_PeekStamp(ES_Event_t *pBlock, uint16_t *pStamps, uint16_t *pStamp)
+{
+  pQueue_t  pThisQueue;
+  bool      ReturnValue = false;
+
+  pThisQueue = (pQueue_t)pBlock;
+  EnterCritical();     // save interrupt state, turn ints off
+  if (pThisQueue->NumEntries > 0)
+  {
+    *pStamp     = pStamps[pThisQueue->CurrentIndex];
+    ReturnValue = true;
+  }
+  ExitCritical();    // restore saved interrupt state
+  return ReturnValue;
+}
+
 #if 0
 /****************************************************************************
  Function
@@ -248,6 +791,27 @@ void QueueFlushQueue(uint8_t *pBlock)
 /***************************************************************************
  private functions
  ***************************************************************************/
+/****************************************************************************
+ Function
+   IsTypeInMask
+ Parameters
+   ES_EventType_t ThisType : the type of an event
+   uint32_t TypeMask : bit n set for event type n, or ES_RECALL_ALL
+ Returns
+   bool : true if the type is selected by the mask
+ Author
+   ags, 10/19/26 19:08
+****************************************************************************/
+static bool IsTypeInMask(ES_EventType_t ThisType, uint32_t TypeMask)
+{
+  if (TypeMask == ES_RECALL_ALL)
+  {
+    return true;
+  }
+  return (ThisType < (sizeof(TypeMask) * BITS_PER_BYTE)) &&
+         ((TypeMask & ((uint32_t)1 << ThisType)) != 0);
+}
+
 #ifdef TEST
 
 #include <stdio.h>
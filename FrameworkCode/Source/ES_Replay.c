@@ -0,0 +1,363 @@
+/****************************************************************************
+ Module
+     ES_Replay.c
+
+ Description
+     This is a module replaying the inputs captured from a running system,
+     so that the same services can be driven by them on the host, again and
+     again, as a benchmark. The inputs are the events posted from outside
+     the run functions, by the event checkers, the timers and the interrupt
+     responses, as captured in a trace (see TRACE_INPUTS_ONLY). The host
+     port reads them from a file and hands each one to ES_Replay_Input at
+     its time on a virtual clock. Everything that the services post to each
+     other follows from them, just as it did in the field.
+     While replaying, the cycles taken by every dispatch, the most events in
+     each service's queue and the time that ES_Run takes to get through the
+     work that each set of inputs brings are measured, and printed at the
+     end of the file.
+
+ Notes
+     The whole module, and the calls to it, compile out unless
+     _INCLUDE_EVENT_REPLAY_ is defined in ES_Configure.h. It is only for the
+     host port.
+     The virtual clock stands still while ES_Run has work to do, and only
+     moves on to the next input once it is idle. So the order of the events
+     does not depend on how fast the host is, and two replays of the same
+     file dispatch the same events in the same order. The cost of that work
+     is measured on the cycle counter, which runs in real time. A service
+     that waits in a loop for the tick or the high resolution count to move
+     on will wait for ever while replaying.
+     The live inputs are dropped, see ES_Replay_Mutes, as the captured ones
+     stand in for them. The timers still run, so their state is right for
+     the services, but their timeouts come from the file. The event checkers
+     are not called.
+     The latency statistics are timed on the virtual clock, so they come
+     out as 0 while replaying. The response times take their place.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/20/26 04:00 ags     Began Coding
+****************************************************************************/
+
+/*----------------------------- Include Files -----------------------------*/
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_General.h"
+#include "ES_Broadcast.h"
+#include "ES_Replay.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef _INCLUDE_EVENT_REPLAY_
+/*----------------------------- Module Defines ----------------------------*/
+
+/*---------------------------- Module Functions ---------------------------*/
+
+/*---------------------------- Module Variables ---------------------------*/
+static ES_ReplayStats_t         Stats;
+static ES_ReplayServiceStats_t  ServiceStats[NUM_SERVICES];
+
+// true while ES_Replay_Input is posting, so that its posts are not dropped
+static bool Delivering = false;
+
+// the cycle count when the current run function was called
+static uint32_t RunStart;
+
+// true from the first input after ES_Run was idle until it is idle again,
+// and the cycle count at that input
+static bool     Responding = false;
+static uint32_t ResponseStart;
+static uint64_t TotalResponse;
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+     ES_Replay_Init
+ Parameters
+     None.
+ Returns
+     None.
+ Description
+     clears the statistics, starts the cycle counter and opens the file of
+     inputs
+ Notes
+     called from ES_Initialize
+ Author
+     ags, 10/20/26 04:02
+****************************************************************************/
+void ES_Replay_Init(void)
+{
+  uint8_t i;
+
+  Stats.Inputs          = 0;
+  Stats.InputsDropped   = 0;
+  Stats.Dispatches      = 0;
+  Stats.DispatchCycles  = 0;
+  Stats.Responses       = 0;
+  Stats.MinResponse     = 0;
+  Stats.MaxResponse     = 0;
+  Stats.LastInputTime   = 0;
+  TotalResponse         = 0;
+  Responding            = false;
+  for (i = 0; i < ARRAY_SIZE(ServiceStats); i++)
+  {
+    ServiceStats[i].Dispatches  = 0;
+    ServiceStats[i].Cycles      = 0;
+    ServiceStats[i].QueuePeak   = 0;
+  }
+  _HW_CycleCount_Init();
+  _HW_Replay_Init();
+}
+
+/****************************************************************************
+ Function
+     ES_Replay_Input
+ Parameters
+     uint8_t WhichService, the service that the input was posted to, or
+       ES_REPLAY_BROADCAST if it was broadcast
+     ES_Event_t ThisEvent, the input
+ Returns
+     None.
+ Description
+     posts a captured input, starting the measurement of the response to
+     it if ES_Run was idle
+ Notes
+     called by the host port as the virtual clock reaches the input's time
+ Author
+     ags, 10/20/26 04:04
+****************************************************************************/
+void ES_Replay_Input(uint8_t WhichService, ES_Event_t ThisEvent)
+{
+  bool Posted = false;
+
+  if (Responding == false)
+  {
+    ResponseStart = _HW_GetCycleCount();
+    Responding    = true;
+  }
+  Delivering = true;
+  if (WhichService == ES_REPLAY_BROADCAST)
+  {
+#if BROADCAST_RING_SIZE > 0
+    Posted = ES_Broadcast(ThisEvent);
+#endif
+  }
+  else
+  {
+    Posted = ES_PostToService(WhichService, ThisEvent);
+  }
+  Delivering = false;
+  Stats.Inputs++;
+  if (Posted == false)
+  {
+    Stats.InputsDropped++;
+  }
+  Stats.LastInputTime = _HW_HRTimer_GetCount();
+}
+
+/****************************************************************************
+ Function
+     ES_Replay_Mutes
+ Parameters
+     None.
+ Returns
+     bool, true if a post made now should be dropped
+ Description
+     drops the live inputs, the posts made from outside the run functions
+     other than by ES_Replay_Input, as the captured inputs take their place
+ Notes
+     called at the top of the post functions
+ Author
+     ags, 10/20/26 04:06
+****************************************************************************/
+bool ES_Replay_Mutes(void)
+{
+  return (Delivering == false) && (ES_PostIsInput() == true);
+}
+
+/****************************************************************************
+ Function
+     ES_Replay_StartRun
+ Parameters
+     uint8_t WhichService, the service about to be given an event
+     uint8_t QueueDepth, the number of events in its queue, with that one
+ Returns
+     None.
+ Description
+     notes the queue's peak and the cycle count as a dispatch begins
+ Notes
+     called from ES_Run
+ Author
+     ags, 10/20/26 04:08
+****************************************************************************/
+void ES_Replay_StartRun(uint8_t WhichService, uint8_t QueueDepth)
+{
+  if (QueueDepth > ServiceStats[WhichService].QueuePeak)
+  {
+    ServiceStats[WhichService].QueuePeak = QueueDepth;
+  }
+  RunStart = _HW_GetCycleCount();
+}
+
+/****************************************************************************
+ Function
+     ES_Replay_EndRun
+ Parameters
+     uint8_t WhichService, the service whose run function has returned
+ Returns
+     None.
+ Description
+     adds the cycles since ES_Replay_StartRun to the dispatch totals
+ Notes
+     called from ES_Run
+ Author
+     ags, 10/20/26 04:09
+****************************************************************************/
+void ES_Replay_EndRun(uint8_t WhichService)
+{
+  uint32_t Cycles = _HW_GetCycleCount() - RunStart;
+
+  ServiceStats[WhichService].Dispatches++;
+  ServiceStats[WhichService].Cycles += Cycles;
+  Stats.Dispatches++;
+  Stats.DispatchCycles += Cycles;
+}
+
+/****************************************************************************
+ Function
+     ES_Replay_Idle
+ Parameters
+     None.
+ Returns
+     None.
+ Description
+     ends the measurement of the response to the last inputs and moves the
+     virtual clock on to the next ones. After the last input, prints the
+     report and exits.
+ Notes
+     called from ES_Run, in place of the event checkers, when there is no
+     work left. The exit runs the atexit handlers, so the trace and the PC
+     samples are still written out.
+ Author
+     ags, 10/20/26 04:11
+****************************************************************************/
+void ES_Replay_Idle(void)
+{
+  uint32_t Cycles;
+
+  if (Responding == true)
+  {
+    Cycles = _HW_GetCycleCount() - ResponseStart;
+    if ((Stats.Responses == 0) || (Cycles < Stats.MinResponse))
+    {
+      Stats.MinResponse = Cycles;
+    }
+    if (Cycles > Stats.MaxResponse)
+    {
+      Stats.MaxResponse = Cycles;
+    }
+    Stats.Responses++;
+    TotalResponse += Cycles;
+    Responding = false;
+  }
+  if (_HW_Replay_Advance() == false)
+  {
+    ES_Replay_Report();
+    exit(EXIT_SUCCESS);
+  }
+}
+
+/****************************************************************************
+ Function
+     ES_Replay_GetStats
+ Parameters
+     ES_ReplayStats_t *pStats, where to copy the totals
+ Returns
+     None.
+ Description
+     copies the totals so far, with the mean response
+ Author
+     ags, 10/20/26 04:12
+****************************************************************************/
+void ES_Replay_GetStats(ES_ReplayStats_t *pStats)
+{
+  *pStats = Stats;
+  if (Stats.Responses == 0)
+  {
+    pStats->MeanResponse = 0;
+  }
+  else
+  {
+    pStats->MeanResponse = (uint32_t)(TotalResponse / Stats.Responses);
+  }
+}
+
+/****************************************************************************
+ Function
+     ES_Replay_GetService
+ Parameters
+     uint8_t WhichService, the service to report on
+     ES_ReplayServiceStats_t *pStats, where to copy its statistics
+ Returns
+     bool, false if the service does not exist
+ Author
+     ags, 10/20/26 04:13
+****************************************************************************/
+bool ES_Replay_GetService(uint8_t WhichService,
+    ES_ReplayServiceStats_t *pStats)
+{
+  if (WhichService >= ARRAY_SIZE(ServiceStats))
+  {
+    return false;
+  }
+  *pStats = ServiceStats[WhichService];
+  return true;
+}
+
+/****************************************************************************
+ Function
+     ES_Replay_Report
+ Parameters
+     None.
+ Returns
+     None.
+ Description
+     prints the totals, and the dispatches, cycles and queue peak of each
+     service that was run
+ Notes
+     the lines start with a keyword, so that a script can pick the figures
+     out to compare one build with another
+ Author
+     ags, 10/20/26 04:15
+****************************************************************************/
+void ES_Replay_Report(void)
+{
+  ES_ReplayStats_t  Totals;
+  uint8_t           i;
+
+  ES_Replay_GetStats(&Totals);
+  printf("\r\nreplay inputs %lu dropped %lu time %lu\r\n",
+      (unsigned long)Totals.Inputs, (unsigned long)Totals.InputsDropped,
+      (unsigned long)Totals.LastInputTime);
+  printf("dispatch count %lu cycles %llu\r\n",
+      (unsigned long)Totals.Dispatches,
+      (unsigned long long)Totals.DispatchCycles);
+  printf("response count %lu min %lu mean %lu max %lu\r\n",
+      (unsigned long)Totals.Responses, (unsigned long)Totals.MinResponse,
+      (unsigned long)Totals.MeanResponse, (unsigned long)Totals.MaxResponse);
+  for (i = 0; i < ARRAY_SIZE(ServiceStats); i++)
+  {
+    if (ServiceStats[i].Dispatches != 0)
+    {
+      printf("service %u count %lu cycles %llu peak %u\r\n", i,
+          (unsigned long)ServiceStats[i].Dispatches,
+          (unsigned long long)ServiceStats[i].Cycles,
+          ServiceStats[i].QueuePeak);
+    }
+  }
+}
+
+#endif /* _INCLUDE_EVENT_REPLAY_ */
+/*------------------------------- Footnotes -------------------------------*/
+/*------------------------------ End of file ------------------------------*/
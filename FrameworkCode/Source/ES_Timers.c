@@ -13,6 +13,19 @@
  History
  When           Who     What/Why
  -------------- ---     --------
+ 10/20/26 06:48 ags      every timer that expires is left with no time on it,
+                         including those coalesced from their slack window
+ 10/20/26 06:18 ags      the slack window is the slack added when the timer
+                         was set, limited to what fits on top of the time
+ 10/20/26 06:12 ags      an unused timer can not join a group, and a group
+                         keeps the one owner
+ 10/20/26 04:52 ags      added ES_Timer_GetTicksToNext
+ 10/20/26 00:30 ags      trace the expirations with _INCLUDE_TRACE_
+ 10/19/26 20:08 ags      the tick response sweeps the timed deferral queues
+ 10/19/26 14:25 ags      added timer groups, owned by a service, that can be
+                         stopped together along with their queued timeouts
+ 10/19/26 13:05 ags      added per-timer slack so that expirations can be
+                         coalesced into a single tick response pass
  10/27/14 14:02 jec      moved ticking of 'time' to ES_Port to allow it to tick
                          even while blocking. required change to ES_GetTime too
  10/20/13 10:48 jec      moved definition of BITS_PER_BYTE to ES_General.h
@@ -49,6 +62,8 @@
 #include "ES_PostList.h"
 #include "ES_LookupTables.h"
 #include "ES_Timers.h"
+#include "ES_DeferRecall.h"
+#include "ES_Trace.h"
 #include "ES_Port.h"
 /*--------------------------- External Variables --------------------------*/
 
@@ -67,6 +82,7 @@ typedef uint16_t Tflag_t;
 typedef uint16_t Timer_t; // sets size of timers to 16 bits
 
 /*---------------------------- Module Functions ---------------------------*/
+static Timer_t AddSlack(uint8_t Num, uint16_t NewTime);
 
 /*---------------------------- Module Variables ---------------------------*/
 static Timer_t TMR_TimerArray[sizeof(Tflag_t) * BITS_PER_BYTE] =
@@ -89,8 +105,26 @@ static Timer_t TMR_TimerArray[sizeof(Tflag_t) * BITS_PER_BYTE] =
   0x0
 };
 
+/*
+   the slack for each timer, the number of ticks that the timer may be late
+   so that it can expire along with another timer. The count in
+   TMR_TimerArray includes the slack that was added when the timer was set,
+   which is kept in TMR_WindowArray, so a timer is eligible to expire once
+   its count has dropped to that value. The slack added is limited so that
+   the count fits in the timer, so the window never opens early.
+*/
+static Timer_t TMR_SlackArray[sizeof(Tflag_t) * BITS_PER_BYTE];
+static Timer_t TMR_WindowArray[sizeof(Tflag_t) * BITS_PER_BYTE];
+
 static Tflag_t TMR_ActiveFlags;
 
+/*
+   the timers in each group, as a mask of TMR_ActiveFlags bits, and the
+   service that owns the group (whose queue receives the group's timeouts)
+*/
+static Tflag_t TMR_GroupMasks[NUM_TIMER_GROUPS];
+static uint8_t TMR_GroupOwners[NUM_TIMER_GROUPS];
+
 static pPostFunc const Timer2PostFunc[sizeof(Tflag_t) * BITS_PER_BYTE] =
 {
   TIMER0_RESP_FUNC,
@@ -160,7 +194,7 @@ ES_TimerReturn_t ES_Timer_SetTimer(uint8_t Num, uint16_t NewTime)
   {
     return ES_Timer_ERR;
   }
-  TMR_TimerArray[Num] = NewTime;
+  TMR_TimerArray[Num] = AddSlack(Num, NewTime);
   return ES_Timer_OK;
 }
 
@@ -244,11 +278,121 @@ ES_TimerReturn_t ES_Timer_InitTimer(uint8_t Num, uint16_t NewTime)
   {
     return ES_Timer_ERR;
   }
-  TMR_TimerArray[Num] = NewTime;
+  TMR_TimerArray[Num] = AddSlack(Num, NewTime);
   TMR_ActiveFlags     |= BitNum2SetMask[Num]; /* set timer as active */
   return ES_Timer_OK;
 }
 
+/****************************************************************************
+ Function
+     ES_Timer_SetSlack
+ Parameters
+     unsigned char Num, the number of the timer
+     unsigned int Slack, the number of ticks that the timer may run late
+ Returns
+     ES_Timer_ERR if the requested timer does not exist, ES_Timer_OK otherwise.
+ Description
+     sets the slack window that will be applied by subsequent calls to
+     ES_Timer_InitTimer & ES_Timer_SetTimer for this timer. A timer with
+     slack expires no earlier than the time requested and no later than
+     the time + slack. Within that window it expires on the same tick as any
+     other timer that reaches its deadline, so that the timeouts are posted
+     from one tick response pass rather than waking the services on
+     several different ticks.
+ Notes
+     The default slack of 0 gives the original exact expiration.
+     Does not change the timing of a timer that is already running.
+ Author
+     ags, 10/19/26 13:10
+****************************************************************************/
+ES_TimerReturn_t ES_Timer_SetSlack(uint8_t Num, uint16_t Slack)
+{
+  if (Num >= ARRAY_SIZE(TMR_TimerArray))
+  {
+    return ES_Timer_ERR;    /* tried to set a timer that doesn't exist */
+  }
+  TMR_SlackArray[Num] = Slack;
+  return ES_Timer_OK;
+}
+
+/****************************************************************************
+ Function
+     ES_Timer_AssignGroup
+ Parameters
+     unsigned char Num, the number of the timer
+     unsigned char Group, the group to place it in
+     unsigned char Owner, the number of the service that owns the group
+ Returns
+     ES_Timer_ERR if the timer, group or owner does not exist, the timer is
+     unused, or the group is already owned by a different service,
+     ES_Timer_OK otherwise.
+ Description
+     tags a timer as belonging to a group owned by a service, removing it
+     from any group that it was in before. The whole group can then be
+     cancelled with a single call to ES_Timer_StopGroup.
+ Notes
+     The owner must be the service that the timer's response function
+     posts to, as ES_Timer_StopGroup purges the group's timeouts from the
+     owner's queue. The timers only know their response functions, so this
+     can not be checked here.
+ Author
+     ags, 10/19/26 14:30
+****************************************************************************/
+ES_TimerReturn_t ES_Timer_AssignGroup(uint8_t Num, uint8_t Group,
+    uint8_t Owner)
+{
+  uint8_t i;
+
+  if ((Num >= ARRAY_SIZE(TMR_TimerArray)) ||
+      (Group >= ARRAY_SIZE(TMR_GroupMasks)) ||
+      (Owner >= NUM_SERVICES) ||
+      (Timer2PostFunc[Num] == TIMER_UNUSED) ||
+      /* a group only ever has one owner */
+      ((TMR_GroupMasks[Group] != 0) && (TMR_GroupOwners[Group] != Owner)))
+  {
+    return ES_Timer_ERR;
+  }
+  for (i = 0; i < ARRAY_SIZE(TMR_GroupMasks); i++)
+  {
+    TMR_GroupMasks[i] &= BitNum2ClrMask[Num];
+  }
+  TMR_GroupMasks[Group]  |= BitNum2SetMask[Num];
+  TMR_GroupOwners[Group] = Owner;
+  return ES_Timer_OK;
+}
+
+/****************************************************************************
+ Function
+     ES_Timer_StopGroup
+ Parameters
+     unsigned char Group, the group to stop
+ Returns
+     ES_Timer_ERR if the group does not exist, ES_Timer_OK otherwise.
+ Description
+     stops every timer in the group by clearing their bits in
+     TMR_ActiveFlags in one mask operation, then purges any ES_TIMEOUT
+     events from those timers that are still sitting in the owner's queue.
+ Notes
+     Intended to be called on ES_EXIT from a (super)state that started the
+     timers, so that the state machine never sees a stale timeout.
+ Author
+     ags, 10/19/26 14:36
+****************************************************************************/
+ES_TimerReturn_t ES_Timer_StopGroup(uint8_t Group)
+{
+  if (Group >= ARRAY_SIZE(TMR_GroupMasks))
+  {
+    return ES_Timer_ERR;
+  }
+  if (TMR_GroupMasks[Group] != 0)
+  {
+    TMR_ActiveFlags &= ~TMR_GroupMasks[Group];  /* set timers as inactive */
+    ES_PurgeFromService(TMR_GroupOwners[Group], ES_TIMEOUT,
+        TMR_GroupMasks[Group]);
+  }
+  return ES_Timer_OK;
+}
+
 /****************************************************************************
  Function
      ES_Timer_GetTime
@@ -270,6 +414,53 @@ uint16_t ES_Timer_GetTime(void)
   return _HW_GetTickCount();
 }
 
+/****************************************************************************
+ Function
+     ES_Timer_GetTicksToNext
+ Parameters
+     None.
+ Returns
+     uint16_t, the number of ticks until the tick response will next post
+     an event, or 0 if no timer is running and nothing is deferred
+ Description
+     finds the active timer that will run out first, and the timed deferral
+     entry that will expire first
+ Notes
+     a timer in its slack window may go sooner, along with another one, but
+     never before the first one to run out. Used by the host port to move
+     its virtual clock on while there is nothing else to do.
+ Author
+     ags, 10/20/26 04:54
+****************************************************************************/
+uint16_t ES_Timer_GetTicksToNext(void)
+{
+  Tflag_t   Active;
+  uint8_t   Num;
+  uint16_t  Ticks = 0;
+#if NUM_TIMED_DEFERRALS > 0
+  uint16_t  DeferralTicks;
+#endif
+
+  Active = TMR_ActiveFlags;
+  while (Active != 0)
+  {
+    Num = ES_GetMSBitSet(Active);
+    if ((Ticks == 0) || (TMR_TimerArray[Num] < Ticks))
+    {
+      Ticks = TMR_TimerArray[Num];
+    }
+    Active &= BitNum2ClrMask[Num];
+  }
+#if NUM_TIMED_DEFERRALS > 0
+  DeferralTicks = ES_TicksToTimedExpiry();
+  if ((DeferralTicks != 0) && ((Ticks == 0) || (DeferralTicks < Ticks)))
+  {
+    Ticks = DeferralTicks;
+  }
+#endif
+  return Ticks;
+}
+
 /****************************************************************************
  Function
      ES_Timer_Tick_Resp
@@ -284,6 +475,9 @@ uint16_t ES_Timer_GetTime(void)
      decrementing each active timers count, if the count goes to 0, it
      will post an event to the corresponding SM and clear the active flag to
      prevent further counting.
+     If any timer expires on this tick, every timer that is inside its
+     slack window expires along with it.
+     Then removes the expired entries from the timed deferral queues.
  Notes
      Called from _Timer_Int_Resp in ES_Port.c.
  Author
@@ -292,6 +486,8 @@ uint16_t ES_Timer_GetTime(void)
 void ES_Timer_Tick_Resp(void)
 {
   static Tflag_t  NeedsProcessing;
+  static Tflag_t  Expired;
+  static Tflag_t  InSlackWindow;
   static uint8_t  NextTimer2Process;
   static ES_Event_t NewEvent;
 
@@ -299,6 +495,8 @@ void ES_Timer_Tick_Resp(void)
   {
     // start by getting a list of all the active timers
     NeedsProcessing = TMR_ActiveFlags;
+    Expired         = 0;
+    InSlackWindow   = 0;
     do
     {
       // find the MSB that is set
@@ -306,17 +504,73 @@ void ES_Timer_Tick_Resp(void)
       /* decrement that timer, check if timed out */
       if (--TMR_TimerArray[NextTimer2Process] == 0)
       {
-        NewEvent.EventType  = ES_TIMEOUT;
-        NewEvent.EventParam = NextTimer2Process;
-        /* post the timeout event to the right Service */
-        Timer2PostFunc[NextTimer2Process](NewEvent);
-        /* and stop counting */
-        TMR_ActiveFlags &= BitNum2ClrMask[NextTimer2Process];
+        Expired |= BitNum2SetMask[NextTimer2Process];
+      }
+      /* or if it could go now, if something else does */
+      else if (TMR_TimerArray[NextTimer2Process] <=
+          TMR_WindowArray[NextTimer2Process])
+      {
+        InSlackWindow |= BitNum2SetMask[NextTimer2Process];
       }
       // mark off the active timer that we just processed
       NeedsProcessing &= BitNum2ClrMask[NextTimer2Process];
     } while (NeedsProcessing != 0);
+
+    if (Expired != 0)
+    {
+      // coalesce the timers in their slack window with this expiration
+      Expired |= InSlackWindow;
+      /* and stop counting all of them */
+      TMR_ActiveFlags &= ~Expired;
+      do
+      {
+        NextTimer2Process   = ES_GetMSBitSet(Expired);
+        // a coalesced timer has slack left, which must not be restarted
+        TMR_TimerArray[NextTimer2Process] = 0;
+        NewEvent.EventType  = ES_TIMEOUT;
+        NewEvent.EventParam = NextTimer2Process;
+#ifdef _INCLUDE_TRACE_
+        ES_Trace_Record(ES_TRACE_TIMEOUT, 0, NewEvent);
+#endif
+        /* post the timeout event to the right Service */
+        Timer2PostFunc[NextTimer2Process](NewEvent);
+        Expired &= BitNum2ClrMask[NextTimer2Process];
+      } while (Expired != 0);
+    }
+  }
+#if NUM_TIMED_DEFERRALS > 0
+  ES_SweepTimedDeferrals();
+#endif
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+/****************************************************************************
+ Function
+     AddSlack
+ Parameters
+     unsigned char Num, the number of the timer
+     unsigned int NewTime, the requested time
+ Returns
+     Timer_t the count to load, the time plus the timer's slack
+ Description
+     the count runs to the end of the slack window. The slack is limited to
+     what fits in the timer on top of the time, and is kept as the size of
+     the window, so that the window opens no earlier than the time.
+ Author
+     ags, 10/19/26 13:14
+****************************************************************************/
+static Timer_t AddSlack(uint8_t Num, uint16_t NewTime)
+{
+  Timer_t Window = TMR_SlackArray[Num];
+
+  if (Window > (UINT16_MAX - NewTime))
+  {
+    Window = UINT16_MAX - NewTime;
   }
+  TMR_WindowArray[Num] = Window;
+  return NewTime + Window;
 }
 
 /*------------------------------- Footnotes -------------------------------*/
@@ -0,0 +1,242 @@
+/****************************************************************************
+ Module
+     ES_Trace.c
+
+ Description
+     This is a module keeping a compact binary trace of the framework's
+     activity: the posts to the service queues, the calls to the run
+     functions, the timer expirations and the event checkers that fire.
+     The records go into a RAM ring, and ES_Run drains the ring through the
+     port's trace output (a UART on the target, a file on the host) while
+     it has nothing else to do.
+
+ Notes
+     The whole module, and the calls to it, compile out unless _INCLUDE_TRACE_
+     is defined in ES_Configure.h.
+     The records are timed on the high resolution timer, each carrying the
+     gap since the one before so that they fit in 6 bytes. See ES_Trace.h
+     for the format.
+     Records may be made from the interrupt responses, so the ring is
+     written in a critical region. ES_Trace_Record must not be called with
+     the interrupts already off. Only ES_Trace_Drain reads the ring.
+     When the ring is full the new records are dropped and counted, and an
+     ES_TRACE_LOST record with the count goes in once there is room.
+     With TRACE_INPUTS_ONLY, only the ES_TRACE_INPUT and
+     ES_TRACE_INPUT_BROADCAST records are kept, along with the SYNC, TIME
+     and LOST records that the stream needs.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/20/26 03:56 ags     TRACE_INPUTS_ONLY keeps only the input records
+ 10/20/26 00:12 ags     Began Coding
+****************************************************************************/
+
+/*----------------------------- Include Files -----------------------------*/
+#include "ES_Configure.h"
+#include "ES_General.h"
+#include "ES_Port.h"
+#include "ES_HRTimers.h"
+#include "ES_Trace.h"
+
+#ifdef _INCLUDE_TRACE_
+/*----------------------------- Module Defines ----------------------------*/
+#if (TRACE_RING_SIZE > 32768) || ((TRACE_RING_SIZE & (TRACE_RING_SIZE - 1)) != 0)
+#error TRACE_RING_SIZE must be a power of 2, no larger than 32768
+#endif
+
+#define TRACE_RING_MASK (TRACE_RING_SIZE - 1)
+
+// the longest gap that fits in a record
+#define MAX_GAP 0xFFFFUL
+
+// the SYNC record's event type and parameter, a pattern that the decoder
+// looks for to find the start of the stream
+#define SYNC_TYPE   0x5A
+#define SYNC_PARAM  0xA55A
+
+/*---------------------------- Module Functions ---------------------------*/
+static void PutRecord(uint8_t Header, uint8_t Type, uint16_t Gap,
+    uint16_t Param);
+
+/*---------------------------- Module Variables ---------------------------*/
+static uint8_t TraceRing[TRACE_RING_SIZE][ES_TRACE_RECORD_SIZE];
+// free-running record numbers, the slot is the number & TRACE_RING_MASK
+static volatile uint16_t TraceHead;   /* next slot to write */
+static uint16_t          TraceTail;   /* next slot to send */
+// the next byte of the record at TraceTail to send
+static uint8_t  TailByte;
+// the time of the last record in the ring
+static uint32_t LastTime;
+// the records dropped since the ring was last full
+static uint16_t NumLost;
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+     ES_Trace_Init
+ Parameters
+     None.
+ Returns
+     None.
+ Description
+     starts the trace output and empties the ring, leaving the SYNC record
+     in it to start the stream
+ Notes
+     called from ES_Initialize, after the high resolution timer is started
+ Author
+     ags, 10/20/26 00:14
+****************************************************************************/
+void ES_Trace_Init(void)
+{
+  _HW_Trace_Init();
+  TraceHead = 0;
+  TraceTail = 0;
+  TailByte  = 0;
+  NumLost   = 0;
+  LastTime  = ES_HRTimer_GetTime();
+  PutRecord((uint8_t)(ES_TRACE_SYNC << 4), SYNC_TYPE, 0, SYNC_PARAM);
+}
+
+/****************************************************************************
+ Function
+     ES_Trace_Record
+ Parameters
+     ES_TraceKind_t Kind, what happened
+     uint8_t WhichService, the service involved, 0 if none
+     ES_Event_t ThisEvent, the event involved, or for ES_TRACE_TIMEOUT and
+       ES_TRACE_CHECKER, the parameter is the timer or checker number
+ Returns
+     None.
+ Description
+     adds a record to the ring, timed now
+ Notes
+     turns the interrupts off, so must not be called from a critical region
+ Author
+     ags, 10/20/26 00:16
+****************************************************************************/
+void ES_Trace_Record(ES_TraceKind_t Kind, uint8_t WhichService,
+    ES_Event_t ThisEvent)
+{
+  uint32_t  Now;
+  uint32_t  Gap;
+  uint16_t  Space;
+  uint16_t  Needed;
+
+#ifdef TRACE_INPUTS_ONLY
+  if ((Kind != ES_TRACE_INPUT) && (Kind != ES_TRACE_INPUT_BROADCAST))
+  {
+    return;
+  }
+#endif
+  EnterCritical();
+  Now     = ES_HRTimer_GetTime();
+  Gap     = Now - LastTime;
+  Needed  = 1;
+  if (Gap > MAX_GAP)
+  {
+    Needed++;     // for the ES_TRACE_TIME record
+  }
+  if (NumLost != 0)
+  {
+    Needed++;     // for the ES_TRACE_LOST record
+  }
+  Space = TRACE_RING_SIZE - (uint16_t)(TraceHead - TraceTail);
+  if (Space < Needed)
+  {
+    if (NumLost < 0xFFFF)
+    {
+      NumLost++;
+    }
+  }
+  else
+  {
+    LastTime = Now;
+    if (Gap > MAX_GAP)
+    {
+      PutRecord((uint8_t)(ES_TRACE_TIME << 4), 0, 0, (uint16_t)(Gap >> 16));
+    }
+    if (NumLost != 0)
+    {
+      PutRecord((uint8_t)(ES_TRACE_LOST << 4), 0, 0, NumLost);
+      NumLost = 0;
+    }
+    PutRecord((uint8_t)((Kind << 4) | (WhichService & 0x0F)),
+        (uint8_t)ThisEvent.EventType, (uint16_t)Gap, ThisEvent.EventParam);
+  }
+  ExitCritical();
+}
+
+/****************************************************************************
+ Function
+     ES_Trace_Drain
+ Parameters
+     None.
+ Returns
+     None.
+ Description
+     sends the records in the ring to the trace output, a byte at a time,
+     until the ring is empty or the output will not take any more
+ Notes
+     called from ES_Run. A record is only removed from the ring when its
+     last byte has been sent.
+ Author
+     ags, 10/20/26 00:18
+****************************************************************************/
+void ES_Trace_Drain(void)
+{
+  uint8_t *pRecord;
+
+  while (TraceTail != TraceHead)
+  {
+    pRecord = TraceRing[TraceTail & TRACE_RING_MASK];
+    while (TailByte < ES_TRACE_RECORD_SIZE)
+    {
+      if (_HW_Trace_PutByte(pRecord[TailByte]) == false)
+      {
+        return;   // the output is full, carry on next time
+      }
+      TailByte++;
+    }
+    TailByte = 0;
+    TraceTail++;
+  }
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+/****************************************************************************
+ Function
+     PutRecord
+ Parameters
+     uint8_t Header, the kind and service byte
+     uint8_t Type, the event type
+     uint16_t Gap, the uS since the previous record
+     uint16_t Param, the event parameter
+ Returns
+     None.
+ Description
+     writes a record into the next slot of the ring
+ Notes
+     the caller must have the interrupts off and have checked for room
+ Author
+     ags, 10/20/26 00:20
+****************************************************************************/
+static void PutRecord(uint8_t Header, uint8_t Type, uint16_t Gap,
+    uint16_t Param)
+{
+  uint8_t *pRecord = TraceRing[TraceHead & TRACE_RING_MASK];
+
+  pRecord[0]  = Header;
+  pRecord[1]  = Type;
+  pRecord[2]  = (uint8_t)Gap;
+  pRecord[3]  = (uint8_t)(Gap >> 8);
+  pRecord[4]  = (uint8_t)Param;
+  pRecord[5]  = (uint8_t)(Param >> 8);
+  TraceHead++;
+}
+
+#endif /* _INCLUDE_TRACE_ */
+/*------------------------------- Footnotes -------------------------------*/
+/*------------------------------ End of file ------------------------------*/
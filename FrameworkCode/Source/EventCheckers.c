@@ -16,13 +16,15 @@
  History
  When           Who     What/Why
  -------------- ---     --------
+ 10/19/26 16:56 ags     publish keystrokes to their subscribers rather than
+                        posting them to every service
  08/06/13 13:36 jec     initial version
 ****************************************************************************/
 
 // this will pull in the symbolic definitions for events, which we will want
 // to post in response to detecting events
 #include "ES_Configure.h"
-// This gets us the prototype for ES_PostAll
+// This gets us the prototype for ES_PostAll & ES_Publish
 #include "ES_Framework.h"
 // this will get us the structure definition for events, which we will need
 // in order to post events in response to detecting events
@@ -74,8 +76,8 @@ bool Check4Lock(void)
     ES_Event ThisEvent;
     ThisEvent.EventType   = ES_LOCK;
     ThisEvent.EventParam  = 1;
-    // this could be any of the service post functions, ES_PostListx or
-    // ES_PostAll functions
+    // this could be any of the service post functions, ES_PostListx,
+    // ES_Publish or ES_PostAll functions
     ES_PostAll(ThisEvent);
     ReturnVal = true;
   }
@@ -95,7 +97,8 @@ bool Check4Lock(void)
    bool: true if a new key was detected & posted
  Description
    checks to see if a new key from the keyboard is detected and, if so,
-   retrieves the key and posts an ES_NewKey event to TestHarnessService0
+   retrieves the key and publishes an ES_NewKey event to the services that
+   have subscribed to it (TestHarnessService0)
  Notes
    The functions that actually check the serial hardware for characters
    and retrieve them are assumed to be in ES_Port.c
@@ -113,7 +116,7 @@ bool Check4Keystroke(void)
     ES_Event_t ThisEvent;
     ThisEvent.EventType   = ES_NEW_KEY;
     ThisEvent.EventParam  = GetNewKey();
-    ES_PostAll(ThisEvent);
+    ES_Publish(ThisEvent);
     return true;
   }
   return false;
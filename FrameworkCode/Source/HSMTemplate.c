@@ -13,6 +13,8 @@
  History
  When           Who     What/Why
  -------------- ---     --------
+ 10/19/26 14:45 ags      added sample of stopping a state's timer group on
+                         exit
  02/27/17 09:48 jec      another correction to re-assign both CurrentEvent
                          and ReturnEvent to the result of the During function
                          this eliminates the need for the prior fix and allows
@@ -222,6 +224,9 @@ static ES_Event_t DuringStateOne( ES_Event_t Event)
         //RunLowerLevelSM(Event);
         // repeat for any concurrently running state machines
         // now do any local exit functionality
+        // if this state's timers were placed in a group on entry, stop them
+        // all, and throw away any of their timeouts still in the queue
+        //ES_Timer_StopGroup(STATE_ONE_TIMER_GROUP);
       
     }else
     // do the 'during' function for this state
@@ -0,0 +1,222 @@
+/****************************************************************************
+ Module
+   TableHSMTemplate.c
+
+ Revision
+   1.0.1
+
+ Description
+   This is a template for a hierarchical state machine service described by
+   const tables and run by the ES_HSM engine, in place of the nested
+   switch statements of HSMTemplate.c and TopHSMTemplate.c
+
+ Notes
+   The sample machine is:
+     STATE_ONE, with substates STATE_ONE_A (entered by default) and
+       STATE_ONE_B. ES_LOCK moves from A to B, ES_UNLOCK from either to
+       STATE_TWO
+     STATE_TWO, ES_LOCK goes back to STATE_ONE (and so to STATE_ONE_A)
+   Each state gets its own row in StateTable, in the order of the
+   TableState_t enum. Any of the entry, exit and during functions may be 0.
+   The machine has no orthogonal states, so everything is in region 0.
+   To have a state defer events, set its DeferMask, e.g.
+   ES_TYPE_MASK(ES_NEW_KEY), and give the machine a deferral queue with
+   ES_HSM_SetDeferralQueue before starting it.
+   For STATE_ONE to go back to the substate it was left in, as the
+   ES_ENTRY_HISTORY entry of HSMTemplate.c does, set its History to
+   ES_HSM_HISTORY_SHALLOW and give it HistorySlot 0.
+   Tools/ES_HSMGen.py can write the tables, and the rest of this file, from
+   a description of the machine, see Tools/TableHSMTemplate.json.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/20/26 05:39 ags      quiet the unused event in the sample actions
+ 10/19/26 22:50 ags      added the history columns
+ 10/19/26 22:34 ags      added the DeferMask column
+ 10/19/26 22:08 ags      added the region columns
+ 10/19/26 21:10 ags      no event maps in the hand written tables
+ 10/19/26 20:48 ags      Began Coding
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_HSM.h"
+#include "TableHSMTemplate.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+
+/*---------------------------- Module Functions ---------------------------*/
+static void EnterStateOne( ES_Event_t ThisEvent );
+static void ExitStateOne( ES_Event_t ThisEvent );
+static ES_Event_t DuringStateTwo( ES_Event_t ThisEvent );
+
+/*---------------------------- Module Variables ---------------------------*/
+// the transitions of each state, the first one on the event type whose
+// guard passes (or that has no guard) is taken
+static const ES_HSMTransition_t StateOneTransitions[] =
+{
+  /* Event,     Guard, Action, Target,    Lca */
+  { ES_UNLOCK,  0,     0,      STATE_TWO, ES_HSM_ROOT }
+};
+
+static const ES_HSMTransition_t StateOneATransitions[] =
+{
+  { ES_LOCK,    0,     0,      STATE_ONE_B, STATE_ONE }
+};
+
+static const ES_HSMTransition_t StateTwoTransitions[] =
+{
+  { ES_LOCK,    0,     0,      STATE_ONE, ES_HSM_ROOT }
+};
+
+static const ES_HSMStateDesc_t StateTable[] =
+{
+  /* Parent, Depth, InitialChild, Entry, Exit, During, Transitions,
+     EventMap, Region, NumRegions, SubRegion, DeferMask, History,
+     HistorySlot */
+  { ES_HSM_ROOT, 1, STATE_ONE_A, EnterStateOne, ExitStateOne, 0,
+    StateOneTransitions, ARRAY_SIZE(StateOneTransitions), 0, 0, 0, 0, 0,
+    ES_HSM_HISTORY_NONE, 0 },
+  { STATE_ONE, 2, ES_HSM_NO_STATE, 0, 0, 0,
+    StateOneATransitions, ARRAY_SIZE(StateOneATransitions), 0, 0, 0, 0, 0,
+    ES_HSM_HISTORY_NONE, 0 },
+  { STATE_ONE, 2, ES_HSM_NO_STATE, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0,
+    ES_HSM_HISTORY_NONE, 0 },
+  { ES_HSM_ROOT, 1, ES_HSM_NO_STATE, 0, 0, DuringStateTwo,
+    StateTwoTransitions, ARRAY_SIZE(StateTwoTransitions), 0, 0, 0, 0, 0,
+    ES_HSM_HISTORY_NONE, 0 }
+};
+
+static const ES_HSMDesc_t TableHSM =
+{
+  StateTable, ARRAY_SIZE(StateTable), STATE_ONE, 1
+};
+
+// the engine keeps the active state here
+static ES_HSM_t MyHSM;
+static uint8_t  MyPriority;
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+     InitTableHSM
+
+ Parameters
+     uint8_t : the priorty of this service
+
+ Returns
+     boolean, False if error in initialization, True otherwise
+
+ Description
+     Saves away the priority, and starts the state machine
+ Notes
+
+ Author
+     ags, 10/19/26 20:50
+****************************************************************************/
+bool InitTableHSM ( uint8_t Priority )
+{
+  ES_Event_t ThisEvent;
+
+  MyPriority = Priority;  // save our priority
+
+  ThisEvent.EventType = ES_ENTRY;
+  ThisEvent.EventParam = 0;
+  ES_HSM_Start(&MyHSM, &TableHSM, ThisEvent);
+
+  return true;
+}
+
+/****************************************************************************
+ Function
+     PostTableHSM
+
+ Parameters
+     ES_Event_t ThisEvent , the event to post to the queue
+
+ Returns
+     boolean False if the post operation failed, True otherwise
+
+ Description
+     Posts an event to this state machine's queue
+ Author
+     ags, 10/19/26 20:51
+****************************************************************************/
+bool PostTableHSM( ES_Event_t ThisEvent )
+{
+  return ES_PostToService( MyPriority, ThisEvent);
+}
+
+/****************************************************************************
+ Function
+    RunTableHSM
+
+ Parameters
+   ES_Event_t: the event to process
+
+ Returns
+   ES_Event_t: ES_NO_EVENT, unless there is a non-recoverable error
+
+ Description
+   hands the event to the engine
+ Notes
+   events that no state uses come back from ES_HSM_Run unchanged, and are
+   dropped here
+ Author
+   ags, 10/19/26 20:52
+****************************************************************************/
+ES_Event_t RunTableHSM( ES_Event_t ThisEvent )
+{
+  ES_Event_t ReturnEvent = { ES_NO_EVENT, 0 };
+
+  ES_HSM_Run(&MyHSM, ThisEvent);
+  return ReturnEvent;
+}
+
+/****************************************************************************
+ Function
+     QueryTableHSM
+
+ Parameters
+     None
+
+ Returns
+     TableState_t The current (leaf) state of the state machine
+
+ Author
+     ags, 10/19/26 20:53
+****************************************************************************/
+TableState_t QueryTableHSM ( void )
+{
+  return (TableState_t)ES_HSM_GetState(&MyHSM);
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+
+static void EnterStateOne( ES_Event_t ThisEvent )
+{
+  (void)ThisEvent;   // remove this once the event is used
+  // implement any entry actions required for this state, the engine enters
+  // the default substate (STATE_ONE_A) after this
+}
+
+static void ExitStateOne( ES_Event_t ThisEvent )
+{
+  (void)ThisEvent;   // remove this once the event is used
+  // the active substate has already been exited when this is called
+  // if this state's timers were placed in a group on entry, stop them
+  // all, and throw away any of their timeouts still in the queue
+  //ES_Timer_StopGroup(STATE_ONE_TIMER_GROUP);
+}
+
+static ES_Event_t DuringStateTwo( ES_Event_t ThisEvent )
+{
+  // do any activity that is repeated as long as we are in this state
+  // return ThisEvent to let the transitions see it, a different event to
+  // re-map it, or ES_NO_EVENT to consume it
+  return ThisEvent;
+}
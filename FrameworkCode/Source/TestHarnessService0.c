@@ -14,6 +14,14 @@
  History
  When           Who     What/Why
  -------------- ---     --------
+ 10/20/26 06:22 ags     the byte debug markers are back, left out only when
+                        ES_Trace is recording the same things
+ 10/20/26 00:56 ags     removed the byte debug markers, ES_Trace records the
+                        posts, runs and timeouts of every service instead
+ 10/19/26 16:58 ags     subscribe to the keystrokes published by Check4Keystroke
+ 10/19/26 16:16 ags     announce the edges captured on input capture channel 0
+ 10/19/26 11:18 ags     converted the pulse test from ES_ShortTimer to
+                        ES_HRTimers
  10/26/17 18:26 jec     moves definition of ALL_BITS to ES_Port.h
  10/19/17 21:28 jec     meaningless change to test updating
  10/19/17 18:42 jec     removed referennces to driverlib and programmed the
@@ -39,7 +47,8 @@
 #include "ES_Configure.h"
 #include "ES_Framework.h"
 #include "ES_DeferRecall.h"
-#include "ES_ShortTimer.h"
+#include "ES_HRTimers.h"
+#include "ES_InputCapture.h"
 #include "ES_Port.h"
 
 /*----------------------------- Module Defines ----------------------------*/
@@ -49,6 +58,12 @@
 #define TWO_SEC (ONE_SEC * 2)
 #define FIVE_SEC (ONE_SEC * 5)
 
+// the byte debug markers, left out when ES_Trace records the posts, runs
+// and timeouts instead
+#if defined(_INCLUDE_BYTE_DEBUG_) && !defined(_INCLUDE_TRACE_)
+#define BYTE_DEBUG_MARKERS
+#endif
+
 #define ENTER_POST     ((MyPriority<<3)|0)
 #define ENTER_RUN      ((MyPriority<<3)|1)
 #define ENTER_TIMEOUT  ((MyPriority<<3)|2)
@@ -99,13 +114,10 @@ bool InitTestHarnessService0(uint8_t Priority)
   ES_InitDeferralQueueWith(DeferralQueue, ARRAY_SIZE(DeferralQueue));
   // initialize LED drive for testing/debug output
   InitLED();
-  // initialize the Short timer system for channel A
-  ES_ShortTimerInit(MyPriority, SHORT_TIMER_UNUSED);
-
-#ifdef _INCLUDE_BYTE_DEBUG_
+#ifdef BYTE_DEBUG_MARKERS
   // initialize the byte-wide debugging
   _HW_ByteDebug_Init();
-#endif  
+#endif
 
   // set up I/O lines for debugging
   // enable the clock to Port B
@@ -121,6 +133,9 @@ bool InitTestHarnessService0(uint8_t Priority)
   // start with the lines low
   HWREG(GPIO_PORTB_BASE + (GPIO_O_DATA + ALL_BITS)) &= BIT2LO;
 
+  // the keystrokes are published, so sign up to receive them
+  ES_Subscribe(MyPriority, ES_NEW_KEY);
+
   // post the initial transition event
   ThisEvent.EventType = ES_INIT;
   if (ES_PostToService(MyPriority, ThisEvent) == true)
@@ -152,10 +167,10 @@ bool InitTestHarnessService0(uint8_t Priority)
 ****************************************************************************/
 bool PostTestHarnessService0(ES_Event_t ThisEvent)
 {
-#ifdef _INCLUDE_BYTE_DEBUG_
+#ifdef BYTE_DEBUG_MARKERS
   _HW_ByteDebug_SetValueWithStrobe( ENTER_POST );
   _HW_ByteDebug_SetValueWithStrobe( END_SERVICE );
-#endif  
+#endif
   return ES_PostToService(MyPriority, ThisEvent);
 }
 
@@ -182,9 +197,9 @@ ES_Event_t RunTestHarnessService0(ES_Event_t ThisEvent)
   ReturnEvent.EventType = ES_NO_EVENT; // assume no errors
   static char DeferredChar = '1';
 
-#ifdef _INCLUDE_BYTE_DEBUG_
+#ifdef BYTE_DEBUG_MARKERS
   _HW_ByteDebug_SetValueWithStrobe( ENTER_RUN );
-#endif  
+#endif
   switch (ThisEvent.EventType)
   {
     case ES_INIT:
@@ -196,9 +211,9 @@ ES_Event_t RunTestHarnessService0(ES_Event_t ThisEvent)
     break;
     case ES_TIMEOUT:   // re-start timer & announce
     {
-#ifdef _INCLUDE_BYTE_DEBUG_
+#ifdef BYTE_DEBUG_MARKERS
       _HW_ByteDebug_SetValueWithStrobe( ENTER_TIMEOUT );
-#endif  
+#endif
       ES_Timer_InitTimer(SERVICE0_TIMER, FIVE_SEC);
      printf("ES_TIMEOUT received from Timer %d in Service %d\r\n",
           ThisEvent.EventParam, MyPriority);
@@ -211,6 +226,17 @@ ES_Event_t RunTestHarnessService0(ES_Event_t ThisEvent)
       puts("ES_SHORT_TIMEOUT received");
     }
     break;
+    case ES_CAPTURE:   // announce the edge time & period
+    {
+      ES_CaptureRecord_t Edge;
+      if (true == ES_InputCapture_GetEdge(ThisEvent.EventParam, &Edge))
+      {
+        printf("ES_CAPTURE on channel %d at %lu uS, period %lu uS\r\n",
+            Edge.Channel, (unsigned long)Edge.Timestamp,
+            (unsigned long)Edge.Period);
+      }
+    }
+    break;
     case ES_NEW_KEY:   // announce
     {
       printf("ES_NEW_KEY received with -> %c <- in Service 0\r\n",
@@ -236,7 +262,7 @@ ES_Event_t RunTestHarnessService0(ES_Event_t ThisEvent)
       }
       if ('p' == ThisEvent.EventParam)
       {
-        ES_ShortTimerStart(TIMER_A, 10);
+        ES_HRTimer_InitTimer(SERVICE0_HR_TIMER, 10);
         // raise the line to show we started
         HWREG(GPIO_PORTB_BASE + (GPIO_O_DATA + ALL_BITS)) |= BIT2HI;
         //puts("Pulsed!\r");
@@ -247,9 +273,9 @@ ES_Event_t RunTestHarnessService0(ES_Event_t ThisEvent)
     {}
      break;
   }
-#ifdef _INCLUDE_BYTE_DEBUG_
+#ifdef BYTE_DEBUG_MARKERS
   _HW_ByteDebug_SetValueWithStrobe( END_SERVICE );
-#endif  
+#endif
 
   return ReturnEvent;
 }
@@ -13,6 +13,8 @@
  History
  When           Who     What/Why
  -------------- ---     --------
+ 10/19/26 14:45 ags      added sample of stopping a state's timer group on
+                         exit
  02/20/17 14:30 jec      updated to remove sample of consuming an event. We 
                          always want to return ES_NO_EVENT at the top level 
                          unless there is a non-recoverable error at the 
@@ -227,6 +229,9 @@ static ES_Event_t DuringStateOne( ES_Event_t Event)
         //RunLowerLevelSM(Event);
         // repeat for any concurrently running state machines
         // now do any local exit functionality
+        // if this state's timers were placed in a group on entry, stop them
+        // all, and throw away any of their timeouts still in the queue
+        //ES_Timer_StopGroup(STATE_ONE_TIMER_GROUP);
       
     }else
     // do the 'during' function for this state
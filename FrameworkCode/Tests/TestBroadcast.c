@@ -0,0 +1,183 @@
+/****************************************************************************
+ Module
+   TestBroadcast.c
+
+ Description
+   Host test of the broadcast channel of ES_Broadcast.c: each subscriber
+   is given every event broadcast while it is subscribed, in order, after
+   the events in its own queue. The ring holds each event until the
+   slowest subscriber has read it, and a broadcast that would overwrite
+   one is refused.
+
+ Notes
+   Built with three services and a ring of 4 events, see
+   TestBroadcastConfig.h. Services 1 and 2 are the subscribers.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/20/26 07:13 ags     Began Coding
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_Broadcast.h"
+#include "TestSupport.h"
+
+/*---------------------------- Module Functions ---------------------------*/
+static void TestSubscribers(void);
+static void TestFull(void);
+static void TestLateSubscriber(void);
+static void TestOwnQueueFirst(void);
+static void TestLimits(void);
+static bool Broadcast(ES_EventType_t Type, uint16_t Param);
+
+/*---------------------------- Module Variables ---------------------------*/
+static ES_Event_t Events[8];
+
+/*------------------------------ Module Code ------------------------------*/
+int main(void)
+{
+  TEST_CHECK(ES_Initialize(ES_Timer_RATE_1mS) == Success);
+
+  TestSubscribers();
+  TestFull();
+  TestLateSubscriber();
+  TestOwnQueueFirst();
+  TestLimits();
+  return TestSupport_Result("TestBroadcast");
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+/****************************************************************************
+ Function
+   TestSubscribers
+ Description
+   services 1 and 2 subscribe, each is given the broadcasts in order, and
+   service 0, which has not subscribed, is given none
+****************************************************************************/
+static void TestSubscribers(void)
+{
+  TEST_CHECK(ES_Broadcast_Subscribe(1) == true);
+  TEST_CHECK(ES_Broadcast_Subscribe(2) == true);
+  TEST_CHECK(Broadcast(ES_LOCK, 1) == true);
+  TEST_CHECK(Broadcast(ES_UNLOCK, 2) == true);
+  TEST_CHECK(ES_Broadcast_GetPending() == (BIT1HI | BIT2HI));
+
+  TEST_CHECK(TestSupport_Drain(Events, ARRAY_SIZE(Events)) == 0);
+  TEST_CHECK(ES_Broadcast_GetPending() == 0);
+  TEST_CHECK(TestSupport_GetLog(1, Events, ARRAY_SIZE(Events)) == 2);
+  TEST_CHECK(TestSupport_IsEvent(Events[0], ES_LOCK, 1));
+  TEST_CHECK(TestSupport_IsEvent(Events[1], ES_UNLOCK, 2));
+  TEST_CHECK(TestSupport_GetLog(2, Events, ARRAY_SIZE(Events)) == 2);
+  TEST_CHECK(TestSupport_IsEvent(Events[0], ES_LOCK, 1));
+  TEST_CHECK(TestSupport_IsEvent(Events[1], ES_UNLOCK, 2));
+}
+
+/****************************************************************************
+ Function
+   TestFull
+ Description
+   with a ring's worth of broadcasts unread the next is refused, and it
+   still is once service 2 unsubscribes, as service 1 holds them too. Once
+   service 1 has read them there is room again.
+****************************************************************************/
+static void TestFull(void)
+{
+  uint8_t i;
+
+  for (i = 0; i < BROADCAST_RING_SIZE; i++)
+  {
+    TEST_CHECK(Broadcast(ES_NEW_KEY, i) == true);
+  }
+  TEST_CHECK(Broadcast(ES_NEW_KEY, BROADCAST_RING_SIZE) == false);
+  TEST_CHECK(ES_Broadcast_Unsubscribe(2) == true);
+  TEST_CHECK(ES_Broadcast_GetPending() == BIT1HI);
+  TEST_CHECK(Broadcast(ES_NEW_KEY, BROADCAST_RING_SIZE) == false);
+
+  TEST_CHECK(TestSupport_Drain(Events, ARRAY_SIZE(Events)) == 0);
+  TEST_CHECK(TestSupport_GetLog(1, Events, ARRAY_SIZE(Events)) ==
+      BROADCAST_RING_SIZE);
+  for (i = 0; i < BROADCAST_RING_SIZE; i++)
+  {
+    TEST_CHECK(TestSupport_IsEvent(Events[i], ES_NEW_KEY, i));
+  }
+  TEST_CHECK(TestSupport_GetLog(2, Events, ARRAY_SIZE(Events)) == 0);
+  TEST_CHECK(Broadcast(ES_NEW_KEY, BROADCAST_RING_SIZE) == true);
+  TEST_CHECK(TestSupport_Drain(Events, ARRAY_SIZE(Events)) == 0);
+}
+
+/****************************************************************************
+ Function
+   TestLateSubscriber
+ Description
+   service 2 subscribes again between two broadcasts, and is given only
+   the second
+****************************************************************************/
+static void TestLateSubscriber(void)
+{
+  TEST_CHECK(Broadcast(ES_LOCK, 7) == true);
+  TEST_CHECK(ES_Broadcast_Subscribe(2) == true);
+  TEST_CHECK(Broadcast(ES_LOCK, 8) == true);
+
+  TEST_CHECK(TestSupport_Drain(Events, ARRAY_SIZE(Events)) == 0);
+  TEST_CHECK(TestSupport_GetLog(1, Events, ARRAY_SIZE(Events)) == 2);
+  TEST_CHECK(TestSupport_IsEvent(Events[0], ES_LOCK, 7));
+  TEST_CHECK(TestSupport_IsEvent(Events[1], ES_LOCK, 8));
+  TEST_CHECK(TestSupport_GetLog(2, Events, ARRAY_SIZE(Events)) == 1);
+  TEST_CHECK(TestSupport_IsEvent(Events[0], ES_LOCK, 8));
+}
+
+/****************************************************************************
+ Function
+   TestOwnQueueFirst
+ Description
+   an event posted to service 1 after a broadcast is still given to it
+   before the broadcast
+****************************************************************************/
+static void TestOwnQueueFirst(void)
+{
+  ES_Event_t ThisEvent = { ES_UNLOCK, 10 };
+
+  TEST_CHECK(Broadcast(ES_LOCK, 9) == true);
+  TEST_CHECK(ES_PostToService(1, ThisEvent) == true);
+
+  TEST_CHECK(TestSupport_Drain(Events, ARRAY_SIZE(Events)) == 0);
+  TEST_CHECK(TestSupport_GetLog(1, Events, ARRAY_SIZE(Events)) == 2);
+  TEST_CHECK(TestSupport_IsEvent(Events[0], ES_UNLOCK, 10));
+  TEST_CHECK(TestSupport_IsEvent(Events[1], ES_LOCK, 9));
+  TEST_CHECK(TestSupport_GetLog(2, Events, ARRAY_SIZE(Events)) == 1);
+  TEST_CHECK(TestSupport_IsEvent(Events[0], ES_LOCK, 9));
+}
+
+/****************************************************************************
+ Function
+   TestLimits
+ Description
+   the services that do not exist are refused
+****************************************************************************/
+static void TestLimits(void)
+{
+  TEST_CHECK(ES_Broadcast_Subscribe(NUM_SERVICES) == false);
+  TEST_CHECK(ES_Broadcast_Unsubscribe(NUM_SERVICES) == false);
+}
+
+/****************************************************************************
+ Function
+   Broadcast
+ Description
+   broadcasts an event of the type, with the parameter
+****************************************************************************/
+static bool Broadcast(ES_EventType_t Type, uint16_t Param)
+{
+  ES_Event_t ThisEvent;
+
+  ThisEvent.EventType   = Type;
+  ThisEvent.EventParam  = Param;
+  return ES_Broadcast(ThisEvent);
+}
+
+/*------------------------------- Footnotes -------------------------------*/
+/*------------------------------ End of file ------------------------------*/
@@ -0,0 +1,16 @@
+/****************************************************************************
+
+  The configuration for TestBroadcast: three services, so that two can
+  subscribe, and a broadcast ring of 4 events, so that it is quick to fill
+
+ ****************************************************************************/
+
+#ifndef TestBroadcastConfig_H
+#define TestBroadcastConfig_H
+
+#include "ThreeServicesConfig.h"
+
+#undef BROADCAST_RING_SIZE
+#define BROADCAST_RING_SIZE 4
+
+#endif /* TestBroadcastConfig_H */
@@ -0,0 +1,209 @@
+/****************************************************************************
+ Module
+   TestBudget.c
+
+ Description
+   Host test of the run budgets and the watchdog: a run over its service's
+   SERV_n_BUDGET is counted and reported with an ES_OVERRUN event, an
+   overrun while handling an ES_OVERRUN is counted but not reported, and
+   a process that stops feeding the watchdog exits.
+
+ Notes
+   Built without _INCLUDE_VIRTUAL_TIME_, so that the runs take real time.
+   Service 0 has a budget of 5mS, see TestBudgetConfig.h.
+   The watchdog is tested in a child process, forked before the parent
+   starts a watchdog of its own, that spins without ever feeding it.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/20/26 07:28 ags     Began Coding
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#define _POSIX_C_SOURCE 200112L   // for fork
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_HRTimers.h"
+#include "TestSupport.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define SERVICE       0
+#define SPIN_uS       10000UL
+// how long the child spins, unfed, before giving up on the watchdog
+#define HANG_uS       (4 * WATCHDOG_TIMEOUT_MS * 1000UL)
+
+/*---------------------------- Module Functions ---------------------------*/
+static void TestWatchdog(void);
+static void TestOverrun(void);
+static void TestNotReported(void);
+static void TestReset(void);
+static void Spin(uint32_t Time);
+static ES_Event_t RunSpin(ES_Event_t ThisEvent);
+
+/*---------------------------- Module Variables ---------------------------*/
+static ES_Event_t Events[4];
+
+/*------------------------------ Module Code ------------------------------*/
+int main(void)
+{
+  TestWatchdog();
+  TEST_CHECK(ES_Initialize(ES_Timer_RATE_1mS) == Success);
+
+  TestOverrun();
+  TestNotReported();
+  TestReset();
+  return TestSupport_Result("TestBudget");
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+/****************************************************************************
+ Function
+   TestWatchdog
+ Description
+   a child that starts the watchdog and then hangs is stopped by it, with
+   EXIT_FAILURE
+****************************************************************************/
+static void TestWatchdog(void)
+{
+  pid_t Child;
+  int   Status = 0;
+
+  fflush(stdout);
+  Child = fork();
+  TEST_CHECK(Child >= 0);
+  if (Child == 0)
+  {
+    // the watchdog's message is expected, so keep it out of the output
+    freopen("/dev/null", "w", stderr);
+    ES_Initialize(ES_Timer_RATE_1mS);
+    Spin(HANG_uS);
+    _exit(EXIT_SUCCESS);
+  }
+  if (Child > 0)
+  {
+    TEST_CHECK(waitpid(Child, &Status, 0) == Child);
+    TEST_CHECK(WIFEXITED(Status));
+    TEST_CHECK(WEXITSTATUS(Status) == EXIT_FAILURE);
+  }
+}
+
+/****************************************************************************
+ Function
+   TestOverrun
+ Description
+   an ES_LOCK that takes twice the budget is counted, and reported with
+   an ES_OVERRUN naming the service and the event, while an ES_UNLOCK
+   that returns at once is not
+****************************************************************************/
+static void TestOverrun(void)
+{
+  ES_Event_t        ThisEvent = { ES_LOCK, 0 };
+  ES_OverrunStats_t Stats;
+
+  TEST_CHECK(ES_PostToService(SERVICE, ThisEvent) == true);
+  ThisEvent.EventType = ES_UNLOCK;
+  TEST_CHECK(ES_PostToService(SERVICE, ThisEvent) == true);
+  TestSupport_SetRunFunc(RunSpin);
+  TestSupport_Drain(0, 0);
+  TestSupport_SetRunFunc(0);
+
+  TEST_CHECK(ES_GetOverrunStats(SERVICE, &Stats) == true);
+  TEST_CHECK(Stats.Count == 1);
+  TEST_CHECK(Stats.WorstTime >= SPIN_uS);
+  TEST_CHECK(Stats.WorstType == ES_LOCK);
+  TEST_CHECK(Stats.LastType == ES_LOCK);
+
+  // the report came in behind the end of the last drain
+  TEST_CHECK(TestSupport_Drain(Events, ARRAY_SIZE(Events)) == 1);
+  TEST_CHECK(TestSupport_IsEvent(Events[0], ES_OVERRUN,
+      (SERVICE << 8) | ES_LOCK));
+  TEST_CHECK(ES_OVERRUN_SERVICE(Events[0].EventParam) == SERVICE);
+  TEST_CHECK(ES_OVERRUN_TYPE(Events[0].EventParam) == ES_LOCK);
+}
+
+/****************************************************************************
+ Function
+   TestNotReported
+ Description
+   an ES_OVERRUN that takes too long is counted, but not reported, so that
+   a slow handler can not keep reporting itself
+****************************************************************************/
+static void TestNotReported(void)
+{
+  ES_Event_t        ThisEvent = { ES_OVERRUN, 0 };
+  ES_OverrunStats_t Stats;
+
+  TEST_CHECK(ES_PostToService(SERVICE, ThisEvent) == true);
+  TestSupport_SetRunFunc(RunSpin);
+  TestSupport_Drain(0, 0);
+  TestSupport_SetRunFunc(0);
+
+  TEST_CHECK(ES_GetOverrunStats(SERVICE, &Stats) == true);
+  TEST_CHECK(Stats.Count == 2);
+  TEST_CHECK(Stats.LastType == ES_OVERRUN);
+  TEST_CHECK(TestSupport_Drain(Events, ARRAY_SIZE(Events)) == 0);
+}
+
+/****************************************************************************
+ Function
+   TestReset
+ Description
+   nothing is left after ES_ResetOverrunStats, and the services that do
+   not exist are refused
+****************************************************************************/
+static void TestReset(void)
+{
+  ES_OverrunStats_t Stats;
+
+  ES_ResetOverrunStats();
+  TEST_CHECK(ES_GetOverrunStats(SERVICE, &Stats) == true);
+  TEST_CHECK(Stats.Count == 0);
+  TEST_CHECK(Stats.WorstTime == 0);
+  TEST_CHECK(Stats.WorstType == ES_NO_EVENT);
+  TEST_CHECK(Stats.LastType == ES_NO_EVENT);
+  TEST_CHECK(ES_GetOverrunStats(NUM_SERVICES, &Stats) == false);
+}
+
+/****************************************************************************
+ Function
+   Spin
+ Description
+   takes the time, in uS, without returning
+****************************************************************************/
+static void Spin(uint32_t Time)
+{
+  uint32_t Start = ES_HRTimer_GetTime();
+
+  while ((ES_HRTimer_GetTime() - Start) < Time)
+  {}
+}
+
+/****************************************************************************
+ Function
+   RunSpin
+ Description
+   takes SPIN_uS over each ES_LOCK and ES_OVERRUN, and returns at once
+   from the others
+****************************************************************************/
+static ES_Event_t RunSpin(ES_Event_t ThisEvent)
+{
+  ES_Event_t ReturnEvent = { ES_NO_EVENT, 0 };
+
+  if ((ThisEvent.EventType == ES_LOCK) || (ThisEvent.EventType == ES_OVERRUN))
+  {
+    Spin(SPIN_uS);
+  }
+  return ReturnEvent;
+}
+
+/*------------------------------- Footnotes -------------------------------*/
+/*------------------------------ End of file ------------------------------*/
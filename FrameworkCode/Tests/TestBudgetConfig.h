@@ -0,0 +1,18 @@
+/****************************************************************************
+
+  The configuration for TestBudget: a budget of 5mS for service 0, with
+  its overruns reported back to it
+
+ ****************************************************************************/
+
+#ifndef TestBudgetConfig_H
+#define TestBudgetConfig_H
+
+#include "ES_Configure.h"
+
+#undef SERV_0_BUDGET
+#define SERV_0_BUDGET 5000
+
+#define OVERRUN_POST_FUNC PostTestHarnessService0
+
+#endif /* TestBudgetConfig_H */
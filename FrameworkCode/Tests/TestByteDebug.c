@@ -0,0 +1,117 @@
+/****************************************************************************
+ Module
+   TestByteDebug.c
+
+ Description
+   Host test of the byte debug port of ES_HostPort.c: each change to the
+   port is logged with its time, the bits can be set and cleared one at a
+   time without touching the others, and a value with a strobe is logged
+   as the two bytes that the target sends, bit 7 hi then lo.
+
+ Notes
+   Built with _INCLUDE_VIRTUAL_TIME_, so the times in the log are exact.
+   On the target the bytes go out through the uDMA ring to the '595, which
+   needs the hardware, so only the values and their order are tested here.
+   The log file is read back after a flush, while the port still has it
+   open.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/20/26 07:22 ags     Began Coding
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_Port.h"
+#include "TestSupport.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define WAIT_mS       5
+#define MAX_WRITES    16
+
+/*------------------------------ Module Types -----------------------------*/
+// a byte as it should be in the log
+typedef struct
+{
+  unsigned long Time;     /* uS of virtual time */
+  unsigned      Value;
+}Write_t;
+
+/*---------------------------- Module Functions ---------------------------*/
+static void CheckLog(void);
+
+/*---------------------------- Module Variables ---------------------------*/
+static const Write_t Expected[] =
+{
+  { 0, 0x00 },    // _HW_ByteDebug_Init
+  { 0, 0x08 },    // SetBit(3)
+  { 0, 0x09 },    // SetBit(0)
+  { 0, 0x01 },    // ClearBit(3)
+  { WAIT_mS * 1000UL, 0xA5 },  // SetValue(0xA5), after the wait
+  { WAIT_mS * 1000UL, 0xA5 },  // SetValueWithStrobe(0x25)
+  { WAIT_mS * 1000UL, 0x25 },
+  { WAIT_mS * 1000UL, 0x27 }   // SetBit(1), on the value without bit 7
+};
+
+/*------------------------------ Module Code ------------------------------*/
+int main(void)
+{
+  TEST_CHECK(ES_Initialize(ES_Timer_RATE_1mS) == Success);
+  _HW_ByteDebug_Init();
+
+  _HW_ByteDebug_SetBit(3);
+  _HW_ByteDebug_SetBit(0);
+  _HW_ByteDebug_ClearBit(3);
+  TEST_CHECK(ES_Timer_InitTimer(SERVICE0_TIMER, WAIT_mS) == ES_Timer_OK);
+  TEST_CHECK(TestSupport_Advance() == true);
+  _HW_ByteDebug_SetValue(0xA5);
+  _HW_ByteDebug_SetValueWithStrobe(0x25);
+  _HW_ByteDebug_SetBit(1);
+
+  CheckLog();
+  return TestSupport_Result("TestByteDebug");
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+/****************************************************************************
+ Function
+   CheckLog
+ Description
+   reads back the byte debug log and compares it with Expected
+****************************************************************************/
+static void CheckLog(void)
+{
+  FILE      *LogFile;
+  Write_t   Writes[MAX_WRITES];
+  uint8_t   NumWrites = 0;
+  uint8_t   i;
+
+  fflush(NULL);
+  LogFile = fopen(getenv("ES_BYTE_DEBUG_FILE"), "r");
+  TEST_CHECK(LogFile != NULL);
+  if (LogFile != NULL)
+  {
+    while ((NumWrites < MAX_WRITES) && (fscanf(LogFile, "%lu 0x%X",
+        &Writes[NumWrites].Time, &Writes[NumWrites].Value) == 2))
+    {
+      NumWrites++;
+    }
+    fclose(LogFile);
+  }
+
+  TEST_CHECK(NumWrites == ARRAY_SIZE(Expected));
+  for (i = 0; (i < NumWrites) && (i < ARRAY_SIZE(Expected)); i++)
+  {
+    TEST_CHECK(Writes[i].Time == Expected[i].Time);
+    TEST_CHECK(Writes[i].Value == Expected[i].Value);
+  }
+}
+
+/*------------------------------- Footnotes -------------------------------*/
+/*------------------------------ End of file ------------------------------*/
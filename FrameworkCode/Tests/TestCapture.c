@@ -0,0 +1,164 @@
+/****************************************************************************
+ Module
+   TestCapture.c
+
+ Description
+   Host test of the input capture of ES_InputCapture.c: the edges in
+   TestCapture.txt come to the service as ES_CAPTURE events at their own
+   times, with the right timestamps and periods, the edges on a channel
+   with no response function are dropped, and the edges that arrive with
+   the ring full are counted as overruns.
+
+ Notes
+   Built with _INCLUDE_INPUT_CAPTURE_ and _INCLUDE_VIRTUAL_TIME_, so the
+   clock jumps straight to each edge. The capture ring holds 4 edges, see
+   TestCaptureConfig.h.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/20/26 06:56 ags     Began Coding
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#define _POSIX_C_SOURCE 200112L   // for setenv
+
+#include <stdlib.h>
+
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_HRTimers.h"
+#include "ES_InputCapture.h"
+#include "TestSupport.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define CHANNEL       0
+#define NUM_EDGES     3
+#define BURST_START   10000UL
+#define BURST_GAP     100UL
+
+/*------------------------------ Module Types -----------------------------*/
+// an edge as the service saw it
+typedef struct
+{
+  uint16_t            Param;
+  ES_CaptureRecord_t  Edge;
+  uint32_t            Time;     /* uS of virtual time when it came */
+}Seen_t;
+
+/*---------------------------- Module Functions ---------------------------*/
+static void TestFile(void);
+static void TestOverrun(void);
+static ES_Event_t RunCapture(ES_Event_t ThisEvent);
+
+/*---------------------------- Module Variables ---------------------------*/
+// the edges of channel 0 in TestCapture.txt, and the periods between them
+static const uint32_t EdgeTimes[NUM_EDGES] = { 1000, 3500, 6200 };
+static const uint32_t EdgePeriods[NUM_EDGES] = { 0, 2500, 2700 };
+
+static Seen_t   Seen[NUM_EDGES];
+static uint8_t  NumSeen = 0;
+
+/*------------------------------ Module Code ------------------------------*/
+int main(void)
+{
+  setenv("ES_CAPTURE_FILE", "TestCapture.txt", 1);
+  TEST_CHECK(ES_Initialize(ES_Timer_RATE_1mS) == Success);
+
+  TestFile();
+  TestOverrun();
+  return TestSupport_Result("TestCapture");
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+/****************************************************************************
+ Function
+   TestFile
+ Description
+   each edge of channel 0 in the file comes at its own time, numbered in
+   order, with the period since the one before
+****************************************************************************/
+static void TestFile(void)
+{
+  uint8_t i;
+
+  TestSupport_SetRunFunc(RunCapture);
+  // RunCapture stops it after the last edge
+  TEST_CHECK(ES_Run() == FailedRun);
+  TestSupport_SetRunFunc(0);
+
+  TEST_CHECK(NumSeen == NUM_EDGES);
+  for (i = 0; i < NumSeen; i++)
+  {
+    TEST_CHECK(Seen[i].Param == ((CHANNEL << 8) | i));
+    TEST_CHECK(Seen[i].Edge.Channel == CHANNEL);
+    TEST_CHECK(Seen[i].Edge.Timestamp == EdgeTimes[i]);
+    TEST_CHECK(Seen[i].Edge.Period == EdgePeriods[i]);
+    TEST_CHECK(Seen[i].Time == EdgeTimes[i]);
+  }
+  TEST_CHECK(ES_InputCapture_GetOverruns() == 0);
+}
+
+/****************************************************************************
+ Function
+   TestOverrun
+ Description
+   a burst of edges, one more than the ring holds, before they can be
+   posted: the last is counted as an overrun and the rest are posted, and
+   the record of an edge from before the burst has been re-used
+****************************************************************************/
+static void TestOverrun(void)
+{
+  ES_Event_t          Events[CAPTURE_RING_SIZE + 1];
+  ES_CaptureRecord_t  Edge;
+  uint8_t             i;
+
+  for (i = 0; i <= CAPTURE_RING_SIZE; i++)
+  {
+    ES_InputCapture_Edge_Resp(CHANNEL, BURST_START + i * BURST_GAP);
+  }
+  TEST_CHECK(ES_InputCapture_GetOverruns() == 1);
+  ES_InputCapture_Process();
+
+  TEST_CHECK(TestSupport_Drain(Events, ARRAY_SIZE(Events)) ==
+      CAPTURE_RING_SIZE);
+  for (i = 0; i < CAPTURE_RING_SIZE; i++)
+  {
+    TEST_CHECK(TestSupport_IsEvent(Events[i], ES_CAPTURE,
+        (CHANNEL << 8) | (NUM_EDGES + i)));
+    TEST_CHECK(ES_InputCapture_GetEdge(Events[i].EventParam, &Edge) == true);
+    TEST_CHECK(Edge.Timestamp == BURST_START + i * BURST_GAP);
+    TEST_CHECK(Edge.Period == ((i == 0) ?
+        (BURST_START - EdgeTimes[NUM_EDGES - 1]) : BURST_GAP));
+  }
+  TEST_CHECK(ES_InputCapture_GetEdge(Seen[0].Param, &Edge) == false);
+}
+
+/****************************************************************************
+ Function
+   RunCapture
+ Description
+   notes each edge with the time that it came, until the last one
+****************************************************************************/
+static ES_Event_t RunCapture(ES_Event_t ThisEvent)
+{
+  ES_Event_t ReturnEvent = { ES_NO_EVENT, 0 };
+
+  if ((ThisEvent.EventType == ES_CAPTURE) && (NumSeen < NUM_EDGES))
+  {
+    Seen[NumSeen].Param = ThisEvent.EventParam;
+    TEST_CHECK(ES_InputCapture_GetEdge(ThisEvent.EventParam,
+        &Seen[NumSeen].Edge) == true);
+    Seen[NumSeen].Time = ES_HRTimer_GetTime();
+    NumSeen++;
+  }
+  if (NumSeen == NUM_EDGES)
+  {
+    ReturnEvent.EventType = ES_ERROR;
+  }
+  return ReturnEvent;
+}
+
+/*------------------------------- Footnotes -------------------------------*/
+/*------------------------------ End of file ------------------------------*/
@@ -0,0 +1,16 @@
+/****************************************************************************
+
+  The configuration for TestCapture: the default ES_Configure.h, with a
+  capture ring of only 4 edges, so that the overruns can be tested
+
+ ****************************************************************************/
+
+#ifndef TestCaptureConfig_H
+#define TestCaptureConfig_H
+
+#include "ES_Configure.h"
+
+#undef CAPTURE_RING_SIZE
+#define CAPTURE_RING_SIZE 4
+
+#endif /* TestCaptureConfig_H */
@@ -0,0 +1,173 @@
+/****************************************************************************
+ Module
+   TestDistLists.c
+
+ Description
+   Host test of the distribution lists of ES_PostList.c: the lists start
+   out with the members from DIST_LIST_INIT, the members can be changed
+   while running, a post to a list reaches its members and no others, and
+   it reaches all of them or none.
+
+ Notes
+   Built with three services and two lists, see TestDistListsConfig.h.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/20/26 07:11 ags     Began Coding
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "TestSupport.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+// a list and a service that do not exist
+#define NO_LIST       NUM_DIST_LISTS
+#define NO_SERVICE    NUM_SERVICES
+
+/*---------------------------- Module Functions ---------------------------*/
+static void TestInitialMembers(void);
+static void TestChanges(void);
+static void TestAllOrNothing(void);
+static void TestLimits(void);
+static bool Got(uint8_t WhichService, ES_EventType_t Type, uint16_t Param);
+
+/*---------------------------- Module Variables ---------------------------*/
+static ES_Event_t Events[8];
+
+/*------------------------------ Module Code ------------------------------*/
+int main(void)
+{
+  TEST_CHECK(ES_Initialize(ES_Timer_RATE_1mS) == Success);
+
+  TestInitialMembers();
+  TestChanges();
+  TestAllOrNothing();
+  TestLimits();
+  return TestSupport_Result("TestDistLists");
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+/****************************************************************************
+ Function
+   TestInitialMembers
+ Description
+   the lists start with the members from DIST_LIST_INIT, and posting to
+   each, directly or through its wrapper, reaches only those
+****************************************************************************/
+static void TestInitialMembers(void)
+{
+  ES_Event_t ThisEvent = { ES_LOCK, 1 };
+
+  TEST_CHECK(ES_GetListMembers(0) == BIT0HI);
+  TEST_CHECK(ES_GetListMembers(1) == (BIT1HI | BIT2HI));
+
+  TEST_CHECK(ES_PostList(1, ThisEvent) == true);
+  ThisEvent.EventType   = ES_UNLOCK;
+  ThisEvent.EventParam  = 2;
+  TEST_CHECK(ES_PostList00(ThisEvent) == true);
+
+  TEST_CHECK(TestSupport_Drain(Events, ARRAY_SIZE(Events)) == 1);
+  TEST_CHECK(TestSupport_IsEvent(Events[0], ES_UNLOCK, 2));
+  TEST_CHECK(Got(1, ES_LOCK, 1) == true);
+  TEST_CHECK(Got(2, ES_LOCK, 1) == true);
+}
+
+/****************************************************************************
+ Function
+   TestChanges
+ Description
+   service 2 is added to list 0 and service 1 taken off list 1, and the
+   posts follow the new members
+****************************************************************************/
+static void TestChanges(void)
+{
+  ES_Event_t ThisEvent = { ES_NEW_KEY, 3 };
+
+  TEST_CHECK(ES_AddToList(0, 2) == true);
+  TEST_CHECK(ES_RemoveFromList(1, 1) == true);
+  TEST_CHECK(ES_GetListMembers(0) == (BIT0HI | BIT2HI));
+  TEST_CHECK(ES_GetListMembers(1) == BIT2HI);
+
+  TEST_CHECK(ES_PostList(0, ThisEvent) == true);
+  TEST_CHECK(TestSupport_Drain(Events, ARRAY_SIZE(Events)) == 1);
+  TEST_CHECK(TestSupport_IsEvent(Events[0], ES_NEW_KEY, 3));
+  TEST_CHECK(TestSupport_GetLog(1, Events, ARRAY_SIZE(Events)) == 0);
+  TEST_CHECK(Got(2, ES_NEW_KEY, 3) == true);
+
+  ThisEvent.EventType   = ES_LOCK;
+  ThisEvent.EventParam  = 4;
+  TEST_CHECK(ES_PostList01(ThisEvent) == true);
+  TEST_CHECK(TestSupport_Drain(Events, ARRAY_SIZE(Events)) == 0);
+  TEST_CHECK(Got(2, ES_LOCK, 4) == true);
+}
+
+/****************************************************************************
+ Function
+   TestAllOrNothing
+ Description
+   with every service on list 1 and service 1's queue full, a post to the
+   list fails and none of the members get it
+****************************************************************************/
+static void TestAllOrNothing(void)
+{
+  ES_Event_t  ThisEvent = { ES_LOCK, 0 };
+  uint8_t     i;
+
+  TEST_CHECK(ES_SetListMembers(1, ES_ALL_SERVICES) == true);
+  TEST_CHECK(ES_GetListMembers(1) == ES_ALL_SERVICES);
+  for (i = 0; i < SERV_1_QUEUE_SIZE; i++)
+  {
+    TEST_CHECK(ES_PostToService(1, ThisEvent) == true);
+  }
+  ThisEvent.EventType = ES_UNLOCK;
+  TEST_CHECK(ES_PostList(1, ThisEvent) == false);
+
+  TEST_CHECK(TestSupport_Drain(Events, ARRAY_SIZE(Events)) == 0);
+  TEST_CHECK(TestSupport_GetLog(1, Events, ARRAY_SIZE(Events)) ==
+      SERV_1_QUEUE_SIZE);
+  TEST_CHECK(TestSupport_GetLog(2, Events, ARRAY_SIZE(Events)) == 0);
+}
+
+/****************************************************************************
+ Function
+   TestLimits
+ Description
+   the lists and services that do not exist are refused, and a refused
+   change leaves the members as they were
+****************************************************************************/
+static void TestLimits(void)
+{
+  ES_Event_t ThisEvent = { ES_LOCK, 5 };
+
+  TEST_CHECK(ES_AddToList(NO_LIST, 0) == false);
+  TEST_CHECK(ES_AddToList(0, NO_SERVICE) == false);
+  TEST_CHECK(ES_RemoveFromList(NO_LIST, 0) == false);
+  TEST_CHECK(ES_RemoveFromList(0, NO_SERVICE) == false);
+  TEST_CHECK(ES_SetListMembers(NO_LIST, BIT0HI) == false);
+  TEST_CHECK(ES_SetListMembers(0, (uint16_t)(1UL << NO_SERVICE)) == false);
+  TEST_CHECK(ES_GetListMembers(0) == (BIT0HI | BIT2HI));
+  TEST_CHECK(ES_GetListMembers(NO_LIST) == 0);
+  TEST_CHECK(ES_PostList(NO_LIST, ThisEvent) == false);
+  TEST_CHECK(TestSupport_Drain(Events, ARRAY_SIZE(Events)) == 0);
+}
+
+/****************************************************************************
+ Function
+   Got
+ Description
+   true if the service was given just the one event in the last drain
+****************************************************************************/
+static bool Got(uint8_t WhichService, ES_EventType_t Type, uint16_t Param)
+{
+  uint8_t NumGot;
+
+  NumGot = TestSupport_GetLog(WhichService, Events, ARRAY_SIZE(Events));
+  return (NumGot == 1) && TestSupport_IsEvent(Events[0], Type, Param);
+}
+
+/*------------------------------- Footnotes -------------------------------*/
+/*------------------------------ End of file ------------------------------*/
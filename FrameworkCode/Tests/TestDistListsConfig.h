@@ -0,0 +1,17 @@
+/****************************************************************************
+
+  The configuration for TestDistLists: three services, with two
+  distribution lists, service 0 on list 0 and services 1 and 2 on list 1
+
+ ****************************************************************************/
+
+#ifndef TestDistListsConfig_H
+#define TestDistListsConfig_H
+
+#include "ThreeServicesConfig.h"
+
+#undef NUM_DIST_LISTS
+#define NUM_DIST_LISTS 2
+#define DIST_LIST_INIT { BIT0HI, BIT1HI | BIT2HI }
+
+#endif /* TestDistListsConfig_H */
@@ -0,0 +1,174 @@
+/****************************************************************************
+ Module
+   TestEventStats.c
+
+ Description
+   Host test of the event type counters of ES_EventStats.c: the posts, the
+   dispatches, the posts dropped on a full queue and the deferrals are
+   counted by event type, and the rates move towards the events counted
+   in each period.
+
+ Notes
+   Built with _INCLUDE_EVENT_STATS_ and _INCLUDE_VIRTUAL_TIME_, so that the
+   periods end exactly when the test moves the clock on. The rates are in
+   tenths of an event per second: 4 events in a 100mS period is a rate of
+   400, and the first period moves a mean of 0 an eighth of the way there.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/20/26 07:26 ags     Began Coding
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_DeferRecall.h"
+#include "ES_EventStats.h"
+#include "TestSupport.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define SERVICE       0
+#define NUM_POSTS     4
+// the rate after the period with NUM_POSTS, then after an empty one
+#define FIRST_RATE    50
+#define EMPTY_RATE    43
+
+/*---------------------------- Module Functions ---------------------------*/
+static void TestRates(void);
+static void TestDropped(void);
+static void TestDeferred(void);
+static void NextPeriod(void);
+
+/*---------------------------- Module Variables ---------------------------*/
+static ES_Event_t Events[8];
+static ES_Event_t DeferralQueue[3 + 1];
+
+/*------------------------------ Module Code ------------------------------*/
+int main(void)
+{
+  ES_EventStats_t Stats;
+
+  TEST_CHECK(ES_Initialize(ES_Timer_RATE_1mS) == Success);
+
+  TestRates();
+  TestDropped();
+  TestDeferred();
+  TEST_CHECK(ES_EventStats_Get(ES_NUM_EVENT_TYPES, &Stats) == false);
+  return TestSupport_Result("TestEventStats");
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+/****************************************************************************
+ Function
+   TestRates
+ Description
+   NUM_POSTS ES_LOCKs are posted and run in the first period, then nothing
+   in the next. The counts are of all of them, and the rates rise after
+   the first period and fall after the second.
+****************************************************************************/
+static void TestRates(void)
+{
+  ES_Event_t      ThisEvent = { ES_LOCK, 0 };
+  ES_EventStats_t Stats;
+  uint8_t         i;
+
+  for (i = 0; i < NUM_POSTS; i++)
+  {
+    TEST_CHECK(ES_PostToService(SERVICE, ThisEvent) == true);
+  }
+  TEST_CHECK(TestSupport_Drain(Events, ARRAY_SIZE(Events)) == NUM_POSTS);
+
+  // the first period is not over, so there are no rates yet
+  TEST_CHECK(ES_EventStats_Get(ES_LOCK, &Stats) == true);
+  TEST_CHECK(Stats.Posted == NUM_POSTS);
+  TEST_CHECK(Stats.Dispatched == NUM_POSTS);
+  TEST_CHECK(Stats.Dropped == 0);
+  TEST_CHECK(Stats.Deferred == 0);
+  TEST_CHECK(Stats.PostRate == 0);
+  TEST_CHECK(Stats.DispatchRate == 0);
+
+  NextPeriod();
+  TEST_CHECK(ES_EventStats_Get(ES_LOCK, &Stats) == true);
+  TEST_CHECK(Stats.PostRate == FIRST_RATE);
+  TEST_CHECK(Stats.DispatchRate == FIRST_RATE);
+
+  NextPeriod();
+  TEST_CHECK(ES_EventStats_Get(ES_LOCK, &Stats) == true);
+  TEST_CHECK(Stats.Posted == NUM_POSTS);
+  TEST_CHECK(Stats.PostRate == EMPTY_RATE);
+  TEST_CHECK(Stats.DispatchRate == EMPTY_RATE);
+}
+
+/****************************************************************************
+ Function
+   TestDropped
+ Description
+   a post to a full queue is counted as dropped, not posted, and the
+   events purged from the queue are never dispatched
+****************************************************************************/
+static void TestDropped(void)
+{
+  ES_Event_t      ThisEvent = { ES_UNLOCK, 0 };
+  ES_EventStats_t Stats;
+  uint8_t         i;
+
+  for (i = 0; i < SERV_0_QUEUE_SIZE; i++)
+  {
+    TEST_CHECK(ES_PostToService(SERVICE, ThisEvent) == true);
+  }
+  TEST_CHECK(ES_PostToService(SERVICE, ThisEvent) == false);
+  // make room for the end marker of the drain
+  TEST_CHECK(ES_PurgeFromService(SERVICE, ES_UNLOCK, BIT0HI) == true);
+  TEST_CHECK(TestSupport_Drain(Events, ARRAY_SIZE(Events)) == 0);
+
+  TEST_CHECK(ES_EventStats_Get(ES_UNLOCK, &Stats) == true);
+  TEST_CHECK(Stats.Posted == SERV_0_QUEUE_SIZE);
+  TEST_CHECK(Stats.Dropped == 1);
+  TEST_CHECK(Stats.Dispatched == 0);
+}
+
+/****************************************************************************
+ Function
+   TestDeferred
+ Description
+   an event put in a deferral queue is counted as deferred, and as
+   dispatched once it has been recalled and run
+****************************************************************************/
+static void TestDeferred(void)
+{
+  ES_Event_t      ThisEvent = { ES_NEW_KEY, 'a' };
+  ES_EventStats_t Stats;
+
+  ES_InitDeferralQueueWith(DeferralQueue, ARRAY_SIZE(DeferralQueue));
+  TEST_CHECK(ES_DeferEvent(DeferralQueue, ThisEvent) == true);
+  TEST_CHECK(ES_EventStats_Get(ES_NEW_KEY, &Stats) == true);
+  TEST_CHECK(Stats.Deferred == 1);
+  TEST_CHECK(Stats.Dispatched == 0);
+
+  TEST_CHECK(ES_RecallEvents(SERVICE, DeferralQueue) == true);
+  TEST_CHECK(TestSupport_Drain(Events, ARRAY_SIZE(Events)) == 1);
+  TEST_CHECK(TestSupport_IsEvent(Events[0], ES_NEW_KEY, 'a'));
+  TEST_CHECK(ES_EventStats_Get(ES_NEW_KEY, &Stats) == true);
+  TEST_CHECK(Stats.Deferred == 1);
+  TEST_CHECK(Stats.Dispatched == 1);
+}
+
+/****************************************************************************
+ Function
+   NextPeriod
+ Description
+   moves the clock on to the end of the next rate period, and runs the
+   timeout that got it there
+****************************************************************************/
+static void NextPeriod(void)
+{
+  TEST_CHECK(ES_Timer_InitTimer(SERVICE0_TIMER, EVENT_RATE_PERIOD_MS) ==
+      ES_Timer_OK);
+  TEST_CHECK(TestSupport_Advance() == true);
+  TEST_CHECK(TestSupport_Drain(Events, ARRAY_SIZE(Events)) == 1);
+}
+
+/*------------------------------- Footnotes -------------------------------*/
+/*------------------------------ End of file ------------------------------*/
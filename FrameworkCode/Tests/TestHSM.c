@@ -0,0 +1,415 @@
+/****************************************************************************
+ Module
+   TestHSM.c
+
+ Description
+   Host test of the table driven state machine engine, ES_HSM.c: the
+   orthogonal regions, the per-state deferral, the shallow and deep
+   history, and the re-mapping of an event by the regions of a top level
+   orthogonal state.
+
+ Notes
+   The machine under test is
+     Idle
+     Busy (shallow history, defers ES_TIMEOUT) { BusyA, BusyB }
+     Ortho (deep history) { RegA { A1, A2 } | RegB { B1, B2 } }
+   RegA re-maps ES_TIMEOUT to ES_SHORT_TIMEOUT, which takes Ortho to Idle,
+   and RegB re-maps it to ES_CAPTURE.
+   The entry and exit functions write to a log, "+" for an entry, "*" for
+   an entry from history and "-" for an exit, so that the order that the
+   states are walked in can be checked.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/20/26 06:27 ags     checks ES_HSM_IsDeferring
+ 10/20/26 06:02 ags     the regions of Ortho re-map ES_TIMEOUT
+ 10/20/26 05:30 ags     Began Coding
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <stdio.h>
+#include <string.h>
+
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_DeferRecall.h"
+#include "ES_HSM.h"
+#include "TestSupport.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+// the states, by their index in the table
+#define IDLE    0
+#define BUSY    1
+#define BUSY_A  2
+#define BUSY_B  3
+#define ORTHO   4
+#define REG_A   5
+#define REG_B   6
+#define A1      7
+#define A2      8
+#define B1      9
+#define B2      10
+
+#define NUM_REGIONS 3
+#define TOP         2
+
+// the entry and exit functions of a state, that write to the log
+#define LOGGED_STATE(Name) \
+  static void Enter##Name(ES_Event_t ThisEvent) \
+  { \
+    Log((ThisEvent.EventType == ES_ENTRY_HISTORY) ? "*" : "+", #Name); \
+  } \
+  static void Exit##Name(ES_Event_t ThisEvent) \
+  { \
+    (void)ThisEvent; \
+    Log("-", #Name); \
+  }
+
+/*---------------------------- Module Functions ---------------------------*/
+static void Log(const char *pHow, const char *pName);
+static bool LogIs(const char *pExpected);
+static ES_Event_t Run(ES_EventType_t Type, uint16_t Param);
+static void TestRegions(void);
+static void TestHistory(void);
+static void TestDeferral(void);
+static void TestRemap(void);
+static ES_Event_t DuringRegA(ES_Event_t ThisEvent);
+static ES_Event_t DuringRegB(ES_Event_t ThisEvent);
+static void DirtyStack(void);
+
+/*---------------------------- Module Variables ---------------------------*/
+static char LogText[256];
+
+LOGGED_STATE(Idle)
+LOGGED_STATE(Busy)
+LOGGED_STATE(BusyA)
+LOGGED_STATE(BusyB)
+LOGGED_STATE(Ortho)
+LOGGED_STATE(RegA)
+LOGGED_STATE(RegB)
+LOGGED_STATE(A1)
+LOGGED_STATE(A2)
+LOGGED_STATE(B1)
+LOGGED_STATE(B2)
+
+static const ES_HSMTransition_t IdleTransitions[] =
+{
+  { ES_LOCK, 0, 0, BUSY, ES_HSM_LCA_AUTO },
+  { ES_UNLOCK, 0, 0, ORTHO, ES_HSM_LCA_AUTO }
+};
+static const ES_HSMTransition_t BusyTransitions[] =
+{
+  { ES_UNLOCK, 0, 0, IDLE, ES_HSM_LCA_AUTO }
+};
+static const ES_HSMTransition_t BusyATransitions[] =
+{
+  { ES_NEW_KEY, 0, 0, BUSY_B, ES_HSM_LCA_AUTO }
+};
+static const ES_HSMTransition_t OrthoTransitions[] =
+{
+  { ES_LOCK, 0, 0, IDLE, ES_HSM_LCA_AUTO },
+  { ES_SHORT_TIMEOUT, 0, 0, IDLE, ES_HSM_LCA_AUTO }
+};
+static const ES_HSMTransition_t A1Transitions[] =
+{
+  { ES_NEW_KEY, 0, 0, A2, ES_HSM_LCA_AUTO }
+};
+static const ES_HSMTransition_t B1Transitions[] =
+{
+  { ES_NEW_KEY, 0, 0, B2, ES_HSM_LCA_AUTO }
+};
+
+static const ES_HSMStateDesc_t StateTable[] =
+{
+  /* Parent, Depth, InitialChild, Entry, Exit, During, Transitions,
+     EventMap, Region, NumRegions, SubRegion, DeferMask, History,
+     HistorySlot */
+  { ES_HSM_ROOT, 1, ES_HSM_NO_STATE, EnterIdle, ExitIdle, 0,
+    IdleTransitions, ARRAY_SIZE(IdleTransitions), 0,
+    TOP, 0, 0, 0, ES_HSM_HISTORY_NONE, 0 },
+  { ES_HSM_ROOT, 1, BUSY_A, EnterBusy, ExitBusy, 0,
+    BusyTransitions, ARRAY_SIZE(BusyTransitions), 0,
+    TOP, 0, 0, ES_TYPE_MASK(ES_TIMEOUT), ES_HSM_HISTORY_SHALLOW, 0 },
+  { BUSY, 2, ES_HSM_NO_STATE, EnterBusyA, ExitBusyA, 0,
+    BusyATransitions, ARRAY_SIZE(BusyATransitions), 0,
+    TOP, 0, 0, 0, ES_HSM_HISTORY_NONE, 0 },
+  { BUSY, 2, ES_HSM_NO_STATE, EnterBusyB, ExitBusyB, 0,
+    0, 0, 0,
+    TOP, 0, 0, 0, ES_HSM_HISTORY_NONE, 0 },
+  { ES_HSM_ROOT, 1, REG_A, EnterOrtho, ExitOrtho, 0,
+    OrthoTransitions, ARRAY_SIZE(OrthoTransitions), 0,
+    TOP, 2, 0, 0, ES_HSM_HISTORY_DEEP, 1 },
+  { ORTHO, 2, A1, EnterRegA, ExitRegA, DuringRegA,
+    0, 0, 0,
+    0, 0, 0, 0, ES_HSM_HISTORY_NONE, 0 },
+  { ORTHO, 2, B1, EnterRegB, ExitRegB, DuringRegB,
+    0, 0, 0,
+    1, 0, 0, 0, ES_HSM_HISTORY_NONE, 0 },
+  { REG_A, 3, ES_HSM_NO_STATE, EnterA1, ExitA1, 0,
+    A1Transitions, ARRAY_SIZE(A1Transitions), 0,
+    0, 0, 0, 0, ES_HSM_HISTORY_NONE, 0 },
+  { REG_A, 3, ES_HSM_NO_STATE, EnterA2, ExitA2, 0,
+    0, 0, 0,
+    0, 0, 0, 0, ES_HSM_HISTORY_NONE, 0 },
+  { REG_B, 3, ES_HSM_NO_STATE, EnterB1, ExitB1, 0,
+    B1Transitions, ARRAY_SIZE(B1Transitions), 0,
+    1, 0, 0, 0, ES_HSM_HISTORY_NONE, 0 },
+  { REG_B, 3, ES_HSM_NO_STATE, EnterB2, ExitB2, 0,
+    0, 0, 0,
+    1, 0, 0, 0, ES_HSM_HISTORY_NONE, 0 }
+};
+
+static const ES_HSMDesc_t MachineDesc =
+{
+  StateTable, ARRAY_SIZE(StateTable), IDLE, NUM_REGIONS
+};
+
+static ES_HSM_t   Machine;
+static ES_Event_t DeferralQueue[3 + 1];
+
+/*------------------------------ Module Code ------------------------------*/
+int main(void)
+{
+  ES_Event_t EntryEvent = { ES_ENTRY, 0 };
+
+  TEST_CHECK(ES_Initialize(ES_Timer_RATE_1mS) == Success);
+  ES_InitDeferralQueueWith(DeferralQueue, ARRAY_SIZE(DeferralQueue));
+  ES_HSM_SetDeferralQueue(&Machine, DeferralQueue, 0);
+  ES_HSM_Start(&Machine, &MachineDesc, EntryEvent);
+  TEST_CHECK(LogIs("+Idle"));
+  TEST_CHECK(ES_HSM_GetState(&Machine) == IDLE);
+
+  TestRegions();
+  TestHistory();
+  TestDeferral();
+  TestRemap();
+  return TestSupport_Result("TestHSM");
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+/****************************************************************************
+ Function
+   TestRegions
+ Description
+   both regions of Ortho are entered, each gets the events, and both are
+   left by a transition from Ortho
+****************************************************************************/
+static void TestRegions(void)
+{
+  ES_Event_t Result;
+
+  Result = Run(ES_UNLOCK, 0);
+  TEST_CHECK(Result.EventType == ES_NO_EVENT);
+  TEST_CHECK(LogIs("-Idle +Ortho +RegA +A1 +RegB +B1"));
+  TEST_CHECK(ES_HSM_GetState(&Machine) == ORTHO);
+  TEST_CHECK(ES_HSM_GetRegionState(&Machine, 0) == A1);
+  TEST_CHECK(ES_HSM_GetRegionState(&Machine, 1) == B1);
+  TEST_CHECK(ES_HSM_IsIn(&Machine, REG_B) == true);
+
+  Result = Run(ES_NEW_KEY, 0);
+  TEST_CHECK(Result.EventType == ES_NO_EVENT);
+  TEST_CHECK(LogIs("-A1 +A2 -B1 +B2"));
+  TEST_CHECK(ES_HSM_GetRegionState(&Machine, 0) == A2);
+  TEST_CHECK(ES_HSM_GetRegionState(&Machine, 1) == B2);
+
+  // nobody takes it, so it comes back
+  Result = Run(ES_CAPTURE, 7);
+  TEST_CHECK((Result.EventType == ES_CAPTURE) && (Result.EventParam == 7));
+  TEST_CHECK(LogIs(""));
+
+  Result = Run(ES_LOCK, 0);
+  TEST_CHECK(Result.EventType == ES_NO_EVENT);
+  TEST_CHECK(LogIs("-A2 -RegA -B2 -RegB -Ortho +Idle"));
+  TEST_CHECK(ES_HSM_GetState(&Machine) == IDLE);
+  TEST_CHECK(ES_HSM_GetRegionState(&Machine, 0) == ES_HSM_NO_STATE);
+  TEST_CHECK(ES_HSM_GetRegionState(&Machine, 1) == ES_HSM_NO_STATE);
+}
+
+/****************************************************************************
+ Function
+   TestHistory
+ Description
+   Ortho resumes the leaves of both regions, Busy resumes its substate
+****************************************************************************/
+static void TestHistory(void)
+{
+  // deep history, after TestRegions left Ortho in A2 and B2
+  Run(ES_UNLOCK, 0);
+  TEST_CHECK(LogIs("-Idle *Ortho *RegA *A2 *RegB *B2"));
+  TEST_CHECK(ES_HSM_GetRegionState(&Machine, 0) == A2);
+  TEST_CHECK(ES_HSM_GetRegionState(&Machine, 1) == B2);
+  Run(ES_LOCK, 0);
+  TEST_CHECK(LogIs("-A2 -RegA -B2 -RegB -Ortho +Idle"));
+
+  // shallow history, the first entry takes the default
+  Run(ES_LOCK, 0);
+  TEST_CHECK(LogIs("-Idle +Busy +BusyA"));
+  Run(ES_NEW_KEY, 0);
+  TEST_CHECK(LogIs("-BusyA +BusyB"));
+  Run(ES_UNLOCK, 0);
+  TEST_CHECK(LogIs("-BusyB -Busy +Idle"));
+  Run(ES_LOCK, 0);
+  TEST_CHECK(LogIs("-Idle *Busy *BusyB"));
+  TEST_CHECK(ES_HSM_IsIn(&Machine, BUSY_B) == true);
+}
+
+/****************************************************************************
+ Function
+   TestDeferral
+ Description
+   Busy defers ES_TIMEOUT until the queue is full, and the deferred events
+   come back to the owner in order once Busy is left
+****************************************************************************/
+static void TestDeferral(void)
+{
+  ES_Event_t  Result;
+  ES_Event_t  Recalled[4];
+  uint8_t     i;
+
+  TEST_CHECK(ES_HSM_IsIn(&Machine, BUSY) == true);
+  TEST_CHECK(ES_HSM_IsDeferring(&Machine, ES_TIMEOUT) == true);
+  TEST_CHECK(ES_HSM_IsDeferring(&Machine, ES_NEW_KEY) == false);
+  for (i = 1; i <= 3; i++)
+  {
+    Result = Run(ES_TIMEOUT, i);
+    TEST_CHECK(Result.EventType == ES_NO_EVENT);
+  }
+  // the deferral queue is full, so the event is handed back
+  Result = Run(ES_TIMEOUT, 4);
+  TEST_CHECK((Result.EventType == ES_TIMEOUT) && (Result.EventParam == 4));
+  TEST_CHECK(TestSupport_Drain(Recalled, ARRAY_SIZE(Recalled)) == 0);
+
+  Run(ES_UNLOCK, 0);
+  TEST_CHECK(LogIs("-BusyB -Busy +Idle"));
+  TEST_CHECK(TestSupport_Drain(Recalled, ARRAY_SIZE(Recalled)) == 3);
+  for (i = 0; i < 3; i++)
+  {
+    TEST_CHECK((Recalled[i].EventType == ES_TIMEOUT) &&
+        (Recalled[i].EventParam == i + 1));
+  }
+  // no longer deferred
+  TEST_CHECK(ES_HSM_IsDeferring(&Machine, ES_TIMEOUT) == false);
+  Result = Run(ES_TIMEOUT, 5);
+  TEST_CHECK((Result.EventType == ES_TIMEOUT) && (Result.EventParam == 5));
+}
+
+/****************************************************************************
+ Function
+   TestRemap
+ Description
+   the first region to re-map an event gives the event that the top level
+   orthogonal state sees
+****************************************************************************/
+static void TestRemap(void)
+{
+  ES_Event_t Result;
+
+  Run(ES_UNLOCK, 0);
+  TEST_CHECK(LogIs("-Idle *Ortho *RegA *A2 *RegB *B2"));
+  // so that a flag left unset by the engine is unlikely to read as false
+  DirtyStack();
+  Result = Run(ES_TIMEOUT, 1);
+  TEST_CHECK(Result.EventType == ES_NO_EVENT);
+  TEST_CHECK(LogIs("-A2 -RegA -B2 -RegB -Ortho +Idle"));
+  TEST_CHECK(ES_HSM_GetState(&Machine) == IDLE);
+}
+
+/****************************************************************************
+ Function
+   DuringRegA
+ Description
+   re-maps ES_TIMEOUT to ES_SHORT_TIMEOUT
+****************************************************************************/
+static ES_Event_t DuringRegA(ES_Event_t ThisEvent)
+{
+  if (ThisEvent.EventType == ES_TIMEOUT)
+  {
+    ThisEvent.EventType = ES_SHORT_TIMEOUT;
+  }
+  return ThisEvent;
+}
+
+/****************************************************************************
+ Function
+   DuringRegB
+ Description
+   re-maps ES_TIMEOUT to ES_CAPTURE, which loses to RegA's re-mapping
+****************************************************************************/
+static ES_Event_t DuringRegB(ES_Event_t ThisEvent)
+{
+  if (ThisEvent.EventType == ES_TIMEOUT)
+  {
+    ThisEvent.EventType = ES_CAPTURE;
+  }
+  return ThisEvent;
+}
+
+/****************************************************************************
+ Function
+   DirtyStack
+ Description
+   fills the stack below the caller with ones
+****************************************************************************/
+static void DirtyStack(void)
+{
+  volatile uint8_t  Junk[512];
+  uint16_t          i;
+
+  for (i = 0; i < sizeof(Junk); i++)
+  {
+    Junk[i] = 0xFF;
+  }
+}
+
+/****************************************************************************
+ Function
+   Run
+ Description
+   clears the log and runs the machine on the event
+****************************************************************************/
+static ES_Event_t Run(ES_EventType_t Type, uint16_t Param)
+{
+  ES_Event_t ThisEvent;
+
+  ThisEvent.EventType   = Type;
+  ThisEvent.EventParam  = Param;
+  LogText[0]            = '\0';
+  return ES_HSM_Run(&Machine, ThisEvent);
+}
+
+/****************************************************************************
+ Function
+   Log
+ Description
+   adds an entry or exit to the log
+****************************************************************************/
+static void Log(const char *pHow, const char *pName)
+{
+  if (LogText[0] != '\0')
+  {
+    strncat(LogText, " ", sizeof(LogText) - strlen(LogText) - 1);
+  }
+  strncat(LogText, pHow, sizeof(LogText) - strlen(LogText) - 1);
+  strncat(LogText, pName, sizeof(LogText) - strlen(LogText) - 1);
+}
+
+/****************************************************************************
+ Function
+   LogIs
+ Description
+   compares the log with what was expected, printing it if it differs
+****************************************************************************/
+static bool LogIs(const char *pExpected)
+{
+  if (strcmp(LogText, pExpected) != 0)
+  {
+    printf("log: \"%s\", expected \"%s\"\n", LogText, pExpected);
+    return false;
+  }
+  return true;
+}
+
+/*------------------------------- Footnotes -------------------------------*/
+/*------------------------------ End of file ------------------------------*/
@@ -0,0 +1,114 @@
+/****************************************************************************
+ Module
+   TestInstrumented.c
+
+ Description
+   Host test of the framework built with all of the instrumentation at
+   once: the profiler, the latency and event stats, the trace, the load
+   accounting, the PC sampler, the run budgets, the input capture and the
+   watchdog. A few events are run through service 0, and each of the
+   modules that counts them must have seen them.
+
+ Notes
+   Built without _INCLUDE_VIRTUAL_TIME_, so that the run times are real.
+   run_tests.sh points the trace and PC sample files into Tests/_build.
+   The modules each have a test of their own, this one is to make sure
+   that they build, with -Werror, and run alongside each other.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/20/26 06:54 ags     Began Coding
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_EventStats.h"
+#include "ES_HRTimers.h"
+#include "ES_InputCapture.h"
+#include "ES_Latency.h"
+#include "ES_Load.h"
+#include "ES_Profiler.h"
+#include "TestSupport.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define SERVICE       0
+#define NUM_RUNS      3
+#define SPIN_uS       200
+
+/*---------------------------- Module Functions ---------------------------*/
+static ES_Event_t RunSpin(ES_Event_t ThisEvent);
+
+/*------------------------------ Module Code ------------------------------*/
+int main(void)
+{
+  ES_Event_t        ThisEvent = { ES_LOCK, 0 };
+  ES_ProfileStats_t Profile;
+  ES_EventStats_t   Stats;
+  ES_LoadStats_t    Load;
+  ES_OverrunStats_t Overruns;
+  uint32_t          Buckets[ES_LATENCY_NUM_BUCKETS];
+  uint32_t          NumLatencies = 0;
+  uint8_t           i;
+
+  TEST_CHECK(ES_Initialize(ES_Timer_RATE_1mS) == Success);
+  TestSupport_SetRunFunc(RunSpin);
+  for (i = 0; i < NUM_RUNS; i++)
+  {
+    ThisEvent.EventParam = i;
+    TEST_CHECK(ES_PostToService(SERVICE, ThisEvent) == true);
+  }
+  TestSupport_Drain(0, 0);
+
+  TEST_CHECK(ES_Profiler_GetService(SERVICE, &Profile) == true);
+  TEST_CHECK(Profile.Count == NUM_RUNS);
+  TEST_CHECK(Profile.MinCycles > 0);
+
+  // the end marker of the drain is taken off the queue too
+  TEST_CHECK(ES_Latency_GetHistogram(SERVICE, Buckets) == true);
+  for (i = 0; i < ES_LATENCY_NUM_BUCKETS; i++)
+  {
+    NumLatencies += Buckets[i];
+  }
+  TEST_CHECK(NumLatencies == NUM_RUNS + 1);
+
+  TEST_CHECK(ES_EventStats_Get(ES_LOCK, &Stats) == true);
+  TEST_CHECK(Stats.Posted == NUM_RUNS);
+  TEST_CHECK(Stats.Dispatched == NUM_RUNS);
+  TEST_CHECK(Stats.Dropped == 0);
+
+  ES_Load_GetStats(&Load);
+  TEST_CHECK(Load.Time[ES_LOAD_DISPATCH] >= NUM_RUNS * SPIN_uS);
+
+  // service 0 has no budget
+  TEST_CHECK(ES_GetOverrunStats(SERVICE, &Overruns) == true);
+  TEST_CHECK(Overruns.Count == 0);
+
+  TEST_CHECK(ES_InputCapture_GetOverruns() == 0);
+  return TestSupport_Result("TestInstrumented");
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+/****************************************************************************
+ Function
+   RunSpin
+ Description
+   takes SPIN_uS over each ES_LOCK
+****************************************************************************/
+static ES_Event_t RunSpin(ES_Event_t ThisEvent)
+{
+  ES_Event_t  ReturnEvent = { ES_NO_EVENT, 0 };
+  uint32_t    Start = ES_HRTimer_GetTime();
+
+  if (ThisEvent.EventType == ES_LOCK)
+  {
+    while ((ES_HRTimer_GetTime() - Start) < SPIN_uS)
+    {}
+  }
+  return ReturnEvent;
+}
+
+/*------------------------------- Footnotes -------------------------------*/
+/*------------------------------ End of file ------------------------------*/
@@ -0,0 +1,151 @@
+/****************************************************************************
+ Module
+   TestLatency.c
+
+ Description
+   Host test of the queue latency stats of ES_Latency.c: the time that
+   each event spends on a service's queue is counted in the service's
+   histogram, and the percentiles and the maximum are read back from it.
+
+ Notes
+   Built with _INCLUDE_VIRTUAL_TIME_, so the latencies are exact. The
+   latencies are kept in units of 2^LATENCY_STAMP_SHIFT uS, 4uS by default.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/20/26 07:17 ags     Began Coding
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_Latency.h"
+#include "TestSupport.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define SERVICE       0
+#define WAIT_mS       10
+// WAIT_mS in latency units is 2500, which has 12 significant bits
+#define WAIT_BUCKET   12
+#define WAIT_LIMIT    (((1UL << WAIT_BUCKET) - 1) << LATENCY_STAMP_SHIFT)
+
+/*---------------------------- Module Functions ---------------------------*/
+static void TestWait(void);
+static void TestPercentiles(void);
+static void TestReset(void);
+static void TestLimits(void);
+
+/*------------------------------ Module Code ------------------------------*/
+int main(void)
+{
+  TEST_CHECK(ES_Initialize(ES_Timer_RATE_1mS) == Success);
+
+  TestWait();
+  TestPercentiles();
+  TestReset();
+  TestLimits();
+  return TestSupport_Result("TestLatency");
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+/****************************************************************************
+ Function
+   TestWait
+ Description
+   an event left on the queue while a timer runs for WAIT_mS waits that
+   long, and the timeout, and the end marker of the drain, wait not at all
+****************************************************************************/
+static void TestWait(void)
+{
+  ES_Event_t  ThisEvent = { ES_LOCK, 0 };
+  ES_Event_t  Events[4];
+  uint32_t    Buckets[ES_LATENCY_NUM_BUCKETS];
+  uint8_t     i;
+
+  TEST_CHECK(ES_PostToService(SERVICE, ThisEvent) == true);
+  TEST_CHECK(ES_Timer_InitTimer(SERVICE0_TIMER, WAIT_mS) == ES_Timer_OK);
+  TEST_CHECK(TestSupport_Advance() == true);
+  TEST_CHECK(TestSupport_Drain(Events, ARRAY_SIZE(Events)) == 2);
+  TEST_CHECK(TestSupport_IsEvent(Events[0], ES_LOCK, 0));
+  TEST_CHECK(TestSupport_IsEvent(Events[1], ES_TIMEOUT, SERVICE0_TIMER));
+
+  TEST_CHECK(ES_Latency_GetHistogram(SERVICE, Buckets) == true);
+  for (i = 0; i < ES_LATENCY_NUM_BUCKETS; i++)
+  {
+    if (i == 0)
+    {
+      TEST_CHECK(Buckets[i] == 2);
+    }
+    else if (i == WAIT_BUCKET)
+    {
+      TEST_CHECK(Buckets[i] == 1);
+    }
+    else
+    {
+      TEST_CHECK(Buckets[i] == 0);
+    }
+  }
+  TEST_CHECK(ES_Latency_GetMax(SERVICE) == WAIT_mS * 1000UL);
+}
+
+/****************************************************************************
+ Function
+   TestPercentiles
+ Description
+   of the three latencies, two are 0, so up to the 66th percentile is 0
+   and from the 67th it is the upper limit of the bucket of the long wait
+****************************************************************************/
+static void TestPercentiles(void)
+{
+  TEST_CHECK(ES_Latency_GetPercentile(SERVICE, 1) == 0);
+  TEST_CHECK(ES_Latency_GetPercentile(SERVICE, 50) == 0);
+  TEST_CHECK(ES_Latency_GetPercentile(SERVICE, 66) == 0);
+  TEST_CHECK(ES_Latency_GetPercentile(SERVICE, 67) == WAIT_LIMIT);
+  TEST_CHECK(ES_Latency_GetPercentile(SERVICE, 100) == WAIT_LIMIT);
+  // more than 100 is taken as 100
+  TEST_CHECK(ES_Latency_GetPercentile(SERVICE, 200) == WAIT_LIMIT);
+}
+
+/****************************************************************************
+ Function
+   TestReset
+ Description
+   nothing is left after ES_Latency_Reset
+****************************************************************************/
+static void TestReset(void)
+{
+  uint32_t  Buckets[ES_LATENCY_NUM_BUCKETS];
+  uint32_t  NumLatencies = 0;
+  uint8_t   i;
+
+  ES_Latency_Reset();
+  TEST_CHECK(ES_Latency_GetHistogram(SERVICE, Buckets) == true);
+  for (i = 0; i < ES_LATENCY_NUM_BUCKETS; i++)
+  {
+    NumLatencies += Buckets[i];
+  }
+  TEST_CHECK(NumLatencies == 0);
+  TEST_CHECK(ES_Latency_GetMax(SERVICE) == 0);
+  TEST_CHECK(ES_Latency_GetPercentile(SERVICE, 100) == 0);
+}
+
+/****************************************************************************
+ Function
+   TestLimits
+ Description
+   the services that do not exist are refused, or read as 0
+****************************************************************************/
+static void TestLimits(void)
+{
+  uint32_t Buckets[ES_LATENCY_NUM_BUCKETS];
+
+  ES_Latency_Record(NUM_SERVICES, 1);
+  TEST_CHECK(ES_Latency_GetHistogram(NUM_SERVICES, Buckets) == false);
+  TEST_CHECK(ES_Latency_GetPercentile(NUM_SERVICES, 100) == 0);
+  TEST_CHECK(ES_Latency_GetMax(NUM_SERVICES) == 0);
+}
+
+/*------------------------------- Footnotes -------------------------------*/
+/*------------------------------ End of file ------------------------------*/
@@ -0,0 +1,77 @@
+/****************************************************************************
+ Module
+   TestLoad.c
+
+ Description
+   Host test of the CPU load accounting of ES_Load.c: ES_Run left with no
+   events for 1.5S, in real time, reports close to no load.
+
+ Notes
+   Built with _INCLUDE_LOAD_STATS_, and without _INCLUDE_VIRTUAL_TIME_, so
+   that ES_Run spins through the pending interrupts and the event checkers
+   the whole time, as it does on the target.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/20/26 06:37 ags     Began Coding
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <stdio.h>
+
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_Load.h"
+#include "TestSupport.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define IDLE_TIME     1500        // ticks
+#define MAX_LOAD      10          // 1%, in 0.1%
+
+/*---------------------------- Module Functions ---------------------------*/
+static ES_Event_t RunIdle(ES_Event_t ThisEvent);
+
+/*------------------------------ Module Code ------------------------------*/
+int main(void)
+{
+  ES_LoadStats_t Load;
+
+  TEST_CHECK(ES_Initialize(ES_Timer_RATE_1mS) == Success);
+  TestSupport_SetRunFunc(RunIdle);
+  ES_Timer_InitTimer(SERVICE0_TIMER, IDLE_TIME);
+
+  // RunIdle stops it on the timeout
+  TEST_CHECK(ES_Run() == FailedRun);
+  ES_Load_GetStats(&Load);
+  printf("load %u.%u%%, pending ints %lluuS, idle %lluuS\n",
+      Load.Load / 10, Load.Load % 10,
+      (unsigned long long)Load.Time[ES_LOAD_PENDING_INTS],
+      (unsigned long long)Load.Time[ES_LOAD_IDLE]);
+  TEST_CHECK(Load.Load < MAX_LOAD);
+  TEST_CHECK(Load.PeakWindow < MAX_LOAD);
+  TEST_CHECK(Load.Time[ES_LOAD_IDLE] > (IDLE_TIME * 1000UL * 99) / 100);
+  return TestSupport_Result("TestLoad");
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+/****************************************************************************
+ Function
+   RunIdle
+ Description
+   stops ES_Run when the timer runs out
+****************************************************************************/
+static ES_Event_t RunIdle(ES_Event_t ThisEvent)
+{
+  ES_Event_t ReturnEvent = { ES_NO_EVENT, 0 };
+
+  if (ThisEvent.EventType == ES_TIMEOUT)
+  {
+    ReturnEvent.EventType = ES_ERROR;
+  }
+  return ReturnEvent;
+}
+
+/*------------------------------- Footnotes -------------------------------*/
+/*------------------------------ End of file ------------------------------*/
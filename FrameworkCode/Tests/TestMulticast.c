@@ -0,0 +1,185 @@
+/****************************************************************************
+ Module
+   TestMulticast.c
+
+ Description
+   Host test of the multicast posts in ES_Framework.c: ES_PostAll,
+   ES_PostToMask and ES_Publish post to every target or to none of them,
+   while ES_PostToMaskBestEffort posts to every target with room and
+   returns the ones that missed out.
+
+ Notes
+   Built with three services, see TestMulticastConfig.h. Service 1's queue
+   is the one that is filled.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/20/26 07:08 ags     Began Coding
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "TestSupport.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define FULL_SERVICE  1
+// a service that does not exist
+#define NO_SERVICE    ((uint16_t)(1UL << NUM_SERVICES))
+
+/*---------------------------- Module Functions ---------------------------*/
+static void TestAll(void);
+static void TestAllOrNothing(void);
+static void TestBestEffort(void);
+static void TestNoService(void);
+static void FillQueue(void);
+static bool GotOnly(uint8_t WhichService, ES_EventType_t Type,
+    uint8_t NumEvents);
+
+/*---------------------------- Module Variables ---------------------------*/
+static ES_Event_t Events[8];
+
+/*------------------------------ Module Code ------------------------------*/
+int main(void)
+{
+  TEST_CHECK(ES_Initialize(ES_Timer_RATE_1mS) == Success);
+
+  TestAll();
+  TestAllOrNothing();
+  TestBestEffort();
+  TestNoService();
+  return TestSupport_Result("TestMulticast");
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+/****************************************************************************
+ Function
+   TestAll
+ Description
+   with room everywhere, ES_PostAll gives every service the event once
+****************************************************************************/
+static void TestAll(void)
+{
+  ES_Event_t ThisEvent = { ES_LOCK, 1 };
+
+  TEST_CHECK(ES_PostAll(ThisEvent) == true);
+  TEST_CHECK(TestSupport_Drain(Events, ARRAY_SIZE(Events)) == 1);
+  TEST_CHECK(TestSupport_IsEvent(Events[0], ES_LOCK, 1));
+  TEST_CHECK(GotOnly(1, ES_LOCK, 1) == true);
+  TEST_CHECK(GotOnly(2, ES_LOCK, 1) == true);
+}
+
+/****************************************************************************
+ Function
+   TestAllOrNothing
+ Description
+   with service 1's queue full, ES_PostAll and ES_Publish fail and none of
+   the services get the event, not even those with room
+****************************************************************************/
+static void TestAllOrNothing(void)
+{
+  ES_Event_t ThisEvent = { ES_UNLOCK, 2 };
+
+  FillQueue();
+  TEST_CHECK(ES_PostAll(ThisEvent) == false);
+  TEST_CHECK(ES_PostToMask(BIT0HI | BIT1HI, ThisEvent) == false);
+  TEST_CHECK(ES_Subscribe(0, ES_UNLOCK) == true);
+  TEST_CHECK(ES_Subscribe(FULL_SERVICE, ES_UNLOCK) == true);
+  TEST_CHECK(ES_Subscribe(2, ES_UNLOCK) == true);
+  TEST_CHECK(ES_Publish(ThisEvent) == false);
+
+  TEST_CHECK(TestSupport_Drain(Events, ARRAY_SIZE(Events)) == 0);
+  TEST_CHECK(GotOnly(FULL_SERVICE, ES_LOCK, SERV_1_QUEUE_SIZE) == true);
+  TEST_CHECK(GotOnly(2, ES_LOCK, 0) == true);
+}
+
+/****************************************************************************
+ Function
+   TestBestEffort
+ Description
+   with service 1's queue full, ES_PostToMaskBestEffort still posts to
+   services 0 and 2, and returns service 1 as the one that missed out
+****************************************************************************/
+static void TestBestEffort(void)
+{
+  ES_Event_t ThisEvent = { ES_NEW_KEY, 3 };
+
+  FillQueue();
+  TEST_CHECK(ES_PostToMaskBestEffort(ES_ALL_SERVICES, ThisEvent) == BIT1HI);
+
+  TEST_CHECK(TestSupport_Drain(Events, ARRAY_SIZE(Events)) == 1);
+  TEST_CHECK(TestSupport_IsEvent(Events[0], ES_NEW_KEY, 3));
+  TEST_CHECK(GotOnly(FULL_SERVICE, ES_LOCK, SERV_1_QUEUE_SIZE) == true);
+  TEST_CHECK(GotOnly(2, ES_NEW_KEY, 1) == true);
+}
+
+/****************************************************************************
+ Function
+   TestNoService
+ Description
+   a mask with a service that does not exist is refused by ES_PostToMask,
+   and ES_PostToMaskBestEffort returns that service as missed
+****************************************************************************/
+static void TestNoService(void)
+{
+  ES_Event_t ThisEvent = { ES_LOCK, 4 };
+
+  TEST_CHECK(ES_PostToMask(NO_SERVICE | BIT0HI, ThisEvent) == false);
+  TEST_CHECK(ES_PostToMaskBestEffort(NO_SERVICE | BIT0HI, ThisEvent) ==
+      NO_SERVICE);
+
+  TEST_CHECK(TestSupport_Drain(Events, ARRAY_SIZE(Events)) == 1);
+  TEST_CHECK(TestSupport_IsEvent(Events[0], ES_LOCK, 4));
+  TEST_CHECK(GotOnly(1, ES_LOCK, 0) == true);
+}
+
+/****************************************************************************
+ Function
+   FillQueue
+ Description
+   fills service 1's queue with ES_LOCK events
+****************************************************************************/
+static void FillQueue(void)
+{
+  ES_Event_t  ThisEvent = { ES_LOCK, 0 };
+  uint8_t     i;
+
+  for (i = 0; i < SERV_1_QUEUE_SIZE; i++)
+  {
+    TEST_CHECK(ES_PostToService(FULL_SERVICE, ThisEvent) == true);
+  }
+  TEST_CHECK(ES_PostToService(FULL_SERVICE, ThisEvent) == false);
+}
+
+/****************************************************************************
+ Function
+   GotOnly
+ Description
+   true if the service was given NumEvents events in the last drain, all
+   of the type
+****************************************************************************/
+static bool GotOnly(uint8_t WhichService, ES_EventType_t Type,
+    uint8_t NumEvents)
+{
+  uint8_t NumGot;
+  uint8_t i;
+
+  NumGot = TestSupport_GetLog(WhichService, Events, ARRAY_SIZE(Events));
+  if (NumGot != NumEvents)
+  {
+    return false;
+  }
+  for (i = 0; i < NumGot; i++)
+  {
+    if (Events[i].EventType != Type)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/*------------------------------- Footnotes -------------------------------*/
+/*------------------------------ End of file ------------------------------*/
@@ -0,0 +1,13 @@
+/****************************************************************************
+
+  The configuration for TestMulticast: three services, so that one of them
+  can have a full queue while the others have room
+
+ ****************************************************************************/
+
+#ifndef TestMulticastConfig_H
+#define TestMulticastConfig_H
+
+#include "ThreeServicesConfig.h"
+
+#endif /* TestMulticastConfig_H */
@@ -0,0 +1,173 @@
+/****************************************************************************
+ Module
+   TestPCSample.c
+
+ Description
+   Host test of the PC sampling profiler of ES_PCSample.c: the live
+   samples are all accounted for, each recorded offset is counted in its
+   bucket or as outside, the buckets saturate rather than wrap, and the
+   histogram is written in the form that Tools/ES_PCSymbolize.py reads.
+
+ Notes
+   Built without _INCLUDE_VIRTUAL_TIME_, as SIGPROF counts the CPU time
+   used. The sampling is stopped after the live spin, so that the rest of
+   the counts are only those recorded by the test itself.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/20/26 07:24 ags     Began Coding
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#define _XOPEN_SOURCE 600   // for setitimer
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_PCSample.h"
+#include "ES_Port.h"
+#include "TestSupport.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+// enough CPU time for about 50 samples
+#define SPIN_CLOCKS   (CLOCKS_PER_SEC / 20)
+#define BUCKET_SIZE   (1UL << PC_SAMPLE_SHIFT)
+#define MAX_COUNT     0xFFFFUL
+#define MAX_TEXT      256
+
+/*---------------------------- Module Functions ---------------------------*/
+static void TestLive(void);
+static void TestRecord(void);
+static void TestSaturation(void);
+static void TestWrite(void);
+
+/*------------------------------ Module Code ------------------------------*/
+int main(void)
+{
+  TEST_CHECK(ES_Initialize(ES_Timer_RATE_1mS) == Success);
+
+  TestLive();
+  TestRecord();
+  TestSaturation();
+  TestWrite();
+  return TestSupport_Result("TestPCSample");
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+/****************************************************************************
+ Function
+   TestLive
+ Description
+   a spin is sampled, and every sample is in a bucket or outside, then
+   the sampling is stopped and the histogram cleared
+****************************************************************************/
+static void TestLive(void)
+{
+  struct itimerval  Stop = { { 0, 0 }, { 0, 0 } };
+  clock_t           Start = clock();
+  uint32_t          NumCounted = 0;
+  uint16_t          i;
+
+  while ((clock() - Start) < SPIN_CLOCKS)
+  {}
+  setitimer(ITIMER_PROF, &Stop, NULL);
+
+  TEST_CHECK(ES_PCSample_GetTotal() > 0);
+  for (i = 0; i < PC_SAMPLE_NUM_BUCKETS; i++)
+  {
+    NumCounted += ES_PCSample_GetCount(i);
+  }
+  TEST_CHECK(NumCounted + ES_PCSample_GetOutside() ==
+      ES_PCSample_GetTotal());
+
+  ES_PCSample_Reset();
+  TEST_CHECK(ES_PCSample_GetTotal() == 0);
+  TEST_CHECK(ES_PCSample_GetOutside() == 0);
+  TEST_CHECK(ES_PCSample_GetCount(0) == 0);
+}
+
+/****************************************************************************
+ Function
+   TestRecord
+ Description
+   the offsets at either end of a bucket count in it, and an offset past
+   the end of the histogram is only counted as outside
+****************************************************************************/
+static void TestRecord(void)
+{
+  ES_PCSample_Record(0);
+  ES_PCSample_Record(BUCKET_SIZE - 1);
+  ES_PCSample_Record(BUCKET_SIZE);
+  ES_PCSample_Record(PC_SAMPLE_NUM_BUCKETS * BUCKET_SIZE);
+
+  TEST_CHECK(ES_PCSample_GetCount(0) == 2);
+  TEST_CHECK(ES_PCSample_GetCount(1) == 1);
+  TEST_CHECK(ES_PCSample_GetCount(PC_SAMPLE_NUM_BUCKETS - 1) == 0);
+  TEST_CHECK(ES_PCSample_GetCount(PC_SAMPLE_NUM_BUCKETS) == 0);
+  TEST_CHECK(ES_PCSample_GetOutside() == 1);
+  TEST_CHECK(ES_PCSample_GetTotal() == 4);
+}
+
+/****************************************************************************
+ Function
+   TestSaturation
+ Description
+   a bucket stops at 65535, while the total carries on
+****************************************************************************/
+static void TestSaturation(void)
+{
+  uint32_t i;
+
+  for (i = 0; i <= MAX_COUNT; i++)
+  {
+    ES_PCSample_Record(2 * BUCKET_SIZE);
+  }
+  TEST_CHECK(ES_PCSample_GetCount(2) == MAX_COUNT);
+  TEST_CHECK(ES_PCSample_GetTotal() == 4 + MAX_COUNT + 1);
+}
+
+/****************************************************************************
+ Function
+   TestWrite
+ Description
+   the histogram is written as the header, a line for each bucket with
+   samples and the end line
+****************************************************************************/
+static void TestWrite(void)
+{
+  FILE    *pFile;
+  char    Expected[MAX_TEXT];
+  char    Written[MAX_TEXT];
+  size_t  NumWritten = 0;
+
+  snprintf(Expected, sizeof(Expected),
+      "# ES_PCSample base 0x%08lx shift %u rate %u samples %lu outside 1\r\n"
+      "%08lx 2\r\n"
+      "%08lx 1\r\n"
+      "%08lx %lu\r\n"
+      "# end\r\n",
+      (unsigned long)_HW_PCSample_GetCodeBase(), PC_SAMPLE_SHIFT,
+      PC_SAMPLE_RATE_HZ, 4 + MAX_COUNT + 1, 0UL, BUCKET_SIZE,
+      2 * BUCKET_SIZE, MAX_COUNT);
+
+  pFile = tmpfile();
+  TEST_CHECK(pFile != NULL);
+  if (pFile != NULL)
+  {
+    ES_PCSample_Write(pFile);
+    rewind(pFile);
+    NumWritten = fread(Written, 1, sizeof(Written) - 1, pFile);
+    fclose(pFile);
+  }
+  Written[NumWritten] = '\0';
+  TEST_CHECK(strcmp(Written, Expected) == 0);
+}
+
+/*------------------------------- Footnotes -------------------------------*/
+/*------------------------------ End of file ------------------------------*/
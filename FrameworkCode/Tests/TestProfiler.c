@@ -0,0 +1,158 @@
+/****************************************************************************
+ Module
+   TestProfiler.c
+
+ Description
+   Host test of the run function profiler of ES_Profiler.c: each run is
+   counted against its service and against the type of its event, with
+   the cycles that it took, and the statistics can be cleared.
+
+ Notes
+   Built without _INCLUDE_VIRTUAL_TIME_, so that the runs take real time.
+   The host cycle count is scaled to 40MHz. The spin is timed in whole uS
+   and the cost of reading the count is taken off, so a run that spins for
+   SPIN_uS is only sure to take (SPIN_uS - 1) * 40 cycles.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/20/26 07:15 ags     Began Coding
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_HRTimers.h"
+#include "ES_Profiler.h"
+#include "TestSupport.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define SERVICE       0
+#define SPIN_uS       1000
+#define SPIN_CYCLES   ((SPIN_uS - 1) * 40UL)
+
+/*---------------------------- Module Functions ---------------------------*/
+static void TestCounts(void);
+static void TestReset(void);
+static void TestLimits(void);
+static ES_Event_t RunSpin(ES_Event_t ThisEvent);
+
+/*------------------------------ Module Code ------------------------------*/
+int main(void)
+{
+  TEST_CHECK(ES_Initialize(ES_Timer_RATE_1mS) == Success);
+  TestSupport_SetRunFunc(RunSpin);
+
+  TestCounts();
+  TestReset();
+  TestLimits();
+  return TestSupport_Result("TestProfiler");
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+/****************************************************************************
+ Function
+   TestCounts
+ Description
+   two ES_LOCK runs that spin and one ES_UNLOCK run that does not: the
+   service has all three, each event type only its own, and the spins are
+   at least as long as they were made to be
+****************************************************************************/
+static void TestCounts(void)
+{
+  ES_Event_t        ThisEvent = { ES_LOCK, 0 };
+  ES_ProfileStats_t Stats;
+
+  TEST_CHECK(ES_PostToService(SERVICE, ThisEvent) == true);
+  TEST_CHECK(ES_PostToService(SERVICE, ThisEvent) == true);
+  ThisEvent.EventType = ES_UNLOCK;
+  TEST_CHECK(ES_PostToService(SERVICE, ThisEvent) == true);
+  TestSupport_Drain(0, 0);
+
+  TEST_CHECK(ES_Profiler_GetService(SERVICE, &Stats) == true);
+  TEST_CHECK(Stats.Count == 3);
+  TEST_CHECK(Stats.MinCycles < SPIN_CYCLES);
+  TEST_CHECK(Stats.MaxCycles >= SPIN_CYCLES);
+  TEST_CHECK(Stats.TotalCycles >= 2 * SPIN_CYCLES);
+  TEST_CHECK(Stats.MeanCycles == (uint32_t)(Stats.TotalCycles / 3));
+
+  TEST_CHECK(ES_Profiler_GetEventType(ES_LOCK, &Stats) == true);
+  TEST_CHECK(Stats.Count == 2);
+  TEST_CHECK(Stats.MinCycles >= SPIN_CYCLES);
+  TEST_CHECK(Stats.MinCycles <= Stats.MeanCycles);
+  TEST_CHECK(Stats.MeanCycles <= Stats.MaxCycles);
+
+  TEST_CHECK(ES_Profiler_GetEventType(ES_UNLOCK, &Stats) == true);
+  TEST_CHECK(Stats.Count == 1);
+  TEST_CHECK(Stats.MaxCycles < SPIN_CYCLES);
+
+  // never run, so all 0
+  TEST_CHECK(ES_Profiler_GetEventType(ES_NEW_KEY, &Stats) == true);
+  TEST_CHECK(Stats.Count == 0);
+  TEST_CHECK(Stats.MinCycles == 0);
+  TEST_CHECK(Stats.MaxCycles == 0);
+  TEST_CHECK(Stats.MeanCycles == 0);
+}
+
+/****************************************************************************
+ Function
+   TestReset
+ Description
+   the statistics start again from nothing after ES_Profiler_Reset
+****************************************************************************/
+static void TestReset(void)
+{
+  ES_Event_t        ThisEvent = { ES_UNLOCK, 0 };
+  ES_ProfileStats_t Stats;
+
+  ES_Profiler_Reset();
+  TEST_CHECK(ES_Profiler_GetService(SERVICE, &Stats) == true);
+  TEST_CHECK(Stats.Count == 0);
+  TEST_CHECK(Stats.TotalCycles == 0);
+  TEST_CHECK(ES_Profiler_GetEventType(ES_LOCK, &Stats) == true);
+  TEST_CHECK(Stats.Count == 0);
+
+  // the minimum is not held over from before the reset
+  TEST_CHECK(ES_PostToService(SERVICE, ThisEvent) == true);
+  TestSupport_Drain(0, 0);
+  TEST_CHECK(ES_Profiler_GetService(SERVICE, &Stats) == true);
+  TEST_CHECK(Stats.Count == 1);
+  TEST_CHECK(Stats.MinCycles == Stats.MaxCycles);
+}
+
+/****************************************************************************
+ Function
+   TestLimits
+ Description
+   the services and event types that do not exist are refused
+****************************************************************************/
+static void TestLimits(void)
+{
+  ES_ProfileStats_t Stats;
+
+  TEST_CHECK(ES_Profiler_GetService(NUM_SERVICES, &Stats) == false);
+  TEST_CHECK(ES_Profiler_GetEventType(ES_NUM_EVENT_TYPES, &Stats) == false);
+}
+
+/****************************************************************************
+ Function
+   RunSpin
+ Description
+   takes SPIN_uS over each ES_LOCK, and returns at once from the others
+****************************************************************************/
+static ES_Event_t RunSpin(ES_Event_t ThisEvent)
+{
+  ES_Event_t  ReturnEvent = { ES_NO_EVENT, 0 };
+  uint32_t    Start = ES_HRTimer_GetTime();
+
+  if (ThisEvent.EventType == ES_LOCK)
+  {
+    while ((ES_HRTimer_GetTime() - Start) < SPIN_uS)
+    {}
+  }
+  return ReturnEvent;
+}
+
+/*------------------------------- Footnotes -------------------------------*/
+/*------------------------------ End of file ------------------------------*/
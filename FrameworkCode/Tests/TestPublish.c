@@ -0,0 +1,128 @@
+/****************************************************************************
+ Module
+   TestPublish.c
+
+ Description
+   Host test of the publish/subscribe dispatch in ES_Framework.c: an event
+   published goes to the services subscribed to its type and to no others,
+   an event with no subscribers is dropped, and the subscriptions can be
+   changed while running.
+
+ Notes
+   Built with three services, see TestPublishConfig.h.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/20/26 07:05 ags     Began Coding
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "TestSupport.h"
+
+/*---------------------------- Module Functions ---------------------------*/
+static void TestSubscribers(void);
+static void TestChanges(void);
+static void TestLimits(void);
+static bool Publish(ES_EventType_t Type, uint16_t Param);
+
+/*---------------------------- Module Variables ---------------------------*/
+static ES_Event_t Events[8];
+
+/*------------------------------ Module Code ------------------------------*/
+int main(void)
+{
+  TEST_CHECK(ES_Initialize(ES_Timer_RATE_1mS) == Success);
+
+  TestSubscribers();
+  TestChanges();
+  TestLimits();
+  return TestSupport_Result("TestPublish");
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+/****************************************************************************
+ Function
+   TestSubscribers
+ Description
+   services 1 and 2 subscribe to ES_LOCK and service 0 to ES_UNLOCK, each
+   gets only its own, and ES_NEW_KEY with no subscribers goes nowhere
+****************************************************************************/
+static void TestSubscribers(void)
+{
+  TEST_CHECK(ES_Subscribe(1, ES_LOCK) == true);
+  TEST_CHECK(ES_Subscribe(2, ES_LOCK) == true);
+  TEST_CHECK(ES_Subscribe(0, ES_UNLOCK) == true);
+
+  TEST_CHECK(Publish(ES_LOCK, 1) == true);
+  TEST_CHECK(Publish(ES_UNLOCK, 2) == true);
+  TEST_CHECK(Publish(ES_NEW_KEY, 3) == true);
+
+  TEST_CHECK(TestSupport_Drain(Events, ARRAY_SIZE(Events)) == 1);
+  TEST_CHECK(TestSupport_IsEvent(Events[0], ES_UNLOCK, 2));
+  TEST_CHECK(TestSupport_GetLog(1, Events, ARRAY_SIZE(Events)) == 1);
+  TEST_CHECK(TestSupport_IsEvent(Events[0], ES_LOCK, 1));
+  TEST_CHECK(TestSupport_GetLog(2, Events, ARRAY_SIZE(Events)) == 1);
+  TEST_CHECK(TestSupport_IsEvent(Events[0], ES_LOCK, 1));
+}
+
+/****************************************************************************
+ Function
+   TestChanges
+ Description
+   a second subscription to the same type changes nothing, and a service
+   that unsubscribes stops getting the type while the others carry on
+****************************************************************************/
+static void TestChanges(void)
+{
+  TEST_CHECK(ES_Subscribe(1, ES_LOCK) == true);
+  TEST_CHECK(ES_Unsubscribe(2, ES_LOCK) == true);
+  TEST_CHECK(ES_Unsubscribe(2, ES_LOCK) == true);
+  TEST_CHECK(ES_Subscribe(2, ES_UNLOCK) == true);
+
+  TEST_CHECK(Publish(ES_LOCK, 4) == true);
+  TEST_CHECK(Publish(ES_UNLOCK, 5) == true);
+
+  TEST_CHECK(TestSupport_Drain(Events, ARRAY_SIZE(Events)) == 1);
+  TEST_CHECK(TestSupport_IsEvent(Events[0], ES_UNLOCK, 5));
+  TEST_CHECK(TestSupport_GetLog(1, Events, ARRAY_SIZE(Events)) == 1);
+  TEST_CHECK(TestSupport_IsEvent(Events[0], ES_LOCK, 4));
+  TEST_CHECK(TestSupport_GetLog(2, Events, ARRAY_SIZE(Events)) == 1);
+  TEST_CHECK(TestSupport_IsEvent(Events[0], ES_UNLOCK, 5));
+}
+
+/****************************************************************************
+ Function
+   TestLimits
+ Description
+   the services and event types that do not exist are refused
+****************************************************************************/
+static void TestLimits(void)
+{
+  TEST_CHECK(ES_Subscribe(NUM_SERVICES, ES_LOCK) == false);
+  TEST_CHECK(ES_Subscribe(0, ES_NUM_EVENT_TYPES) == false);
+  TEST_CHECK(ES_Unsubscribe(NUM_SERVICES, ES_LOCK) == false);
+  TEST_CHECK(ES_Unsubscribe(0, ES_NUM_EVENT_TYPES) == false);
+  TEST_CHECK(Publish(ES_NUM_EVENT_TYPES, 6) == false);
+}
+
+/****************************************************************************
+ Function
+   Publish
+ Description
+   publishes an event of the type, with the parameter
+****************************************************************************/
+static bool Publish(ES_EventType_t Type, uint16_t Param)
+{
+  ES_Event_t ThisEvent;
+
+  ThisEvent.EventType   = Type;
+  ThisEvent.EventParam  = Param;
+  return ES_Publish(ThisEvent);
+}
+
+/*------------------------------- Footnotes -------------------------------*/
+/*------------------------------ End of file ------------------------------*/
@@ -0,0 +1,13 @@
+/****************************************************************************
+
+  The configuration for TestPublish: three services, so that the events can
+  be published to some of them and not the others
+
+ ****************************************************************************/
+
+#ifndef TestPublishConfig_H
+#define TestPublishConfig_H
+
+#include "ThreeServicesConfig.h"
+
+#endif /* TestPublishConfig_H */
@@ -0,0 +1,235 @@
+/****************************************************************************
+ Module
+   TestQueue.c
+
+ Description
+   Host test of the queue splice, and of the recall and timed deferral
+   built on it in ES_DeferRecall.c
+
+ Notes
+   Built with _INCLUDE_VIRTUAL_TIME_, so that the ticks only pass when
+   TestSupport_Advance is called.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/20/26 05:42 ags     Began Coding
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_DeferRecall.h"
+#include "ES_Queue.h"
+#include "TestSupport.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define SERVICE       0
+#define LIFETIME      50
+
+/*---------------------------- Module Functions ---------------------------*/
+static void TestRecall(void);
+static void TestRecallOfType(void);
+static void TestSpliceRoom(void);
+static void TestTimedDeferral(void);
+static bool Post(ES_EventType_t Type, uint16_t Param);
+
+/*---------------------------- Module Variables ---------------------------*/
+static ES_Event_t DeferralQueue[3 + 1];
+
+static ES_Event_t TimedQueue[3 + 1];
+static uint16_t   TimedStamps[3];
+static ES_TimedDeferral_t TimedDeferral = { TimedQueue,
+    ARRAY_SIZE(TimedQueue), TimedStamps, LIFETIME, ES_OVERRUN, 0 };
+
+/*------------------------------ Module Code ------------------------------*/
+int main(void)
+{
+  TEST_CHECK(ES_Initialize(ES_Timer_RATE_1mS) == Success);
+  ES_InitDeferralQueueWith(DeferralQueue, ARRAY_SIZE(DeferralQueue));
+  TEST_CHECK(ES_InitTimedDeferral(&TimedDeferral, SERVICE) == true);
+
+  TestRecall();
+  TestRecallOfType();
+  TestSpliceRoom();
+  TestTimedDeferral();
+  return TestSupport_Result("TestQueue");
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+/****************************************************************************
+ Function
+   TestRecall
+ Description
+   the recalled events go in front of the one already in the queue, in the
+   order that they were deferred
+****************************************************************************/
+static void TestRecall(void)
+{
+  ES_Event_t  Events[5];
+  ES_Event_t  ThisEvent;
+  uint16_t    i;
+
+  TEST_CHECK(Post(ES_NEW_KEY, 'X') == true);
+  ThisEvent.EventType = ES_LOCK;
+  for (i = 1; i <= 3; i++)
+  {
+    ThisEvent.EventParam = i;
+    TEST_CHECK(ES_DeferEvent(DeferralQueue, ThisEvent) == true);
+  }
+  TEST_CHECK(ES_RecallEvents(SERVICE, DeferralQueue) == true);
+  TEST_CHECK(ES_IsQueueEmpty(DeferralQueue) == true);
+  TEST_CHECK(ES_RecallEvents(SERVICE, DeferralQueue) == false);
+
+  TEST_CHECK(TestSupport_Drain(Events, ARRAY_SIZE(Events)) == 4);
+  TEST_CHECK(TestSupport_IsEvent(Events[0], ES_LOCK, 1));
+  TEST_CHECK(TestSupport_IsEvent(Events[1], ES_LOCK, 2));
+  TEST_CHECK(TestSupport_IsEvent(Events[2], ES_LOCK, 3));
+  TEST_CHECK(TestSupport_IsEvent(Events[3], ES_NEW_KEY, 'X'));
+}
+
+/****************************************************************************
+ Function
+   TestRecallOfType
+ Description
+   only the selected type is recalled, the rest stay deferred in order
+****************************************************************************/
+static void TestRecallOfType(void)
+{
+  ES_Event_t  Events[5];
+  ES_Event_t  ThisEvent;
+
+  ThisEvent.EventType   = ES_LOCK;
+  ThisEvent.EventParam  = 1;
+  ES_DeferEvent(DeferralQueue, ThisEvent);
+  ThisEvent.EventType   = ES_UNLOCK;
+  ThisEvent.EventParam  = 2;
+  ES_DeferEvent(DeferralQueue, ThisEvent);
+  ThisEvent.EventType   = ES_LOCK;
+  ThisEvent.EventParam  = 3;
+  ES_DeferEvent(DeferralQueue, ThisEvent);
+
+  TEST_CHECK(ES_RecallEventsOfType(SERVICE, DeferralQueue,
+      ES_TYPE_MASK(ES_TIMEOUT)) == false);
+  TEST_CHECK(ES_RecallEventsOfType(SERVICE, DeferralQueue,
+      ES_TYPE_MASK(ES_LOCK)) == true);
+  TEST_CHECK(TestSupport_Drain(Events, ARRAY_SIZE(Events)) == 2);
+  TEST_CHECK(TestSupport_IsEvent(Events[0], ES_LOCK, 1));
+  TEST_CHECK(TestSupport_IsEvent(Events[1], ES_LOCK, 3));
+
+  TEST_CHECK(ES_DeQueue(DeferralQueue, &ThisEvent) == 0);
+  TEST_CHECK(TestSupport_IsEvent(ThisEvent, ES_UNLOCK, 2));
+}
+
+/****************************************************************************
+ Function
+   TestSpliceRoom
+ Description
+   when there is not room for all of them, the oldest selected events are
+   moved and the rest stay in the source, still in order
+****************************************************************************/
+static void TestSpliceRoom(void)
+{
+  ES_Event_t  Dest[4 + 1];
+  ES_Event_t  Source[4 + 1];
+  ES_Event_t  ThisEvent;
+  uint16_t    i;
+
+  ES_InitQueue(Dest, ARRAY_SIZE(Dest));
+  ES_InitQueue(Source, ARRAY_SIZE(Source));
+  ThisEvent.EventType = ES_NEW_KEY;
+  for (i = 1; i <= 2; i++)
+  {
+    ThisEvent.EventParam = i;
+    ES_EnQueueFIFO(Dest, ThisEvent);
+  }
+  ThisEvent.EventType = ES_LOCK;
+  for (i = 1; i <= 3; i++)
+  {
+    ThisEvent.EventParam = i;
+    ES_EnQueueFIFO(Source, ThisEvent);
+  }
+
+  TEST_CHECK(ES_SpliceQueue(Dest, Source, 0, ES_RECALL_ALL) == 2);
+  TEST_CHECK(ES_QueueSpace(Dest) == 0);
+  ES_DeQueue(Dest, &ThisEvent);
+  TEST_CHECK(TestSupport_IsEvent(ThisEvent, ES_LOCK, 1));
+  ES_DeQueue(Dest, &ThisEvent);
+  TEST_CHECK(TestSupport_IsEvent(ThisEvent, ES_LOCK, 2));
+  ES_DeQueue(Dest, &ThisEvent);
+  TEST_CHECK(TestSupport_IsEvent(ThisEvent, ES_NEW_KEY, 1));
+  ES_DeQueue(Dest, &ThisEvent);
+  TEST_CHECK(TestSupport_IsEvent(ThisEvent, ES_NEW_KEY, 2));
+  TEST_CHECK(ES_IsQueueEmpty(Dest) == true);
+
+  TEST_CHECK(ES_DeQueue(Source, &ThisEvent) == 0);
+  TEST_CHECK(TestSupport_IsEvent(ThisEvent, ES_LOCK, 3));
+}
+
+/****************************************************************************
+ Function
+   TestTimedDeferral
+ Description
+   the deferred events expire LIFETIME ticks after they were deferred, the
+   owner is told of each one, and only the live ones are recalled
+****************************************************************************/
+static void TestTimedDeferral(void)
+{
+  ES_Event_t  Events[5];
+  ES_Event_t  ThisEvent;
+  uint16_t    Start;
+
+  Start = ES_Timer_GetTime();
+  ThisEvent.EventType   = ES_LOCK;
+  ThisEvent.EventParam  = 1;
+  TEST_CHECK(ES_DeferEventTimed(&TimedDeferral, ThisEvent) == true);
+  ThisEvent.EventParam  = 2;
+  TEST_CHECK(ES_DeferEventTimed(&TimedDeferral, ThisEvent) == true);
+  TEST_CHECK(ES_TicksToTimedExpiry() == LIFETIME);
+
+  // part way through their life
+  ES_Timer_InitTimer(SERVICE0_TIMER, 30);
+  TEST_CHECK(TestSupport_Advance() == true);
+  TEST_CHECK((uint16_t)(ES_Timer_GetTime() - Start) == 30);
+  TEST_CHECK(TestSupport_Drain(Events, ARRAY_SIZE(Events)) == 1);
+  TEST_CHECK(TestSupport_IsEvent(Events[0], ES_TIMEOUT, SERVICE0_TIMER));
+
+  ThisEvent.EventType   = ES_UNLOCK;
+  ThisEvent.EventParam  = 3;
+  TEST_CHECK(ES_DeferEventTimed(&TimedDeferral, ThisEvent) == true);
+
+  // the first two expire, the third has 30 ticks left
+  TEST_CHECK(TestSupport_Advance() == true);
+  TEST_CHECK((uint16_t)(ES_Timer_GetTime() - Start) == LIFETIME);
+  TEST_CHECK(TestSupport_Drain(Events, ARRAY_SIZE(Events)) == 2);
+  TEST_CHECK(TestSupport_IsEvent(Events[0], ES_OVERRUN, ES_LOCK));
+  TEST_CHECK(TestSupport_IsEvent(Events[1], ES_OVERRUN, ES_LOCK));
+  TEST_CHECK(ES_TicksToTimedExpiry() == 30);
+
+  TEST_CHECK(ES_RecallTimedEvents(&TimedDeferral, ES_RECALL_ALL) == true);
+  TEST_CHECK(TestSupport_Drain(Events, ARRAY_SIZE(Events)) == 1);
+  TEST_CHECK(TestSupport_IsEvent(Events[0], ES_UNLOCK, 3));
+
+  // nothing left to wait for
+  TEST_CHECK(ES_TicksToTimedExpiry() == 0);
+  TEST_CHECK(TestSupport_Advance() == false);
+}
+
+/****************************************************************************
+ Function
+   Post
+ Description
+   posts an event to the service under test
+****************************************************************************/
+static bool Post(ES_EventType_t Type, uint16_t Param)
+{
+  ES_Event_t ThisEvent;
+
+  ThisEvent.EventType   = Type;
+  ThisEvent.EventParam  = Param;
+  return ES_PostToService(SERVICE, ThisEvent);
+}
+
+/*------------------------------- Footnotes -------------------------------*/
+/*------------------------------ End of file ------------------------------*/
@@ -0,0 +1,151 @@
+/****************************************************************************
+ Module
+   TestReplay.c
+
+ Description
+   Host test of the replay of captured inputs: the inputs in TestReplay.txt
+   reach the service in the same order and at the same virtual times on
+   every run, the live inputs are dropped, and the replay statistics count
+   exactly what happened.
+
+ Notes
+   Built with _INCLUDE_EVENT_REPLAY_. The replay exits from ES_Run once the
+   inputs run out, so the checks are made from an atexit function.
+   The service posts an ES_LOCK to itself for each key, which is not an
+   input so is kept, and starts a timer on the first one, whose timeout is
+   a live input so is dropped.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/20/26 05:55 ags     Began Coding
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#define _POSIX_C_SOURCE 200112L   // for setenv
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_Broadcast.h"
+#include "ES_HRTimers.h"
+#include "ES_Replay.h"
+#include "TestSupport.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define SERVICE       0
+#define MAX_SEEN      16
+
+/*------------------------------ Module Types -----------------------------*/
+// an event as the service saw it
+typedef struct
+{
+  ES_Event_t  Event;
+  uint32_t    Time;       /* uS of virtual time */
+}Seen_t;
+
+/*---------------------------- Module Functions ---------------------------*/
+static ES_Event_t RunReplay(ES_Event_t ThisEvent);
+static void CheckReplay(void);
+
+/*---------------------------- Module Variables ---------------------------*/
+// what the service should see from TestReplay.txt
+static const Seen_t Expected[] =
+{
+  { { ES_NEW_KEY, 'a' }, 1000 },
+  { { ES_NEW_KEY, 'b' }, 1000 },
+  { { ES_LOCK, 'a' }, 1000 },
+  { { ES_LOCK, 'b' }, 1000 },
+  { { ES_LOCK, 1 }, 2500 },
+  { { ES_UNLOCK, 2 }, 2500 },
+  { { ES_NEW_KEY, 'c' }, 400000 },
+  { { ES_LOCK, 'c' }, 400000 }
+};
+
+static Seen_t   Seen[MAX_SEEN];
+static uint8_t  NumSeen = 0;
+
+/*------------------------------ Module Code ------------------------------*/
+int main(void)
+{
+  setenv("ES_REPLAY_FILE", "TestReplay.txt", 1);
+  atexit(CheckReplay);
+  TEST_CHECK(ES_Initialize(ES_Timer_RATE_1mS) == Success);
+  TEST_CHECK(ES_Broadcast_Subscribe(SERVICE) == true);
+  TestSupport_SetRunFunc(RunReplay);
+  ES_Run();
+  // the replay should have exited from ES_Run
+  TEST_CHECK(false);
+  return TestSupport_Result("TestReplay");
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+/****************************************************************************
+ Function
+   RunReplay
+ Description
+   notes each event with the time that it came, and answers each key with
+   an ES_LOCK
+****************************************************************************/
+static ES_Event_t RunReplay(ES_Event_t ThisEvent)
+{
+  ES_Event_t ReturnEvent = { ES_NO_EVENT, 0 };
+
+  if (NumSeen < MAX_SEEN)
+  {
+    Seen[NumSeen].Event = ThisEvent;
+    Seen[NumSeen].Time  = ES_HRTimer_GetTime();
+    NumSeen++;
+  }
+  if (ThisEvent.EventType == ES_NEW_KEY)
+  {
+    if (ThisEvent.EventParam == 'a')
+    {
+      ES_Timer_InitTimer(SERVICE0_TIMER, 5);
+    }
+    ThisEvent.EventType = ES_LOCK;
+    ES_PostToService(SERVICE, ThisEvent);
+  }
+  return ReturnEvent;
+}
+
+/****************************************************************************
+ Function
+   CheckReplay
+ Description
+   at exit, compares what the service saw and the replay statistics with
+   what TestReplay.txt should give, and exits with the result
+****************************************************************************/
+static void CheckReplay(void)
+{
+  ES_ReplayStats_t        Stats;
+  ES_ReplayServiceStats_t ServiceStats;
+  uint8_t                 i;
+
+  TEST_CHECK(NumSeen == ARRAY_SIZE(Expected));
+  for (i = 0; (i < NumSeen) && (i < ARRAY_SIZE(Expected)); i++)
+  {
+    TEST_CHECK(TestSupport_IsEvent(Seen[i].Event,
+        Expected[i].Event.EventType, Expected[i].Event.EventParam));
+    TEST_CHECK(Seen[i].Time == Expected[i].Time);
+  }
+
+  ES_Replay_GetStats(&Stats);
+  TEST_CHECK(Stats.Inputs == 5);
+  TEST_CHECK(Stats.InputsDropped == 0);
+  TEST_CHECK(Stats.Dispatches == ARRAY_SIZE(Expected));
+  TEST_CHECK(Stats.Responses == 3);
+  TEST_CHECK(Stats.LastInputTime == 400000);
+  TEST_CHECK(ES_Replay_GetService(SERVICE, &ServiceStats) == true);
+  TEST_CHECK(ServiceStats.Dispatches == ARRAY_SIZE(Expected));
+  TEST_CHECK(ServiceStats.QueuePeak == 2);
+
+  _exit(TestSupport_Result("TestReplay"));
+}
+
+/*------------------------------- Footnotes -------------------------------*/
+/*------------------------------ End of file ------------------------------*/
@@ -0,0 +1,387 @@
+/****************************************************************************
+ Module
+   TestSupport.c
+
+ Description
+   The support shared by the host tests: the checks, and a service 0 that
+   stands in for TestHarnessService0, so that the tests run against the
+   default ES_Configure.h.
+
+ Notes
+   By default service 0 logs the events that it is given, see
+   TestSupport_Drain. A test may give it a run function of its own instead.
+   Its init function posts nothing, so a test starts with an empty queue.
+   The tests built with ThreeServicesConfig.h have services 1 and 2 as
+   well, which only log the events they are given, see TestSupport_GetLog.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/20/26 07:19 ags     TestSupport_Result flushes the output
+ 10/20/26 06:58 ags     added the stand-ins for services 1 and 2
+ 10/20/26 05:20 ags     Began Coding
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include "TestSupport.h"
+#include "TestHarnessService0.h"
+
+#include <stdio.h>
+
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_Port.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+// the parameter of the event that TestSupport_Drain puts behind the others
+#define DRAIN_END_PARAM 0xD0E5
+
+// the events that services 1 and 2 can log in each drain
+#define SERVICE_LOG_SIZE 8
+
+/*---------------------------- Module Functions ---------------------------*/
+#if NUM_SERVICES > 1
+static void LogServiceEvent(uint8_t WhichService, ES_Event_t ThisEvent);
+#endif
+
+/*---------------------------- Module Variables ---------------------------*/
+static uint8_t      MyPriority;
+static pTestRunFunc RunFunc = 0;
+static unsigned     NumChecks = 0;
+static unsigned     NumFailed = 0;
+
+// where the logging run function puts the events
+static ES_Event_t   *pLog;
+static uint8_t      LogSize;
+static uint8_t      LogCount;
+
+#if NUM_SERVICES > 1
+// where services 1 and up log their events, index 0 is not used
+static ES_Event_t   ServiceLog[NUM_SERVICES][SERVICE_LOG_SIZE];
+static uint8_t      ServiceLogCount[NUM_SERVICES];
+#endif
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+   TestSupport_Check
+ Parameters
+   bool Passed, the result of the check
+   const char *pText, the condition checked
+   const char *pFile, int Line, where the check is
+ Returns
+   None.
+ Description
+   counts the check, and prints it if it failed
+ Author
+   ags, 10/20/26 05:21
+****************************************************************************/
+void TestSupport_Check(bool Passed, const char *pText, const char *pFile,
+    int Line)
+{
+  NumChecks++;
+  if (Passed == false)
+  {
+    NumFailed++;
+    printf("%s:%d: check failed: %s\n", pFile, Line, pText);
+  }
+}
+
+/****************************************************************************
+ Function
+   TestSupport_Result
+ Parameters
+   const char *pName, the name of the test
+ Returns
+   int, the exit status for the test, 0 if every check passed
+ Description
+   prints the number of checks and of failures
+ Notes
+   flushes the output, as the tests that check at exit leave with _exit
+ Author
+   ags, 10/20/26 05:22
+****************************************************************************/
+int TestSupport_Result(const char *pName)
+{
+  printf("%s: %u checks, %u failed\n", pName, NumChecks, NumFailed);
+  fflush(stdout);
+  return ((NumFailed == 0) && (NumChecks != 0)) ? 0 : 1;
+}
+
+/****************************************************************************
+ Function
+   TestSupport_IsEvent
+ Parameters
+   ES_Event_t ThisEvent, the event to check
+   ES_EventType_t Type, uint16_t Param, what it should be
+ Returns
+   bool, true if the type and the parameter are both as expected
+ Description
+   compares an event with what was expected, printing it if it differs
+ Author
+   ags, 10/20/26 05:45
+****************************************************************************/
+bool TestSupport_IsEvent(ES_Event_t ThisEvent, ES_EventType_t Type,
+    uint16_t Param)
+{
+  if ((ThisEvent.EventType != Type) || (ThisEvent.EventParam != Param))
+  {
+    printf("event: %d(%u), expected %d(%u)\n", (int)ThisEvent.EventType,
+        (unsigned)ThisEvent.EventParam, (int)Type, (unsigned)Param);
+    return false;
+  }
+  return true;
+}
+
+/****************************************************************************
+ Function
+   TestSupport_SetRunFunc
+ Parameters
+   pTestRunFunc NewRunFunc, the run function for service 0, 0 for the log
+ Returns
+   None.
+ Author
+   ags, 10/20/26 05:23
+****************************************************************************/
+void TestSupport_SetRunFunc(pTestRunFunc NewRunFunc)
+{
+  RunFunc = NewRunFunc;
+}
+
+/****************************************************************************
+ Function
+   TestSupport_Drain
+ Parameters
+   ES_Event_t *pEvents, where to put the events
+   uint8_t MaxEvents, the room there
+ Returns
+   uint8_t, the number of events that service 0 was given
+ Description
+   runs ES_Run until service 0 has been given every event in its queue,
+   logging them in the order that they came
+ Notes
+   an end marker is posted behind the events, and ES_Run is stopped by
+   returning an error from the run function when it comes. So the queue
+   must have room for one more event. Service 0 is the lowest priority, so
+   the other services have been given all of their events by then.
+ Author
+   ags, 10/20/26 05:24
+****************************************************************************/
+uint8_t TestSupport_Drain(ES_Event_t *pEvents, uint8_t MaxEvents)
+{
+  ES_Event_t EndEvent;
+#if NUM_SERVICES > 1
+  uint8_t    i;
+#endif
+
+  pLog      = pEvents;
+  LogSize   = MaxEvents;
+  LogCount  = 0;
+#if NUM_SERVICES > 1
+  for (i = 0; i < NUM_SERVICES; i++)
+  {
+    ServiceLogCount[i] = 0;
+  }
+#endif
+  EndEvent.EventType  = ES_ERROR;
+  EndEvent.EventParam = DRAIN_END_PARAM;
+  if (ES_PostToService(MyPriority, EndEvent) == false)
+  {
+    return 0;
+  }
+  ES_Run();
+  return LogCount;
+}
+
+#ifdef _INCLUDE_VIRTUAL_TIME_
+/****************************************************************************
+ Function
+   TestSupport_Advance
+ Parameters
+   None.
+ Returns
+   bool, false if nothing was waiting for the time to pass
+ Description
+   moves the virtual clock on to the next deadline and runs the responses
+   that are due then, as ES_Run would once it was idle
+ Author
+   ags, 10/20/26 05:28
+****************************************************************************/
+bool TestSupport_Advance(void)
+{
+  bool Due;
+
+  Due = _HW_VirtualTime_Advance();
+  _HW_Process_Pending_Ints();
+  return Due;
+}
+#endif
+
+#if NUM_SERVICES > 1
+/****************************************************************************
+ Function
+   TestSupport_GetLog
+ Parameters
+   uint8_t WhichService, service 1 or up
+   ES_Event_t *pEvents, where to put the events
+   uint8_t MaxEvents, the room there
+ Returns
+   uint8_t, the number of events that the service was given in the last
+   TestSupport_Drain
+ Author
+   ags, 10/20/26 07:00
+****************************************************************************/
+uint8_t TestSupport_GetLog(uint8_t WhichService, ES_Event_t *pEvents,
+    uint8_t MaxEvents)
+{
+  uint8_t i;
+
+  if ((WhichService == 0) || (WhichService >= NUM_SERVICES))
+  {
+    return 0;
+  }
+  for (i = 0; (i < ServiceLogCount[WhichService]) && (i < MaxEvents); i++)
+  {
+    pEvents[i] = ServiceLog[WhichService][i];
+  }
+  return i;
+}
+
+/****************************************************************************
+ Function
+   TestSupport_InitService1, TestSupport_InitService2
+ Parameters
+   uint8_t : the priority of the service
+ Returns
+   bool, always true
+ Author
+   ags, 10/20/26 07:01
+****************************************************************************/
+bool TestSupport_InitService1(uint8_t Priority)
+{
+  (void)Priority;
+  return true;
+}
+
+bool TestSupport_InitService2(uint8_t Priority)
+{
+  (void)Priority;
+  return true;
+}
+
+/****************************************************************************
+ Function
+   TestSupport_RunService1, TestSupport_RunService2
+ Parameters
+   ES_Event_t : the event to process
+ Returns
+   ES_Event_t, always ES_NO_EVENT
+ Description
+   log the event for TestSupport_GetLog
+ Author
+   ags, 10/20/26 07:02
+****************************************************************************/
+ES_Event_t TestSupport_RunService1(ES_Event_t ThisEvent)
+{
+  ES_Event_t ReturnEvent = { ES_NO_EVENT, 0 };
+
+  LogServiceEvent(1, ThisEvent);
+  return ReturnEvent;
+}
+
+ES_Event_t TestSupport_RunService2(ES_Event_t ThisEvent)
+{
+  ES_Event_t ReturnEvent = { ES_NO_EVENT, 0 };
+
+  LogServiceEvent(2, ThisEvent);
+  return ReturnEvent;
+}
+#endif /* NUM_SERVICES > 1 */
+
+/****************************************************************************
+ Function
+   InitTestHarnessService0
+ Parameters
+   uint8_t : the priority of this service
+ Returns
+   bool, always true
+ Author
+   ags, 10/20/26 05:25
+****************************************************************************/
+bool InitTestHarnessService0(uint8_t Priority)
+{
+  MyPriority = Priority;
+  return true;
+}
+
+/****************************************************************************
+ Function
+   PostTestHarnessService0
+ Parameters
+   ES_Event_t ThisEvent, the event to post
+ Returns
+   bool false if the post operation failed, true otherwise
+ Author
+   ags, 10/20/26 05:26
+****************************************************************************/
+bool PostTestHarnessService0(ES_Event_t ThisEvent)
+{
+  return ES_PostToService(MyPriority, ThisEvent);
+}
+
+/****************************************************************************
+ Function
+   RunTestHarnessService0
+ Parameters
+   ES_Event_t : the event to process
+ Returns
+   ES_Event_t, ES_NO_EVENT, or ES_ERROR to stop ES_Run at the end of a
+   TestSupport_Drain
+ Author
+   ags, 10/20/26 05:27
+****************************************************************************/
+ES_Event_t RunTestHarnessService0(ES_Event_t ThisEvent)
+{
+  ES_Event_t ReturnEvent = { ES_NO_EVENT, 0 };
+
+  if ((ThisEvent.EventType == ES_ERROR) &&
+      (ThisEvent.EventParam == DRAIN_END_PARAM))
+  {
+    ReturnEvent = ThisEvent;
+  }
+  else if (RunFunc != 0)
+  {
+    ReturnEvent = RunFunc(ThisEvent);
+  }
+  else if (LogCount < LogSize)
+  {
+    pLog[LogCount++] = ThisEvent;
+  }
+  return ReturnEvent;
+}
+
+#if NUM_SERVICES > 1
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+/****************************************************************************
+ Function
+   LogServiceEvent
+ Parameters
+   uint8_t WhichService, the service given the event
+   ES_Event_t ThisEvent, the event
+ Returns
+   None.
+ Author
+   ags, 10/20/26 07:03
+****************************************************************************/
+static void LogServiceEvent(uint8_t WhichService, ES_Event_t ThisEvent)
+{
+  if (ServiceLogCount[WhichService] < SERVICE_LOG_SIZE)
+  {
+    ServiceLog[WhichService][ServiceLogCount[WhichService]++] = ThisEvent;
+  }
+}
+#endif
+
+/*------------------------------- Footnotes -------------------------------*/
+/*------------------------------ End of file ------------------------------*/
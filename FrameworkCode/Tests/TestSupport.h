@@ -0,0 +1,44 @@
+/****************************************************************************
+
+  Header file for the support shared by the host tests
+
+ ****************************************************************************/
+
+#ifndef TestSupport_H
+#define TestSupport_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "ES_Events.h"
+
+// checks a condition, counting and reporting it if it does not hold
+#define TEST_CHECK(Condition) \
+  TestSupport_Check((Condition), #Condition, __FILE__, __LINE__)
+
+// the run function that a test may give service 0 in place of the log
+typedef ES_Event_t (*pTestRunFunc)(ES_Event_t ThisEvent);
+
+// Public Function Prototypes
+
+void TestSupport_Check(bool Passed, const char *pText, const char *pFile,
+    int Line);
+int TestSupport_Result(const char *pName);
+void TestSupport_SetRunFunc(pTestRunFunc NewRunFunc);
+bool TestSupport_IsEvent(ES_Event_t ThisEvent, ES_EventType_t Type,
+    uint16_t Param);
+uint8_t TestSupport_Drain(ES_Event_t *pEvents, uint8_t MaxEvents);
+#ifdef _INCLUDE_VIRTUAL_TIME_
+bool TestSupport_Advance(void);
+#endif
+#if NUM_SERVICES > 1
+// services 1 and 2, for the tests built with ThreeServicesConfig.h
+bool TestSupport_InitService1(uint8_t Priority);
+ES_Event_t TestSupport_RunService1(ES_Event_t ThisEvent);
+bool TestSupport_InitService2(uint8_t Priority);
+ES_Event_t TestSupport_RunService2(ES_Event_t ThisEvent);
+uint8_t TestSupport_GetLog(uint8_t WhichService, ES_Event_t *pEvents,
+    uint8_t MaxEvents);
+#endif
+
+#endif /* TestSupport_H */
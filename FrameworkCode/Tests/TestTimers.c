@@ -0,0 +1,189 @@
+/****************************************************************************
+ Module
+   TestTimers.c
+
+ Description
+   Host test of the slack windows and the timer groups of ES_Timers.c
+
+ Notes
+   Built with _INCLUDE_VIRTUAL_TIME_, so that the ticks only pass when
+   TestSupport_Advance is called, and with TestTimersConfig.h, which gives
+   service 0 a second timer.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/20/26 06:48 ags     a coalesced timer can not be restarted
+ 10/20/26 06:18 ags     the slack is limited to what fits on top of the time
+ 10/20/26 06:14 ags     an unused timer can not join a group
+ 10/20/26 05:48 ags     Began Coding
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_Timers.h"
+#include "TestSupport.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define SERVICE       0
+#define GROUP         0
+
+/*---------------------------- Module Functions ---------------------------*/
+static void TestSlack(void);
+static void TestGroups(void);
+static uint16_t Elapsed(void);
+
+/*---------------------------- Module Variables ---------------------------*/
+static uint16_t Start;
+
+/*------------------------------ Module Code ------------------------------*/
+int main(void)
+{
+  TEST_CHECK(ES_Initialize(ES_Timer_RATE_1mS) == Success);
+
+  TestSlack();
+  TestGroups();
+  return TestSupport_Result("TestTimers");
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+/****************************************************************************
+ Function
+   TestSlack
+ Description
+   a timer with slack runs to the end of its window on its own, and goes
+   early along with another timer once it is inside the window, but never
+   before the time that it was set for
+****************************************************************************/
+static void TestSlack(void)
+{
+  ES_Event_t Events[4];
+
+  TEST_CHECK(ES_Timer_SetSlack(SERVICE0_TIMER, 10) == ES_Timer_OK);
+
+  // on its own
+  Start = ES_Timer_GetTime();
+  ES_Timer_InitTimer(SERVICE0_TIMER, 100);
+  TEST_CHECK(TestSupport_Advance() == true);
+  TEST_CHECK(Elapsed() == 110);
+  TEST_CHECK(TestSupport_Drain(Events, ARRAY_SIZE(Events)) == 1);
+  TEST_CHECK(TestSupport_IsEvent(Events[0], ES_TIMEOUT, SERVICE0_TIMER));
+
+  // the other timer runs out inside the window
+  Start = ES_Timer_GetTime();
+  ES_Timer_InitTimer(SERVICE0_TIMER, 100);
+  ES_Timer_InitTimer(SECOND_TIMER, 105);
+  TEST_CHECK(TestSupport_Advance() == true);
+  TEST_CHECK(Elapsed() == 105);
+  TEST_CHECK(TestSupport_Drain(Events, ARRAY_SIZE(Events)) == 2);
+  TEST_CHECK(TestSupport_IsEvent(Events[0], ES_TIMEOUT, SERVICE0_TIMER));
+  TEST_CHECK(TestSupport_IsEvent(Events[1], ES_TIMEOUT, SECOND_TIMER));
+  // its leftover slack is gone, so it can not be restarted, like any
+  // other timer that has expired
+  TEST_CHECK(ES_Timer_StartTimer(SERVICE0_TIMER) == ES_Timer_ERR);
+  TEST_CHECK(ES_Timer_StartTimer(SECOND_TIMER) == ES_Timer_ERR);
+
+  // and before it, so each goes on its own
+  Start = ES_Timer_GetTime();
+  ES_Timer_InitTimer(SERVICE0_TIMER, 100);
+  ES_Timer_InitTimer(SECOND_TIMER, 50);
+  TEST_CHECK(TestSupport_Advance() == true);
+  TEST_CHECK(Elapsed() == 50);
+  TEST_CHECK(TestSupport_Drain(Events, ARRAY_SIZE(Events)) == 1);
+  TEST_CHECK(TestSupport_IsEvent(Events[0], ES_TIMEOUT, SECOND_TIMER));
+  TEST_CHECK(TestSupport_Advance() == true);
+  TEST_CHECK(Elapsed() == 110);
+  TEST_CHECK(TestSupport_Drain(Events, ARRAY_SIZE(Events)) == 1);
+  TEST_CHECK(TestSupport_IsEvent(Events[0], ES_TIMEOUT, SERVICE0_TIMER));
+
+  // a long time, with more slack than fits on top of it, so that its
+  // window is cut short rather than opening before the time
+  TEST_CHECK(ES_Timer_SetSlack(SERVICE0_TIMER, 100) == ES_Timer_OK);
+  Start = ES_Timer_GetTime();
+  ES_Timer_InitTimer(SERVICE0_TIMER, 65500);
+  ES_Timer_InitTimer(SECOND_TIMER, 65450);
+  TEST_CHECK(TestSupport_Advance() == true);
+  TEST_CHECK(Elapsed() == 65450);
+  TEST_CHECK(TestSupport_Drain(Events, ARRAY_SIZE(Events)) == 1);
+  TEST_CHECK(TestSupport_IsEvent(Events[0], ES_TIMEOUT, SECOND_TIMER));
+  TEST_CHECK(TestSupport_Advance() == true);
+  TEST_CHECK(Elapsed() == UINT16_MAX);
+  TEST_CHECK(TestSupport_Drain(Events, ARRAY_SIZE(Events)) == 1);
+  TEST_CHECK(TestSupport_IsEvent(Events[0], ES_TIMEOUT, SERVICE0_TIMER));
+
+  // the slack that a running timer was set with stays with it
+  Start = ES_Timer_GetTime();
+  ES_Timer_InitTimer(SERVICE0_TIMER, 200);
+  TEST_CHECK(ES_Timer_SetSlack(SERVICE0_TIMER, 0) == ES_Timer_OK);
+  ES_Timer_InitTimer(SECOND_TIMER, 250);
+  TEST_CHECK(TestSupport_Advance() == true);
+  TEST_CHECK(Elapsed() == 250);
+  TEST_CHECK(TestSupport_Drain(Events, ARRAY_SIZE(Events)) == 2);
+  TEST_CHECK(TestSupport_IsEvent(Events[0], ES_TIMEOUT, SERVICE0_TIMER));
+  TEST_CHECK(TestSupport_IsEvent(Events[1], ES_TIMEOUT, SECOND_TIMER));
+}
+
+/****************************************************************************
+ Function
+   TestGroups
+ Description
+   stopping a group stops its timers and throws away their timeouts that
+   are still queued, leaving the other events alone
+****************************************************************************/
+static void TestGroups(void)
+{
+  ES_Event_t Events[4];
+  ES_Event_t ThisEvent;
+
+  TEST_CHECK(ES_Timer_AssignGroup(SERVICE0_TIMER, GROUP, SERVICE) ==
+      ES_Timer_OK);
+  TEST_CHECK(ES_Timer_AssignGroup(SECOND_TIMER, GROUP, SERVICE) ==
+      ES_Timer_OK);
+  // a group has only the one owner
+  TEST_CHECK(ES_Timer_AssignGroup(SECOND_TIMER, GROUP, SERVICE + 1) ==
+      ES_Timer_ERR);
+  // and only timers that are in use can join one
+  TEST_CHECK(ES_Timer_AssignGroup(0, GROUP + 1, SERVICE) == ES_Timer_ERR);
+  TEST_CHECK(ES_Timer_AssignGroup(SECOND_TIMER, GROUP + 1, NUM_SERVICES) ==
+      ES_Timer_ERR);
+  TEST_CHECK(ES_Timer_AssignGroup(SECOND_TIMER, NUM_TIMER_GROUPS, SERVICE) ==
+      ES_Timer_ERR);
+  TEST_CHECK(ES_Timer_StopGroup(NUM_TIMER_GROUPS) == ES_Timer_ERR);
+
+  // a timeout from the group waiting in the queue
+  ES_Timer_InitTimer(SERVICE0_TIMER, 10);
+  TEST_CHECK(TestSupport_Advance() == true);
+  // with events that are not from the group
+  ThisEvent.EventType   = ES_NEW_KEY;
+  ThisEvent.EventParam  = 'k';
+  ES_PostToService(SERVICE, ThisEvent);
+  ThisEvent.EventType   = ES_TIMEOUT;
+  ThisEvent.EventParam  = 3;
+  ES_PostToService(SERVICE, ThisEvent);
+
+  ES_Timer_InitTimer(SERVICE0_TIMER, 20);
+  ES_Timer_InitTimer(SECOND_TIMER, 20);
+  TEST_CHECK(ES_Timer_StopGroup(GROUP) == ES_Timer_OK);
+  TEST_CHECK(TestSupport_Drain(Events, ARRAY_SIZE(Events)) == 2);
+  TEST_CHECK(TestSupport_IsEvent(Events[0], ES_NEW_KEY, 'k'));
+  TEST_CHECK(TestSupport_IsEvent(Events[1], ES_TIMEOUT, 3));
+  // and neither timer is running
+  TEST_CHECK(ES_Timer_GetTicksToNext() == 0);
+  TEST_CHECK(TestSupport_Advance() == false);
+}
+
+/****************************************************************************
+ Function
+   Elapsed
+ Description
+   the ticks since Start
+****************************************************************************/
+static uint16_t Elapsed(void)
+{
+  return (uint16_t)(ES_Timer_GetTime() - Start);
+}
+
+/*------------------------------- Footnotes -------------------------------*/
+/*------------------------------ End of file ------------------------------*/
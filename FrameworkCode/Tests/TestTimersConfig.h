@@ -0,0 +1,19 @@
+/****************************************************************************
+
+  The configuration for TestTimers: the default ES_Configure.h, with a
+  second tick timer posting to service 0, so that the coalescing of timers
+  and the timer groups can be tested
+
+ ****************************************************************************/
+
+#ifndef TestTimersConfig_H
+#define TestTimersConfig_H
+
+#include "ES_Configure.h"
+
+#undef TIMER14_RESP_FUNC
+#define TIMER14_RESP_FUNC PostTestHarnessService0
+
+#define SECOND_TIMER 14
+
+#endif /* TestTimersConfig_H */
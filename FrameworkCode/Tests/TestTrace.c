@@ -0,0 +1,158 @@
+/****************************************************************************
+ Module
+   TestTrace.c
+
+ Description
+   Host test of the binary trace of ES_Trace.c: the inputs, the runs and
+   the timeouts each leave a record with the right kind, service, event
+   and gap, a gap too long for a record is carried by an ES_TRACE_TIME
+   record, and the records that do not fit in the ring are counted in an
+   ES_TRACE_LOST record.
+
+ Notes
+   Built with _INCLUDE_TRACE_ and _INCLUDE_VIRTUAL_TIME_, so the gaps are
+   exact. The ring holds 8 records, see TestTraceConfig.h.
+   The host trace file is only complete once the port has flushed it at
+   exit, so the file is checked from an atexit function, registered
+   before ES_Initialize so that it runs after the flush.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/20/26 07:19 ags     Began Coding
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_Trace.h"
+#include "TestSupport.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define SERVICE       0
+#define WAIT_mS       100
+// the gap of the timeout, less the upper 16 bits in the ES_TRACE_TIME
+#define WAIT_GAP      ((uint16_t)(WAIT_mS * 1000UL))
+#define WAIT_HIGH     ((uint16_t)((WAIT_mS * 1000UL) >> 16))
+// the records made straight into the ring, 2 more than it holds
+#define NUM_DIRECT    (TRACE_RING_SIZE + 2)
+#define MAX_RECORDS   32
+
+// the first byte of a record
+#define HEADER(Kind, Service) ((uint8_t)(((Kind) << 4) | (Service)))
+
+/*------------------------------ Module Types -----------------------------*/
+// a record as it should be in the file
+typedef struct
+{
+  uint8_t   Header;
+  uint8_t   Type;
+  uint16_t  Gap;
+  uint16_t  Param;
+}Record_t;
+
+/*---------------------------- Module Functions ---------------------------*/
+static void CheckTrace(void);
+
+/*---------------------------- Module Variables ---------------------------*/
+static const Record_t Expected[] =
+{
+  { HEADER(ES_TRACE_SYNC, 0), 0x5A, 0, 0xA55A },
+  { HEADER(ES_TRACE_INPUT, SERVICE), ES_LOCK, 0, 1 },
+  { HEADER(ES_TRACE_TIME, 0), 0, 0, WAIT_HIGH },
+  { HEADER(ES_TRACE_TIMEOUT, 0), ES_TIMEOUT, WAIT_GAP, SERVICE0_TIMER },
+  { HEADER(ES_TRACE_INPUT, SERVICE), ES_TIMEOUT, 0, SERVICE0_TIMER },
+  // the end marker of TestSupport_Drain
+  { HEADER(ES_TRACE_INPUT, SERVICE), ES_ERROR, 0, 0xD0E5 },
+  { HEADER(ES_TRACE_RUN_BEGIN, SERVICE), ES_LOCK, 0, 1 },
+  { HEADER(ES_TRACE_RUN_END, SERVICE), ES_LOCK, 0, 1 },
+  { HEADER(ES_TRACE_RUN_BEGIN, SERVICE), ES_TIMEOUT, 0, SERVICE0_TIMER },
+  { HEADER(ES_TRACE_RUN_END, SERVICE), ES_TIMEOUT, 0, SERVICE0_TIMER },
+  // the end marker stops ES_Run, so it has no RUN_END
+  { HEADER(ES_TRACE_RUN_BEGIN, SERVICE), ES_ERROR, 0, 0xD0E5 },
+  // the records made straight into the ring, as many as it holds
+  { HEADER(ES_TRACE_POST, 1), ES_NEW_KEY, 0, 0 },
+  { HEADER(ES_TRACE_POST, 1), ES_NEW_KEY, 0, 1 },
+  { HEADER(ES_TRACE_POST, 1), ES_NEW_KEY, 0, 2 },
+  { HEADER(ES_TRACE_POST, 1), ES_NEW_KEY, 0, 3 },
+  { HEADER(ES_TRACE_POST, 1), ES_NEW_KEY, 0, 4 },
+  { HEADER(ES_TRACE_POST, 1), ES_NEW_KEY, 0, 5 },
+  { HEADER(ES_TRACE_POST, 1), ES_NEW_KEY, 0, 6 },
+  { HEADER(ES_TRACE_POST, 1), ES_NEW_KEY, 0, 7 },
+  { HEADER(ES_TRACE_LOST, 0), 0, 0, NUM_DIRECT - TRACE_RING_SIZE },
+  { HEADER(ES_TRACE_POST, 1), ES_NEW_KEY, 0, NUM_DIRECT }
+};
+
+/*------------------------------ Module Code ------------------------------*/
+int main(void)
+{
+  ES_Event_t  ThisEvent = { ES_LOCK, 1 };
+  ES_Event_t  Events[4];
+  uint8_t     i;
+
+  atexit(CheckTrace);
+  TEST_CHECK(ES_Initialize(ES_Timer_RATE_1mS) == Success);
+
+  TEST_CHECK(ES_PostToService(SERVICE, ThisEvent) == true);
+  TEST_CHECK(ES_Timer_InitTimer(SERVICE0_TIMER, WAIT_mS) == ES_Timer_OK);
+  TEST_CHECK(TestSupport_Advance() == true);
+  TEST_CHECK(TestSupport_Drain(Events, ARRAY_SIZE(Events)) == 2);
+
+  // with the ring empty, more records than it holds, then one more once
+  // it has been drained
+  ES_Trace_Drain();
+  ThisEvent.EventType = ES_NEW_KEY;
+  for (i = 0; i < NUM_DIRECT; i++)
+  {
+    ThisEvent.EventParam = i;
+    ES_Trace_Record(ES_TRACE_POST, 1, ThisEvent);
+  }
+  ES_Trace_Drain();
+  ThisEvent.EventParam = NUM_DIRECT;
+  ES_Trace_Record(ES_TRACE_POST, 1, ThisEvent);
+  // CheckTrace gives the result
+  return 0;
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+/****************************************************************************
+ Function
+   CheckTrace
+ Description
+   at exit, reads back the trace file and compares it with Expected, and
+   exits with the result
+****************************************************************************/
+static void CheckTrace(void)
+{
+  FILE      *TraceFile;
+  uint8_t   Records[MAX_RECORDS][ES_TRACE_RECORD_SIZE];
+  size_t    NumRecords = 0;
+  uint8_t   i;
+
+  TraceFile = fopen(getenv("ES_TRACE_FILE"), "rb");
+  TEST_CHECK(TraceFile != NULL);
+  if (TraceFile != NULL)
+  {
+    NumRecords = fread(Records, ES_TRACE_RECORD_SIZE, MAX_RECORDS, TraceFile);
+    fclose(TraceFile);
+  }
+
+  TEST_CHECK(NumRecords == ARRAY_SIZE(Expected));
+  for (i = 0; (i < NumRecords) && (i < ARRAY_SIZE(Expected)); i++)
+  {
+    TEST_CHECK(Records[i][0] == Expected[i].Header);
+    TEST_CHECK(Records[i][1] == Expected[i].Type);
+    TEST_CHECK((Records[i][2] | (Records[i][3] << 8)) == Expected[i].Gap);
+    TEST_CHECK((Records[i][4] | (Records[i][5] << 8)) == Expected[i].Param);
+  }
+
+  _exit(TestSupport_Result("TestTrace"));
+}
+
+/*------------------------------- Footnotes -------------------------------*/
+/*------------------------------ End of file ------------------------------*/
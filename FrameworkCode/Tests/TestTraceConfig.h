@@ -0,0 +1,16 @@
+/****************************************************************************
+
+  The configuration for TestTrace: a trace ring of 8 records, so that it
+  is quick to fill
+
+ ****************************************************************************/
+
+#ifndef TestTraceConfig_H
+#define TestTraceConfig_H
+
+#include "ES_Configure.h"
+
+#undef TRACE_RING_SIZE
+#define TRACE_RING_SIZE 8
+
+#endif /* TestTraceConfig_H */
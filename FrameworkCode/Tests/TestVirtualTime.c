@@ -0,0 +1,129 @@
+/****************************************************************************
+ Module
+   TestVirtualTime.c
+
+ Description
+   Host test of the virtual clock: an hour of a minute tick timer and a
+   700mS high resolution timer, run through ES_Run, comes out on exactly
+   the deadlines and takes a moment to run. The load stats charge the
+   waits for the deadlines as idle. High resolution times too long to
+   compare as a signed difference are refused.
+
+ Notes
+   Built with _INCLUDE_VIRTUAL_TIME_ and _INCLUDE_LOAD_STATS_.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/20/26 06:51 ags     checks the HR_TIMER_MAX_TIME limit
+ 10/20/26 06:31 ags     checks that the hour is charged as idle
+ 10/20/26 05:52 ags     Began Coding
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <time.h>
+
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_HRTimers.h"
+#include "ES_Load.h"
+#include "TestSupport.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define ONE_MINUTE    60000UL     // ticks
+#define ONE_HOUR_uS   3600000000UL
+#define SHORT_uS      700000UL
+#define MAX_CPU_SECS  10
+#define MAX_LOAD      10          // 1%, in 0.1%
+
+/*---------------------------- Module Functions ---------------------------*/
+static ES_Event_t RunHour(ES_Event_t ThisEvent);
+
+/*---------------------------- Module Variables ---------------------------*/
+static uint16_t Minutes = 0;
+static uint32_t Shorts = 0;
+static bool     OffDeadline = false;
+static uint32_t Start;
+
+/*------------------------------ Module Code ------------------------------*/
+int main(void)
+{
+  clock_t         CPUStart;
+  ES_LoadStats_t  Load;
+
+  TEST_CHECK(ES_Initialize(ES_Timer_RATE_1mS) == Success);
+  TestSupport_SetRunFunc(RunHour);
+
+  // longer than this would look like a deadline already passed
+  TEST_CHECK(ES_HRTimer_SetTimer(SERVICE0_HR_TIMER, HR_TIMER_MAX_TIME + 1) ==
+      ES_Timer_ERR);
+  TEST_CHECK(ES_HRTimer_InitTimer(SERVICE0_HR_TIMER, UINT32_MAX) ==
+      ES_Timer_ERR);
+  TEST_CHECK(ES_HRTimer_SetTimer(SERVICE0_HR_TIMER, HR_TIMER_MAX_TIME) ==
+      ES_Timer_OK);
+
+  CPUStart  = clock();
+  Start     = ES_HRTimer_GetTime();
+  ES_Timer_InitTimer(SERVICE0_TIMER, ONE_MINUTE);
+  ES_HRTimer_InitTimer(SERVICE0_HR_TIMER, SHORT_uS);
+
+  // RunHour stops it after the sixtieth minute
+  TEST_CHECK(ES_Run() == FailedRun);
+  TEST_CHECK(Minutes == 60);
+  TEST_CHECK(ES_HRTimer_GetTime() - Start == ONE_HOUR_uS);
+  TEST_CHECK(Shorts == ONE_HOUR_uS / SHORT_uS);
+  TEST_CHECK(OffDeadline == false);
+  TEST_CHECK((clock() - CPUStart) < (clock_t)(MAX_CPU_SECS * CLOCKS_PER_SEC));
+
+  // the time between the deadlines was spent idle
+  ES_Load_GetStats(&Load);
+  TEST_CHECK(Load.Time[ES_LOAD_IDLE] > (ONE_HOUR_uS - ONE_MINUTE * 1000UL));
+  TEST_CHECK(Load.Load < MAX_LOAD);
+  TEST_CHECK(Load.PeakWindow < MAX_LOAD);
+  return TestSupport_Result("TestVirtualTime");
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+/****************************************************************************
+ Function
+   RunHour
+ Description
+   restarts both timers each time they run out, noting any timeout that
+   does not come exactly on its deadline, until an hour has passed
+****************************************************************************/
+static ES_Event_t RunHour(ES_Event_t ThisEvent)
+{
+  ES_Event_t  ReturnEvent = { ES_NO_EVENT, 0 };
+  uint32_t    Now = ES_HRTimer_GetTime() - Start;
+
+  if (ThisEvent.EventType == ES_TIMEOUT)
+  {
+    Minutes++;
+    if (Now != Minutes * ONE_MINUTE * 1000UL)
+    {
+      OffDeadline = true;
+    }
+    if (Minutes < 60)
+    {
+      ES_Timer_InitTimer(SERVICE0_TIMER, ONE_MINUTE);
+    }
+    else
+    {
+      ReturnEvent.EventType = ES_ERROR;
+    }
+  }
+  else if (ThisEvent.EventType == ES_SHORT_TIMEOUT)
+  {
+    Shorts++;
+    if (Now != Shorts * SHORT_uS)
+    {
+      OffDeadline = true;
+    }
+    ES_HRTimer_InitTimer(SERVICE0_HR_TIMER, SHORT_uS);
+  }
+  return ReturnEvent;
+}
+
+/*------------------------------- Footnotes -------------------------------*/
+/*------------------------------ End of file ------------------------------*/
@@ -0,0 +1,30 @@
+/****************************************************************************
+
+  The services for the tests of the posts to more than one service: the
+  default ES_Configure.h, with services 1 and 2 added. They are stand-ins
+  in TestSupport.c that log the events that they are given, see
+  TestSupport_GetLog. The <Test>Config.h of such a test includes this.
+
+ ****************************************************************************/
+
+#ifndef ThreeServicesConfig_H
+#define ThreeServicesConfig_H
+
+#include "ES_Configure.h"
+
+#undef NUM_SERVICES
+#define NUM_SERVICES 3
+
+#define SERV_1_HEADER "TestSupport.h"
+#define SERV_1_INIT TestSupport_InitService1
+#define SERV_1_RUN TestSupport_RunService1
+#define SERV_1_QUEUE_SIZE 3
+#define SERV_1_BUDGET 0
+
+#define SERV_2_HEADER "TestSupport.h"
+#define SERV_2_INIT TestSupport_InitService2
+#define SERV_2_RUN TestSupport_RunService2
+#define SERV_2_QUEUE_SIZE 3
+#define SERV_2_BUDGET 0
+
+#endif /* ThreeServicesConfig_H */
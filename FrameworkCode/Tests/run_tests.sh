@@ -0,0 +1,116 @@
+#!/bin/sh
+#
+# Builds each host test against the framework, with the host port
+# (ES_HostPort.c) and the default ES_Configure.h, and runs it.
+#
+# usage: Tests/run_tests.sh [test name ...]
+#   CC and CFLAGS may be set in the environment. The programs are built in
+#   Tests/_build. The exit status is the number of tests that failed.
+#
+
+TESTS_DIR=$(cd "$(dirname "$0")" && pwd)
+FRAMEWORK_DIR=$(dirname "$TESTS_DIR")
+BUILD_DIR="$TESTS_DIR/_build"
+CC=${CC:-cc}
+WARNINGS="-Wall -Wextra -Werror"
+
+# the framework sources that every test is linked with
+FRAMEWORK_SOURCES="ES_HostPort.c ES_Framework.c ES_Queue.c ES_Timers.c
+  ES_HRTimers.c ES_LookupTables.c ES_PostList.c ES_CheckEvents.c
+  ES_DeferRecall.c EventCheckers.c ES_InputCapture.c ES_Broadcast.c
+  ES_HSM.c"
+
+# each test: its name, the extra framework sources and the defines. A test
+# that needs more than the default configuration has a <Test>Config.h,
+# which is included ahead of everything else. It includes ES_Configure.h
+# and then changes what it needs.
+test_options()
+{
+  case "$1" in
+    TestHSM)          echo "" ;;
+    TestQueue)        echo "-D_INCLUDE_VIRTUAL_TIME_" ;;
+    TestTimers)       echo "-D_INCLUDE_VIRTUAL_TIME_" ;;
+    TestVirtualTime)  echo "ES_Load.c -D_INCLUDE_VIRTUAL_TIME_
+                        -D_INCLUDE_LOAD_STATS_" ;;
+    TestReplay)       echo "ES_Replay.c -D_INCLUDE_EVENT_REPLAY_" ;;
+    TestLoad)         echo "ES_Load.c -D_INCLUDE_LOAD_STATS_" ;;
+    TestCapture)      echo "-D_INCLUDE_INPUT_CAPTURE_ -D_INCLUDE_VIRTUAL_TIME_" ;;
+    TestPublish)      echo "" ;;
+    TestMulticast)    echo "" ;;
+    TestDistLists)    echo "" ;;
+    TestBroadcast)    echo "" ;;
+    TestProfiler)     echo "ES_Profiler.c -D_INCLUDE_PROFILER_" ;;
+    TestLatency)      echo "ES_Latency.c -D_INCLUDE_LATENCY_STATS_
+                        -D_INCLUDE_VIRTUAL_TIME_" ;;
+    TestTrace)        echo "ES_Trace.c -D_INCLUDE_TRACE_
+                        -D_INCLUDE_VIRTUAL_TIME_" ;;
+    TestByteDebug)    echo "-D_INCLUDE_VIRTUAL_TIME_" ;;
+    TestPCSample)     echo "ES_PCSample.c -D_INCLUDE_PC_SAMPLER_" ;;
+    TestEventStats)   echo "ES_EventStats.c -D_INCLUDE_EVENT_STATS_
+                        -D_INCLUDE_VIRTUAL_TIME_" ;;
+    TestBudget)       echo "-D_INCLUDE_RUN_BUDGETS_ -D_INCLUDE_WATCHDOG_" ;;
+    TestInstrumented) echo "ES_Profiler.c ES_Latency.c ES_Trace.c ES_Load.c
+                        ES_PCSample.c ES_EventStats.c -D_INCLUDE_PROFILER_
+                        -D_INCLUDE_LATENCY_STATS_ -D_INCLUDE_TRACE_
+                        -D_INCLUDE_LOAD_STATS_ -D_INCLUDE_PC_SAMPLER_
+                        -D_INCLUDE_EVENT_STATS_ -D_INCLUDE_RUN_BUDGETS_
+                        -D_INCLUDE_INPUT_CAPTURE_ -D_INCLUDE_WATCHDOG_" ;;
+    *)                return 1 ;;
+  esac
+}
+
+ALL_TESTS="TestHSM TestQueue TestTimers TestVirtualTime TestReplay TestLoad
+  TestCapture TestPublish TestMulticast TestDistLists
+  TestBroadcast TestProfiler TestLatency TestTrace TestByteDebug
+  TestPCSample TestEventStats TestBudget TestInstrumented"
+
+mkdir -p "$BUILD_DIR" || exit 1
+Failed=0
+for Test in ${*:-$ALL_TESTS}
+do
+  if ! Options=$(test_options "$Test")
+  then
+    echo "$Test: no such test"
+    Failed=$((Failed + 1))
+    continue
+  fi
+  Sources=""
+  Defines=""
+  if [ -f "$TESTS_DIR/${Test}Config.h" ]
+  then
+    Defines="-include $TESTS_DIR/${Test}Config.h"
+  fi
+  for Option in $FRAMEWORK_SOURCES $Options
+  do
+    case "$Option" in
+      -*) Defines="$Defines $Option" ;;
+      *)  Sources="$Sources $FRAMEWORK_DIR/Source/$Option" ;;
+    esac
+  done
+  if ! $CC -std=c99 $WARNINGS -D_ES_HOST_PORT_ $Defines $CFLAGS \
+      -I"$FRAMEWORK_DIR/Headers" -I"$TESTS_DIR" \
+      "$TESTS_DIR/$Test.c" "$TESTS_DIR/TestSupport.c" $Sources \
+      -o "$BUILD_DIR/$Test"
+  then
+    echo "$Test: build failed"
+    Failed=$((Failed + 1))
+    continue
+  fi
+  # the tests that read files find them next to the test source, and the
+  # files that the host port writes go in the build directory
+  if ! (cd "$TESTS_DIR" &&
+      ES_TRACE_FILE="$BUILD_DIR/$Test.trace" \
+      ES_PCSAMPLE_FILE="$BUILD_DIR/$Test.pcsample" \
+      ES_BYTE_DEBUG_FILE="$BUILD_DIR/$Test.bytedebug" \
+      "$BUILD_DIR/$Test" < /dev/null)
+  then
+    Failed=$((Failed + 1))
+  fi
+done
+if [ $Failed -eq 0 ]
+then
+  echo "all tests passed"
+else
+  echo "$Failed test(s) failed"
+fi
+exit $Failed
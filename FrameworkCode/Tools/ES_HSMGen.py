@@ -0,0 +1,766 @@
+#!/usr/bin/env python3
+"""
+ Module
+     ES_HSMGen.py
+
+ Description
+     Generates a hierarchical state machine service, run by the ES_HSM
+     engine, from a JSON description of the statechart. Writes <Name>.c
+     with the const state tables, the event maps and the Init, Post, Run
+     and Query functions, <Name>.h with the state enum and the prototypes,
+     and optionally a Graphviz DOT diagram of the machine.
+
+ Notes
+     usage: ES_HSMGen.py Machine.json [-s SourceDir] [-i HeaderDir]
+                [-c Headers/ES_Configure.h] [--dot Machine.dot]
+
+     The description looks like (see TableHSMTemplate.json):
+       {
+         "name": "DoorSM",
+         "prefix": "DOOR_",
+         "initial": "Closed",
+         "states": {
+           "Closed": {
+             "initial": "Locked",
+             "entry": "EnterClosed",
+             "states": {
+               "Locked":   { "transitions": [
+                 { "event": "ES_UNLOCK", "target": "Unlocked",
+                   "guard": "CodeIsGood", "action": "ClearCode" } ] },
+               "Unlocked": {}
+             },
+             "transitions": [ { "event": "ES_NEW_KEY", "action": "AddKey" } ]
+           },
+           "Open": {}
+         }
+       }
+     A state may have "entry", "exit" and "during" functions, nested
+     "states" (with an "initial" one, the first if not given) and a list of
+     "transitions". A transition with no "target" is internal, it runs its
+     action without leaving the state.
+     An orthogonal state has "regions" in place of "states". Each region is
+     described like a state, with its own "states" and "initial", and gets
+     a state of its own in the enum. All of the regions are active together.
+     A transition may not go from one region of an orthogonal state to
+     another.
+     A state may "defer" a list of event types while it is active. The
+     machine is then given a deferral queue of "defer_queue_size" events
+     (default 4). The deferred types must be among the first 32 of the
+     ES_EventType_t enum, which is read from ES_Configure.h, by default the
+     one in the Headers directory next to this one. An event that does not
+     fit in the full deferral queue is lost. The run function counts these,
+     and <Name>DeferralOverflows returns the count, rather than stopping
+     ES_Run with an error.
+     A state may keep "history", "shallow" or "deep", and then resumes it
+     whenever it is the target of a transition.
+     The state enum constants are the prefix (default the name and '_')
+     followed by the state name.
+     The functions named in the description are written by hand, in another
+     file that includes <Name>.h, which declares them.
+     The LCA of every transition is worked out here, and each state with
+     transitions gets an event map, so the engine goes straight from the
+     event type to the transitions on it.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/20/26 06:44 ags     count the events lost to a full deferral queue,
+                        rather than returning ES_ERROR, which stops ES_Run
+ 10/20/26 06:29 ags     the run function reports a full deferral queue, the
+                        deferred types are checked against the event enum,
+                        and the functions have header blocks
+ 10/19/26 22:52 ags     added shallow and deep history
+ 10/19/26 22:36 ags     added per-state deferral
+ 10/19/26 22:12 ags     added orthogonal regions
+ 10/19/26 21:12 ags     Began Coding
+"""
+
+import argparse
+import json
+import os
+import re
+import sys
+
+# must match ES_HSM_MAX_DEPTH in ES_HSM.h
+MAX_DEPTH = 8
+# must match ES_HSM_MAX_REGIONS in ES_HSM.h
+MAX_REGIONS = 4
+# must match ES_HSM_MAX_HISTORY in ES_HSM.h
+MAX_HISTORY = 4
+# the DeferMask is a uint32_t of ES_TYPE_MASK() bits
+MAX_DEFER_TYPE = 31
+# ES_HSM_ROOT etc. take the top of the uint8_t range
+MAX_STATES = 0xFC
+MAX_TRANSITIONS = 0xFF
+
+HISTORY_KINDS = {None: 'ES_HSM_HISTORY_NONE',
+                 'shallow': 'ES_HSM_HISTORY_SHALLOW',
+                 'deep': 'ES_HSM_HISTORY_DEEP'}
+
+ROOT = None
+
+
+class GenError(Exception):
+    pass
+
+
+class Transition(object):
+    def __init__(self, source, desc):
+        if 'event' not in desc:
+            raise GenError('a transition of %s has no event' % source.name)
+        self.source = source
+        self.event = desc['event']
+        self.guard = desc.get('guard')
+        self.action = desc.get('action')
+        self.target_name = desc.get('target')
+        self.target = None
+        self.lca = None
+
+
+class State(object):
+    def __init__(self, name, desc, parent):
+        self.name = name
+        self.parent = parent
+        self.depth = 1 if parent is None else parent.depth + 1
+        self.entry = desc.get('entry')
+        self.exit = desc.get('exit')
+        self.during = desc.get('during')
+        self.children = []
+        self.initial_name = desc.get('initial')
+        self.initial = None
+        self.transitions = [Transition(self, t)
+                            for t in desc.get('transitions', [])]
+        self.index = None
+        self.orthogonal = 'regions' in desc
+        self.defer = desc.get('defer', [])
+        self.history = desc.get('history')
+        self.history_slot = 0
+        if self.history not in HISTORY_KINDS:
+            raise GenError('the history of %s must be "shallow" or "deep"'
+                           % name)
+        self.is_region = False
+        self.region = None
+        self.sub_region = None
+        if self.orthogonal and 'states' in desc:
+            raise GenError('state %s has both states and regions' % name)
+
+
+def read_event_values(config_path):
+    """returns a dict of the ES_EventType_t names and their values"""
+    with open(config_path) as f:
+        text = f.read()
+    text = re.sub(r'/\*.*?\*/', '', text, flags=re.S)
+    text = re.sub(r'//[^\n]*', '', text)
+    match = re.search(r'typedef\s+enum\s*\{([^}]*)\}\s*ES_EventType_t', text)
+    if match is None:
+        raise GenError('no ES_EventType_t enum in %s' % config_path)
+    values = {}
+    value = 0
+    for entry in match.group(1).split(','):
+        entry = entry.strip()
+        if not entry:
+            continue
+        if '=' in entry:
+            name, number = entry.split('=')
+            name = name.strip()
+            value = int(number.strip(), 0)
+        else:
+            name = entry
+        values[name] = value
+        value += 1
+    return values
+
+
+def check_defers(states, event_values):
+    """the deferred types must fit in the 32 bit DeferMask"""
+    for state in states:
+        for event in state.defer:
+            if event not in event_values:
+                raise GenError('%s defers %s, which is not an event type'
+                               % (state.name, event))
+            if event_values[event] > MAX_DEFER_TYPE:
+                raise GenError('%s defers %s, but only the first %d event '
+                               'types can be deferred'
+                               % (state.name, event, MAX_DEFER_TYPE + 1))
+
+
+def load_states(states_desc, parent, all_states):
+    """builds the tree of State objects"""
+    children = []
+    for name, desc in states_desc.items():
+        if name in all_states:
+            raise GenError('state %s is defined twice' % name)
+        state = State(name, desc, parent)
+        if state.depth > MAX_DEPTH:
+            raise GenError('state %s is nested deeper than %d levels'
+                           % (name, MAX_DEPTH))
+        all_states[name] = state
+        children.append(state)
+        if state.orthogonal:
+            state.children = load_states(desc['regions'], state, all_states)
+            for region in state.children:
+                region.is_region = True
+            state.initial = state.children[0]
+        else:
+            state.children = load_states(desc.get('states', {}), state,
+                                         all_states)
+        if state.children and not state.orthogonal:
+            if state.initial_name is None:
+                state.initial = state.children[0]
+            elif state.initial_name in [c.name for c in state.children]:
+                state.initial = all_states[state.initial_name]
+            else:
+                raise GenError('the initial state of %s, %s, is not one of '
+                               'its substates' % (name, state.initial_name))
+    return children
+
+
+def order_states(siblings, out):
+    """lists the states depth first, so that each state's substates follow
+    it, except that the regions of an orthogonal state come together"""
+    for state in siblings:
+        out.append(state)
+        expand(state, out)
+
+
+def expand(state, out):
+    if state.orthogonal:
+        out.extend(state.children)
+        for region in state.children:
+            expand(region, out)
+    else:
+        order_states(state.children, out)
+
+
+def number_regions(members, next_region):
+    """numbers the regions so that each comes after those inside it, the
+    members are the states directly in this region, returns the number
+    given to the region and the next number free"""
+    inside = []
+    pending = list(members)
+    while pending:
+        state = pending.pop(0)
+        inside.append(state)
+        if state.orthogonal:
+            first = next_region
+            for region in state.children:
+                _, next_region = number_regions([region], next_region)
+            state.sub_region = first
+        else:
+            pending.extend(state.children)
+    for state in inside:
+        state.region = next_region
+    return next_region, next_region + 1
+
+
+def find_lca(source, target):
+    """the deepest state containing both that is not left, transitions are
+    external so if one contains the other, the outer one is left too"""
+    a, b = source, target
+    while a.depth > b.depth:
+        a = a.parent
+    while b.depth > a.depth:
+        b = b.parent
+    while a is not b and a is not None:
+        a, b = a.parent, b.parent
+    if a is not None and (a is source or a is target):
+        a = a.parent
+    return a
+
+
+def resolve(machine):
+    all_states = {}
+    top = load_states(machine.get('states', {}), ROOT, all_states)
+    if not top:
+        raise GenError('the machine has no states')
+    if len(all_states) > MAX_STATES:
+        raise GenError('the machine has more than %d states' % MAX_STATES)
+    states = []
+    order_states(top, states)
+    for i, state in enumerate(states):
+        state.index = i
+    _, num_regions = number_regions(top, 0)
+    if num_regions > MAX_REGIONS:
+        raise GenError('the machine has more than %d regions' % MAX_REGIONS)
+    machine['_num_regions'] = num_regions
+    keeping = [s for s in states if s.history]
+    if len(keeping) > MAX_HISTORY:
+        raise GenError('more than %d states keep history' % MAX_HISTORY)
+    for slot, state in enumerate(keeping):
+        state.history_slot = slot
+    initial_name = machine.get('initial', top[0].name)
+    if initial_name not in [s.name for s in top]:
+        raise GenError('the initial state, %s, is not a top level state'
+                       % initial_name)
+    for state in all_states.values():
+        if len(state.transitions) > MAX_TRANSITIONS:
+            raise GenError('state %s has more than %d transitions'
+                           % (state.name, MAX_TRANSITIONS))
+        for t in state.transitions:
+            if t.target_name is None:
+                continue
+            if t.target_name not in all_states:
+                raise GenError('the target of %s on %s, %s, is not a state'
+                               % (state.name, t.event, t.target_name))
+            t.target = all_states[t.target_name]
+            t.lca = find_lca(state, t.target)
+            if t.lca is not None and t.lca.orthogonal:
+                raise GenError('the transition of %s on %s goes from one '
+                               'region of %s to another'
+                               % (state.name, t.event, t.lca.name))
+        # the transitions on one event must be together for the event map,
+        # keeping their order, which is the order the guards are tried in
+        order = []
+        for t in state.transitions:
+            if t.event not in order:
+                order.append(t.event)
+        state.transitions.sort(key=lambda t: order.index(t.event))
+    return states, all_states[initial_name]
+
+
+def fn(name):
+    return name if name else '0'
+
+
+def write_header(machine, states, prefix):
+    name = machine['name']
+    funcs = []
+    for s in states:
+        for f in (s.entry, s.exit):
+            if f and ('void %s( ES_Event_t ThisEvent );' % f) not in funcs:
+                funcs.append('void %s( ES_Event_t ThisEvent );' % f)
+        if s.during:
+            p = 'ES_Event_t %s( ES_Event_t ThisEvent );' % s.during
+            if p not in funcs:
+                funcs.append(p)
+        for t in s.transitions:
+            if t.guard:
+                p = 'bool %s( ES_Event_t ThisEvent );' % t.guard
+                if p not in funcs:
+                    funcs.append(p)
+            if t.action:
+                p = 'void %s( ES_Event_t ThisEvent );' % t.action
+                if p not in funcs:
+                    funcs.append(p)
+    out = []
+    out.append('/' + '*' * 76)
+    out.append(' Header file for the %s hierarchical state machine' % name)
+    out.append(' Generated by ES_HSMGen.py from %s, do not edit'
+               % machine['_source'])
+    out.append(' ' + '*' * 76 + '/')
+    out.append('')
+    out.append('#ifndef %s_H' % name)
+    out.append('#define %s_H' % name)
+    out.append('')
+    out.append('#include "ES_HSM.h"')
+    out.append('')
+    out.append('// State definitions for use with the query functions')
+    out.append('typedef enum')
+    out.append('{')
+    for i, s in enumerate(states):
+        out.append('  %s%s%s' % (prefix, s.name,
+                                 ',' if i < len(states) - 1 else ''))
+    out.append('}%sState_t;' % name)
+    out.append('')
+    out.append('// Public Function Prototypes')
+    out.append('')
+    out.append('bool Init%s ( uint8_t Priority );' % name)
+    out.append('bool Post%s( ES_Event_t ThisEvent );' % name)
+    out.append('ES_Event_t Run%s( ES_Event_t ThisEvent );' % name)
+    out.append('%sState_t Query%s ( void );' % (name, name))
+    out.append('bool %sIsIn ( %sState_t State );' % (name, name))
+    if any(s.defer for s in states):
+        out.append('uint16_t %sDeferralOverflows ( void );' % name)
+    if funcs:
+        out.append('')
+        out.append('// The entry, exit, during, guard and action functions,'
+                   ' written by hand')
+        out.append('')
+        out.extend(funcs)
+    out.append('')
+    out.append('#endif /* %s_H */' % name)
+    out.append('')
+    return '\n'.join(out)
+
+
+def state_ref(state, prefix):
+    return 'ES_HSM_ROOT' if state is None else prefix + state.name
+
+
+def write_source(machine, states, initial, prefix):
+    name = machine['name']
+    out = []
+    out.append('/' + '*' * 76)
+    out.append(' Module')
+    out.append('   %s.c' % name)
+    out.append('')
+    out.append(' Description')
+    out.append('   Generated by ES_HSMGen.py from %s, do not edit. Change the'
+               % machine['_source'])
+    out.append('   description and generate it again.')
+    if machine.get('description'):
+        out.append('')
+        out.append('   ' + machine['description'])
+    out.append('')
+    out.append(' Notes')
+    out.append('   The tables are run by the ES_HSM engine. Each state with '
+               'transitions has')
+    out.append('   an event map, indexed by the event type, so the engine '
+               'goes straight to')
+    out.append('   the transitions on an event.')
+    out.append(' ' + '*' * 76 + '/')
+    out.append('/*----------------------------- Include Files '
+               '-----------------------------*/')
+    out.append('#include "ES_Configure.h"')
+    out.append('#include "ES_Framework.h"')
+    out.append('#include "ES_DeferRecall.h"')
+    out.append('#include "ES_HSM.h"')
+    out.append('#include "%s.h"' % name)
+    out.append('')
+    out.append('/*---------------------------- Module Variables '
+               '---------------------------*/')
+    for s in states:
+        if not s.transitions:
+            continue
+        out.append('static const ES_HSMTransition_t %sTransitions[] =' %
+                   s.name)
+        out.append('{')
+        out.append('  /* Event, Guard, Action, Target, Lca */')
+        rows = []
+        for t in s.transitions:
+            if t.target is None:
+                target, lca = 'ES_HSM_INTERNAL', 'ES_HSM_ROOT'
+            else:
+                target = state_ref(t.target, prefix)
+                lca = state_ref(t.lca, prefix)
+            rows.append('  { %s, %s, %s, %s, %s }' %
+                        (t.event, fn(t.guard), fn(t.action), target, lca))
+        out.append(',\n'.join(rows))
+        out.append('};')
+        out.append('')
+        out.append('static const uint8_t %sEventMap[ES_NUM_EVENT_TYPES] ='
+                   % s.name)
+        out.append('{')
+        firsts = []
+        for i, t in enumerate(s.transitions):
+            if t.event not in [e for e, _ in firsts]:
+                firsts.append((t.event, i + 1))
+        out.append(',\n'.join('  [%s] = %d' % (e, i) for e, i in firsts))
+        out.append('};')
+        out.append('')
+    out.append('static const ES_HSMStateDesc_t StateTable[] =')
+    out.append('{')
+    out.append('  /* Parent, Depth, InitialChild, Entry, Exit, During, '
+               'Transitions,')
+    out.append('     EventMap, Region, NumRegions, SubRegion, DeferMask, History,')
+    out.append('     HistorySlot */')
+    rows = []
+    for s in states:
+        child = (prefix + s.initial.name) if s.initial else 'ES_HSM_NO_STATE'
+        if s.transitions:
+            trans = '%sTransitions, ARRAY_SIZE(%sTransitions), %sEventMap' % (
+                s.name, s.name, s.name)
+        else:
+            trans = '0, 0, 0'
+        if s.orthogonal:
+            regions = '%d, %d, %d' % (s.region, len(s.children), s.sub_region)
+        else:
+            regions = '%d, 0, 0' % s.region
+        if s.defer:
+            defer = ' | '.join('ES_TYPE_MASK(%s)' % e for e in s.defer)
+        else:
+            defer = '0'
+        rows.append('  /* %s%s */\n  { %s, %d, %s, %s, %s, %s,\n    %s,\n'
+                    '    %s, %s,\n    %s, %d }' % (
+                        prefix, s.name, state_ref(s.parent, prefix), s.depth,
+                        child, fn(s.entry), fn(s.exit), fn(s.during), trans,
+                        regions, defer, HISTORY_KINDS[s.history],
+                        s.history_slot))
+    out.append(',\n'.join(rows))
+    out.append('};')
+    out.append('')
+    out.append('static const ES_HSMDesc_t %sDesc =' % name)
+    out.append('{')
+    out.append('  StateTable, ARRAY_SIZE(StateTable), %s%s, %d' %
+               (prefix, initial.name, machine['_num_regions']))
+    out.append('};')
+    out.append('')
+    out.append('static ES_HSM_t MyHSM;')
+    out.append('static uint8_t  MyPriority;')
+    defers = any(s.defer for s in states)
+    if defers:
+        out.append('static ES_Event_t DeferralQueue[%d + 1];' %
+                   machine.get('defer_queue_size', 4))
+        out.append('// the events lost because the deferral queue was full')
+        out.append('static uint16_t   DeferralOverflows = 0;')
+    out.append('')
+    out.append('/*------------------------------ Module Code '
+               '------------------------------*/')
+    out.append('''/%(stars)s
+ Function
+     Init%(n)s
+
+ Parameters
+     uint8_t : the priority of this service
+
+ Returns
+     bool, false if error in initialization, true otherwise
+
+ Description
+     Saves away the priority, and starts the state machine
+ Author
+     ES_HSMGen.py, from %(src)s
+%(stars)s/
+bool Init%(n)s ( uint8_t Priority )
+{
+  ES_Event_t ThisEvent;
+
+  MyPriority = Priority;
+%(defer)s  ThisEvent.EventType = ES_ENTRY;
+  ThisEvent.EventParam = 0;
+  ES_HSM_Start(&MyHSM, &%(n)sDesc, ThisEvent);
+  return true;
+}
+
+/%(stars)s
+ Function
+     Post%(n)s
+
+ Parameters
+     ES_Event_t ThisEvent , the event to post to the queue
+
+ Returns
+     bool, false if the post operation failed, true otherwise
+
+ Description
+     Posts an event to this state machine's queue
+ Author
+     ES_HSMGen.py, from %(src)s
+%(stars)s/
+bool Post%(n)s( ES_Event_t ThisEvent )
+{
+  return ES_PostToService( MyPriority, ThisEvent);
+}
+
+/%(stars)s
+ Function
+     Run%(n)s
+
+ Parameters
+     ES_Event_t : the event to process
+
+ Returns
+     ES_Event_t, ES_NO_EVENT
+
+ Description
+     hands the event to the ES_HSM engine
+ Notes
+     events that no state uses come back from ES_HSM_Run unchanged, and are
+     dropped here%(run_note)s
+ Author
+     ES_HSMGen.py, from %(src)s
+%(stars)s/
+ES_Event_t Run%(n)s( ES_Event_t ThisEvent )
+{
+  ES_Event_t ReturnEvent = { ES_NO_EVENT, 0 };
+
+%(run)s  return ReturnEvent;
+}
+
+/%(stars)s
+ Function
+     Query%(n)s
+
+ Parameters
+     None
+
+ Returns
+     %(n)sState_t, the current (leaf) state of the state machine
+
+ Author
+     ES_HSMGen.py, from %(src)s
+%(stars)s/
+%(n)sState_t Query%(n)s ( void )
+{
+  return (%(n)sState_t)ES_HSM_GetState(&MyHSM);
+}
+
+/%(stars)s
+ Function
+     %(n)sIsIn
+
+ Parameters
+     %(n)sState_t State, the state to test for
+
+ Returns
+     bool, true if State is active, the leaf state or one of its ancestors
+
+ Author
+     ES_HSMGen.py, from %(src)s
+%(stars)s/
+bool %(n)sIsIn ( %(n)sState_t State )
+{
+  return ES_HSM_IsIn(&MyHSM, (ES_HSMState_t)State);
+}
+%(overflows)s''' % {'n': name, 'src': machine['_source'], 'stars': '*' * 76,
+       'run': RUN_DEFERRING if defers else RUN_PLAIN,
+       'run_note': ('. So are events of a deferred type that did not '
+                    'fit in the\n     deferral queue, after they are counted'
+                    if defers else ''),
+       'overflows': (OVERFLOWS % {'n': name, 'src': machine['_source'],
+                                  'stars': '*' * 76} if defers else ''),
+       'defer': (
+        '  ES_InitDeferralQueueWith(DeferralQueue, ARRAY_SIZE(DeferralQueue));\n'
+        '  ES_HSM_SetDeferralQueue(&MyHSM, DeferralQueue, MyPriority);\n'
+        if defers else '')})
+    return '\n'.join(out)
+
+
+RUN_PLAIN = """  ES_HSM_Run(&MyHSM, ThisEvent);
+"""
+
+RUN_DEFERRING = """  if ((ES_HSM_Run(&MyHSM, ThisEvent).EventType != ES_NO_EVENT) &&
+      (ES_HSM_IsDeferring(&MyHSM, ThisEvent.EventType) == true) &&
+      (DeferralOverflows < UINT16_MAX))
+  {
+    DeferralOverflows++;  // the deferral queue was full, so it was lost
+  }
+"""
+
+OVERFLOWS = """
+/%(stars)s
+ Function
+     %(n)sDeferralOverflows
+
+ Parameters
+     None
+
+ Returns
+     uint16_t, the number of events lost because the deferral queue was
+     full, stopping at UINT16_MAX
+
+ Author
+     ES_HSMGen.py, from %(src)s
+%(stars)s/
+uint16_t %(n)sDeferralOverflows ( void )
+{
+  return DeferralOverflows;
+}
+"""
+
+
+def dot_id(state):
+    return '"%s"' % state.name
+
+
+def write_dot(machine, states, initial):
+    out = ['digraph %s {' % machine['name'],
+           '  compound=true;',
+           '  node [shape=box, style=rounded];']
+
+    def label(t):
+        text = t.event
+        if t.guard:
+            text += ' [%s]' % t.guard
+        if t.action:
+            text += ' / %s' % t.action
+        return text
+
+    def anchor(state):
+        # edges to and from a composite state attach to its cluster
+        if state.children:
+            return '"%s_anchor"' % state.name
+        return dot_id(state)
+
+    def emit(state, indent):
+        pad = '  ' * indent
+        if state.children:
+            out.append('%ssubgraph "cluster_%s" {' % (pad, state.name))
+            out.append('%s  label="%s%s";' % (pad, state.name, {
+                None: '', 'shallow': ' (H)', 'deep': ' (H*)'}[state.history]))
+            if state.is_region:
+                out.append('%s  style=dashed;' % pad)
+            out.append('%s  %s [shape=point, style=invis];' %
+                       (pad, anchor(state)))
+            if not state.orthogonal:
+                out.append('%s  "%s_init" [shape=point];' % (pad, state.name))
+                out.append('%s  "%s_init" -> %s;' %
+                           (pad, state.name, anchor(state.initial)))
+            for c in state.children:
+                emit(c, indent + 1)
+            out.append('%s}' % pad)
+        else:
+            out.append('%s%s;' % (pad, dot_id(state)))
+
+    for s in states:
+        if s.parent is None:
+            emit(s, 1)
+    out.append('  "__init" [shape=point];')
+    out.append('  "__init" -> %s;' % anchor(initial))
+    for s in states:
+        for t in s.transitions:
+            attrs = ['label="%s"' % label(t)]
+            if s.children:
+                attrs.append('ltail="cluster_%s"' % s.name)
+            if t.target is None:
+                attrs.append('style=dashed')
+                dest = anchor(s)
+                if s.children:
+                    attrs.append('lhead="cluster_%s"' % s.name)
+            else:
+                dest = anchor(t.target)
+                if t.target.children:
+                    attrs.append('lhead="cluster_%s"' % t.target.name)
+            out.append('  %s -> %s [%s];' % (anchor(s), dest,
+                                             ', '.join(attrs)))
+    out.append('}')
+    out.append('')
+    return '\n'.join(out)
+
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    parser = argparse.ArgumentParser(
+        description='Generate an ES_HSM state machine service from a JSON '
+                    'statechart description')
+    parser.add_argument('description', help='the JSON description')
+    parser.add_argument('-s', '--source-dir', default='.',
+                        help='where to write <Name>.c')
+    parser.add_argument('-i', '--header-dir', default=None,
+                        help='where to write <Name>.h (default: source dir)')
+    parser.add_argument('-c', '--config',
+                        default=os.path.join(here, '..', 'Headers',
+                                             'ES_Configure.h'),
+                        help='the ES_Configure.h to check the deferred event '
+                             'types against')
+    parser.add_argument('--dot', help='also write a DOT diagram to this file')
+    args = parser.parse_args()
+
+    try:
+        with open(args.description) as f:
+            machine = json.load(f)
+        if 'name' not in machine:
+            raise GenError('the machine has no name')
+        machine['_source'] = os.path.basename(args.description)
+        prefix = machine.get('prefix', machine['name'] + '_')
+        states, initial = resolve(machine)
+        if any(s.defer for s in states):
+            check_defers(states, read_event_values(args.config))
+    except (GenError, ValueError, IOError) as e:
+        sys.stderr.write('%s: %s\n' % (args.description, e))
+        return 1
+
+    header_dir = args.header_dir if args.header_dir else args.source_dir
+    name = machine['name']
+    with open(os.path.join(header_dir, name + '.h'), 'w') as f:
+        f.write(write_header(machine, states, prefix))
+    with open(os.path.join(args.source_dir, name + '.c'), 'w') as f:
+        f.write(write_source(machine, states, initial, prefix))
+    if args.dot:
+        with open(args.dot, 'w') as f:
+            f.write(write_dot(machine, states, initial))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,205 @@
+#!/usr/bin/env python3
+"""
+ Module
+     ES_PCSymbolize.py
+
+ Description
+     Turns the PC sample histogram written by ES_PCSample into the share of
+     the samples, and so of the time, that fell in each function. The
+     functions are taken from the program's symbol table, either from the
+     ELF image (the .axf from uVision, or the host executable) by way of nm,
+     or from the Image Symbol Table of a uVision .map file.
+
+ Notes
+     usage: ES_PCSymbolize.py samples.txt program.axf|program.map
+                [--nm arm-none-eabi-nm] [--top N] [--buckets]
+
+     On the host, the samples are the file named by ES_PCSAMPLE_FILE
+     (default es_pcsample.txt). On the Tiva, ES_PCSample_Dump prints them on
+     the console, and a capture of the console can be given as it is, the
+     lines around the histogram are skipped.
+     The samples are offsets from the start of the code. That is address 0
+     on the Tiva, and the __executable_start (__mh_execute_header on macOS)
+     symbol for the host, so the offsets are moved by the address of that
+     symbol when it is in the symbol table.
+     Each bucket is charged to the function that holds the start of the
+     bucket. With PC_SAMPLE_SHIFT at 5, the few samples in a bucket that
+     straddles the end of a short function can go to the wrong one.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/20/26 02:40 ags     Began Coding
+"""
+
+import argparse
+import bisect
+import re
+import shutil
+import subprocess
+import sys
+
+HEADER = re.compile(r'# ES_PCSample base (0x[0-9a-fA-F]+) shift (\d+) '
+                    r'rate (\d+) samples (\d+) outside (\d+)')
+BUCKET = re.compile(r'^([0-9a-fA-F]+) (\d+)$')
+
+# a code symbol in the Image Symbol Table of an armlink .map file:
+#   RunTestHarnessService0    0x00000a41   Thumb Code   212  TestHarn...
+MAP_SYMBOL = re.compile(r'^\s+(\S+)\s+0x([0-9a-fA-F]+)\s+'
+                        r'(?:Thumb|ARM) Code\s+(\d+)\s')
+
+# the symbols that mark the start of the code on the host
+BASE_SYMBOLS = ('__executable_start', '__mh_execute_header')
+
+
+class SymbolizeError(Exception):
+    pass
+
+
+def read_samples(path):
+    """returns the header fields and a list of (offset, count)"""
+    header = None
+    buckets = []
+    with open(path) as f:
+        for line in f:
+            line = line.strip()
+            if header is None:
+                match = HEADER.search(line)
+                if match is not None:
+                    header = {'shift': int(match.group(2)),
+                              'rate': int(match.group(3)),
+                              'samples': int(match.group(4)),
+                              'outside': int(match.group(5))}
+                continue
+            if line.startswith('# end'):
+                return header, buckets
+            match = BUCKET.match(line)
+            if match is not None:
+                buckets.append((int(match.group(1), 16),
+                                int(match.group(2))))
+    if header is None:
+        raise SymbolizeError('no ES_PCSample header found')
+    raise SymbolizeError('the histogram is cut short, no "# end" line')
+
+
+def read_map(path):
+    """returns a list of (address, size, name) from a uVision .map file"""
+    symbols = []
+    with open(path, errors='replace') as f:
+        for line in f:
+            match = MAP_SYMBOL.match(line)
+            if match is not None:
+                # the Thumb bit is set in the addresses of Thumb code
+                symbols.append((int(match.group(2), 16) & ~1,
+                                int(match.group(3)), match.group(1)))
+    return symbols
+
+
+def find_nm(requested):
+    if requested:
+        return requested
+    for tool in ('arm-none-eabi-nm', 'nm'):
+        if shutil.which(tool):
+            return tool
+    raise SymbolizeError('no nm found, give one with --nm')
+
+
+def read_elf(path, nm):
+    """returns a list of (address, size, name), and the base if found"""
+    result = subprocess.run([nm, '-n', '-S', '--defined-only', path],
+                            stdout=subprocess.PIPE, stderr=subprocess.PIPE,
+                            universal_newlines=True)
+    if result.returncode != 0:
+        raise SymbolizeError(result.stderr.strip())
+    symbols = []
+    base = 0
+    for line in result.stdout.splitlines():
+        fields = line.split()
+        if len(fields) == 4:
+            address, size, kind, name = fields
+            size = int(size, 16)
+        elif len(fields) == 3:
+            address, kind, name = fields
+            size = 0
+        else:
+            continue
+        if name in BASE_SYMBOLS:
+            base = int(address, 16)
+        if kind in 'tTwW':
+            symbols.append((int(address, 16) & ~1, size, name))
+    return symbols, base
+
+
+def symbol_for(starts, symbols, address):
+    """returns the name of the function holding the address, or None"""
+    i = bisect.bisect_right(starts, address) - 1
+    if i < 0:
+        return None, 0
+    start, size, name = symbols[i]
+    # a size of 0 means it was not given, so take it to run to the next one
+    if size != 0 and address >= start + size:
+        return None, 0
+    return name, address - start
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Symbolize an ES_PCSample histogram')
+    parser.add_argument('samples', help='the output of ES_PCSample_Write')
+    parser.add_argument('program',
+                        help='the ELF image (.axf) or uVision .map file')
+    parser.add_argument('--nm', default=None,
+                        help='the nm to read the ELF image with (default: '
+                             'arm-none-eabi-nm, then nm)')
+    parser.add_argument('--top', type=int, default=30,
+                        help='how many functions to list (default: 30)')
+    parser.add_argument('--buckets', action='store_true',
+                        help='list the busiest buckets as well')
+    args = parser.parse_args()
+
+    try:
+        header, buckets = read_samples(args.samples)
+        if args.program.lower().endswith('.map'):
+            symbols, base = read_map(args.program), 0
+        else:
+            symbols, base = read_elf(args.program, find_nm(args.nm))
+    except (SymbolizeError, IOError, OSError) as e:
+        sys.stderr.write('%s\n' % e)
+        return 1
+    if not symbols:
+        sys.stderr.write('%s: no code symbols found\n' % args.program)
+        return 1
+
+    symbols.sort()
+    starts = [s[0] for s in symbols]
+    total = header['samples']
+    per_function = {}
+    located = []
+    for offset, count in buckets:
+        name, into = symbol_for(starts, symbols, base + offset)
+        name = name if name is not None else '(unknown)'
+        per_function[name] = per_function.get(name, 0) + count
+        located.append((count, name, into, offset))
+
+    print('%d samples at %dHz, %d outside the histogram' %
+          (total, header['rate'], header['outside']))
+    if total == 0:
+        return 0
+    print('\n Samples      %  Function')
+    ranked = sorted(per_function.items(), key=lambda item: -item[1])
+    for name, count in ranked[:args.top]:
+        print('%8d %6.2f  %s' % (count, 100.0 * count / total, name))
+    if header['outside']:
+        print('%8d %6.2f  (outside)' %
+              (header['outside'], 100.0 * header['outside'] / total))
+    if args.buckets:
+        print('\n Samples      %  Offset    Where')
+        for count, name, into, offset in sorted(located,
+                                                key=lambda b: -b[0])[:args.top]:
+            print('%8d %6.2f  %08x  %s+0x%x' %
+                  (count, 100.0 * count / total, offset, name, into))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
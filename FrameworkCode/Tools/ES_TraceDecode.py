@@ -0,0 +1,279 @@
+#!/usr/bin/env python3
+"""
+ Module
+     ES_TraceDecode.py
+
+ Description
+     Decodes the binary trace written by ES_Trace into the Chrome trace
+     event JSON format, which can be opened in chrome://tracing or
+     ui.perfetto.dev. Each service is shown as a thread, with a slice for
+     every call to its run function and a mark for every event posted to
+     it. The timer expirations and the event checkers that fired are shown
+     on threads of their own.
+     With --replay, the inputs to the services (the posts made from outside
+     the run functions) are written out instead, in the form that the host
+     port reads back to replay them with _INCLUDE_EVENT_REPLAY_.
+
+ Notes
+     usage: ES_TraceDecode.py trace.bin [-o trace.json]
+                [-c Headers/ES_Configure.h] [--replay]
+
+     On the host, the trace is the file named by ES_TRACE_FILE (default
+     es_trace.bin). On the Tiva it comes out of UART1 at 1Mbaud, 8N1, and
+     can be saved with, for example:
+       stty -F /dev/ttyUSB0 1000000 raw && cat /dev/ttyUSB0 > trace.bin
+     The stream starts with a SYNC record. Anything before the first SYNC
+     (a capture started part way through) is skipped, and a later SYNC
+     (the target was reset) starts a new run on the same timeline. If the
+     records get out of step, the decoder skips to the next SYNC.
+     The event type names are read from the ES_EventType_t enum in
+     ES_Configure.h, by default the one in the Headers directory next to
+     this one. Types that are not found are shown by number.
+     The record format must match ES_Trace.h.
+     A replay only covers the first run in the stream, up to the next SYNC,
+     and is incomplete if any records were lost. Both are warned about.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/20/26 04:41 ags     input records, and --replay to write them out
+ 10/20/26 01:02 ags     Began Coding
+"""
+
+import argparse
+import json
+import os
+import re
+import struct
+import sys
+
+# must match ES_TRACE_RECORD_SIZE and ES_TraceKind_t in ES_Trace.h
+RECORD_SIZE = 6
+POST = 0
+RUN_BEGIN = 1
+RUN_END = 2
+TIMEOUT = 3
+CHECKER = 4
+OVERFLOW = 5
+LOST = 6
+TIME = 7
+INPUT = 8
+INPUT_BROADCAST = 9
+SYNC = 0x0F
+
+# the SYNC record as ES_Trace_Init writes it
+SYNC_RECORD = bytes([SYNC << 4, 0x5A, 0x00, 0x00, 0x5A, 0xA5])
+
+# the services are threads 0-15, these come after them
+TIMER_TID = 16
+CHECKER_TID = 17
+INPUT_TID = 18
+
+
+class DecodeError(Exception):
+    pass
+
+
+def read_event_names(config_path):
+    """returns a list of the ES_EventType_t names, indexed by value"""
+    with open(config_path) as f:
+        text = f.read()
+    text = re.sub(r'/\*.*?\*/', '', text, flags=re.S)
+    text = re.sub(r'//[^\n]*', '', text)
+    match = re.search(r'typedef\s+enum\s*\{([^}]*)\}\s*ES_EventType_t', text)
+    if match is None:
+        raise DecodeError('no ES_EventType_t enum in %s' % config_path)
+    names = []
+    value = 0
+    for entry in match.group(1).split(','):
+        entry = entry.strip()
+        if not entry:
+            continue
+        if '=' in entry:
+            name, number = entry.split('=')
+            name = name.strip()
+            value = int(number.strip(), 0)
+        else:
+            name = entry
+        while len(names) <= value:
+            names.append(None)
+        names[value] = name
+        value += 1
+    return names
+
+
+def event_name(names, event_type):
+    if event_type < len(names) and names[event_type] is not None:
+        return names[event_type]
+    return 'event %d' % event_type
+
+
+def decode(data, names, inputs=None):
+    """returns the list of trace events for the records in data, and adds
+    the inputs of the first run to inputs, as (time, service, type, param)
+    with a service of None for a broadcast"""
+    start = data.find(SYNC_RECORD)
+    if start < 0:
+        raise DecodeError('no SYNC record found, is this an ES_Trace stream?')
+    events = []
+    threads = set()
+    now = 0
+    extra_gap = 0
+    offset = start
+    runs = 0
+    while offset + RECORD_SIZE <= len(data):
+        header, event_type, gap, param = struct.unpack_from(
+            '<BBHH', data, offset)
+        offset += RECORD_SIZE
+        kind = header >> 4
+        service = header & 0x0F
+        now += (extra_gap << 16) + gap
+        extra_gap = 0
+        name = event_name(names, event_type)
+        args = {'param': param}
+
+        if kind == TIME:
+            extra_gap = param
+        elif kind == SYNC:
+            if param != 0xA55A:
+                raise DecodeError('bad SYNC record at byte %d' % (offset -
+                                  RECORD_SIZE))
+            runs += 1
+            if runs == 2 and inputs is not None:
+                sys.stderr.write('the target was reset at %d uS, only the '
+                                 'inputs before it are replayed\n' % now)
+            events.append({'name': 'start', 'ph': 'i', 's': 'g',
+                           'pid': 0, 'tid': 0, 'ts': now})
+        elif kind == RUN_BEGIN:
+            events.append({'name': name, 'ph': 'B', 'pid': 0,
+                           'tid': service, 'ts': now, 'args': args})
+            threads.add(service)
+        elif kind == RUN_END:
+            events.append({'name': name, 'ph': 'E', 'pid': 0,
+                           'tid': service, 'ts': now})
+            threads.add(service)
+        elif kind == POST:
+            events.append({'name': 'post ' + name, 'ph': 'i', 's': 't',
+                           'pid': 0, 'tid': service, 'ts': now,
+                           'args': args})
+            threads.add(service)
+        elif kind == INPUT:
+            events.append({'name': 'input ' + name, 'ph': 'i', 's': 't',
+                           'pid': 0, 'tid': service, 'ts': now,
+                           'args': args})
+            threads.add(service)
+            if runs == 1 and inputs is not None:
+                inputs.append((now, service, event_type, param))
+        elif kind == INPUT_BROADCAST:
+            events.append({'name': 'broadcast ' + name, 'ph': 'i',
+                           's': 't', 'pid': 0, 'tid': INPUT_TID, 'ts': now,
+                           'args': args})
+            threads.add(INPUT_TID)
+            if runs == 1 and inputs is not None:
+                inputs.append((now, None, event_type, param))
+        elif kind == OVERFLOW:
+            events.append({'name': 'queue full, lost ' + name, 'ph': 'i',
+                           's': 't', 'pid': 0, 'tid': service, 'ts': now,
+                           'args': args})
+            threads.add(service)
+        elif kind == TIMEOUT:
+            label = 'HR timer' if name == 'ES_SHORT_TIMEOUT' else 'timer'
+            events.append({'name': '%s %d' % (label, param), 'ph': 'i',
+                           's': 't', 'pid': 0, 'tid': TIMER_TID, 'ts': now})
+            threads.add(TIMER_TID)
+        elif kind == CHECKER:
+            events.append({'name': 'checker %d' % param, 'ph': 'i',
+                           's': 't', 'pid': 0, 'tid': CHECKER_TID,
+                           'ts': now})
+            threads.add(CHECKER_TID)
+        elif kind == LOST:
+            if runs == 1 and inputs is not None:
+                sys.stderr.write('%d records lost at %d uS, the replay is '
+                                 'missing any inputs among them\n' %
+                                 (param, now))
+            events.append({'name': 'trace full, %d records lost' % param,
+                           'ph': 'i', 's': 'g', 'pid': 0, 'tid': 0,
+                           'ts': now})
+        else:
+            # out of step, most likely the target was reset part way
+            # through a record, so carry on from the next SYNC
+            sys.stderr.write('unknown record kind %d at byte %d, '
+                             'skipping to the next SYNC\n' %
+                             (kind, offset - RECORD_SIZE))
+            offset = data.find(SYNC_RECORD, offset - RECORD_SIZE + 1)
+            if offset < 0:
+                break
+
+    events.append({'name': 'process_name', 'ph': 'M', 'pid': 0,
+                   'args': {'name': 'ES Framework'}})
+    for tid in sorted(threads):
+        if tid == TIMER_TID:
+            thread = 'Timers'
+        elif tid == CHECKER_TID:
+            thread = 'Event checkers'
+        elif tid == INPUT_TID:
+            thread = 'Broadcast inputs'
+        else:
+            thread = 'Service %d' % tid
+        events.append({'name': 'thread_name', 'ph': 'M', 'pid': 0,
+                       'tid': tid, 'args': {'name': thread}})
+        events.append({'name': 'thread_sort_index', 'ph': 'M', 'pid': 0,
+                       'tid': tid, 'args': {'sort_index': -tid}})
+    return events
+
+
+def replay_text(inputs, names):
+    """returns the inputs as the lines of a replay file"""
+    lines = ['# time(uS) service type param']
+    for now, service, event_type, param in inputs:
+        lines.append('%d %s %d 0x%04X  # %s' % (
+            now, 'B' if service is None else service, event_type, param,
+            event_name(names, event_type)))
+    return '\n'.join(lines)
+
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    parser = argparse.ArgumentParser(
+        description='Decode an ES_Trace stream into Chrome trace JSON')
+    parser.add_argument('trace', help='the binary trace, - for stdin')
+    parser.add_argument('-o', '--output', default=None,
+                        help='where to write the JSON (default: stdout)')
+    parser.add_argument('-c', '--config',
+                        default=os.path.join(here, '..', 'Headers',
+                                             'ES_Configure.h'),
+                        help='the ES_Configure.h to take the event names '
+                             'from')
+    parser.add_argument('--replay', action='store_true',
+                        help='write the inputs, for ES_REPLAY_FILE, rather '
+                             'than the JSON')
+    args = parser.parse_args()
+
+    try:
+        names = read_event_names(args.config)
+        if args.trace == '-':
+            data = sys.stdin.buffer.read()
+        else:
+            with open(args.trace, 'rb') as f:
+                data = f.read()
+        inputs = [] if args.replay else None
+        events = decode(data, names, inputs)
+    except (DecodeError, ValueError, IOError) as e:
+        sys.stderr.write('%s: %s\n' % (args.trace, e))
+        return 1
+
+    if args.replay:
+        text = replay_text(inputs, names)
+    else:
+        text = json.dumps({'traceEvents': events, 'displayTimeUnit': 'ms'},
+                          indent=1)
+    if args.output:
+        with open(args.output, 'w') as f:
+            f.write(text)
+    else:
+        sys.stdout.write(text + '\n')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())